@@ -26,14 +26,14 @@ rem If your compiler is in the PATH, you can remove these lines
 set PATH=%COMPILER_PATH%;%PATH%
 
 rem Compile the library
-gcc -c src/raypals.c -o lib/raypals.o -I include -I%RAYLIB_PATH%/include
+gcc -c src/raypals.c -o lib/raypals.o -I include -I%RAYLIB_PATH%/include && gcc -c src/raypals_thread.c -o lib/raypals_thread.o
 if %errorlevel% neq 0 (
     echo Error: Failed to compile raypals.c!
     pause
     exit /b 1
 )
 
-ar rcs lib/libraypals.a lib/raypals.o
+ar rcs lib/libraypals.a lib/raypals.o lib/raypals_thread.o
 if %errorlevel% neq 0 (
     echo Error: Failed to create static library!
     pause
@@ -65,7 +65,7 @@ echo.
 echo All done! You can now use RayPals in your projects.
 echo.
 echo To use RayPals in your own project:
-echo 1. Copy include/raypals.h and src/raypals.c to your project
+echo 1. Copy include/raypals.h and the src/ files to your project
 echo 2. Or link against lib/libraypals.a
 echo.
 echo To try the examples: cd bin and run sprite_gallery.exe
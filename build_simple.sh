@@ -20,7 +20,8 @@ mkdir -p lib
 # Compile the library
 echo "🔨 Building RayPals library..."
 gcc -c src/raypals.c -o lib/raypals.o -I include $(pkg-config --cflags raylib)
-ar rcs lib/libraypals.a lib/raypals.o
+gcc -c src/raypals_thread.c -o lib/raypals_thread.o
+ar rcs lib/libraypals.a lib/raypals.o lib/raypals_thread.o
 
 if [ $? -eq 0 ]; then
     echo "✅ Library built successfully in lib/libraypals.a!"
@@ -38,7 +39,7 @@ if [ -d "examples" ]; then
     for example in examples/*.c; do
         name=$(basename "$example" .c)
         echo "   Building $name..."
-        gcc "$example" lib/raypals.a -o "bin/$name" -I include $(pkg-config --cflags --libs raylib) -lm
+        gcc "$example" lib/raypals.a -o "bin/$name" -I include $(pkg-config --cflags --libs raylib) -lm -lpthread
         
         if [ $? -eq 0 ]; then
             echo "   ✅ Built $name"
@@ -54,7 +55,7 @@ echo ""
 echo "🎉 All done! You can now use RayPals in your projects."
 echo ""
 echo "To use RayPals in your own project:"
-echo "1. Copy include/raypals.h and src/raypals.c to your project"
+echo "1. Copy include/raypals.h and the src/ files to your project"
 echo "2. Or link against lib/libraypals.a"
 echo ""
 echo "To try the examples: cd bin && ./sprite_gallery"
@@ -12,6 +12,9 @@
 #include "raylib.h"
 #include "raypals.h"
 #include <math.h>
+#include <stdlib.h>
+
+#define CROWD_SIZE 2000   // Robots in the background crowd
 
 int main(void)
 {
@@ -65,6 +68,29 @@ int main(void)
     Vector3 rotationSpeed2 = { 10.0f, 20.0f, 5.0f };    // Different rotation for robot2
     Vector3 rotationSpeed3 = { 0.0f, -40.0f, 0.0f };    // Different rotation for robot3
 
+    // A crowd of small robots around the scene, kept both as sprites and as instances of
+    // one template so the two draw paths can be compared
+    RayPals3DSprite** crowd = (RayPals3DSprite**)malloc(sizeof(RayPals3DSprite*) * CROWD_SIZE);
+    Matrix* crowdTransforms = (Matrix*)malloc(sizeof(Matrix) * CROWD_SIZE);
+    Color* crowdTints = (Color*)malloc(sizeof(Color) * CROWD_SIZE);
+    RayPals3DSprite* crowdRobot = Create3DRobot((Vector3){ 0.0f, 0.0f, 0.0f }, 0.5f, DARKGRAY, SKYBLUE);
+    RayPals3DSpriteTemplate* crowdTemplate = Create3DSpriteTemplate(crowdRobot);
+    for (int i = 0; i < CROWD_SIZE; i++) {
+        float angle = i * 137.5f * DEG2RAD;             // Golden angle spiral outside the grid
+        float distance = 12.0f + 0.02f * i;
+        Vector3 position = { cosf(angle) * distance, 0.5f, sinf(angle) * distance };
+        Vector3 rotation = { 0.0f, (float)GetRandomValue(0, 359), 0.0f };
+        Color tint = (Color){ (unsigned char)GetRandomValue(128, 255), (unsigned char)GetRandomValue(128, 255), 255, 255 };
+
+        crowd[i] = Create3DRobot(position, 0.5f, DARKGRAY, SKYBLUE);
+        Set3DSpriteRotation(crowd[i], rotation);
+        crowdTransforms[i] = Get3DInstanceTransform(position, rotation, (Vector3){ 1.0f, 1.0f, 1.0f });
+        crowdTints[i] = tint;
+    }
+    bool drawCrowd = false;
+    bool instancedCrowd = true;
+    int crowdDrawn = 0;
+
     SetTargetFPS(60);                                   // Set our game to run at 60 frames-per-second
     //--------------------------------------------------------------------------------------
 
@@ -80,6 +106,9 @@ int main(void)
             rotationPaused = !rotationPaused;
         }
         
+        if (IsKeyPressed(KEY_C)) drawCrowd = !drawCrowd;
+        if (IsKeyPressed(KEY_I)) instancedCrowd = !instancedCrowd;
+        
         // Update camera position if rotation is not paused
         if (!rotationPaused) {
             cameraAngle += rotationSpeed;
@@ -150,15 +179,27 @@ int main(void)
                 Draw3DSprite(robot2, camera);
                 Draw3DSprite(robot3, camera);
                 
+                // The instanced crowd is one vertex stream; per sprite it is 2000 traversals
+                if (drawCrowd && instancedCrowd) {
+                    crowdDrawn = Draw3DSpriteInstancesCulled(crowdTemplate, crowdTransforms, crowdTints, CROWD_SIZE, camera);
+                } else if (drawCrowd) {
+                    crowdDrawn = Draw3DSpritesCulled(crowd, CROWD_SIZE, camera);
+                }
+                
             EndMode3D();
 
             // Draw UI
             DrawRectangle(0, 0, screenWidth, 40, (Color){ 0, 0, 0, 120 });
             DrawText("3D Robot Example", 10, 10, 20, WHITE);
+            if (drawCrowd) {
+                DrawText(TextFormat("+%d robots (%s): %d drawn", CROWD_SIZE, instancedCrowd ? "instanced" : "per sprite",
+                         crowdDrawn), 250, 10, 20, YELLOW);
+            }
             DrawFPS(700, 10);
             
             // Instructions
-            DrawRectangle(0, screenHeight - 80, screenWidth, 80, (Color){ 0, 0, 0, 120 });
+            DrawRectangle(0, screenHeight - 100, screenWidth, 100, (Color){ 0, 0, 0, 120 });
+            DrawText("Press C to toggle the crowd, I to switch instancing", 10, screenHeight - 95, 20, WHITE);
             DrawText("Press SPACE to pause/resume camera rotation", 10, screenHeight - 70, 20, WHITE);
             DrawText("Use ARROW KEYS to move the main robot", 10, screenHeight - 40, 20, WHITE);
 
@@ -172,6 +213,12 @@ int main(void)
     Free3DSprite(robot);
     Free3DSprite(robot2);
     Free3DSprite(robot3);
+    for (int i = 0; i < CROWD_SIZE; i++) Free3DSprite(crowd[i]);
+    free(crowd);
+    free(crowdTransforms);
+    free(crowdTints);
+    Free3DSpriteTemplate(crowdTemplate);
+    Free3DSprite(crowdRobot);
     
     CloseWindow();
     //--------------------------------------------------------------------------------------
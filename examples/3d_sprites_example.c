@@ -14,42 +14,53 @@
 #include <math.h>
 #include <stdlib.h>
 
-// Custom drawing functions for 3D shapes
-void DrawCone(Vector3 position, float radius, float height, int segments, Color color) {
-    DrawCylinderEx(position, 
-                  (Vector3){position.x, position.y + height, position.z}, 
-                  radius, 0.0f, 
-                  segments, color);
-}
+#define FOREST_SIZE 32   // The dense forest is FOREST_SIZE x FOREST_SIZE trees
+#define NUM_PEBBLES 500   // Loose pebbles scattered over the ground
 
-void DrawConeWires(Vector3 position, float radius, float height, int segments, Color color) {
-    DrawCylinderWiresEx(position, 
-                      (Vector3){position.x, position.y + height, position.z}, 
-                      radius, 0.0f, 
-                      segments, color);
-}
+// Draws a sprite, then its outline by redrawing every shape as black wireframe
+static void DrawOutlined3DSprite(RayPals3DSprite* sprite, Camera3D camera, bool drawWireframes) {
+    Draw3DSprite(sprite, camera);
+    if (!drawWireframes) return;
+
+    Color colors[8];
+    int count = sprite->shapeCount < 8 ? sprite->shapeCount : 8;
+    for (int i = 0; i < count; i++) {
+        colors[i] = sprite->shapes[i]->color;
+        sprite->shapes[i]->color = BLACK;
+        sprite->shapes[i]->wireframe = true;
+    }
 
-void DrawCylinder(Vector3 position, float radius, float radius2, float height, int segments, Color color) {
-    DrawCylinderEx(position, 
-                  (Vector3){position.x, position.y + height, position.z}, 
-                  radius, radius2, 
-                  segments, color);
+    Draw3DSprite(sprite, camera);
+
+    for (int i = 0; i < count; i++) {
+        sprite->shapes[i]->color = colors[i];
+        sprite->shapes[i]->wireframe = false;
+    }
 }
 
-void DrawCylinderWires(Vector3 position, float radius, float radius2, float height, int segments, Color color) {
-    DrawCylinderWiresEx(position, 
-                      (Vector3){position.x, position.y + height, position.z}, 
-                      radius, radius2, 
-                      segments, color);
+static void DrawOutlined3DShape(RayPals3DShape* shape, bool drawWireframes) {
+    Draw3DShape(shape, NULL);
+    if (!drawWireframes) return;
+
+    Color color = shape->color;
+    shape->color = BLACK;
+    shape->wireframe = true;
+    Draw3DShape(shape, NULL);
+    shape->color = color;
+    shape->wireframe = false;
 }
 
 // Simple draw function to ensure no movement
 void DrawStaticScene(Camera3D camera, RayPals3DTree* trees, int treeCount, 
                      RayPals3DTree centerTree, RayPals3DShape* rock1, RayPals3DShape* rock2, 
-                     bool drawWireframes) {
+                     RayPals3DSprite** forestSprites, RayPals3DStaticBatch* forestBatch, bool drawForest,
+                     bool bakedForest, RayPals3DShape** pebbles, bool drawWireframes) {
     ClearBackground((Color){ 135, 206, 235, 255 });  // Sky blue
+    ResetDrawStats();
+    Begin3DLODFrame();
 
-    BeginMode3D(camera);
+    // One camera scope for the whole scene; shape draws inside it add no flushes
+    Begin3DBatch(camera);
         // Draw ground
         DrawPlane((Vector3){ 0.0f, 0.0f, 0.0f }, (Vector2){ 40.0f, 40.0f }, (Color){ 34, 139, 34, 255 });  // Forest green ground
         
@@ -68,156 +79,47 @@ void DrawStaticScene(Camera3D camera, RayPals3DTree* trees, int treeCount,
             );
         }
 
-        // Draw all trees - ensure zero rotation
+        // Every tree shares the cached unit cylinder and cone, so a draw only streams
+        // vertices under the sprite transform instead of regenerating the geometry
         for (int i = 0; i < treeCount; i++) {
-            // Force zero rotation before drawing
-            Vector3 zeroRotation = { 0.0f, 0.0f, 0.0f };
-            Set3DSpriteRotation(trees[i].sprite, zeroRotation);
-            
-            // Draw each shape individually with manual transformations
-            for (int j = 0; j < trees[i].sprite->shapeCount; j++) {
-                RayPals3DShape* shape = trees[i].sprite->shapes[j];
-                Vector3 pos = trees[i].sprite->position;
-                
-                // Apply tree position to shape position
-                Vector3 finalPos = {
-                    pos.x + shape->position.x,
-                    pos.y + shape->position.y,
-                    pos.z + shape->position.z
-                };
-                
-                // Draw based on shape type
-                if (shape->type == RAYPALS_CYLINDER) { // Trunk
-                    // Draw solid shape
-                    DrawCylinder(
-                        finalPos,
-                        shape->size.x/2,  // radius
-                        shape->size.x/2,  // top radius
-                        shape->size.y,    // height
-                        shape->segments,
-                        shape->color
-                    );
-                    
-                    // Draw wireframe outline if requested
-                    if (drawWireframes) {
-                        DrawCylinderWires(
-                            finalPos,
-                            shape->size.x/2,  // radius
-                            shape->size.x/2,  // top radius
-                            shape->size.y,    // height
-                            shape->segments,
-                            BLACK
-                        );
-                    }
-                } else if (shape->type == RAYPALS_CONE) { // Leaves
-                    // Draw solid shape
-                    DrawCone(
-                        finalPos,
-                        shape->size.x/2,  // radius
-                        shape->size.y,    // height
-                        shape->segments,
-                        shape->color
-                    );
-                    
-                    // Draw wireframe outline if requested
-                    if (drawWireframes) {
-                        DrawConeWires(
-                            finalPos,
-                            shape->size.x/2,  // radius
-                            shape->size.y,    // height
-                            shape->segments,
-                            BLACK
-                        );
-                    }
-                }
-            }
+            DrawOutlined3DSprite(trees[i].sprite, camera, drawWireframes);
         }
+        DrawOutlined3DSprite(centerTree.sprite, camera, drawWireframes);
 
-        // Draw center tree with zero rotation
-        Vector3 zeroRotation = { 0.0f, 0.0f, 0.0f };
-        Set3DSpriteRotation(centerTree.sprite, zeroRotation);
-        
-        // Draw each shape in center tree
-        for (int j = 0; j < centerTree.sprite->shapeCount; j++) {
-            RayPals3DShape* shape = centerTree.sprite->shapes[j];
-            Vector3 pos = centerTree.sprite->position;
-            
-            // Apply tree position to shape position
-            Vector3 finalPos = {
-                pos.x + shape->position.x,
-                pos.y + shape->position.y,
-                pos.z + shape->position.z
-            };
-            
-            // Draw based on shape type
-            if (shape->type == RAYPALS_CYLINDER) { // Trunk
-                // Draw solid shape
-                DrawCylinder(
-                    finalPos,
-                    shape->size.x/2,  // radius
-                    shape->size.x/2,  // top radius
-                    shape->size.y,    // height
-                    shape->segments,
-                    shape->color
-                );
-                
-                // Draw wireframe outline if requested
-                if (drawWireframes) {
-                    DrawCylinderWires(
-                        finalPos,
-                        shape->size.x/2,  // radius
-                        shape->size.x/2,  // top radius
-                        shape->size.y,    // height
-                        shape->segments,
-                        BLACK
-                    );
-                }
-            } else if (shape->type == RAYPALS_CONE) { // Leaves
-                // Draw solid shape
-                DrawCone(
-                    finalPos,
-                    shape->size.x/2,  // radius
-                    shape->size.y,    // height
-                    shape->segments,
-                    shape->color
-                );
-                
-                // Draw wireframe outline if requested
-                if (drawWireframes) {
-                    DrawConeWires(
-                        finalPos,
-                        shape->size.x/2,  // radius
-                        shape->size.y,    // height
-                        shape->segments,
-                        BLACK
-                    );
-                }
-            }
+        // The baked forest is drawn as pre-transformed vertex runs, one per color; per sprite,
+        // trees outside the view are skipped using their cached bounding spheres
+        if (drawForest && bakedForest) {
+            Draw3DStaticBatch(forestBatch);
+        } else if (drawForest) {
+            Draw3DSpritesCulled(forestSprites, FOREST_SIZE*FOREST_SIZE, camera);
         }
 
-        // Draw rocks directly
-        DrawSphere(rock1->position, rock1->size.x/2, rock1->color);
-        if (drawWireframes) {
-            DrawSphereWires(rock1->position, rock1->size.x/2, 8, 8, BLACK);
-        }
-        
-        DrawSphere(rock2->position, rock2->size.x/2, rock2->color);
-        if (drawWireframes) {
-            DrawSphereWires(rock2->position, rock2->size.x/2, 8, 8, BLACK);
-        }
+        // Draw rocks
+        DrawOutlined3DShape(rock1, drawWireframes);
+        DrawOutlined3DShape(rock2, drawWireframes);
+        Draw3DShapes(pebbles, NUM_PEBBLES, camera);
         
         // Draw coordinate grid
         DrawGrid(10, 1.0f);
-    EndMode3D();
+    End3DBatch();
 
     // Draw title and info
     DrawRectangle(0, 0, 800, 40, (Color){ 0, 0, 0, 120 });
     DrawText(drawWireframes ? "3D Forest Scene (With Wireframes)" : "3D Forest Scene", 10, 10, 20, WHITE);
+    if (drawForest && bakedForest) {
+        DrawText(TextFormat("+%d trees (baked)", FOREST_SIZE*FOREST_SIZE), 400, 10, 20, YELLOW);
+    } else if (drawForest) {
+        DrawText(TextFormat("+%d trees (%d culled)", FOREST_SIZE*FOREST_SIZE, GetDrawStats().culled), 400, 10, 20, YELLOW);
+    }
+    DrawText(TextFormat("%d batch flushes, %d triangles (LOD %s)", GetDrawStats().flushes, GetDrawStats().triangles,
+             Get3DLODSettings().enabled ? "on" : "off"), 10, 45, 20, DARKGRAY);
     DrawFPS(700, 10);
     
     // Instructions
-    DrawRectangle(0, 530, 800, 70, (Color){ 0, 0, 0, 120 });
-    DrawText("Press W to toggle wireframe mode", 10, 520, 20, WHITE);
+    DrawRectangle(0, 500, 800, 100, (Color){ 0, 0, 0, 120 });
+    DrawText("Press W to toggle wireframe mode", 10, 510, 20, WHITE);
+    DrawText("Press F to toggle the dense forest, B to bake it", 10, 530, 20, WHITE);
+    DrawText("Press L to toggle distance LOD", 10, 570, 20, WHITE);
 }
 
 int main(void) {
@@ -296,8 +198,30 @@ int main(void) {
         DARKGRAY
     );
 
+    // Pebbles drawn as loose shapes, all inside the scene's single camera scope
+    RayPals3DShape* pebbles[NUM_PEBBLES];
+    for (int i = 0; i < NUM_PEBBLES; i++) {
+        Vector3 position = { GetRandomValue(-1900, 1900) / 100.0f, 0.05f, GetRandomValue(-1900, 1900) / 100.0f };
+        pebbles[i] = CreateSphere(position, 0.1f, 4, (i % 2) ? GRAY : LIGHTGRAY);
+    }
+
+    // Dense forest grid to stress repeated primitive draws
+    RayPals3DTree* forest = (RayPals3DTree*)malloc(sizeof(RayPals3DTree) * FOREST_SIZE * FOREST_SIZE);
+    RayPals3DSprite** forestSprites = (RayPals3DSprite**)malloc(sizeof(RayPals3DSprite*) * FOREST_SIZE * FOREST_SIZE);
+    for (int i = 0; i < FOREST_SIZE*FOREST_SIZE; i++) {
+        Vector3 position = { -18.0f + (i % FOREST_SIZE) * 1.15f, 0.0f, -18.0f + (i / FOREST_SIZE) * 1.15f };
+        forest[i] = Create3DTree(position, 0.4f, (Color){ 139, 69, 19, 255 }, (Color){ 0, 100, 0, 255 });
+        Set3DSpriteRotation(forest[i].sprite, zeroRotation);
+        forestSprites[i] = forest[i].sprite;
+    }
+    
+    // The forest never moves, so it can be flattened into two vertex runs (trunks and leaves)
+    RayPals3DStaticBatch* forestBatch = Create3DStaticBatch(forestSprites, FOREST_SIZE * FOREST_SIZE);
+
     // Wireframe mode flag
     bool drawWireframes = false;
+    bool drawForest = false;
+    bool bakedForest = true;
     
     SetTargetFPS(60);
     //--------------------------------------------------------------------------------------
@@ -309,6 +233,22 @@ int main(void) {
             drawWireframes = !drawWireframes;
         }
         
+        if (IsKeyPressed(KEY_F)) {
+            drawForest = !drawForest;
+        }
+        
+        if (IsKeyPressed(KEY_B)) {
+            bakedForest = !bakedForest;
+        }
+        
+        // Distant trunks, leaves and pebbles drop segments; the baked forest keeps full detail
+        if (IsKeyPressed(KEY_L)) {
+            RayPals3DLODSettings lod = Get3DLODSettings();
+            lod.enabled = !lod.enabled;
+            lod.triangleBudget = 150000;
+            Set3DLODSettings(lod);
+        }
+        
         // Check for toggle camera rotation
         if (IsKeyPressed(KEY_SPACE)) {
             rotationPaused = !rotationPaused;
@@ -328,7 +268,7 @@ int main(void) {
         BeginDrawing();
         
         // Draw the entire scene using our static draw function
-        DrawStaticScene(camera, trees, NUM_TREES, centerTree, rock1, rock2, drawWireframes);
+        DrawStaticScene(camera, trees, NUM_TREES, centerTree, rock1, rock2, forestSprites, forestBatch, drawForest, bakedForest, pebbles, drawWireframes);
         
         // Additional instructions for camera control
         DrawText("Press SPACE to pause/resume camera rotation", 10, 550, 20, WHITE);
@@ -343,10 +283,20 @@ int main(void) {
         Free3DTree(&trees[i]);
     }
     Free3DTree(&centerTree);
+    Free3DStaticBatch(forestBatch);
+    for (int i = 0; i < FOREST_SIZE*FOREST_SIZE; i++) {
+        Free3DTree(&forest[i]);
+    }
+    free(forestSprites);
+    free(forest);
     
     // Free rocks
     Free3DShape(rock1);
     Free3DShape(rock2);
+    for (int i = 0; i < NUM_PEBBLES; i++) {
+        Free3DShape(pebbles[i]);
+    }
+    Free3DMeshCache();
     
     CloseWindow();
     //--------------------------------------------------------------------------------------
@@ -72,7 +72,7 @@ int main(void)
         if (IsKeyDown(KEY_DOWN)) camera.position.z += 0.1f;
         
         // Update shape rotation
-        cube->rotation.y += 1.0f;
+        Set3DShapeRotation(cube, (Vector3){ cube->rotation.x, cube->rotation.y + 1.0f, cube->rotation.z });
         star->rotation += 0.5f;
         //----------------------------------------------------------------------------------
 
@@ -89,19 +89,19 @@ int main(void)
             Draw2DShape(triangle);
             Draw2DShape(star);
             
-            // Draw 3D scene
-            BeginMode3D(camera);
+            // Draw 3D scene in one camera scope
+            Begin3DBatch(camera);
                 
                 // Draw grid for reference
                 DrawGrid(10, 1.0f);
                 
-                // Draw 3D shapes
+                // Draw 3D shapes (the batch camera replaces their own scopes)
                 Draw3DShape(cube, &camera);
                 Draw3DShape(sphere, &camera);
                 Draw3DShape(cone, &camera);
                 Draw3DShape(cylinder, &camera);
                 
-            EndMode3D();
+            End3DBatch();
             
             // Draw instructions
             DrawText("Use arrow keys and Z/X to move camera", 20, 20, 20, DARKGRAY);
@@ -0,0 +1,90 @@
+/*******************************************************************************************
+*
+*   RayPals [Blend Benchmark] - Example measuring the software canvas span kernels
+*
+*   This example has been created using raylib 5.5 (www.raylib.com)
+*   raylib is licensed under an unmodified zlib/libpng license (View raylib.h for details)
+*
+*   Copyright (c) 2023 RayPals Team
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "raypals.h"
+#include <stdio.h>
+#include <time.h>
+
+#define PASS_COUNT 40
+
+static const char* kernelNames[] = { "auto", "scalar", "SSE2", "AVX2" };
+
+// Wall-clock seconds (GetTime needs a window)
+static double GetWallSeconds(void)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return now.tv_sec + now.tv_nsec*1.0e-9;
+}
+
+// Covers a freshly cleared canvas with two triangles PASS_COUNT times and returns the
+// pixels per second spent drawing (the clears are not timed)
+static double MeasureKernel(RayPalsCanvas* canvas, Color background, Color color)
+{
+    Vector2 topLeft = { 0, 0 };
+    Vector2 topRight = { (float)canvas->image.width, 0 };
+    Vector2 bottomLeft = { 0, (float)canvas->image.height };
+    Vector2 bottomRight = { (float)canvas->image.width, (float)canvas->image.height };
+
+    ResetCanvasStats(canvas);
+    double seconds = 0.0;
+
+    for (int pass = 0; pass < PASS_COUNT; pass++) {
+        ClearCanvas(canvas, background);
+
+        double start = GetWallSeconds();
+        DrawCanvasTriangle(canvas, topLeft, topRight, bottomLeft, color);
+        DrawCanvasTriangle(canvas, topRight, bottomRight, bottomLeft, color);
+        seconds += GetWallSeconds() - start;
+    }
+
+    return seconds > 0.0 ? canvas->stats.pixels/seconds : 0.0;
+}
+
+int main(void)
+{
+    // Initialization (no window: only the CPU canvas is measured)
+    //--------------------------------------------------------------------------------------
+    RayPalsCanvas* canvas = CreateCanvas(1920, 1080);
+    if (canvas == NULL) return 1;
+
+    RayPalsCanvasKernel automatic = GetCanvasKernel();
+    printf("Automatic kernel: %s\n\n", kernelNames[automatic]);
+    printf("%-8s %16s %22s %28s\n", "kernel", "fill (Mpix/s)", "blend a=200 (Mpix/s)", "over translucent (Mpix/s)");
+    //--------------------------------------------------------------------------------------
+
+    // Opaque fill, translucent blend over opaque pixels (the waterfall drop case), and
+    // blend over translucent pixels (the slow, exact path every kernel shares)
+    //--------------------------------------------------------------------------------------
+    for (int kernel = RAYPALS_CANVAS_KERNEL_SCALAR; kernel <= RAYPALS_CANVAS_KERNEL_AVX2; kernel++) {
+        if (!SetCanvasKernel((RayPalsCanvasKernel)kernel)) {
+            printf("%-8s %16s\n", kernelNames[kernel], "not supported");
+            continue;
+        }
+
+        double fill = MeasureKernel(canvas, RAYWHITE, SKYBLUE);
+        double blend = MeasureKernel(canvas, RAYWHITE, (Color){ 80, 160, 255, 200 });
+        double translucent = MeasureKernel(canvas, (Color){ 0, 0, 0, 128 }, (Color){ 80, 160, 255, 200 });
+
+        printf("%-8s %16.1f %22.1f %28.1f\n", kernelNames[kernel], fill/1.0e6, blend/1.0e6, translucent/1.0e6);
+    }
+
+    SetCanvasKernel(RAYPALS_CANVAS_KERNEL_AUTO);
+    //--------------------------------------------------------------------------------------
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    FreeCanvas(canvas);
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
@@ -0,0 +1,164 @@
+/*******************************************************************************************
+*
+*   RayPals [BVH World] - Example culling and picking a large 3D world through a BVH
+*
+*   This example has been created using raylib 5.5 (www.raylib.com)
+*   raylib is licensed under an unmodified zlib/libpng license (View raylib.h for details)
+*
+*   Copyright (c) 2024 RayPals Team
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "raypals.h"
+#include <stdlib.h>
+#include <math.h>
+
+#define WORLD_OBJECTS 50000
+#define WORLD_SIZE 400.0f      // The objects are scattered over a WORLD_SIZE square
+#define MOVING_OBJECTS 500     // Objects that wander every frame and force refits
+#define MAX_PICKED 64
+
+int main(void)
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    const int screenWidth = 1024;
+    const int screenHeight = 768;
+
+    InitWindow(screenWidth, screenHeight, "RayPals - BVH World");
+
+    Camera3D camera = { 0 };
+    camera.position = (Vector3){ 0.0f, 12.0f, 30.0f };
+    camera.target = (Vector3){ 0.0f, 0.0f, 0.0f };
+    camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+    camera.fovy = 60.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+
+    // Trees, rocks and crystals scattered over the world
+    RayPals3DSprite** objects = (RayPals3DSprite**)malloc(sizeof(RayPals3DSprite*) * WORLD_OBJECTS);
+    for (int i = 0; i < WORLD_OBJECTS; i++) {
+        Vector3 position = {
+            (float)GetRandomValue(-200, 200) * WORLD_SIZE / 400.0f,
+            0.0f,
+            (float)GetRandomValue(-200, 200) * WORLD_SIZE / 400.0f
+        };
+
+        objects[i] = Create3DSprite(2);
+        Set3DSpritePosition(objects[i], position);
+        switch (i % 3) {
+            case 0:
+                AddShapeTo3DSprite(objects[i], CreateCylinder((Vector3){ 0, 0, 0 }, 0.15f, 0.8f, 6, BROWN));
+                AddShapeTo3DSprite(objects[i], CreateCone((Vector3){ 0, 0.8f, 0 }, 0.6f, 1.2f, 6, DARKGREEN));
+                break;
+            case 1:
+                AddShapeTo3DSprite(objects[i], CreateSphere((Vector3){ 0, 0.3f, 0 }, 0.4f, 6, GRAY));
+                break;
+            default:
+                AddShapeTo3DSprite(objects[i], CreateCube((Vector3){ 0, 0.4f, 0 }, (Vector3){ 0.4f, 0.8f, 0.4f }, SKYBLUE));
+                break;
+        }
+    }
+
+    RayPals3DBVH* bvh = Create3DBVH(objects, WORLD_OBJECTS);
+    RayPals3DSprite* picked[MAX_PICKED];
+    int pickedCount = 0;
+
+    bool useBVH = true;
+    bool moving = true;
+    float orbit = 0.0f;
+    double drawTime = 0.0;       // Smoothed CPU time spent culling and submitting
+
+    SetTargetFPS(60);
+    //--------------------------------------------------------------------------------------
+
+    // Main game loop
+    while (!WindowShouldClose())    // Detect window close button or ESC key
+    {
+        // Update
+        //----------------------------------------------------------------------------------
+        if (IsKeyPressed(KEY_B)) useBVH = !useBVH;
+        if (IsKeyPressed(KEY_M)) moving = !moving;
+        if (IsKeyPressed(KEY_R)) Rebuild3DBVH(bvh);
+
+        orbit += GetFrameTime() * 0.1f;
+        camera.position = (Vector3){ sinf(orbit) * 30.0f, 12.0f, cosf(orbit) * 30.0f };
+
+        // A few objects wander; only their leaves and ancestors are refitted
+        if (moving) {
+            float time = (float)GetTime();
+            for (int i = 0; i < MOVING_OBJECTS; i++) {
+                RayPals3DSprite* object = objects[i];
+                Vector3 position = object->position;
+                position.x += sinf(time + i) * 0.05f;
+                position.z += cosf(time + i) * 0.05f;
+                Set3DSpritePosition(object, position);
+            }
+        }
+        Refit3DBVH(bvh);
+
+        // Everything under the mouse, tested against bounding boxes only
+        Ray ray = GetScreenToWorldRay(GetMousePosition(), camera);
+        pickedCount = Query3DBVHRay(bvh, ray, 200.0f, picked, MAX_PICKED);
+        if (pickedCount > MAX_PICKED) pickedCount = MAX_PICKED;
+
+        // The exact shape under the mouse, nearest first
+        RayCollision hit = { 0 };
+        int hitShape = -1;
+        RayPals3DSprite* hitObject = Raycast3DBVH(bvh, ray, 200.0f, &hit, &hitShape);
+        //----------------------------------------------------------------------------------
+
+        // Draw
+        //----------------------------------------------------------------------------------
+        BeginDrawing();
+
+            ClearBackground((Color){ 135, 206, 235, 255 });
+            ResetDrawStats();
+
+            Begin3DBatch(camera);
+                DrawPlane((Vector3){ 0.0f, 0.0f, 0.0f }, (Vector2){ WORLD_SIZE, WORLD_SIZE }, (Color){ 34, 139, 34, 255 });
+
+                double start = GetTime();
+                if (useBVH) {
+                    Draw3DBVH(bvh, camera);
+                } else {
+                    Draw3DSpritesCulled(objects, WORLD_OBJECTS, camera);
+                }
+                double elapsed = GetTime() - start;
+                drawTime = drawTime > 0.0 ? drawTime*0.95 + elapsed*0.05 : elapsed;
+
+                for (int i = 0; i < pickedCount; i++) DrawBoundingBox(Get3DSpriteBounds(picked[i]).box, YELLOW);
+                if (hitObject != NULL) {
+                    DrawBoundingBox(Get3DShapeBounds(hitObject->shapes[hitShape], hitObject).box, RED);
+                    DrawSphere(hit.point, 0.05f, RED);
+                }
+            End3DBatch();
+
+            RayPalsBVHStats stats = Get3DBVHStats(bvh);
+            RayPalsDrawStats drawStats = GetDrawStats();
+            DrawRectangle(0, 0, screenWidth, 82, Fade(BLACK, 0.7f));
+            DrawText(TextFormat("%s: %d drawn, %d culled in %.2f ms", useBVH ? "BVH" : "Per-sprite culling",
+                     drawStats.sprites, drawStats.culled, drawTime*1000.0), 10, 8, 20, WHITE);
+            DrawText(TextFormat("%d nodes, %d leaves, depth %d, built in %.1f ms, refit %d nodes in %.2f ms",
+                     stats.nodeCount, stats.leafCount, stats.depth, stats.buildTime, stats.refitNodes, stats.refitTime), 10, 32, 20, YELLOW);
+            DrawText(TextFormat("%d objects under the mouse, %s", pickedCount,
+                     hitObject != NULL ? TextFormat("shape %d hit at %.1f", hitShape, hit.distance) : "no shape hit"), 10, 56, 20, LIGHTGRAY);
+
+            DrawText("B: toggle BVH   M: toggle movement   R: rebuild", 10, screenHeight - 30, 20, WHITE);
+            DrawFPS(screenWidth - 90, screenHeight - 30);
+
+        EndDrawing();
+        //----------------------------------------------------------------------------------
+    }
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    Free3DBVH(bvh);
+    for (int i = 0; i < WORLD_OBJECTS; i++) Free3DSprite(objects[i]);
+    free(objects);
+
+    CloseWindow();        // Close window and OpenGL context
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
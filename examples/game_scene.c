@@ -17,12 +17,18 @@
 typedef struct {
     RayPalsSprite* player;
     RayPalsSprite* houses[3];
-    RayPalsSprite* trees[5];
-    RayPalsSprite* bushes[8];
+    RayPalsBakeKey houseKeys[3];
+    RayPalsSpriteTemplate* treeTemplates[2];
+    RayPalsSpriteTemplate* bushTemplate;
+    RayPalsSpriteInstance trees[5];
+    RayPalsSpriteInstance bushes[8];
     RayPalsSprite* rocks[4];
     RayPalsSprite* clouds[3];
+    RayPalsBakeKey cloudKeys[3];
+    RayPalsSpriteAtlas* atlas;       // Baked cloud and house textures
     RayPalsSprite* enemies[4];
     RayPalsSprite* healthBar;
+    RayPalsRenderQueue* queue;       // World objects, sorted by layer and depth every frame
 } GameScene;
 
 // Function to free all sprites in a scene
@@ -30,13 +36,16 @@ void FreeGameScene(GameScene* scene) {
     FreeSprite(scene->player);
     
     for (int i = 0; i < 3; i++) FreeSprite(scene->houses[i]);
-    for (int i = 0; i < 5; i++) FreeSprite(scene->trees[i]);
-    for (int i = 0; i < 8; i++) FreeSprite(scene->bushes[i]);
+    // Instances own no memory; only the shared templates are freed
+    for (int i = 0; i < 2; i++) FreeSpriteTemplate(scene->treeTemplates[i]);
+    FreeSpriteTemplate(scene->bushTemplate);
     for (int i = 0; i < 4; i++) FreeSprite(scene->rocks[i]);
     for (int i = 0; i < 3; i++) FreeSprite(scene->clouds[i]);
     for (int i = 0; i < 4; i++) FreeSprite(scene->enemies[i]);
     
     FreeSprite(scene->healthBar);
+    FreeSpriteAtlas(scene->atlas);
+    FreeRenderQueue(scene->queue);
 }
 
 int main(void)
@@ -58,20 +67,36 @@ int main(void)
     scene.houses[0] = CreateHouse((Vector2){ 650, 350 }, 120, LIGHTGRAY, RED);
     scene.houses[1] = CreateHouse((Vector2){ 500, 400 }, 100, BEIGE, ORANGE);
     scene.houses[2] = CreateHouse((Vector2){ 700, 450 }, 80, WHITE, DARKBLUE);
+    scene.houseKeys[0] = (RayPalsBakeKey){ "CreateHouse", 120, { LIGHTGRAY, RED }, 0 };
+    scene.houseKeys[1] = (RayPalsBakeKey){ "CreateHouse", 100, { BEIGE, ORANGE }, 0 };
+    scene.houseKeys[2] = (RayPalsBakeKey){ "CreateHouse", 80, { WHITE, DARKBLUE }, 0 };
     
-    // Trees
-    scene.trees[0] = CreateSimpleTree((Vector2){ 100, 400 }, 100, BROWN, GREEN);
-    scene.trees[1] = CreateSimpleTree((Vector2){ 180, 450 }, 80, BROWN, DARKGREEN);
-    scene.trees[2] = CreateSimpleTree((Vector2){ 300, 420 }, 90, BROWN, GREEN);
-    scene.trees[3] = CreateSimpleTree((Vector2){ 50, 480 }, 70, BROWN, DARKGREEN);
-    scene.trees[4] = CreateSimpleTree((Vector2){ 250, 500 }, 110, BROWN, DARKGREEN);
+    // Trees and bushes share one template per look; instances only store a transform.
+    // Templates are built at a reference size of 100 and scaled per instance.
+    RayPalsSprite* prefab = CreateSimpleTree((Vector2){ 0, 0 }, 100, BROWN, GREEN);
+    scene.treeTemplates[0] = CreateSpriteTemplate(prefab);
+    FreeSprite(prefab);
+    
+    prefab = CreateSimpleTree((Vector2){ 0, 0 }, 100, BROWN, DARKGREEN);
+    scene.treeTemplates[1] = CreateSpriteTemplate(prefab);
+    FreeSprite(prefab);
+    
+    prefab = CreateBush((Vector2){ 0, 0 }, 100, GREEN);
+    scene.bushTemplate = CreateSpriteTemplate(prefab);
+    FreeSprite(prefab);
+    
+    scene.trees[0] = CreateSpriteInstance(scene.treeTemplates[0], (Vector2){ 100, 400 }, 1.0f);
+    scene.trees[1] = CreateSpriteInstance(scene.treeTemplates[1], (Vector2){ 180, 450 }, 0.8f);
+    scene.trees[2] = CreateSpriteInstance(scene.treeTemplates[0], (Vector2){ 300, 420 }, 0.9f);
+    scene.trees[3] = CreateSpriteInstance(scene.treeTemplates[1], (Vector2){ 50, 480 }, 0.7f);
+    scene.trees[4] = CreateSpriteInstance(scene.treeTemplates[1], (Vector2){ 250, 500 }, 1.1f);
     
     // Bushes
     for (int i = 0; i < 8; i++) {
-        scene.bushes[i] = CreateBush(
+        scene.bushes[i] = CreateSpriteInstance(
+            scene.bushTemplate,
             (Vector2){ 100 + i * 90, 520 + GetRandomValue(-20, 20) }, 
-            30 + GetRandomValue(0, 20), 
-            GREEN
+            (30 + GetRandomValue(0, 20))/100.0f
         );
     }
     
@@ -84,10 +109,14 @@ int main(void)
         );
     }
     
-    // Clouds
-    scene.clouds[0] = CreateCloud((Vector2){ 100, 100 }, 60, WHITE);
-    scene.clouds[1] = CreateCloud((Vector2){ 300, 80 }, 80, WHITE);
-    scene.clouds[2] = CreateCloud((Vector2){ 600, 120 }, 70, WHITE);
+    // Clouds, baked into an atlas on first draw and then drawn as single quads
+    float cloudSizes[3] = { 60, 80, 70 };
+    scene.clouds[0] = CreateCloud((Vector2){ 100, 100 }, cloudSizes[0], WHITE);
+    scene.clouds[1] = CreateCloud((Vector2){ 300, 80 }, cloudSizes[1], WHITE);
+    scene.clouds[2] = CreateCloud((Vector2){ 600, 120 }, cloudSizes[2], WHITE);
+    for (int i = 0; i < 3; i++) scene.cloudKeys[i] = (RayPalsBakeKey){ "CreateCloud", cloudSizes[i], { WHITE }, 0 };
+    scene.atlas = CreateSpriteAtlas(512, 512, 0);
+    scene.queue = CreateRenderQueue(64);
     
     // Enemies (ghosts)
     scene.enemies[0] = CreateGhost((Vector2){ 200, 200 }, 40, VIOLET);
@@ -128,9 +157,10 @@ int main(void)
         if (IsKeyDown(KEY_UP)) SetSpritePosition(scene.player, (Vector2){ scene.player->position.x, scene.player->position.y - playerSpeed*deltaTime });
         if (IsKeyDown(KEY_DOWN)) SetSpritePosition(scene.player, (Vector2){ scene.player->position.x, scene.player->position.y + playerSpeed*deltaTime });
         
-        // Update camera to follow player
+        // Update camera to follow player; the mouse wheel zooms
         camera.target = scene.player->position;
         camera.offset = (Vector2){ screenWidth/2.0f, screenHeight/2.0f };
+        camera.zoom = fminf(fmaxf(camera.zoom * (1.0f + GetMouseWheelMove()*0.1f), 0.5f), 6.0f);
         
         // Move clouds
         for (int i = 0; i < 3; i++) {
@@ -165,7 +195,7 @@ int main(void)
         
         // Rotate trees slightly for a wind effect
         for (int i = 0; i < 5; i++) {
-            RotateSprite(scene.trees[i], deltaTime, sinf(GetTime() + i) * 2.0f);
+            scene.trees[i].rotation += sinf(GetTime() + i) * 2.0f * deltaTime;
         }
         //----------------------------------------------------------------------------------
 
@@ -176,7 +206,8 @@ int main(void)
             ClearBackground(SKYBLUE);
             
             // Draw clouds (in screen space, not affected by camera)
-            for (int i = 0; i < 3; i++) DrawSprite(scene.clouds[i]);
+            SetAtlasZoom(scene.atlas, 1.0f);
+            for (int i = 0; i < 3; i++) DrawSpriteBaked(scene.atlas, scene.cloudKeys[i], scene.clouds[i]);
             
             // Begin camera mode for the game world
             BeginMode2D(camera);
@@ -184,17 +215,30 @@ int main(void)
             // Draw background
             DrawRectangle(-1000, 550, 3000, 1000, DARKGREEN);
             
-            // Draw game objects (back to front)
-            for (int i = 0; i < 5; i++) DrawSprite(scene.trees[i]);
-            for (int i = 0; i < 3; i++) DrawSprite(scene.houses[i]);
-            for (int i = 0; i < 8; i++) DrawSprite(scene.bushes[i]);
-            for (int i = 0; i < 4; i++) DrawSprite(scene.rocks[i]);
+            // Houses form the backdrop, drawn from the atlas at a resolution tier matching the zoom
+            SetAtlasZoom(scene.atlas, camera.zoom);
+            Rectangle view = GetCameraViewBounds(camera);
+            for (int i = 0; i < 3; i++) {
+                if (CheckCollisionRecs(GetSpriteBounds(scene.houses[i]), view)) DrawSpriteBaked(scene.atlas, scene.houseKeys[i], scene.houses[i]);
+            }
             
-            // Draw enemies
-            for (int i = 0; i < 4; i++) DrawSprite(scene.enemies[i]);
+            // Props are y-sorted (lower on screen is nearer) in layer 0, characters go on top in
+            // layer 1; objects outside the camera view are not submitted
+            for (int i = 0; i < 5; i++) {
+                if (CheckCollisionRecs(GetSpriteInstanceBounds(&scene.trees[i]), view)) QueueSpriteInstance(scene.queue, &scene.trees[i], 0, -scene.trees[i].position.y, RAYPALS_BLEND_ALPHA);
+            }
+            for (int i = 0; i < 8; i++) {
+                if (CheckCollisionRecs(GetSpriteInstanceBounds(&scene.bushes[i]), view)) QueueSpriteInstance(scene.queue, &scene.bushes[i], 0, -scene.bushes[i].position.y, RAYPALS_BLEND_ALPHA);
+            }
+            for (int i = 0; i < 4; i++) {
+                if (CheckCollisionRecs(GetSpriteBounds(scene.rocks[i]), view)) QueueSprite(scene.queue, scene.rocks[i], 0, -scene.rocks[i]->position.y, RAYPALS_BLEND_ALPHA);
+            }
+            for (int i = 0; i < 4; i++) {
+                if (CheckCollisionRecs(GetSpriteBounds(scene.enemies[i]), view)) QueueSprite(scene.queue, scene.enemies[i], 1, -scene.enemies[i]->position.y, RAYPALS_BLEND_ALPHA);
+            }
+            QueueSprite(scene.queue, scene.player, 1, -scene.player->position.y, RAYPALS_BLEND_ALPHA);
             
-            // Draw player
-            DrawSprite(scene.player);
+            FlushRenderQueue(scene.queue);
             
             EndMode2D();
             
@@ -203,7 +247,7 @@ int main(void)
             DrawText("Health", 50, 35, 20, BLACK);
             
             // Draw instructions
-            DrawText("Use arrow keys to move", 10, 10, 20, BLACK);
+            DrawText("Use arrow keys to move, mouse wheel to zoom", 10, 10, 20, BLACK);
             DrawText("Press H to decrease health", screenWidth - 300, 10, 20, BLACK);
             DrawFPS(screenWidth - 80, screenHeight - 30);
 
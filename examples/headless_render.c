@@ -0,0 +1,99 @@
+/*******************************************************************************************
+*
+*   RayPals [Headless Render] - Example rasterizing sprites into an image without a window
+*
+*   This example has been created using raylib 5.5 (www.raylib.com)
+*   raylib is licensed under an unmodified zlib/libpng license (View raylib.h for details)
+*
+*   Copyright (c) 2023 RayPals Team
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "raypals.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define SPRITE_COUNT 4000
+#define FRAME_COUNT 5
+
+// Wall-clock seconds (GetTime needs a window; clock() adds up the CPU time of every thread)
+static double GetWallSeconds(void)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return now.tv_sec + now.tv_nsec*1.0e-9;
+}
+
+int main(void)
+{
+    // Initialization (no InitWindow: the canvas never touches OpenGL)
+    //--------------------------------------------------------------------------------------
+    const int imageWidth = 3840;
+    const int imageHeight = 2160;
+
+    RayPalsCanvas* canvas = CreateCanvas(imageWidth, imageHeight);
+    RayPalsCanvas* tiled = CreateCanvas(imageWidth, imageHeight);
+    if (canvas == NULL || tiled == NULL) return 1;
+    SetCanvasThreads(tiled, 0);     // One thread per processor
+
+    RayPalsSprite* sprites[SPRITE_COUNT];
+    for (int i = 0; i < SPRITE_COUNT; i++) {
+        Vector2 position = { (float)((i*137) % imageWidth), (float)((i*59) % imageHeight) };
+
+        switch (i % 4) {
+            case 0: sprites[i] = CreateSimpleTree(position, 60, BROWN, DARKGREEN); break;
+            case 1: sprites[i] = CreateBush(position, 40, Fade(GREEN, 0.8f)); break;
+            case 2: sprites[i] = CreateGhost(position, 40, Fade(VIOLET, 0.6f)); break;
+            default: sprites[i] = CreateCoin(position, 32, GOLD); break;
+        }
+    }
+    //--------------------------------------------------------------------------------------
+
+    // Render the same scene a few times on one thread, then tiled on every processor
+    //--------------------------------------------------------------------------------------
+    double seconds[2] = { 0 };
+    RayPalsCanvas* canvases[2] = { canvas, tiled };
+
+    for (int pass = 0; pass < 2; pass++) {
+        double start = GetWallSeconds();
+
+        for (int frame = 0; frame < FRAME_COUNT; frame++) {
+            ClearCanvas(canvases[pass], RAYWHITE);
+            for (int i = 0; i < SPRITE_COUNT; i++) DrawSpriteToCanvas(canvases[pass], sprites[i]);
+            FlushCanvas(canvases[pass]);
+        }
+
+        seconds[pass] = GetWallSeconds() - start;
+        printf("%d thread(s): %d frames, %d triangles, %lld pixels in %.3f s", canvases[pass]->threadCount, FRAME_COUNT,
+               canvases[pass]->stats.triangles, canvases[pass]->stats.pixels, seconds[pass]);
+        if (seconds[pass] > 0.0) printf(" (%.1f M pixels/s)", canvases[pass]->stats.pixels/seconds[pass]/1.0e6);
+        printf("\n");
+    }
+
+    bool identical = memcmp(canvas->image.data, tiled->image.data, (size_t)imageWidth*imageHeight*sizeof(Color)) == 0;
+    printf("Tiled output %s the single-threaded output\n", identical ? "matches" : "DIFFERS from");
+
+    // Save the last frame, plus a zoomed-in thumbnail of the top-left corner
+    ExportImage(canvas->image, "headless_render.png");
+
+    RayPalsCanvas* thumbnail = CreateCanvas(256, 256);
+    if (thumbnail != NULL) {
+        ClearCanvas(thumbnail, RAYWHITE);
+        SetCanvasCamera(thumbnail, (Camera2D){ { 0, 0 }, { 0, 0 }, 0.0f, 2.0f });
+        for (int i = 0; i < SPRITE_COUNT; i++) DrawSpriteToCanvas(thumbnail, sprites[i]);
+        ExportImage(thumbnail->image, "headless_thumbnail.png");
+        FreeCanvas(thumbnail);
+    }
+    //--------------------------------------------------------------------------------------
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 0; i < SPRITE_COUNT; i++) FreeSprite(sprites[i]);
+    FreeCanvas(canvas);
+    FreeCanvas(tiled);
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*******************************************************************************************
+*
+*   RayPals [Retained Scene] - Example repainting only the screen regions that changed
+*
+*   This example has been created using raylib 5.5 (www.raylib.com)
+*   raylib is licensed under an unmodified zlib/libpng license (View raylib.h for details)
+*
+*   Copyright (c) 2023 RayPals Team
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "raypals.h"
+#include <math.h>
+
+#define STATIC_SPRITES 600
+#define CLOUD_COUNT 3
+
+int main(void)
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    const int screenWidth = 1024;
+    const int screenHeight = 768;
+
+    InitWindow(screenWidth, screenHeight, "RayPals - Retained Scene");
+
+    // A mostly static kiosk scene: rows of houses, trees and rocks
+    RayPalsSprite* props[STATIC_SPRITES];
+    for (int i = 0; i < STATIC_SPRITES; i++) {
+        Vector2 position = { 30.0f + (i % 30)*33.0f, 220.0f + (i / 30)*27.0f };
+
+        switch (i % 3) {
+            case 0: props[i] = CreateHouse(position, 28, LIGHTGRAY, MAROON); break;
+            case 1: props[i] = CreateSimpleTree(position, 26, BROWN, DARKGREEN); break;
+            default: props[i] = CreateRock(position, 14, GRAY); break;
+        }
+    }
+
+    // A few animated elements
+    RayPalsSprite* clouds[CLOUD_COUNT];
+    for (int i = 0; i < CLOUD_COUNT; i++) clouds[i] = CreateCloud((Vector2){ 150.0f + i*300.0f, 80.0f + i*30.0f }, 60, WHITE);
+    float health = 1.0f;
+    RayPalsSprite* healthBar = CreateHealthBar((Vector2){ 20, 20 }, 200, health, DARKGRAY, RED);
+
+    RayPalsRetainedScene* scene = CreateRetainedScene(screenWidth, screenHeight, SKYBLUE);
+    bool retained = true;
+    //--------------------------------------------------------------------------------------
+
+    // Main game loop
+    while (!WindowShouldClose())    // Detect window close button or ESC key
+    {
+        // Update
+        //----------------------------------------------------------------------------------
+        if (IsKeyPressed(KEY_SPACE)) {
+            retained = !retained;
+            InvalidateRetainedScene(scene);
+        }
+
+        float deltaTime = GetFrameTime();
+        for (int i = 0; i < CLOUD_COUNT; i++) {
+            float x = clouds[i]->position.x + (20.0f + i*10.0f)*deltaTime;
+            SetSpritePosition(clouds[i], (Vector2){ x > screenWidth + 80 ? -80.0f : x, clouds[i]->position.y });
+        }
+
+        // The health bar only changes a few times per second; a new sprite is a change too
+        float newHealth = 0.5f + 0.5f*sinf((float)GetTime()*0.5f);
+        if (fabsf(newHealth - health) > 0.02f) {
+            health = newHealth;
+            FreeSprite(healthBar);
+            healthBar = CreateHealthBar((Vector2){ 20, 20 }, 200, health, DARKGRAY, RED);
+        }
+
+        // Retained mode: submit everything, then repaint only what changed
+        if (retained) {
+            BeginRetainedScene(scene);
+            for (int i = 0; i < CLOUD_COUNT; i++) DrawSpriteRetained(scene, clouds[i]);
+            for (int i = 0; i < STATIC_SPRITES; i++) DrawSpriteRetained(scene, props[i]);
+            DrawSpriteRetained(scene, healthBar);
+            EndRetainedScene(scene);
+        }
+        //----------------------------------------------------------------------------------
+
+        // Draw
+        //----------------------------------------------------------------------------------
+        BeginDrawing();
+
+            if (retained) {
+                DrawRetainedScene(scene, (Vector2){ 0, 0 });
+            } else {
+                ClearBackground(SKYBLUE);
+                for (int i = 0; i < CLOUD_COUNT; i++) DrawSprite(clouds[i]);
+                for (int i = 0; i < STATIC_SPRITES; i++) DrawSprite(props[i]);
+                DrawSprite(healthBar);
+            }
+
+            RayPalsRetainedStats stats = scene->stats;
+            DrawRectangle(0, screenHeight - 56, screenWidth, 56, Fade(BLACK, 0.8f));
+            DrawText(retained ? "Retained scene (SPACE for immediate)" : "Immediate redraw (SPACE for retained)", 10, screenHeight - 50, 20, WHITE);
+            if (retained) {
+                DrawText(TextFormat("%d rects, %.1f%% of the screen redrawn, %d sprite draws", stats.dirtyRects,
+                         100.0*stats.redrawnPixels/((double)screenWidth*screenHeight), stats.redrawnSprites), 10, screenHeight - 26, 20, YELLOW);
+            }
+            DrawFPS(screenWidth - 90, screenHeight - 50);
+
+        EndDrawing();
+        //----------------------------------------------------------------------------------
+    }
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    FreeRetainedScene(scene);
+    for (int i = 0; i < STATIC_SPRITES; i++) FreeSprite(props[i]);
+    for (int i = 0; i < CLOUD_COUNT; i++) FreeSprite(clouds[i]);
+    FreeSprite(healthBar);
+
+    CloseWindow();        // Close window and OpenGL context
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*******************************************************************************************
+*
+*   RayPals [Sprite Benchmark] - Example comparing sprite draw paths by vertex throughput
+*
+*   This example has been created using raylib 5.5 (www.raylib.com)
+*   raylib is licensed under an unmodified zlib/libpng license (View raylib.h for details)
+*
+*   Copyright (c) 2023 RayPals Team
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "rlgl.h"
+#include "raypals.h"
+#include <stdlib.h>
+
+#define MAX_SPRITES 20000
+
+typedef enum {
+    MODE_PER_SHAPE = 0,   // Matrix push per sprite and per shape, one raylib call per shape
+    MODE_CACHED,          // DrawSprite: matrix push per sprite, cached vertices
+    MODE_BATCHED,         // DrawSpritesBatched: CPU transforms, one triangle run
+    MODE_COUNT
+} DrawMode;
+
+static const char* modeNames[MODE_COUNT] = {
+    "Per-shape Draw2DShape",
+    "DrawSprite (cached)",
+    "DrawSpritesBatched"
+};
+
+// The draw path every sprite used before sprites cached their tessellation
+static void DrawSpritePerShape(RayPalsSprite* sprite) {
+    rlPushMatrix();
+    rlTranslatef(sprite->position.x, sprite->position.y, 0.0f);
+    rlRotatef(sprite->rotation, 0.0f, 0.0f, 1.0f);
+    rlScalef(sprite->scale, sprite->scale, 1.0f);
+
+    for (int i = 0; i < sprite->shapeCount; i++) Draw2DShape(sprite->shapes[i]);
+
+    rlPopMatrix();
+}
+
+int main(void)
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    const int screenWidth = 1024;
+    const int screenHeight = 768;
+
+    InitWindow(screenWidth, screenHeight, "RayPals - Sprite Benchmark");
+
+    // A mix of prefabs with different shape counts
+    RayPalsSprite** sprites = (RayPalsSprite**)malloc(sizeof(RayPalsSprite*) * MAX_SPRITES);
+    for (int i = 0; i < MAX_SPRITES; i++) {
+        Vector2 position = { (float)GetRandomValue(0, screenWidth), (float)GetRandomValue(60, screenHeight) };
+
+        switch (i % 4) {
+            case 0: sprites[i] = CreateSimpleTree(position, 30, BROWN, DARKGREEN); break;
+            case 1: sprites[i] = CreateBush(position, 20, GREEN); break;
+            case 2: sprites[i] = CreateGhost(position, 20, VIOLET); break;
+            default: sprites[i] = CreateCoin(position, 16, GOLD); break;
+        }
+    }
+
+    int spriteCount = 2000;
+    DrawMode mode = MODE_BATCHED;   // Starts batched so the caches exist before switching paths
+    double drawTime = 0.0;       // Smoothed CPU time spent submitting and flushing sprites
+    int vertexCount = 0;
+
+    SetTargetFPS(0);             // Uncapped so the draw path dominates the frame time
+    //--------------------------------------------------------------------------------------
+
+    // Main game loop
+    while (!WindowShouldClose())    // Detect window close button or ESC key
+    {
+        // Update
+        //----------------------------------------------------------------------------------
+        if (IsKeyPressed(KEY_SPACE)) mode = (mode + 1) % MODE_COUNT;
+        if (IsKeyPressed(KEY_UP) && spriteCount < MAX_SPRITES) spriteCount *= 2;
+        if (IsKeyPressed(KEY_DOWN) && spriteCount > 250) spriteCount /= 2;
+        if (spriteCount > MAX_SPRITES) spriteCount = MAX_SPRITES;
+
+        // Keep the transforms changing so nothing can be skipped
+        float deltaTime = GetFrameTime();
+        for (int i = 0; i < spriteCount; i++) RotateSprite(sprites[i], deltaTime, (i % 7 - 3) * 20.0f);
+        //----------------------------------------------------------------------------------
+
+        // Draw
+        //----------------------------------------------------------------------------------
+        BeginDrawing();
+
+            ClearBackground(RAYWHITE);
+
+            ResetDrawStats();
+            double start = GetTime();
+
+            switch (mode) {
+                case MODE_PER_SHAPE: for (int i = 0; i < spriteCount; i++) DrawSpritePerShape(sprites[i]); break;
+                case MODE_CACHED: for (int i = 0; i < spriteCount; i++) DrawSprite(sprites[i]); break;
+                default: DrawSpritesBatched(sprites, spriteCount); break;
+            }
+
+            // Include the upload of the last partial rlgl batch in the measurement
+            rlDrawRenderBatchActive();
+
+            double elapsed = GetTime() - start;
+            drawTime = drawTime > 0.0 ? drawTime*0.95 + elapsed*0.05 : elapsed;
+
+            // The per-shape path bypasses the counters; it submits the same geometry the
+            // caches hold (caches stay valid because only sprite transforms change)
+            if (mode != MODE_PER_SHAPE) {
+                vertexCount = GetDrawStats().vertices;
+            } else {
+                vertexCount = 0;
+                for (int i = 0; i < spriteCount; i++) vertexCount += GetSpriteCachedVertexCount(sprites[i]);
+            }
+
+            DrawRectangle(0, 0, screenWidth, 56, Fade(BLACK, 0.8f));
+            DrawText(TextFormat("%s - %d sprites (UP/DOWN), SPACE to switch path", modeNames[mode], spriteCount), 10, 8, 20, WHITE);
+            DrawText(TextFormat("draw %.2f ms   %.1f M vertices/s   %d batches", drawTime*1000.0,
+                     drawTime > 0.0 ? vertexCount/drawTime/1.0e6 : 0.0, GetDrawStats().batches), 10, 32, 20, YELLOW);
+            DrawFPS(screenWidth - 90, screenHeight - 30);
+
+        EndDrawing();
+        //----------------------------------------------------------------------------------
+    }
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 0; i < MAX_SPRITES; i++) FreeSprite(sprites[i]);
+    free(sprites);
+
+    CloseWindow();        // Close window and OpenGL context
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
@@ -25,6 +25,7 @@
 #include <raylib.h>
 #include <rlgl.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -54,6 +55,25 @@ typedef enum {
     RAYPALS_WATER_DROP  ///< A water drop shape
 } RayPalsShapeType;
 
+/**
+ * @brief Opaque slab allocator for shapes and sprites
+ * 
+ * While an arena is active (see BeginShapeArena), every Create* function takes its
+ * memory from the arena's contiguous slabs instead of calling malloc. Everything
+ * allocated from an arena is released at once with FreeShapeArena or ResetShapeArena.
+ */
+typedef struct RayPalsArena RayPalsArena;
+
+/**
+ * @brief Opaque local-space tessellation cached by DrawSprite
+ * 
+ * Holds one triangle list with per-vertex colors for all shapes of a sprite. It is
+ * rebuilt only when the version of the sprite or of one of its shapes no longer matches
+ * the versions it was built from. The shape setters renew a shape's version; writes to
+ * public fields do not, and need MarkSpriteDirty.
+ */
+typedef struct RayPalsSpriteCache RayPalsSpriteCache;
+
 /**
  * @brief Structure representing a 2D shape
  * 
@@ -71,8 +91,19 @@ typedef struct {
     int segments;              ///< Number of segments for circle/star
     int points;                ///< Number of points for star
     bool visible;              ///< Whether the shape is visible
+    unsigned int version;      ///< Renewed by the setters when the shape changes; sprite caches compare it (internal)
+    RayPalsArena* arena;       ///< Arena the shape was allocated from (NULL for heap shapes)
 } RayPals2DShape;
 
+/**
+ * @brief Conservative world-space bounds of a 3D shape or sprite
+ */
+typedef struct {
+    BoundingBox box;           ///< Axis-aligned box
+    Vector3 center;            ///< Bounding sphere center
+    float radius;              ///< Bounding sphere radius
+} RayPalsBounds3D;
+
 /**
  * @brief Structure representing a 3D shape
  * 
@@ -89,6 +120,13 @@ typedef struct {
     float thickness;           ///< Line thickness for wireframe
     int segments;              ///< Number of segments for sphere/cone/cylinder
     bool visible;              ///< Whether the shape is visible
+    bool transformDirty;       ///< Set by the transform setters; localMatrix is rebuilt on the next draw
+    Matrix localMatrix;        ///< Cached unit mesh to sprite space transform: position, rotation and size (internal)
+    Matrix worldMatrix;        ///< Cached localMatrix under the sprite that last drew the shape (internal)
+    unsigned int parentStamp;  ///< Version of the sprite matrix worldMatrix was built from (internal)
+    RayPalsBounds3D bounds;    ///< World bounds under worldMatrix, refreshed with it (internal)
+    int lodLevel;              ///< Segment halvings 3D LOD last chose for the shape (internal)
+    RayPalsArena* arena;       ///< Arena the shape was allocated from (NULL for heap shapes)
 } RayPals3DShape;
 
 /**
@@ -117,16 +155,59 @@ typedef struct {
  * 
  * A sprite is a collection of 2D shapes that can be manipulated as a single unit.
  * It supports position, rotation, and scale transformations that affect all shapes.
+ * 
+ * Inline sprites (see CreateInlineSprite and MakeSpriteInline) keep their shapes by
+ * value in shapeStorage; shapes[i] then points at shapeStorage[i] so code that reads
+ * shapes through the pointer array works for both storage modes.
  */
 typedef struct {
     RayPals2DShape** shapes;   ///< Array of pointers to shapes
+    RayPals2DShape* shapeStorage; ///< Contiguous by-value shape storage for inline sprites (NULL otherwise)
     int shapeCount;            ///< Number of shapes in the sprite
+    int shapeCapacity;         ///< Number of shapes the sprite can hold before growing
     Vector2 position;          ///< Master position
     float rotation;            ///< Master rotation
     float scale;               ///< Master scale factor
     bool visible;              ///< Visibility flag
+    unsigned int version;      ///< Renewed when shapes are added or MarkSpriteDirty is called; caches compare it (internal)
+    bool transformDirty;       ///< Set by the transform setters; worldMatrix is rebuilt on the next draw
+    Matrix worldMatrix;        ///< Cached position, rotation and scale transform (internal)
+    Vector2 matrixPosition;    ///< Position worldMatrix was built from (internal)
+    float matrixRotation;      ///< Rotation worldMatrix was built from (internal)
+    float matrixScale;         ///< Scale worldMatrix was built from (internal)
+    RayPalsSpriteCache* cache; ///< Cached local-space tessellation (internal, built by DrawSprite)
+    RayPalsArena* arena;       ///< Arena the sprite was allocated from (NULL for heap sprites)
 } RayPalsSprite;
 
+/**
+ * @brief Immutable shape list shared by many sprite instances
+ * 
+ * A template owns one contiguous copy of a sprite's shapes in local space. Instances
+ * reference the template instead of copying it, so the geometry is stored once no
+ * matter how many instances are drawn. Templates must outlive their instances.
+ */
+typedef struct {
+    RayPals2DShape* shapes;    ///< Contiguous local-space shapes
+    int shapeCount;            ///< Number of shapes in the template
+    RayPalsSpriteCache* cache; ///< Tessellation built once at creation (internal)
+    RayPalsArena* arena;       ///< Arena the template was allocated from (NULL for heap templates)
+} RayPalsSpriteTemplate;
+
+/**
+ * @brief Lightweight placement of a sprite template
+ * 
+ * An instance holds only a transform, a tint and a visibility flag. It owns no
+ * memory and can be stored by value in plain arrays.
+ */
+typedef struct {
+    const RayPalsSpriteTemplate* spriteTemplate; ///< Shared geometry to draw
+    Vector2 position;          ///< Instance position
+    float rotation;            ///< Instance rotation in degrees
+    float scale;               ///< Instance scale factor
+    Color tint;                ///< Color multiplied with every shape color (WHITE leaves colors unchanged)
+    bool visible;              ///< Visibility flag
+} RayPalsSpriteInstance;
+
 /**
  * @brief Structure representing a 3D sprite (collection of 3D shapes)
  * 
@@ -136,12 +217,397 @@ typedef struct {
 typedef struct {
     RayPals3DShape** shapes;   ///< Array of pointers to 3D shapes
     int shapeCount;            ///< Number of shapes in the sprite
+    int shapeCapacity;         ///< Number of shapes the sprite can hold before growing
     Vector3 position;          ///< Master position in 3D space
     Vector3 rotation;          ///< Master rotation (x, y, z in degrees)
     Vector3 scale;             ///< Master scale factor for each axis
     bool visible;              ///< Visibility flag
+    bool transformDirty;       ///< Set by the transform setters; worldMatrix is rebuilt on the next draw
+    Matrix worldMatrix;        ///< Cached position, rotation and scale transform (internal)
+    unsigned int transformStamp; ///< Version of worldMatrix, compared by the shapes' cached world matrices (internal)
+    RayPalsBounds3D bounds;    ///< World bounds enclosing every shape (internal, see Get3DSpriteBounds)
+    unsigned int boundsStamp;  ///< Version of worldMatrix the bounds were built from (internal)
+    struct RayPals3DBVH* bvh;  ///< Tree the setters report moves to (internal, set by the last build containing the sprite)
+    int bvhLeaf;               ///< Index of the leaf node holding the sprite in that tree (internal)
+    bool bvhQueued;            ///< The leaf is already queued for the tree's next refit (internal)
+    RayPalsArena* arena;       ///< Arena the sprite was allocated from (NULL for heap sprites)
 } RayPals3DSprite;
 
+/**
+ * @brief Structure-of-arrays container for many shapes of one type
+ * 
+ * A shape batch stores each property in its own array so that update and transform
+ * passes stream through memory and vectorize, and DrawShapeBatch submits every
+ * element inside a single rlBegin/rlEnd run. Elements are addressed by index;
+ * removing an element moves the last one into its slot.
+ */
+typedef struct {
+    RayPalsShapeType type;     ///< Shape type shared by every element
+    int count;                 ///< Number of elements in the batch
+    int capacity;              ///< Number of elements the arrays can hold before growing
+    int segments;              ///< Circle segments, polygon sides or star points
+    float* positionX;          ///< Element center x coordinates
+    float* positionY;          ///< Element center y coordinates
+    float* sizeX;              ///< Element widths (same meaning as RayPals2DShape.size.x)
+    float* sizeY;              ///< Element heights (same meaning as RayPals2DShape.size.y)
+    float* rotation;           ///< Element rotations in degrees
+    float* velocityX;          ///< Horizontal velocities used by UpdateShapeBatch
+    float* velocityY;          ///< Vertical velocities used by UpdateShapeBatch
+    float* angularVelocity;    ///< Rotation speeds in degrees per second used by UpdateShapeBatch
+    Color* color;              ///< Element colors
+    Vector2* unitVertices;     ///< Cached unit-space triangles of the shape type (internal)
+    int unitVertexCount;       ///< Number of cached unit-space vertices (internal)
+    int unitSegments;          ///< Segment count the cached triangles were built with (internal)
+    RayPalsArena* arena;       ///< Arena the batch was allocated from (NULL for heap batches)
+} RayPalsShapeBatch;
+
+/**
+ * @brief Global level-of-detail settings for curved 2D shapes
+ * 
+ * With LOD enabled, the cached sprite tessellation picks the segment count of circles,
+ * water drops, skeleton skulls, many-sided polygons and small stars from their radius
+ * on screen, after the sprite scale and the current rlgl matrices (e.g. a Camera2D
+ * zoom) are applied. Shapes keep their own segment counts while LOD is disabled.
+ */
+typedef struct {
+    bool enabled;              ///< Whether segment counts follow the on-screen size (default false)
+    float tolerance;           ///< Largest distance in pixels between a curve and its tessellation (default 0.5)
+    float quality;             ///< Global knob dividing the tolerance: above 1 adds triangles, below 1 removes them (default 1)
+    int minSegments;           ///< Fewest segments used for a circle (default 6)
+    int maxSegments;           ///< Most segments used for a circle (default 128)
+} RayPalsLODSettings;
+
+/**
+ * @brief Global level-of-detail settings for 3D spheres, cylinders and cones
+ * 
+ * With LOD enabled, a shape drawn through a camera halves its segment count in steps
+ * while its projected radius stays within the tolerance, drawing each step from the
+ * unit mesh cache. A shape only moves to a coarser step once that step satisfies the
+ * tolerance with the hysteresis margin to spare, so shapes near a threshold do not pop
+ * back and forth.
+ * 
+ * The triangle budget is a per-frame target, counted between Begin3DLODFrame calls.
+ * Every 3D triangle drawn counts towards it, but only spheres, cylinders and cones can
+ * be coarsened to meet it; they never drop below their coarsest step, and other shapes,
+ * static batches and instances are drawn in full, so a frame can still exceed it.
+ */
+typedef struct {
+    bool enabled;              ///< Whether segment counts follow the projected size (default false)
+    float tolerance;           ///< Largest distance in pixels between a surface and its tessellation (default 1)
+    float hysteresis;          ///< Extra fraction of segments a coarser step must spare before it is chosen (default 0.2)
+    int minSegments;           ///< Fewest segments LOD reduces to (default 6)
+    int triangleBudget;        ///< 3D triangles per frame that LOD coarsening aims to stay under, 0 for none (default 0)
+} RayPals3DLODSettings;
+
+/**
+ * @brief Counters accumulated by the cached and batched drawing paths
+ * 
+ * The counters grow until ResetDrawStats is called, typically once per frame.
+ */
+typedef struct {
+    int sprites;               ///< Sprites and sprite instances drawn
+    int vertices;              ///< Vertices submitted to rlgl
+    int batches;               ///< RL_TRIANGLES runs opened
+    int culled;                ///< Sprites and instances skipped by the culled draw functions
+    int flushes;               ///< rlgl batch flushes caused by 3D camera scopes, blend switches and full buffers
+    int triangles;             ///< Triangles drawn by 3D shapes, sprites, static batches and instances
+} RayPalsDrawStats;
+
+/**
+ * @brief Counters accumulated by a software canvas
+ */
+typedef struct {
+    int triangles;             ///< Triangles that reached the rasterizer (after trivial rejection; counted by FlushCanvas when tiled)
+    long long pixels;          ///< Pixels blended into the image
+    long long tileTriangles;   ///< Triangle-tile pairs rasterized by FlushCanvas (multi-threaded canvases)
+} RayPalsCanvasStats;
+
+/**
+ * @brief Pixel loops used by software canvases to fill and blend spans
+ * 
+ * All kernels produce identical images; they only differ in speed. The SIMD kernels
+ * exist on x86 and x64 and are only selectable when cpuid reports them.
+ */
+typedef enum {
+    RAYPALS_CANVAS_KERNEL_AUTO,    ///< Fastest kernel the CPU supports (default)
+    RAYPALS_CANVAS_KERNEL_SCALAR,  ///< Portable C, one pixel at a time
+    RAYPALS_CANVAS_KERNEL_SSE2,    ///< 4 pixels per step
+    RAYPALS_CANVAS_KERNEL_AVX2     ///< 8 pixels per step
+} RayPalsCanvasKernel;
+
+/**
+ * @brief Opaque triangle queue and worker threads of a multi-threaded canvas
+ */
+typedef struct RayPalsCanvasQueue RayPalsCanvasQueue;
+
+/**
+ * @brief CPU render target that shapes and sprites can be rasterized into without a window
+ * 
+ * A canvas owns an RGBA8 image and fills the same triangles the cached sprite path
+ * sends to rlgl, so it needs neither a GL context nor InitWindow. Triangles are sampled
+ * at pixel centers with 1/16 pixel vertex precision and the top-left fill rule, so
+ * triangles sharing an edge never cover a pixel twice, and colors are composited with
+ * source-over alpha blending.
+ * 
+ * With more than one thread (see SetCanvasThreads), drawing only records triangles;
+ * FlushCanvas bins them into 64x64 pixel tiles and rasterizes the tiles in parallel,
+ * each in submission order, so the image is bit-identical to single-threaded output.
+ */
+typedef struct {
+    Image image;               ///< Pixels in PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, owned by the canvas
+    Camera2D camera;           ///< World-to-pixel view applied to everything drawn (zoom 1 at the origin by default)
+    RayPalsCanvasStats stats;  ///< Counters since creation or the last ResetCanvasStats
+    int threadCount;           ///< Threads that rasterize the image (1 draws immediately)
+    RayPalsCanvasQueue* queue; ///< Recorded triangles when threadCount > 1 (internal)
+    RayPalsSpriteCache* scratch; ///< Tessellation buffer for loose shapes (internal)
+} RayPalsCanvas;
+
+/**
+ * @brief Identifies a baked prefab in a sprite atlas
+ * 
+ * Sprites baked with equal keys share one atlas entry, so the key should capture
+ * everything that changes how the prefab looks: typically the factory name and the
+ * size and colors it was created with. Unused colors can be left zeroed.
+ */
+typedef struct {
+    const char* factory;       ///< Prefab factory name, e.g. "CreateCastle" (copied by the atlas)
+    float size;                ///< Size argument the prefab was created with
+    Color colors[4];           ///< Color arguments the prefab was created with
+    int variant;               ///< Free value for anything else that changes the look
+} RayPalsBakeKey;
+
+/**
+ * @brief Counters of a sprite atlas
+ */
+typedef struct {
+    int entries;               ///< Prefabs currently baked
+    size_t bytesUsed;          ///< Texel bytes of the baked prefabs, padding included
+    int bakes;                 ///< Prefabs rasterized into the atlas (first bakes and re-bakes)
+    int hits;                  ///< Lookups served by an existing entry
+    int evictions;             ///< Entries dropped to respect the byte budget or free space
+    int uploads;               ///< Texture updates sent to the GPU
+    int backgroundBakes;       ///< Bakes rasterized on the atlas's baker thread
+    int pendingBakes;          ///< Bakes queued or running on the baker thread
+} RayPalsAtlasStats;
+
+/**
+ * @brief Opaque entry table and rectangle packer of a sprite atlas
+ */
+typedef struct RayPalsAtlasPacker RayPalsAtlasPacker;
+
+/**
+ * @brief Shared texture that caches prefabs rasterized once and drawn as single quads
+ * 
+ * Prefabs are rasterized on the CPU with the software canvas and packed into shelves of
+ * the atlas image. The GPU texture is created on the first draw and only the changed
+ * region is uploaded afterwards. When the baked entries would exceed the byte budget,
+ * or a new prefab does not fit, the least recently used entries are evicted.
+ * 
+ * Each key can be baked at four resolution tiers of bakeScale, 2x, 4x and 8x. The tier is
+ * picked from the sprite's on-screen scale (its scale times the atlas zoom). A missing
+ * tier is rasterized on a background thread while the closest baked tier is drawn.
+ */
+typedef struct {
+    RayPalsCanvas* canvas;     ///< CPU copy of the atlas pixels
+    Texture2D texture;         ///< GPU copy, created lazily by DrawSpriteBaked (id 0 until then)
+    float bakeScale;           ///< Texels per sprite-space unit at the lowest tier (default 1)
+    float zoom;                ///< Camera zoom the sprites are drawn under (default 1)
+    size_t byteBudget;         ///< Most texel bytes the baked entries may use
+    RayPalsAtlasStats stats;   ///< Counters since creation
+    RayPalsAtlasPacker* packer; ///< Entries, hash table, shelves and pending upload region (internal)
+} RayPalsSpriteAtlas;
+
+/**
+ * @brief Counters of the last frame composed by a retained scene
+ */
+typedef struct {
+    int sprites;               ///< Sprites submitted
+    int dirtyRects;            ///< Screen rectangles redrawn
+    long long redrawnPixels;   ///< Pixel area of the redrawn rectangles
+    int redrawnSprites;        ///< Sprite draws issued to repaint them
+} RayPalsRetainedStats;
+
+/**
+ * @brief Opaque submission history and dirty regions of a retained scene
+ */
+typedef struct RayPalsRetainedState RayPalsRetainedState;
+
+/**
+ * @brief Persistent framebuffer that only repaints the regions that changed
+ * 
+ * Sprites are submitted every frame like DrawSprite calls. Each submission is compared
+ * with the one at the same position in the previous frame; when the sprite, its transform,
+ * its visibility or its shapes changed, both its old and new screen areas are marked dirty.
+ * Only those rectangles are cleared and redrawn into the render texture.
+ */
+typedef struct {
+    RenderTexture2D target;    ///< Composed frame, kept between frames
+    Color background;          ///< Color dirty regions are cleared to
+    Camera2D camera;           ///< Camera the sprites are drawn under (zoom 1 by default)
+    RayPalsRetainedStats stats; ///< Counters of the last EndRetainedScene
+    RayPalsRetainedState* state; ///< Submissions and dirty regions (internal)
+} RayPalsRetainedScene;
+
+/**
+ * @brief How a render queue item is blended, which also decides how it is sorted
+ * 
+ * Opaque items are grouped by draw state within their layer and come before the blended
+ * items of that layer; they are assumed not to overlap each other. Blended items are drawn
+ * back to front.
+ */
+typedef enum {
+    RAYPALS_BLEND_OPAQUE = 0,  ///< Sorted by state, drawn with alpha blending
+    RAYPALS_BLEND_ALPHA,       ///< Sorted back to front, alpha blending
+    RAYPALS_BLEND_ADDITIVE,    ///< Sorted back to front, additive blending
+    RAYPALS_BLEND_MULTIPLIED   ///< Sorted back to front, multiplied blending
+} RayPalsBlendMode;
+
+/**
+ * @brief Sort key of a render queue item
+ * 
+ * From the most significant bit: layer (8 bits), blended flag (1 bit), then for opaque
+ * items the draw state (23 bits) and depth (32 bits), and for blended items the depth
+ * (32 bits), blend mode (2 bits) and draw state (21 bits). Depth is stored inverted so
+ * that farther items sort first.
+ */
+typedef struct {
+    unsigned long long key;    ///< Packed sort key
+    int item;                  ///< Index of the item in submission order
+} RayPalsQueueKey;
+
+/**
+ * @brief Counters of the last render queue flush
+ */
+typedef struct {
+    int items;                 ///< Items drawn
+    int sortPasses;            ///< Radix passes run (8-bit digits that were not all equal)
+    int blendChanges;          ///< Blend mode switches, each of which flushes the rlgl batch
+} RayPalsRenderQueueStats;
+
+/**
+ * @brief Opaque record of a submitted sprite or instance
+ */
+typedef struct RayPalsQueueItem RayPalsQueueItem;
+
+/**
+ * @brief Draw list sorted by layer, blend mode and depth before drawing
+ * 
+ * Items are recorded by the Queue functions and drawn by FlushRenderQueue, which leaves
+ * the queue empty. Its buffers are kept, so a queue reused every frame only allocates
+ * when it holds more items than ever before.
+ */
+typedef struct {
+    RayPalsQueueItem* items;   ///< Submitted items (internal)
+    RayPalsQueueKey* order;    ///< Keys in draw order after SortRenderQueue
+    RayPalsQueueKey* scratch;  ///< Second radix sort buffer (internal)
+    int count;                 ///< Items submitted since the last flush
+    int capacity;              ///< Items the buffers hold before growing
+    bool sorted;               ///< order is current for the submitted items
+    RayPalsRenderQueueStats stats; ///< Counters of the last flush
+} RayPalsRenderQueue;
+
+/**
+ * @brief Opaque run of baked vertices sharing one color and fill mode
+ */
+typedef struct RayPalsStaticGroup RayPalsStaticGroup;
+
+/**
+ * @brief Six planes bounding what a 3D camera sees
+ * 
+ * Each plane is (x, y, z) normal and w offset, normalized and pointing inwards: a point p
+ * is inside when x*p.x + y*p.y + z*p.z + w >= 0 for every plane. Order: left, right,
+ * bottom, top, near, far.
+ */
+typedef struct {
+    Vector4 planes[6];         ///< Inward-facing planes
+} RayPalsFrustum;
+
+/**
+ * @brief 3D sprites flattened into world-space vertices grouped by color
+ * 
+ * Baking applies every sprite and shape transform once on the CPU, so drawing is a single
+ * pass over the vertex runs with no matrix pushes or rotations. Each sprite owns one
+ * contiguous range per run, which lets Update3DStaticBatch rewrite a moved sprite in place.
+ * The sprites are not owned by the batch and must outlive it.
+ */
+typedef struct {
+    RayPals3DSprite** sprites;     ///< Baked sprites, in the order given to Create3DStaticBatch
+    int spriteCount;               ///< Number of baked sprites
+    RayPalsStaticGroup* groups;    ///< Vertex runs, one per color and fill mode (internal)
+    int groupCount;                ///< Number of vertex runs
+    int* spans;                    ///< First vertex and count of each sprite in each run (internal)
+    int vertexCount;               ///< Vertices across all runs
+    int rebuilds;                  ///< Full bakes since creation, including the first
+    int updates;                   ///< Sprites rewritten in place since creation
+} RayPals3DStaticBatch;
+
+/**
+ * @brief Opaque node of a 3D bounding volume hierarchy
+ */
+typedef struct RayPalsBVHNode RayPalsBVHNode;
+
+/**
+ * @brief Shape and cost of a 3D bounding volume hierarchy
+ */
+typedef struct {
+    int nodeCount;             ///< Nodes in the tree, leaves included
+    int leafCount;             ///< Leaf nodes
+    int depth;                 ///< Nodes on the longest root-to-leaf path
+    int refitNodes;            ///< Nodes whose box changed during the last refit
+    int refitLeaves;           ///< Leaves whose sprites were measured again during the last refit
+    double buildTime;          ///< Milliseconds spent in the last build
+    double refitTime;          ///< Milliseconds spent in the last refit
+} RayPalsBVHStats;
+
+/**
+ * @brief Bounding volume hierarchy over the bounds of 3D sprites
+ * 
+ * Built top-down with a binned surface area heuristic. Every node covers a contiguous
+ * range of the sprites array, so a node entirely inside a query yields its sprites
+ * without visiting its children. Each sprite remembers its leaf, and the 3D sprite setters,
+ * AddShapeTo3DSprite and Mark3DSpriteDirty queue that leaf; Refit3DBVH then re-measures
+ * only the queued leaves and merges their ancestors, keeping the topology. After editing
+ * a shape of a sprite in the tree, call Mark3DSpriteDirty on the sprite.
+ * 
+ * A sprite reports to the tree built last among those holding it. A tree that lost one of
+ * its sprites to another tree (or holds a sprite twice) re-measures every leaf on refit.
+ * The sprites are not owned by the tree and must outlive it.
+ */
+typedef struct RayPals3DBVH {
+    RayPals3DSprite** sprites;     ///< Sprites in leaf order
+    int spriteCount;               ///< Number of sprites in the tree
+    RayPalsBVHNode* nodes;         ///< Nodes, root first, children after their parent (internal)
+    int nodeCount;                 ///< Nodes in use
+    int* queuedLeaves;             ///< Leaves queued by the sprites since the last refit (internal)
+    int queuedCount;               ///< Entries in queuedLeaves (internal)
+    bool untracked;                ///< Some sprite reports to another tree; refits visit every leaf (internal)
+    unsigned int refits;           ///< Refits so far, used to count each changed node once (internal)
+    RayPalsBVHStats stats;         ///< Counters of the last build and refit
+} RayPals3DBVH;
+
+/**
+ * @brief Opaque run of template vertices sharing one color and primitive mode
+ */
+typedef struct RayPals3DTemplateRun RayPals3DTemplateRun;
+
+/**
+ * @brief 3D sprite geometry baked once for instanced drawing
+ * 
+ * Every visible shape's unit mesh is transformed into template space once, and stored
+ * as planes of x, y, z and normal components so instances can transform four vertices
+ * per SIMD instruction. Triangle runs come first and wireframe runs after them.
+ */
+typedef struct {
+    float* vertexData;             ///< Six planes (x, y, z, nx, ny, nz) of stride floats each (internal)
+    int stride;                    ///< Floats per plane: the vertex count padded to the SIMD width
+    int vertexCount;               ///< Vertices across all runs
+    int triangleVertexCount;       ///< Vertices of the triangle runs
+    RayPals3DTemplateRun* runs;    ///< Triangle runs, then line runs (internal)
+    int runCount;                  ///< Number of runs
+    int triangleRunCount;          ///< Runs drawn as triangles
+    RayPalsBounds3D bounds;        ///< Template-space bounds of the baked shapes
+} RayPals3DSpriteTemplate;
+
 /**
  * @brief Structure representing a 3D tree
  * 
@@ -284,11 +750,101 @@ RayPalsSprite* CreateSprite(int initialCapacity);
 /**
  * @brief Adds a shape to a sprite
  * 
+ * The shape array grows geometrically, so adding n shapes costs amortized O(n).
+ * 
+ * Ownership differs by storage mode. A pointer-based sprite keeps the shape pointer,
+ * which stays valid for setters. An inline sprite (see CreateInlineSprite) copies the
+ * shape into its storage and frees the original, so the pointer passed in must not be
+ * used again; fetch the sprite's copy with GetSpriteShape instead.
+ * 
  * @param sprite The sprite to add the shape to
  * @param shape The shape to add
  */
 void AddShapeToSprite(RayPalsSprite* sprite, RayPals2DShape* shape);
 
+/**
+ * @brief Returns the shape a sprite holds at an index
+ * 
+ * For inline sprites this is the copy in the sprite's storage, valid until the
+ * storage moves (the next AddShapeToSprite, AddShapesToSprite or ShrinkSpriteToFit).
+ * 
+ * @param sprite The sprite to read
+ * @param index The shape index, from 0 to shapeCount - 1
+ * @return The shape, or NULL if the index is out of range
+ */
+RayPals2DShape* GetSpriteShape(RayPalsSprite* sprite, int index);
+
+/**
+ * @brief Adds several shapes to a sprite with a single reallocation at most
+ * 
+ * @param sprite The sprite to add the shapes to
+ * Inline sprites take ownership of the shapes as AddShapeToSprite describes.
+ * 
+ * @param shapes Array of shapes to add (NULL entries are skipped; none may already belong to the sprite)
+ * @param count The number of entries in the array
+ */
+void AddShapesToSprite(RayPalsSprite* sprite, RayPals2DShape** shapes, int count);
+
+/**
+ * @brief Releases unused shape capacity of a sprite
+ * 
+ * Has no effect on arena sprites, whose memory is only reclaimed with the arena.
+ * 
+ * @param sprite The sprite to shrink
+ */
+void ShrinkSpriteToFit(RayPalsSprite* sprite);
+
+/**
+ * @brief Creates a sprite that stores its shapes by value in one contiguous array
+ * 
+ * AddShapeToSprite copies shapes into the sprite's storage and frees the original,
+ * so read shapes back through sprite->shapes or sprite->shapeStorage afterwards.
+ * 
+ * @param initialCapacity The initial number of shapes the sprite can hold
+ * @return A pointer to the created inline sprite
+ */
+RayPalsSprite* CreateInlineSprite(int initialCapacity);
+
+/**
+ * @brief Moves the shapes of a pointer-based sprite into contiguous inline storage
+ * 
+ * The original shape allocations are freed; sprite->shapes is updated to point into
+ * the new storage, so any previously held shape pointers become invalid.
+ * 
+ * @param sprite The sprite to convert (e.g. one returned by a prefab factory)
+ * @return true if the sprite now uses inline storage
+ */
+bool MakeSpriteInline(RayPalsSprite* sprite);
+
+/**
+ * @brief Creates an immutable template from the shapes of a sprite
+ * 
+ * The shapes are copied in local space; the source sprite's own position, rotation
+ * and scale are not captured, and the sprite can be freed afterwards. Build the
+ * source at a reference size and use the instance scale for other sizes.
+ * 
+ * @param sprite The sprite to copy (e.g. one returned by a prefab factory)
+ * @return A pointer to the created template
+ */
+RayPalsSpriteTemplate* CreateSpriteTemplate(const RayPalsSprite* sprite);
+
+/**
+ * @brief Frees a sprite template
+ * 
+ * @param spriteTemplate The template to free (no instance may still reference it)
+ */
+void FreeSpriteTemplate(RayPalsSpriteTemplate* spriteTemplate);
+
+/**
+ * @brief Creates a visible, untinted instance of a sprite template
+ * 
+ * @param spriteTemplate The template to reference
+ * @param position The position of the instance
+ * @param scale The scale factor of the instance
+ * @return The instance (no memory is allocated)
+ */
+RayPalsSpriteInstance CreateSpriteInstance(const RayPalsSpriteTemplate* spriteTemplate, Vector2 position, float scale);
+
 /**
  * @brief Creates a simple character sprite
  * 
@@ -505,116 +1061,347 @@ void Draw2DShape(RayPals2DShape* shape);
 /**
  * @brief Draws a 3D shape
  * 
+ * Primitives are generated once per type, segment count and fill mode as unit
+ * meshes and scaled to the shape's size at draw time, so repeated draws skip the
+ * trigonometry raylib's DrawSphere/DrawCylinder calls redo every frame.
+ * 
  * @param shape The shape to draw
- * @param camera The camera to use for 3D rendering
+ * @param camera The camera to use for 3D rendering, or NULL when already in 3D mode
+ *               (ignored inside Begin3DBatch/End3DBatch)
  */
 void Draw3DShape(RayPals3DShape* shape, Camera *camera);
 
 /**
- * @brief Draws a sprite
+ * @brief Opens a 3D camera scope shared by the following 3D draws
  * 
- * @param sprite The sprite to draw
+ * BeginMode3D and EndMode3D each flush the rlgl batch. Inside a 3D batch,
+ * Draw3DShape ignores its camera argument instead of opening its own scope,
+ * so many shapes cost two flushes in total instead of two each.
+ * 
+ * Batches nest: only the outermost Begin3DBatch/End3DBatch pair opens and closes
+ * 3D mode, and the cameras of inner scopes are ignored.
+ * 
+ * @param camera The camera every shape in the batch is drawn with
  */
-void DrawSprite(RayPalsSprite* sprite);
+void Begin3DBatch(Camera camera);
 
 /**
- * @brief Updates the animation of a 2D shape
- * 
- * @param shape The shape to animate
- * @param animation The animation properties
- * @param deltaTime The time elapsed since the last update
+ * @brief Closes the innermost scope opened by Begin3DBatch; extra calls are ignored
  */
-void UpdateShapeAnimation(RayPals2DShape* shape, RayPalsAnimation* animation, float deltaTime);
+void End3DBatch(void);
 
 /**
- * @brief Updates the animation of a 3D shape
+ * @brief Draws many 3D shapes inside a single camera scope
  * 
- * @param shape The shape to animate
- * @param animation The animation properties
- * @param deltaTime The time elapsed since the last update
+ * @param shapes Array of shape pointers (NULL entries are skipped)
+ * @param count Number of shapes
+ * @param camera The camera to draw with (the open batch's camera when called inside one)
  */
-void Update3DShapeAnimation(RayPals3DShape* shape, RayPalsAnimation* animation, float deltaTime);
+void Draw3DShapes(RayPals3DShape** shapes, int count, Camera camera);
 
 /**
- * @brief Sets the color of a 2D shape
+ * @brief Frees the unit meshes cached by Draw3DShape
  * 
- * @param shape The shape to modify
- * @param color The new color
+ * Optional; meshes are rebuilt on the next draw. Call before CloseWindow to
+ * release the memory or after drawing many distinct segment counts. Also releases
+ * the buffer Draw3DSpriteInstances transforms instances into.
  */
-void SetShapeColor(RayPals2DShape* shape, Color color);
+void Free3DMeshCache(void);
 
 /**
- * @brief Sets the color of a 3D shape
+ * @brief Draws a sprite
  * 
- * @param shape The shape to modify
- * @param color The new color
+ * The shapes are tessellated once into a cached local-space triangle list; later
+ * draws only apply the sprite transform and stream the cached vertices. Changes made
+ * through the shape setters invalidate the cache automatically. After writing shape
+ * fields directly, call MarkSpriteDirty.
+ * 
+ * The sprite transform is likewise cached as a matrix, rebuilt only when position,
+ * rotation or scale differ from the values it was built from, whether they were
+ * changed through the setters or written directly.
+ * 
+ * @param sprite The sprite to draw
  */
-void Set3DShapeColor(RayPals3DShape* shape, Color color);
+void DrawSprite(RayPalsSprite* sprite);
 
 /**
- * @brief Sets the rotation of a 2D shape
+ * @brief Forces the cached tessellation and matrix of a sprite to be rebuilt on the next draw
  * 
- * @param shape The shape to modify
- * @param rotation The new rotation in degrees
+ * Direct writes to shape or sprite fields (e.g. shape->color) are not detected on
+ * their own. A shape shared by several sprites needs this call on each of them.
+ * 
+ * @param sprite The sprite whose fields or shapes were modified directly
  */
-void SetShapeRotation(RayPals2DShape* shape, float rotation);
+void MarkSpriteDirty(RayPalsSprite* sprite);
 
 /**
- * @brief Sets the rotation of a 3D shape
+ * @brief Gets the cached transform of a sprite, rebuilding it if position, rotation or scale changed
  * 
- * @param shape The shape to modify
- * @param rotation The new rotation in degrees (x, y, z)
+ * @param sprite The sprite to query
+ * @return Matrix mapping sprite space to world space (identity for NULL)
  */
-void Set3DShapeRotation(RayPals3DShape* shape, Vector3 rotation);
+Matrix GetSpriteMatrix(RayPalsSprite* sprite);
 
 /**
- * @brief Sets the position of a 2D shape
+ * @brief Gets the number of vertices in a sprite's cached tessellation
  * 
- * @param shape The shape to modify
- * @param position The new position
+ * @param sprite The sprite to query
+ * @return The cached vertex count, or 0 if the sprite has not been drawn since it changed
  */
-void SetShapePosition(RayPals2DShape* shape, Vector2 position);
+int GetSpriteCachedVertexCount(const RayPalsSprite* sprite);
 
 /**
- * @brief Sets the position of a 3D shape
+ * @brief Draws a sprite template instance
  * 
- * @param shape The shape to modify
- * @param position The new position
+ * @param instance The instance to draw
  */
-void Set3DShapePosition(RayPals3DShape* shape, Vector3 position);
+void DrawSpriteInstance(const RayPalsSpriteInstance* instance);
 
 /**
- * @brief Rotates a 2D shape by a given speed
+ * @brief Draws an array of sprite template instances
  * 
- * @param shape The shape to rotate
- * @param deltaTime The time elapsed since the last update
- * @param speed The rotation speed in degrees per second
+ * All instances are transformed on the CPU and submitted in one RL_TRIANGLES run.
+ * 
+ * @param instances The instances to draw
+ * @param count The number of instances
  */
-void RotateShape(RayPals2DShape* shape, float deltaTime, float speed);
+void DrawSpriteInstances(const RayPalsSpriteInstance* instances, int count);
 
 /**
- * @brief Rotates a 3D shape by a given speed
+ * @brief Draws a sprite with its transform applied on the CPU
  * 
- * @param shape The shape to rotate
- * @param deltaTime The time elapsed since the last update
- * @param speed The rotation speed in degrees per second (x, y, z)
+ * Unlike DrawSprite, this does not touch the matrix stack: the cached vertices are
+ * transformed on the CPU and submitted in a single RL_TRIANGLES run.
+ * 
+ * @param sprite The sprite to draw
  */
-void Rotate3DShape(RayPals3DShape* shape, float deltaTime, Vector3 speed);
+void DrawSpriteBatched(RayPalsSprite* sprite);
 
 /**
- * @brief Rotates a sprite by a given speed
+ * @brief Draws an array of sprites inside a single RL_TRIANGLES run
  * 
- * @param sprite The sprite to rotate
- * @param deltaTime The time elapsed since the last update
- * @param speed The rotation speed in degrees per second
+ * Sprites are drawn in array order. NULL entries and hidden sprites are skipped.
+ * 
+ * @param sprites The sprites to draw
+ * @param count The number of sprites
  */
-void RotateSprite(RayPalsSprite* sprite, float deltaTime, float speed);
+void DrawSpritesBatched(RayPalsSprite** sprites, int count);
 
 /**
- * @brief Sets the position of a sprite
+ * @brief Gets the world-space bounding box of a sprite
  * 
- * @param sprite The sprite to modify
- * @param position The new position
+ * The box covers every visible shape after shape rotation and the sprite's position,
+ * rotation and scale. The sprite-space box is cached with the sprite's tessellation and
+ * the world box is only recomputed when the sprite transform changes.
+ * 
+ * @param sprite The sprite to measure
+ * @return The axis-aligned bounds in world coordinates
+ */
+Rectangle GetSpriteBounds(RayPalsSprite* sprite);
+
+/**
+ * @brief Gets the world-space bounding box of a sprite template instance
+ * 
+ * @param instance The instance to measure
+ * @return The axis-aligned bounds in world coordinates
+ */
+Rectangle GetSpriteInstanceBounds(const RayPalsSpriteInstance* instance);
+
+/**
+ * @brief Gets the world-space area visible through a 2D camera
+ * 
+ * @param camera The camera covering the whole screen
+ * @return The axis-aligned bounds of the view (enclosing it if the camera is rotated)
+ */
+Rectangle GetCameraViewBounds(Camera2D camera);
+
+/**
+ * @brief Draws the sprites that intersect a camera's view inside a single RL_TRIANGLES run
+ * 
+ * Call between BeginMode2D(camera) and EndMode2D(); the camera is only used for culling.
+ * 
+ * @param sprites The sprites to draw
+ * @param count The number of sprites
+ * @param camera The camera the sprites are viewed through
+ * @return The number of sprites drawn
+ */
+int DrawSpritesCulled(RayPalsSprite** sprites, int count, Camera2D camera);
+
+/**
+ * @brief Draws the template instances that intersect a camera's view in one RL_TRIANGLES run
+ * 
+ * @param instances The instances to draw
+ * @param count The number of instances
+ * @param camera The camera the instances are viewed through
+ * @return The number of instances drawn
+ */
+int DrawSpriteInstancesCulled(const RayPalsSpriteInstance* instances, int count, Camera2D camera);
+
+/**
+ * @brief Replaces the global level-of-detail settings
+ * 
+ * Every cached sprite tessellation is rebuilt on its next draw.
+ * 
+ * @param settings The new settings (non-positive tolerance or quality fall back to the defaults)
+ */
+void SetLODSettings(RayPalsLODSettings settings);
+
+/**
+ * @brief Gets the global level-of-detail settings
+ * 
+ * @return The current settings
+ */
+RayPalsLODSettings GetLODSettings(void);
+
+/**
+ * @brief Gets the number of segments LOD uses for a circle of a given on-screen radius
+ * 
+ * @param screenRadius The radius of the circle in pixels
+ * @return The segment count, clamped to the minimum and maximum in the LOD settings
+ */
+int GetCircleLODSegments(float screenRadius);
+
+/**
+ * @brief Replaces the global 3D level-of-detail settings
+ * 
+ * While a triangle budget is set, the tolerance is raised for the next frame whenever
+ * a frame would have exceeded it, and LOD shapes drawn after the budget ran out fall
+ * back to coarser steps, down to their coarsest one.
+ * 
+ * @param settings The new settings (a non-positive tolerance falls back to the default)
+ */
+void Set3DLODSettings(RayPals3DLODSettings settings);
+
+/**
+ * @brief Gets the global 3D level-of-detail settings
+ * 
+ * @return The current settings
+ */
+RayPals3DLODSettings Get3DLODSettings(void);
+
+/**
+ * @brief Starts a new frame for the 3D LOD triangle budget
+ * 
+ * Call once per frame before drawing 3D shapes. The triangles of the previous frame
+ * decide whether the LOD tolerance rises or relaxes, then the count starts over.
+ */
+void Begin3DLODFrame(void);
+
+/**
+ * @brief Gets the counters accumulated since the last ResetDrawStats call
+ * 
+ * @return The current draw statistics
+ */
+RayPalsDrawStats GetDrawStats(void);
+
+/**
+ * @brief Resets the draw statistics counters to zero
+ */
+void ResetDrawStats(void);
+
+/**
+ * @brief Updates the animation of a 2D shape
+ * 
+ * @param shape The shape to animate
+ * @param animation The animation properties
+ * @param deltaTime The time elapsed since the last update
+ */
+void UpdateShapeAnimation(RayPals2DShape* shape, RayPalsAnimation* animation, float deltaTime);
+
+/**
+ * @brief Updates the animation of a 3D shape
+ * 
+ * Draw3DShape and Draw3DSprite pick up the new rotation, size and color on the next
+ * draw. A 3D static batch holding the shape keeps the baked vertices until
+ * Update3DStaticBatch is called for the shape's sprite. A 3D sprite template built
+ * from the shape's sprite is a snapshot; rebuild it with Create3DSpriteTemplate.
+ * 
+ * @param shape The shape to animate
+ * @param animation The animation properties
+ * @param deltaTime The time elapsed since the last update
+ */
+void Update3DShapeAnimation(RayPals3DShape* shape, RayPalsAnimation* animation, float deltaTime);
+
+/**
+ * @brief Sets the color of a 2D shape
+ * 
+ * @param shape The shape to modify
+ * @param color The new color
+ */
+void SetShapeColor(RayPals2DShape* shape, Color color);
+
+/**
+ * @brief Sets the color of a 3D shape
+ * 
+ * @param shape The shape to modify
+ * @param color The new color
+ */
+void Set3DShapeColor(RayPals3DShape* shape, Color color);
+
+/**
+ * @brief Sets the rotation of a 2D shape
+ * 
+ * @param shape The shape to modify
+ * @param rotation The new rotation in degrees
+ */
+void SetShapeRotation(RayPals2DShape* shape, float rotation);
+
+/**
+ * @brief Sets the rotation of a 3D shape
+ * 
+ * @param shape The shape to modify
+ * @param rotation The new rotation in degrees (x, y, z)
+ */
+void Set3DShapeRotation(RayPals3DShape* shape, Vector3 rotation);
+
+/**
+ * @brief Sets the position of a 2D shape
+ * 
+ * @param shape The shape to modify
+ * @param position The new position
+ */
+void SetShapePosition(RayPals2DShape* shape, Vector2 position);
+
+/**
+ * @brief Sets the position of a 3D shape
+ * 
+ * @param shape The shape to modify
+ * @param position The new position
+ */
+void Set3DShapePosition(RayPals3DShape* shape, Vector3 position);
+
+/**
+ * @brief Rotates a 2D shape by a given speed
+ * 
+ * @param shape The shape to rotate
+ * @param deltaTime The time elapsed since the last update
+ * @param speed The rotation speed in degrees per second
+ */
+void RotateShape(RayPals2DShape* shape, float deltaTime, float speed);
+
+/**
+ * @brief Rotates a 3D shape by a given speed
+ * 
+ * @param shape The shape to rotate
+ * @param deltaTime The time elapsed since the last update
+ * @param speed The rotation speed in degrees per second (x, y, z)
+ */
+void Rotate3DShape(RayPals3DShape* shape, float deltaTime, Vector3 speed);
+
+/**
+ * @brief Rotates a sprite by a given speed
+ * 
+ * @param sprite The sprite to rotate
+ * @param deltaTime The time elapsed since the last update
+ * @param speed The rotation speed in degrees per second
+ */
+void RotateSprite(RayPalsSprite* sprite, float deltaTime, float speed);
+
+/**
+ * @brief Sets the position of a sprite
+ * 
+ * @param sprite The sprite to modify
+ * @param position The new position
  */
 void SetSpritePosition(RayPalsSprite* sprite, Vector2 position);
 
@@ -655,6 +1442,57 @@ void Free3DShape(RayPals3DShape* shape);
  */
 void FreeSprite(RayPalsSprite* sprite);
 
+/**
+ * @brief Creates an arena allocator for shapes and sprites
+ * 
+ * @param slabSize The size in bytes of each slab (0 selects a 64 KB default)
+ * @return A pointer to the created arena
+ */
+RayPalsArena* CreateShapeArena(size_t slabSize);
+
+/**
+ * @brief Makes an arena the allocation target for all Create* functions
+ * 
+ * Calls can be nested up to 16 deep, including with the same arena; each call needs a
+ * matching EndShapeArena, which restores the previously active arena. Deeper calls are
+ * counted but keep the current arena.
+ * 
+ * @param arena The arena to allocate from
+ */
+void BeginShapeArena(RayPalsArena* arena);
+
+/**
+ * @brief Stops allocating from the current arena and restores the previous one
+ */
+void EndShapeArena(void);
+
+/**
+ * @brief Releases every object allocated from an arena but keeps its slabs for reuse
+ * 
+ * @param arena The arena to reset
+ */
+void ResetShapeArena(RayPalsArena* arena);
+
+/**
+ * @brief Returns the number of bytes handed out by an arena since it was created or reset
+ * 
+ * @param arena The arena to query
+ * @return The number of bytes in use
+ */
+size_t GetShapeArenaUsage(const RayPalsArena* arena);
+
+/**
+ * @brief Frees an arena together with every shape and sprite allocated from it
+ * 
+ * FreeShape, FreeSprite and their 3D counterparts do nothing for arena objects,
+ * so they can still be called on them safely before the arena is freed.
+ * The arena is removed from every pending BeginShapeArena scope: those scopes
+ * allocate from the heap until their EndShapeArena, which never reactivates it.
+ * 
+ * @param arena The arena to free
+ */
+void FreeShapeArena(RayPalsArena* arena);
+
 /**
  * @brief Creates a sprite with a star shape
  * 
@@ -907,6 +1745,24 @@ RayPals3DSprite* Create3DSprite(int initialCapacity);
  */
 void AddShapeTo3DSprite(RayPals3DSprite* sprite, RayPals3DShape* shape);
 
+/**
+ * @brief Adds several 3D shapes to a 3D sprite with a single reallocation at most
+ * 
+ * @param sprite The sprite to add the shapes to
+ * @param shapes Array of shapes to add (NULL entries are skipped)
+ * @param count The number of entries in the array
+ */
+void AddShapesTo3DSprite(RayPals3DSprite* sprite, RayPals3DShape** shapes, int count);
+
+/**
+ * @brief Releases unused shape capacity of a 3D sprite
+ * 
+ * Has no effect on arena sprites, whose memory is only reclaimed with the arena.
+ * 
+ * @param sprite The sprite to shrink
+ */
+void Shrink3DSpriteToFit(RayPals3DSprite* sprite);
+
 /**
  * @brief Draws a 3D sprite
  * 
@@ -948,6 +1804,65 @@ void Set3DSpriteScale(RayPals3DSprite* sprite, Vector3 scale);
  */
 void Rotate3DSprite(RayPals3DSprite* sprite, float deltaTime, Vector3 speed);
 
+/**
+ * @brief Forces the cached matrices of a 3D sprite and all its shapes to be rebuilt
+ * 
+ * The setters and Rotate functions keep the matrices current on their own; call this
+ * after writing position, rotation, scale or size fields directly, or after editing a
+ * shape of a sprite held by a bounding volume hierarchy.
+ * 
+ * @param sprite The sprite that was modified directly
+ */
+void Mark3DSpriteDirty(RayPals3DSprite* sprite);
+
+/**
+ * @brief Forces the cached matrices of a 3D shape to be rebuilt
+ * 
+ * @param shape The shape whose position, rotation or size was written directly
+ */
+void Mark3DShapeDirty(RayPals3DShape* shape);
+
+/**
+ * @brief Gets the cached transform of a 3D sprite, rebuilding it if needed
+ * 
+ * @param sprite The sprite to query
+ * @return Matrix mapping sprite space to world space (identity for NULL)
+ */
+Matrix Get3DSpriteMatrix(RayPals3DSprite* sprite);
+
+/**
+ * @brief Gets the cached world transform of a shape's unit mesh
+ * 
+ * The unit meshes are a cube of side 1 and a sphere of radius 1 centered on the origin,
+ * and a cylinder and cone of radius 1 and height 1 standing on the origin. The result
+ * is only rebuilt when the shape or its sprite changed.
+ * 
+ * @param shape The shape to query
+ * @param sprite The sprite holding the shape, or NULL for a standalone shape
+ * @return Matrix mapping the unit mesh to world space (identity for NULL)
+ */
+Matrix Get3DShapeMatrix(RayPals3DShape* shape, RayPals3DSprite* sprite);
+
+/**
+ * @brief Gets the cached world bounds of a shape's unit mesh
+ * 
+ * @param shape The shape to measure
+ * @param sprite The sprite holding the shape, or NULL for a standalone shape
+ * @return Box and sphere enclosing the shape (hidden shapes are measured too)
+ */
+RayPalsBounds3D Get3DShapeBounds(RayPals3DShape* shape, RayPals3DSprite* sprite);
+
+/**
+ * @brief Gets the cached world bounds of a 3D sprite
+ * 
+ * The bounds enclose every shape, visible or not, and are only rebuilt after the sprite
+ * or one of its shapes changed through the setters or Mark3DSpriteDirty.
+ * 
+ * @param sprite The sprite to measure
+ * @return Box and sphere enclosing the sprite
+ */
+RayPalsBounds3D Get3DSpriteBounds(RayPals3DSprite* sprite);
+
 /**
  * @brief Frees the memory allocated for a 3D sprite
  * 
@@ -1148,6 +2063,777 @@ RayPalsSprite* CreateWerewolf(Vector2 position, float size, Color furColor, Colo
  */
 RayPalsSprite* CreateMummy(Vector2 position, float size, Color bandageColor, Color eyeColor);
 
+/**
+ * @brief Creates a structure-of-arrays batch for shapes of a single type
+ * 
+ * @param type The shape type of every element (any filled 2D type except RAYPALS_SKELETON)
+ * @param initialCapacity The initial number of elements the batch can hold
+ * @return A pointer to the created batch, or NULL if the type cannot be batched
+ */
+RayPalsShapeBatch* CreateShapeBatch(RayPalsShapeType type, int initialCapacity);
+
+/**
+ * @brief Appends an element to a shape batch
+ * 
+ * @param batch The batch to add to
+ * @param position The center position of the element
+ * @param size The size of the element (as in RayPals2DShape.size)
+ * @param rotation The rotation of the element in degrees
+ * @param color The color of the element
+ * @return The index of the new element, or -1 on failure
+ */
+int AddShapeToBatch(RayPalsShapeBatch* batch, Vector2 position, Vector2 size, float rotation, Color color);
+
+/**
+ * @brief Removes an element from a shape batch by moving the last element into its slot
+ * 
+ * @param batch The batch to modify
+ * @param index The index of the element to remove
+ */
+void RemoveShapeFromBatch(RayPalsShapeBatch* batch, int index);
+
+/**
+ * @brief Sets the linear and angular velocity of a batch element
+ * 
+ * @param batch The batch to modify
+ * @param index The index of the element
+ * @param velocity The velocity in units per second
+ * @param angularVelocity The rotation speed in degrees per second
+ */
+void SetBatchShapeVelocity(RayPalsShapeBatch* batch, int index, Vector2 velocity, float angularVelocity);
+
+/**
+ * @brief Advances every element of a batch by its velocity
+ * 
+ * @param batch The batch to update
+ * @param deltaTime The time elapsed since the last update
+ */
+void UpdateShapeBatch(RayPalsShapeBatch* batch, float deltaTime);
+
+/**
+ * @brief Rotates and scales every element about the origin, then translates it
+ * 
+ * @param batch The batch to transform
+ * @param translation The offset added after rotation and scaling
+ * @param rotation The rotation in degrees
+ * @param scale The uniform scale factor applied to positions and sizes
+ */
+void TransformShapeBatch(RayPalsShapeBatch* batch, Vector2 translation, float rotation, float scale);
+
+/**
+ * @brief Draws every element of a batch in a single rlBegin/rlEnd run
+ * 
+ * @param batch The batch to draw
+ */
+void DrawShapeBatch(RayPalsShapeBatch* batch);
+
+/**
+ * @brief Frees a shape batch and all of its arrays
+ * 
+ * @param batch The batch to free
+ */
+void FreeShapeBatch(RayPalsShapeBatch* batch);
+
+/**
+ * @brief Creates a software canvas cleared to transparent black
+ * 
+ * @param width The image width in pixels
+ * @param height The image height in pixels
+ * @return Pointer to the new canvas, or NULL on failure
+ */
+RayPalsCanvas* CreateCanvas(int width, int height);
+
+/**
+ * @brief Fills every pixel of a canvas with a color (no blending)
+ * 
+ * @param canvas The canvas to clear
+ * @param color The color to fill with
+ */
+void ClearCanvas(RayPalsCanvas* canvas, Color color);
+
+/**
+ * @brief Sets the view used to map world coordinates to canvas pixels
+ * 
+ * @param canvas The canvas to modify
+ * @param camera The view, with the same meaning as in BeginMode2D
+ */
+void SetCanvasCamera(RayPalsCanvas* canvas, Camera2D camera);
+
+/**
+ * @brief Rasterizes a single triangle given in world coordinates
+ * 
+ * @param canvas The canvas to draw into
+ * @param v1 The first vertex
+ * @param v2 The second vertex
+ * @param v3 The third vertex
+ * @param color The fill color, blended over the existing pixels
+ */
+void DrawCanvasTriangle(RayPalsCanvas* canvas, Vector2 v1, Vector2 v2, Vector2 v3, Color color);
+
+/**
+ * @brief Rasterizes a 2D shape as DrawSprite would tessellate it
+ * 
+ * @param canvas The canvas to draw into
+ * @param shape The shape to draw
+ */
+void DrawShapeToCanvas(RayPalsCanvas* canvas, RayPals2DShape* shape);
+
+/**
+ * @brief Rasterizes a sprite, reusing and refreshing its cached tessellation
+ * 
+ * @param canvas The canvas to draw into
+ * @param sprite The sprite to draw
+ */
+void DrawSpriteToCanvas(RayPalsCanvas* canvas, RayPalsSprite* sprite);
+
+/**
+ * @brief Rasterizes a sprite template instance with its transform and tint
+ * 
+ * @param canvas The canvas to draw into
+ * @param instance The instance to draw
+ */
+void DrawSpriteInstanceToCanvas(RayPalsCanvas* canvas, const RayPalsSpriteInstance* instance);
+
+/**
+ * @brief Sets how many threads rasterize a canvas
+ * 
+ * With one thread (the default) every draw call fills pixels right away. With more,
+ * draw calls only record triangles and FlushCanvas renders them on a pool of worker
+ * threads plus the calling thread. Pending work is flushed before the pool changes.
+ * 
+ * @param canvas The canvas to modify
+ * @param threadCount The number of threads, or 0 for one per processor
+ */
+void SetCanvasThreads(RayPalsCanvas* canvas, int threadCount);
+
+/**
+ * @brief Rasterizes everything recorded on a multi-threaded canvas into its image
+ * 
+ * Call it before reading canvas->image; it does nothing on single-threaded canvases.
+ * 
+ * @param canvas The canvas to flush
+ */
+void FlushCanvas(RayPalsCanvas* canvas);
+
+/**
+ * @brief Checks whether a span kernel can run on this CPU
+ * 
+ * @param kernel The kernel to check
+ * @return true if SetCanvasKernel would accept the kernel
+ */
+bool IsCanvasKernelSupported(RayPalsCanvasKernel kernel);
+
+/**
+ * @brief Selects the span kernel used by every canvas
+ * 
+ * Do not call it while a multi-threaded canvas is flushing. Atlas bakes already queued
+ * for the background keep the kernel that was selected when they were queued.
+ * 
+ * @param kernel The kernel to use, or RAYPALS_CANVAS_KERNEL_AUTO for the fastest supported one
+ * @return true if the kernel was selected, false if the CPU does not support it
+ */
+bool SetCanvasKernel(RayPalsCanvasKernel kernel);
+
+/**
+ * @brief Gets the span kernel canvases currently use
+ * 
+ * @return The selected kernel (never RAYPALS_CANVAS_KERNEL_AUTO)
+ */
+RayPalsCanvasKernel GetCanvasKernel(void);
+
+/**
+ * @brief Zeroes the triangle and pixel counters of a canvas
+ * 
+ * @param canvas The canvas to reset
+ */
+void ResetCanvasStats(RayPalsCanvas* canvas);
+
+/**
+ * @brief Frees a canvas and its image
+ * 
+ * @param canvas The canvas to free
+ */
+void FreeCanvas(RayPalsCanvas* canvas);
+
+/**
+ * @brief Creates a sprite atlas
+ * 
+ * @param width The atlas width in texels
+ * @param height The atlas height in texels
+ * @param byteBudget Most texel bytes baked prefabs may use, or 0 for the whole atlas
+ * @return Pointer to the new atlas, or NULL on failure
+ */
+RayPalsSpriteAtlas* CreateSpriteAtlas(int width, int height, size_t byteBudget);
+
+/**
+ * @brief Sets the resolution of the lowest tier and drops every baked entry
+ * 
+ * @param atlas The atlas to modify
+ * @param bakeScale Texels per sprite-space unit (e.g. 0.5 for sprites usually drawn at half size)
+ */
+void SetAtlasBakeScale(RayPalsSpriteAtlas* atlas, float bakeScale);
+
+/**
+ * @brief Sets the camera zoom used to pick resolution tiers
+ * 
+ * Call it whenever Camera2D.zoom changes for sprites drawn inside BeginMode2D.
+ * 
+ * @param atlas The atlas to modify
+ * @param zoom The camera zoom (must be positive)
+ */
+void SetAtlasZoom(RayPalsSpriteAtlas* atlas, float zoom);
+
+/**
+ * @brief Bakes a sprite under a key, reusing the entry when it exists and is current
+ * 
+ * The sprite is (re)rasterized, on the calling thread, when the key has no entry at the
+ * tier for the sprite's scale, or when the sprite or one of its shapes was edited (or
+ * created) after the entry was baked. Drawing the sprite in between does not hide an edit.
+ * The sprite's position and rotation are ignored.
+ * 
+ * @param atlas The atlas to bake into
+ * @param key The key identifying the prefab
+ * @param sprite The sprite to bake
+ * @return The entry's texels in the atlas image, or a zero-sized rectangle on failure
+ */
+Rectangle BakeSprite(RayPalsSpriteAtlas* atlas, RayPalsBakeKey key, RayPalsSprite* sprite);
+
+/**
+ * @brief Draws a sprite as one textured quad from the atlas, baking it first if needed
+ * 
+ * The first bake of a key happens immediately. Once any tier exists, other tiers are baked
+ * in the background and the closest baked tier is drawn until they are ready.
+ * Falls back to DrawSprite when the sprite cannot be baked (e.g. it is larger than the atlas).
+ * 
+ * @param atlas The atlas to draw from
+ * @param key The key identifying the prefab
+ * @param sprite The sprite to draw, with its position, rotation and scale
+ * @return true if the sprite was drawn from the atlas
+ */
+bool DrawSpriteBaked(RayPalsSpriteAtlas* atlas, RayPalsBakeKey key, RayPalsSprite* sprite);
+
+/**
+ * @brief Waits for the background bakes of an atlas and adds them to it
+ * 
+ * Finished bakes are otherwise added by the next BakeSprite or DrawSpriteBaked call.
+ * 
+ * @param atlas The atlas to flush
+ */
+void FlushSpriteAtlas(RayPalsSpriteAtlas* atlas);
+
+/**
+ * @brief Drops every baked entry of an atlas
+ * 
+ * @param atlas The atlas to clear
+ */
+void ClearSpriteAtlas(RayPalsSpriteAtlas* atlas);
+
+/**
+ * @brief Frees an atlas, its image, its texture and its baker thread
+ * 
+ * @param atlas The atlas to free
+ */
+void FreeSpriteAtlas(RayPalsSpriteAtlas* atlas);
+
+/**
+ * @brief Creates a retained scene with its own render texture
+ * 
+ * The first EndRetainedScene redraws the whole texture.
+ * 
+ * @param width The framebuffer width in pixels
+ * @param height The framebuffer height in pixels
+ * @param background The color the framebuffer is cleared to
+ * @return Pointer to the new scene, or NULL on failure
+ */
+RayPalsRetainedScene* CreateRetainedScene(int width, int height, Color background);
+
+/**
+ * @brief Sets the camera the scene's sprites are drawn under
+ * 
+ * Any change redraws the whole framebuffer on the next EndRetainedScene.
+ * 
+ * @param scene The scene to modify
+ * @param camera The new camera
+ */
+void SetRetainedSceneCamera(RayPalsRetainedScene* scene, Camera2D camera);
+
+/**
+ * @brief Sets the background color, redrawing the whole framebuffer if it changed
+ * 
+ * @param scene The scene to modify
+ * @param background The new background color
+ */
+void SetRetainedSceneBackground(RayPalsRetainedScene* scene, Color background);
+
+/**
+ * @brief Redraws the whole framebuffer on the next EndRetainedScene
+ * 
+ * @param scene The scene to invalidate
+ */
+void InvalidateRetainedScene(RayPalsRetainedScene* scene);
+
+/**
+ * @brief Redraws a screen rectangle on the next EndRetainedScene
+ * 
+ * Use it for changes the scene cannot see, such as a sprite edited through its fields
+ * without marking it dirty.
+ * 
+ * @param scene The scene to invalidate
+ * @param rect The framebuffer rectangle to redraw, in pixels
+ */
+void InvalidateRetainedRect(RayPalsRetainedScene* scene, Rectangle rect);
+
+/**
+ * @brief Starts submitting the sprites of a frame
+ * 
+ * @param scene The scene to submit to
+ */
+void BeginRetainedScene(RayPalsRetainedScene* scene);
+
+/**
+ * @brief Submits a sprite to the current frame of a retained scene
+ * 
+ * Submit the same sprites in the same back-to-front order every frame. A sprite that moves
+ * in the order is treated as changed. The scene keeps the sprite's address until the next
+ * EndRetainedScene, and only compares it afterwards.
+ * 
+ * @param scene The scene to submit to
+ * @param sprite The sprite to draw, as with DrawSprite
+ */
+void DrawSpriteRetained(RayPalsRetainedScene* scene, RayPalsSprite* sprite);
+
+/**
+ * @brief Finishes a frame, redrawing the dirty regions into the framebuffer
+ * 
+ * Call it outside BeginMode2D and BeginTextureMode, as it switches to the scene's
+ * render texture and camera.
+ * 
+ * @param scene The scene to compose
+ */
+void EndRetainedScene(RayPalsRetainedScene* scene);
+
+/**
+ * @brief Draws the composed framebuffer
+ * 
+ * @param scene The scene to draw
+ * @param position The screen position of the framebuffer's top-left corner
+ */
+void DrawRetainedScene(const RayPalsRetainedScene* scene, Vector2 position);
+
+/**
+ * @brief Frees a retained scene and its render texture
+ * 
+ * @param scene The scene to free
+ */
+void FreeRetainedScene(RayPalsRetainedScene* scene);
+
+/**
+ * @brief Creates a render queue
+ * 
+ * @param capacity Items to reserve room for (grown as needed)
+ * @return Pointer to the new queue, or NULL on failure
+ */
+RayPalsRenderQueue* CreateRenderQueue(int capacity);
+
+/**
+ * @brief Submits a sprite to a render queue
+ * 
+ * The sprite is drawn by the next FlushRenderQueue and must stay alive until then.
+ * 
+ * @param queue The queue to submit to
+ * @param sprite The sprite to draw, as with DrawSprite
+ * @param layer Draw layer from 0 (drawn first) to 255
+ * @param depth Distance from the viewer; farther blended items are drawn first (e.g. -position.y for y-sorting)
+ * @param blend How the sprite is blended and sorted
+ */
+void QueueSprite(RayPalsRenderQueue* queue, RayPalsSprite* sprite, int layer, float depth, RayPalsBlendMode blend);
+
+/**
+ * @brief Submits a sprite instance to a render queue
+ * 
+ * The instance is copied; its template must stay alive until the next FlushRenderQueue.
+ * Opaque instances are grouped by template.
+ * 
+ * @param queue The queue to submit to
+ * @param instance The instance to draw, as with DrawSpriteInstance
+ * @param layer Draw layer from 0 (drawn first) to 255
+ * @param depth Distance from the viewer; farther blended items are drawn first
+ * @param blend How the instance is blended and sorted
+ */
+void QueueSpriteInstance(RayPalsRenderQueue* queue, const RayPalsSpriteInstance* instance, int layer, float depth, RayPalsBlendMode blend);
+
+/**
+ * @brief Sorts the submitted items into draw order with a stable radix sort
+ * 
+ * FlushRenderQueue sorts on its own; call this to inspect the order first.
+ * Items with equal keys keep their submission order.
+ * 
+ * @param queue The queue to sort
+ */
+void SortRenderQueue(RayPalsRenderQueue* queue);
+
+/**
+ * @brief Sorts and draws every submitted item in one pass, then empties the queue
+ * 
+ * Consecutive items with the same blend mode share one triangle run.
+ * 
+ * @param queue The queue to flush
+ */
+void FlushRenderQueue(RayPalsRenderQueue* queue);
+
+/**
+ * @brief Drops the submitted items without drawing them
+ * 
+ * @param queue The queue to clear
+ */
+void ClearRenderQueue(RayPalsRenderQueue* queue);
+
+/**
+ * @brief Frees a render queue
+ * 
+ * @param queue The queue to free
+ */
+void FreeRenderQueue(RayPalsRenderQueue* queue);
+
+/**
+ * @brief Bakes 3D sprites into a static batch
+ * 
+ * Hidden sprites and shapes contribute nothing until the batch is rebuilt.
+ * 
+ * @param sprites The sprites to bake (the array is copied, the sprites are not)
+ * @param count Number of sprites
+ * @return Pointer to the new batch, or NULL on failure
+ */
+RayPals3DStaticBatch* Create3DStaticBatch(RayPals3DSprite** sprites, int count);
+
+/**
+ * @brief Rebakes one sprite after it or its shapes changed
+ * 
+ * Transform changes made through the setters (or flagged with Mark3DSpriteDirty) are
+ * rewritten in place. Changes that alter the sprite's vertex
+ * counts per run (colors, visibility, segments, wireframe or added shapes) rebuild
+ * the whole batch.
+ * 
+ * @param batch The batch holding the sprite
+ * @param index Index of the sprite in batch->sprites
+ * @return true on success, false if the index is invalid or memory ran out
+ */
+bool Update3DStaticBatch(RayPals3DStaticBatch* batch, int index);
+
+/**
+ * @brief Rebakes every sprite of a static batch
+ * 
+ * @param batch The batch to rebuild
+ * @return true on success, false if memory ran out (the batch is then empty)
+ */
+bool Rebuild3DStaticBatch(RayPals3DStaticBatch* batch);
+
+/**
+ * @brief Draws a static batch, one rlgl run per color
+ * 
+ * Call between BeginMode3D and EndMode3D, like Draw3DSprite.
+ * 
+ * @param batch The batch to draw
+ */
+void Draw3DStaticBatch(RayPals3DStaticBatch* batch);
+
+/**
+ * @brief Frees a static batch (not the sprites it baked)
+ * 
+ * @param batch The batch to free
+ */
+void Free3DStaticBatch(RayPals3DStaticBatch* batch);
+
+/**
+ * @brief Extracts the view frustum of a 3D camera
+ * 
+ * Uses the same projection BeginMode3D sets up for the current framebuffer (the screen,
+ * or the render texture inside BeginTextureMode), including rlgl's near and far clip
+ * distances, so results match what is drawn.
+ * 
+ * @param camera The camera to extract the frustum from
+ * @return The six frustum planes
+ */
+RayPalsFrustum GetCameraFrustum(Camera camera);
+
+/**
+ * @brief Tests whether bounds may be visible inside a frustum
+ * 
+ * Tests the bounding sphere first and then the box, so the result is conservative:
+ * false means the bounds are certainly outside.
+ * 
+ * @param frustum The frustum to test against
+ * @param bounds The bounds to test
+ * @return false if the bounds lie entirely outside one of the planes
+ */
+bool IsBoundsInFrustum(const RayPalsFrustum* frustum, RayPalsBounds3D bounds);
+
+/**
+ * @brief Draws the 3D sprites whose bounds intersect a camera's frustum
+ * 
+ * Sprites are rejected from their cached bounds before any matrix work, and the shapes
+ * of sprites crossing a frustum plane are tested one by one. Call between BeginMode3D
+ * and EndMode3D (or inside a 3D batch); the camera is only used for culling.
+ * 
+ * @param sprites The sprites to draw
+ * @param count Number of sprites
+ * @param camera The camera the sprites are viewed through
+ * @return The number of sprites drawn
+ */
+int Draw3DSpritesCulled(RayPals3DSprite** sprites, int count, Camera camera);
+
+/**
+ * @brief Builds a bounding volume hierarchy over 3D sprites
+ * 
+ * @param sprites The sprites to index (the array is copied, the sprites are not)
+ * @param count Number of sprites
+ * @return Pointer to the new tree, or NULL on failure
+ */
+RayPals3DBVH* Create3DBVH(RayPals3DSprite** sprites, int count);
+
+/**
+ * @brief Rebuilds a bounding volume hierarchy from the current sprite bounds
+ * 
+ * Refitting keeps the tree valid as sprites move, but its boxes grow looser when
+ * sprites travel far from where they were built; rebuild when queries slow down.
+ * 
+ * @param bvh The tree to rebuild
+ * @return true on success, false if memory ran out (the tree is left unchanged)
+ */
+bool Rebuild3DBVH(RayPals3DBVH* bvh);
+
+/**
+ * @brief Updates the boxes of a bounding volume hierarchy after sprites moved
+ * 
+ * Only the leaves queued since the last refit are measured again, and only the nodes
+ * above the ones that changed are merged again, so the cost follows the number of moved
+ * sprites rather than the size of the tree. Call once per frame after moving sprites and
+ * before querying or drawing the tree.
+ * 
+ * @param bvh The tree to refit
+ * @return Number of nodes whose box changed
+ */
+int Refit3DBVH(RayPals3DBVH* bvh);
+
+/**
+ * @brief Gets the statistics of a bounding volume hierarchy
+ * 
+ * @param bvh The tree to inspect
+ * @return Node counts, depth and the time of the last build and refit
+ */
+RayPalsBVHStats Get3DBVHStats(const RayPals3DBVH* bvh);
+
+/**
+ * @brief Finds the visible sprites whose bounds may intersect a frustum
+ * 
+ * @param bvh The tree to search
+ * @param frustum The frustum to test against
+ * @param results Array receiving the sprites found (may be NULL to only count them)
+ * @param maxResults Capacity of the results array
+ * @return Number of sprites found, which may exceed maxResults
+ */
+int Query3DBVHFrustum(const RayPals3DBVH* bvh, const RayPalsFrustum* frustum, RayPals3DSprite** results, int maxResults);
+
+/**
+ * @brief Finds the visible sprites whose bounding boxes overlap a region
+ * 
+ * @param bvh The tree to search
+ * @param region The world-space box to search
+ * @param results Array receiving the sprites found (may be NULL to only count them)
+ * @param maxResults Capacity of the results array
+ * @return Number of sprites found, which may exceed maxResults
+ */
+int Query3DBVHRegion(const RayPals3DBVH* bvh, BoundingBox region, RayPals3DSprite** results, int maxResults);
+
+/**
+ * @brief Finds the visible sprites whose bounding boxes a ray hits
+ * 
+ * Sprites are reported in tree order, not by distance.
+ * 
+ * @param bvh The tree to search
+ * @param ray The ray to cast
+ * @param maxDistance Farthest hit reported, in units of the ray direction's length
+ * @param results Array receiving the sprites found (may be NULL to only count them)
+ * @param maxResults Capacity of the results array
+ * @return Number of sprites found, which may exceed maxResults
+ */
+int Query3DBVHRay(const RayPals3DBVH* bvh, Ray ray, float maxDistance, RayPals3DSprite** results, int maxResults);
+
+/**
+ * @brief Draws the sprites of a bounding volume hierarchy that a camera can see
+ * 
+ * Subtrees outside the frustum are skipped whole and count their sprites as culled;
+ * subtrees entirely inside draw without further tests. Call between BeginMode3D and
+ * EndMode3D (or inside a 3D batch) after Refit3DBVH.
+ * 
+ * @param bvh The tree to draw
+ * @param camera The camera the sprites are viewed through
+ * @return The number of sprites drawn
+ */
+int Draw3DBVH(const RayPals3DBVH* bvh, Camera camera);
+
+/**
+ * @brief Frees a bounding volume hierarchy (not the sprites it indexes)
+ * 
+ * @param bvh The tree to free
+ */
+void Free3DBVH(RayPals3DBVH* bvh);
+
+/**
+ * @brief Bakes the shapes of a 3D sprite into an instancing template
+ * 
+ * Shapes are captured in sprite space, without the sprite's own position, rotation
+ * and scale; the sprite can be changed or freed afterwards. Hidden shapes are skipped.
+ * 
+ * @param sprite The sprite to bake (e.g. one returned by Create3DRobot)
+ * @return Pointer to the new template, or NULL on failure
+ */
+RayPals3DSpriteTemplate* Create3DSpriteTemplate(RayPals3DSprite* sprite);
+
+/**
+ * @brief Builds an instance transform with the same conventions as a 3D sprite
+ * 
+ * @param position Translation
+ * @param rotation Rotation in degrees around each axis
+ * @param scale Scale along each axis
+ * @return The transform matrix
+ */
+Matrix Get3DInstanceTransform(Vector3 position, Vector3 rotation, Vector3 scale);
+
+/**
+ * @brief Draws many copies of a template in one vertex stream
+ * 
+ * Each instance's vertices and normals are transformed on the CPU with SIMD where
+ * available and streamed into a single RL_TRIANGLES run (plus one RL_LINES run for
+ * wireframe shapes), so the cost grows linearly with the instance count. Call between
+ * BeginMode3D and EndMode3D (or inside a 3D batch).
+ * 
+ * @param spriteTemplate The template to draw
+ * @param transforms One template-to-world transform per instance
+ * @param tints One color per instance multiplied with the shape colors (NULL for none)
+ * @param count Number of instances
+ */
+void Draw3DSpriteInstances(const RayPals3DSpriteTemplate* spriteTemplate, const Matrix* transforms, const Color* tints, int count);
+
+/**
+ * @brief Draws the instances of a template whose bounds intersect a camera's frustum
+ * 
+ * @param spriteTemplate The template to draw
+ * @param transforms One template-to-world transform per instance
+ * @param tints One color per instance multiplied with the shape colors (NULL for none)
+ * @param count Number of instances
+ * @param camera The camera the instances are viewed through
+ * @return The number of instances drawn
+ */
+int Draw3DSpriteInstancesCulled(const RayPals3DSpriteTemplate* spriteTemplate, const Matrix* transforms, const Color* tints, int count, Camera camera);
+
+/**
+ * @brief Transforms one instance of a template with the kernel Draw3DSpriteInstances uses
+ * 
+ * Vertices come out in template order: triangle runs first, then line runs.
+ * 
+ * @param spriteTemplate The template to transform
+ * @param transform The template-to-world transform of the instance
+ * @param positions Receives spriteTemplate->vertexCount world positions (NULL to skip)
+ * @param normals Receives spriteTemplate->vertexCount unit world normals (NULL to skip)
+ * @return The number of vertices written, 0 on failure
+ */
+int Get3DInstanceVertices(const RayPals3DSpriteTemplate* spriteTemplate, Matrix transform, Vector3* positions, Vector3* normals);
+
+/**
+ * @brief Frees an instancing template
+ * 
+ * @param spriteTemplate The template to free
+ */
+void Free3DSpriteTemplate(RayPals3DSpriteTemplate* spriteTemplate);
+
+/**
+ * @brief Checks whether a point lies on the area of a 2D shape
+ * 
+ * The test is exact for the geometry the shape fills: stars and polygons by their
+ * spikes and sides, circles and the round top of water drops by their true curve.
+ * Outlined shapes count as filled, and trees and skeletons use their bounding box.
+ * 
+ * @param point The point, in the space the shape is positioned in
+ * @param shape The shape to test
+ * @return true if the point is on the shape
+ */
+bool CheckCollisionPoint2DShape(Vector2 point, const RayPals2DShape* shape);
+
+/**
+ * @brief Finds the topmost visible shape of a sprite under a point
+ * 
+ * @param sprite The sprite to test
+ * @param point The point in world space, undone through the sprite's transform
+ * @return Index of the last-drawn shape holding the point, or -1 if none does
+ */
+int GetSpriteShapeAtPoint(RayPalsSprite* sprite, Vector2 point);
+
+/**
+ * @brief Finds the topmost visible shape of a sprite instance under a point
+ * 
+ * @param instance The instance to test
+ * @param point The point in world space, undone through the instance's transform
+ * @return Index of the last-drawn template shape holding the point, or -1 if none does
+ */
+int GetSpriteInstanceShapeAtPoint(const RayPalsSpriteInstance* instance, Vector2 point);
+
+/**
+ * @brief Picks the topmost sprite under a point
+ * 
+ * Sprites are assumed to be drawn in array order, so the search runs from the last
+ * one. Sprites whose bounds miss the point are skipped without testing their shapes.
+ * 
+ * @param sprites Array of sprites to search
+ * @param count Number of sprites
+ * @param point The point in world space (e.g. the mouse through GetScreenToWorld2D)
+ * @param shapeIndex Receives the index of the shape hit, or -1 (may be NULL)
+ * @return The sprite hit, or NULL
+ */
+RayPalsSprite* PickSprite(RayPalsSprite** sprites, int count, Vector2 point, int* shapeIndex);
+
+/**
+ * @brief Casts a ray against the exact surface of a 3D shape
+ * 
+ * Cubes are tested as oriented boxes, spheres, cylinders and cones analytically
+ * (caps included), under the shape's rotation and size and the sprite's transform.
+ * The shape's tessellation and visibility are not considered.
+ * 
+ * @param ray The ray to cast; its direction does not need to be normalized
+ * @param shape The shape to test
+ * @param sprite The sprite holding the shape, or NULL for a standalone shape
+ * @return The first hit in front of the ray origin, with distance in world units and
+ *         the surface normal facing the ray
+ */
+RayCollision GetRayCollision3DShape(Ray ray, RayPals3DShape* shape, RayPals3DSprite* sprite);
+
+/**
+ * @brief Casts a ray against the visible shapes of a 3D sprite
+ * 
+ * @param ray The ray to cast; its direction does not need to be normalized
+ * @param sprite The sprite to test
+ * @param shapeIndex Receives the index of the nearest shape hit, or -1 (may be NULL)
+ * @return The nearest hit, as GetRayCollision3DShape reports it
+ */
+RayCollision GetRayCollision3DSprite(Ray ray, RayPals3DSprite* sprite, int* shapeIndex);
+
+/**
+ * @brief Finds the nearest visible sprite shape a ray hits through a BVH
+ * 
+ * Nodes are visited near to far and skipped once they lie beyond the nearest hit, so
+ * only the few sprites along the ray are tested exactly. Call after Refit3DBVH. For a
+ * line of sight check, cast from one point towards the other with maxDistance set to
+ * the distance between them; the view is blocked if a sprite is returned.
+ * 
+ * @param bvh The tree to search
+ * @param ray The ray to cast; its direction does not need to be normalized
+ * @param maxDistance Farthest hit reported, in world units
+ * @param collision Receives the hit (may be NULL)
+ * @param shapeIndex Receives the index of the shape hit within the sprite, or -1 (may be NULL)
+ * @return The sprite hit, or NULL
+ */
+RayPals3DSprite* Raycast3DBVH(const RayPals3DBVH* bvh, Ray ray, float maxDistance, RayCollision* collision, int* shapeIndex);
+
 #ifdef __cplusplus
 }
 #endif
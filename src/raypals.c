@@ -1,8 +1,20 @@
 #include "raypals.h"
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include <math.h>
+#include <limits.h>
 #include <stdio.h>
 #include <time.h>
+#include "raypals_thread.h"
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
 #include "rlgl.h"
 
 // ----------------------------------------------------------------------------
@@ -89,1402 +101,2379 @@ static void DrawWaterDrop(float radius, Color color, bool filled) {
 }
 
 // ----------------------------------------------------------------------------
-// 2D Shape Functions
+// Tessellation shared by the batched and cached drawing paths
 // ----------------------------------------------------------------------------
 
-RayPals2DShape* CreateSquare(Vector2 position, float size, Color color) {
-    RayPals2DShape* shape = (RayPals2DShape*)malloc(sizeof(RayPals2DShape));
-    if (shape == NULL) return NULL;
-    
-    shape->type = RAYPALS_SQUARE;
-    shape->position = position;
-    shape->size = (Vector2){ size, size };
-    shape->rotation = 0.0f;
-    shape->color = color;
-    shape->filled = true;
-    shape->thickness = 2.0f;
-    shape->segments = 0;
-    shape->points = 0;
-    shape->visible = true;
-    
-    return shape;
+#define RAYPALS_DEFAULT_CIRCLE_SEGMENTS 36  // Matches raylib's DrawCircle
+
+// Triangles are emitted in raylib's front-face order for y-down screen space
+static Vector2* EmitUnitTriangle(Vector2* out, Vector2 a, Vector2 b, Vector2 c) {
+    float cross = (b.x - a.x)*(c.y - a.y) - (b.y - a.y)*(c.x - a.x);
+    out[0] = a;
+    if (cross > 0.0f) {
+        out[1] = c;
+        out[2] = b;
+    } else {
+        out[1] = b;
+        out[2] = c;
+    }
+    return out + 3;
 }
 
-RayPals2DShape* CreateRectangle(Vector2 position, Vector2 size, Color color) {
-    RayPals2DShape* shape = (RayPals2DShape*)malloc(sizeof(RayPals2DShape));
-    if (shape == NULL) return NULL;
-    
-    shape->type = RAYPALS_RECTANGLE;
-    shape->position = position;
-    shape->size = size;
-    shape->rotation = 0.0f;
-    shape->color = color;
-    shape->filled = true;
-    shape->thickness = 2.0f;
-    shape->segments = 0;
-    shape->points = 0;
-    shape->visible = true;
+static Vector2* EmitUnitFan(Vector2* out, Vector2 center, float radius, int segments, float startAngle) {
+    float angleStep = 2.0f * PI / segments;
+    Vector2 previous = { center.x + cosf(startAngle) * radius, center.y + sinf(startAngle) * radius };
     
-    return shape;
+    for (int i = 1; i <= segments; i++) {
+        float angle = startAngle + i * angleStep;
+        Vector2 next = { center.x + cosf(angle) * radius, center.y + sinf(angle) * radius };
+        out = EmitUnitTriangle(out, center, previous, next);
+        previous = next;
+    }
+    return out;
 }
 
-RayPals2DShape* CreateCircle(Vector2 position, float radius, Color color) {
-    RayPals2DShape* shape = (RayPals2DShape*)malloc(sizeof(RayPals2DShape));
-    if (shape == NULL) return NULL;
+// Returns the factors that scale unit-space vertices of a shape type to its size.
+// Squares and rectangles use both axes; the other types are drawn from size.x alone.
+static Vector2 GetUnitShapeScale(RayPalsShapeType type, Vector2 size) {
+    if (type == RAYPALS_SQUARE || type == RAYPALS_RECTANGLE) return size;
+    return (Vector2){ size.x, size.x };
+}
+
+// Number of vertices BuildUnitShapeTriangles writes for a filled shape type
+static int GetUnitShapeVertexCount(RayPalsShapeType type, int segments, int points) {
+    switch (type) {
+        case RAYPALS_SQUARE:
+        case RAYPALS_RECTANGLE: return 6;
+        case RAYPALS_CIRCLE: return (segments >= 3 ? segments : RAYPALS_DEFAULT_CIRCLE_SEGMENTS) * 3;
+        case RAYPALS_TRIANGLE: return 3;
+        case RAYPALS_STAR: return (points >= 3 ? points : 5) * 2 * 3;
+        case RAYPALS_POLYGON: return (segments >= 3 ? segments : 3) * 3;
+        case RAYPALS_ARROW: return 9;
+        case RAYPALS_WATER_DROP: return (segments >= 3 ? segments : RAYPALS_DEFAULT_CIRCLE_SEGMENTS) * 3 + 3;
+        default: return 0;
+    }
+}
+
+// Writes the filled triangles of a shape type centered at the origin in unit space
+// (multiply by GetUnitShapeScale), following the geometry Draw2DShape produces.
+// Returns the number of vertices written.
+static int BuildUnitShapeTriangles(RayPalsShapeType type, int segments, int points, Vector2* out) {
+    Vector2* start = out;
     
-    shape->type = RAYPALS_CIRCLE;
-    shape->position = position;
-    shape->size = (Vector2){ radius * 2, radius * 2 };
-    shape->rotation = 0.0f;
-    shape->color = color;
-    shape->filled = true;
-    shape->thickness = 2.0f;
-    shape->segments = 36;  // Default segment count
-    shape->points = 0;
-    shape->visible = true;
+    switch (type) {
+        case RAYPALS_SQUARE:
+        case RAYPALS_RECTANGLE: {
+            Vector2 topLeft = { -0.5f, -0.5f }, topRight = { 0.5f, -0.5f };
+            Vector2 bottomLeft = { -0.5f, 0.5f }, bottomRight = { 0.5f, 0.5f };
+            out = EmitUnitTriangle(out, topLeft, bottomLeft, bottomRight);
+            out = EmitUnitTriangle(out, topLeft, bottomRight, topRight);
+        } break;
+        
+        case RAYPALS_CIRCLE: {
+            int circleSegments = segments >= 3 ? segments : RAYPALS_DEFAULT_CIRCLE_SEGMENTS;
+            out = EmitUnitFan(out, (Vector2){ 0, 0 }, 0.5f, circleSegments, 0.0f);
+        } break;
+        
+        case RAYPALS_TRIANGLE: {
+            out = EmitUnitTriangle(out, (Vector2){ 0, -0.5f }, (Vector2){ -0.5f, 0.5f }, (Vector2){ 0.5f, 0.5f });
+        } break;
+        
+        case RAYPALS_STAR: {
+            int starPoints = points >= 3 ? points : 5;
+            float outerRadius = 0.5f;
+            float innerRadius = outerRadius/3;
+            Vector2 center = { 0, 0 };
+            
+            // Alternate outer and inner vertices, starting at the top point
+            Vector2 previous = { 0, -outerRadius };
+            for (int i = 1; i <= starPoints * 2; i++) {
+                float radius = i % 2 == 0 ? outerRadius : innerRadius;
+                float angle = i * PI / starPoints - PI/2;
+                Vector2 next = { cosf(angle) * radius, sinf(angle) * radius };
+                out = EmitUnitTriangle(out, center, previous, next);
+                previous = next;
+            }
+        } break;
+        
+        case RAYPALS_POLYGON: {
+            out = EmitUnitFan(out, (Vector2){ 0, 0 }, 0.5f, segments >= 3 ? segments : 3, 0.0f);
+        } break;
+        
+        case RAYPALS_ARROW: {
+            // Shaft followed by the head, as in DrawArrow
+            Vector2 topLeft = { -0.5f, -0.1f }, topRight = { 0.5f, -0.1f };
+            Vector2 bottomLeft = { -0.5f, 0.1f }, bottomRight = { 0.5f, 0.1f };
+            out = EmitUnitTriangle(out, topLeft, bottomLeft, bottomRight);
+            out = EmitUnitTriangle(out, topLeft, bottomRight, topRight);
+            out = EmitUnitTriangle(out, (Vector2){ 0.5f, 0 }, (Vector2){ 0.25f, -0.25f }, (Vector2){ 0.25f, 0.25f });
+        } break;
+        
+        case RAYPALS_WATER_DROP: {
+            // Circular top and triangular bottom, as in DrawWaterDrop (radius = size/2)
+            int circleSegments = segments >= 3 ? segments : RAYPALS_DEFAULT_CIRCLE_SEGMENTS;
+            out = EmitUnitFan(out, (Vector2){ 0, -0.15f }, 0.35f, circleSegments, 0.0f);
+            out = EmitUnitTriangle(out, (Vector2){ 0, 0.45f }, (Vector2){ -0.35f, -0.05f }, (Vector2){ 0.35f, -0.05f });
+        } break;
+        
+        default: break;
+    }
     
-    return shape;
+    return (int)(out - start);
 }
 
-RayPals2DShape* CreateTriangle(Vector2 position, float size, Color color) {
-    RayPals2DShape* shape = (RayPals2DShape*)malloc(sizeof(RayPals2DShape));
-    if (shape == NULL) return NULL;
+// ----------------------------------------------------------------------------
+// Memory Management
+// ----------------------------------------------------------------------------
+
+#define RAYPALS_ARENA_DEFAULT_SLAB_SIZE (64*1024)
+#define RAYPALS_ARENA_ALIGNMENT 16
+
+// Slabs are chained in creation order; the usable bytes follow the (aligned) header
+typedef struct RayPalsArenaSlab {
+    struct RayPalsArenaSlab* next;
+    size_t capacity;
+    size_t used;
+} RayPalsArenaSlab;
+
+struct RayPalsArena {
+    RayPalsArenaSlab* firstSlab;
+    RayPalsArenaSlab* currentSlab;  // Slab new allocations are carved from
+    size_t slabSize;
+    size_t bytesUsed;
+};
+
+#define RAYPALS_ARENA_STACK_DEPTH 16  // Nested BeginShapeArena scopes tracked by the stack
+
+// Arena that Create* functions allocate from (NULL means the heap): the top of the
+// BeginShapeArena stack. Scopes nested deeper than the stack are counted in
+// arenaOverflow so their EndShapeArena calls stay balanced; they keep the top arena.
+static RayPalsArena* arenaStack[RAYPALS_ARENA_STACK_DEPTH];
+static int arenaDepth = 0;
+static int arenaOverflow = 0;
+static RayPalsArena* activeArena = NULL;
+
+static size_t AlignArenaSize(size_t size) {
+    return (size + (RAYPALS_ARENA_ALIGNMENT - 1)) & ~(size_t)(RAYPALS_ARENA_ALIGNMENT - 1);
+}
+
+static unsigned char* GetArenaSlabData(RayPalsArenaSlab* slab) {
+    return (unsigned char*)slab + AlignArenaSize(sizeof(RayPalsArenaSlab));
+}
+
+static RayPalsArenaSlab* CreateArenaSlab(size_t capacity) {
+    RayPalsArenaSlab* slab = (RayPalsArenaSlab*)malloc(AlignArenaSize(sizeof(RayPalsArenaSlab)) + capacity);
+    if (slab == NULL) return NULL;
     
-    shape->type = RAYPALS_TRIANGLE;
-    shape->position = position;
-    shape->size = (Vector2){ size, size };
-    shape->rotation = 0.0f;
-    shape->color = color;
-    shape->filled = true;
-    shape->thickness = 2.0f;
-    shape->segments = 0;
-    shape->points = 0;
-    shape->visible = true;
+    slab->next = NULL;
+    slab->capacity = capacity;
+    slab->used = 0;
     
-    return shape;
+    return slab;
 }
 
-RayPals2DShape* CreateStar(Vector2 position, float size, int points, Color color) {
-    RayPals2DShape* shape = (RayPals2DShape*)malloc(sizeof(RayPals2DShape));
-    if (shape == NULL) return NULL;
+static void* ArenaAlloc(RayPalsArena* arena, size_t size) {
+    size = AlignArenaSize(size > 0 ? size : 1);
     
-    // Default to 5 points if invalid value is provided
-    if (points < 3) points = 5;
+    // Walk forward through slabs kept from a previous reset before growing
+    RayPalsArenaSlab* slab = arena->currentSlab;
+    while (slab != NULL && slab->capacity - slab->used < size) {
+        if (slab->next == NULL || slab->next->used != 0) break;
+        slab = slab->next;
+    }
     
-    // Use yellow as default if no color is specified
-    if (color.r == 0 && color.g == 0 && color.b == 0 && color.a == 0) {
-        color = YELLOW;
+    if (slab == NULL || slab->capacity - slab->used < size) {
+        RayPalsArenaSlab* newSlab = CreateArenaSlab(size > arena->slabSize ? size : arena->slabSize);
+        if (newSlab == NULL) return NULL;
+        
+        // Insert after the current slab so reused slabs further down stay reachable
+        if (slab == NULL) {
+            arena->firstSlab = newSlab;
+        } else {
+            newSlab->next = slab->next;
+            slab->next = newSlab;
+        }
+        slab = newSlab;
     }
     
-    shape->type = RAYPALS_STAR;
-    shape->position = position;
-    shape->size = (Vector2){ size, size };
-    shape->rotation = 0.0f;
-    shape->color = color;
-    shape->filled = true;
-    shape->thickness = 2.0f;
-    shape->segments = 0;
-    shape->points = points;
-    shape->visible = true;
+    arena->currentSlab = slab;
     
-    return shape;
+    void* memory = GetArenaSlabData(slab) + slab->used;
+    slab->used += size;
+    arena->bytesUsed += size;
+    
+    memset(memory, 0, size);
+    return memory;
 }
 
-RayPals2DShape* CreatePolygon(Vector2 position, float radius, int sides, Color color) {
-    if (sides < 3) sides = 3; // Minimum 3 sides
-    
-    RayPals2DShape* shape = (RayPals2DShape*)malloc(sizeof(RayPals2DShape));
-    if (shape == NULL) return NULL;
-    
-    shape->type = RAYPALS_POLYGON;
-    shape->position = position;
-    shape->size = (Vector2){ radius * 2, radius * 2 };
-    shape->rotation = 0.0f;
-    shape->color = color;
-    shape->filled = true;
-    shape->thickness = 2.0f;
-    shape->segments = sides;
-    shape->points = sides;
-    shape->visible = true;
+// Allocates zeroed memory from the given arena, or from the heap when arena is NULL
+static void* RayPalsAlloc(RayPalsArena* arena, size_t size) {
+    if (arena != NULL) return ArenaAlloc(arena, size);
+    return calloc(1, size);
+}
+
+// Grows a block; arena blocks are copied since slabs cannot resize in place
+static void* RayPalsRealloc(RayPalsArena* arena, void* memory, size_t oldSize, size_t newSize) {
+    if (arena == NULL) return realloc(memory, newSize);
     
-    return shape;
+    void* newMemory = ArenaAlloc(arena, newSize);
+    if (newMemory != NULL && memory != NULL) {
+        memcpy(newMemory, memory, oldSize < newSize ? oldSize : newSize);
+    }
+    return newMemory;
 }
 
-RayPals2DShape* CreateArrow(Vector2 position, float size, float direction, Color color) {
-    RayPals2DShape* shape = (RayPals2DShape*)malloc(sizeof(RayPals2DShape));
-    if (shape == NULL) return NULL;
+// Releases a block; arena memory is only reclaimed when the arena is reset or freed
+static void RayPalsFree(RayPalsArena* arena, void* memory) {
+    if (arena == NULL) free(memory);
+}
+
+RayPalsArena* CreateShapeArena(size_t slabSize) {
+    RayPalsArena* arena = (RayPalsArena*)calloc(1, sizeof(RayPalsArena));
+    if (arena == NULL) return NULL;
     
-    shape->type = RAYPALS_ARROW;
-    shape->position = position;
-    shape->size = (Vector2){ size, size };
-    shape->rotation = direction;
-    shape->color = color;
-    shape->filled = true;
-    shape->thickness = 2.0f;
-    shape->segments = 0;
-    shape->points = 0;
-    shape->visible = true;
+    arena->slabSize = AlignArenaSize(slabSize > 0 ? slabSize : RAYPALS_ARENA_DEFAULT_SLAB_SIZE);
     
-    return shape;
+    return arena;
 }
 
-RayPals2DShape* CreateWaterDrop(Vector2 position, float size, float rotation, Color color) {
-    RayPals2DShape* shape = (RayPals2DShape*)malloc(sizeof(RayPals2DShape));
-    if (shape == NULL) return NULL;
+void BeginShapeArena(RayPalsArena* arena) {
+    if (arena == NULL) return;
     
-    // Setup basic properties
-    shape->type = RAYPALS_WATER_DROP; // Use water drop type for proper rendering
-    shape->position = position;
-    shape->size = (Vector2){ size, size * 1.5f }; // Water drop is taller than wide
-    shape->rotation = rotation;
-    shape->color = color;
-    shape->filled = true;
-    shape->thickness = 2.0f;
-    shape->segments = 16; // Use enough segments for smooth drop shape
-    shape->points = 0;
-    shape->visible = true;
+    if (arenaDepth == RAYPALS_ARENA_STACK_DEPTH) {
+        arenaOverflow++;
+        return;
+    }
     
-    return shape;
+    // The same arena may be pushed again; each push needs its own EndShapeArena
+    arenaStack[arenaDepth++] = arena;
+    activeArena = arena;
 }
 
-// ----------------------------------------------------------------------------
-// 3D Shape Functions
-// ----------------------------------------------------------------------------
+void EndShapeArena(void) {
+    if (arenaOverflow > 0) {
+        arenaOverflow--;
+        return;
+    }
+    if (arenaDepth == 0) return;
+    
+    arenaDepth--;
+    activeArena = arenaDepth > 0 ? arenaStack[arenaDepth - 1] : NULL;
+}
 
-RayPals3DShape* CreateCube(Vector3 position, Vector3 size, Color color) {
-    RayPals3DShape* shape = (RayPals3DShape*)malloc(sizeof(RayPals3DShape));
-    if (shape == NULL) return NULL;
+void ResetShapeArena(RayPalsArena* arena) {
+    if (arena == NULL) return;
     
-    shape->type = RAYPALS_CUBE;
-    shape->position = position;
-    shape->size = size;
-    shape->rotation = (Vector3){ 0.0f, 0.0f, 0.0f };
-    shape->color = color;
-    shape->wireframe = false;
-    shape->thickness = 2.0f;
-    shape->segments = 0;
-    shape->visible = true;
+    for (RayPalsArenaSlab* slab = arena->firstSlab; slab != NULL; slab = slab->next) {
+        slab->used = 0;
+    }
     
-    return shape;
+    arena->currentSlab = arena->firstSlab;
+    arena->bytesUsed = 0;
 }
 
-RayPals3DShape* CreateSphere(Vector3 position, float radius, int segments, Color color) {
-    RayPals3DShape* shape = (RayPals3DShape*)malloc(sizeof(RayPals3DShape));
-    if (shape == NULL) return NULL;
+size_t GetShapeArenaUsage(const RayPalsArena* arena) {
+    return (arena != NULL) ? arena->bytesUsed : 0;
+}
+
+void FreeShapeArena(RayPalsArena* arena) {
+    if (arena == NULL) return;
     
-    shape->type = RAYPALS_SPHERE;
-    shape->position = position;
-    shape->size = (Vector3){ radius * 2, radius * 2, radius * 2 };
-    shape->rotation = (Vector3){ 0.0f, 0.0f, 0.0f };
-    shape->color = color;
-    shape->wireframe = false;
-    shape->thickness = 2.0f;
-    shape->segments = segments;
-    shape->visible = true;
+    // Never leave a dangling arena on the stack, wherever it was pushed. Its scopes fall
+    // back to the heap so their EndShapeArena calls still pop the right entries.
+    for (int i = 0; i < arenaDepth; i++) {
+        if (arenaStack[i] == arena) arenaStack[i] = NULL;
+    }
+    activeArena = arenaDepth > 0 ? arenaStack[arenaDepth - 1] : NULL;
     
-    return shape;
+    RayPalsArenaSlab* slab = arena->firstSlab;
+    while (slab != NULL) {
+        RayPalsArenaSlab* next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    
+    free(arena);
 }
 
-RayPals3DShape* CreateCone(Vector3 position, float radius, float height, int segments, Color color) {
-    RayPals3DShape* shape = (RayPals3DShape*)malloc(sizeof(RayPals3DShape));
+// Source of shape and sprite versions. Every edit takes a fresh stamp, so a version
+// differs from whatever a cache recorded even when the shape was replaced by another.
+static unsigned int contentStamp = 0;
+
+static unsigned int NextContentStamp(void) {
+    if (++contentStamp == 0) contentStamp = 1;
+    return contentStamp;
+}
+
+// True when stamp a was taken after stamp b; the signed difference keeps the order across wraparound
+static bool IsStampNewer(unsigned int a, unsigned int b) {
+    return (int)(a - b) > 0;
+}
+
+// Every shape and sprite is allocated zeroed through these helpers so that the
+// owning arena is recorded and fields not set by a constructor start out cleared
+static RayPals2DShape* AllocShape2D(void) {
+    RayPals2DShape* shape = (RayPals2DShape*)RayPalsAlloc(activeArena, sizeof(RayPals2DShape));
     if (shape == NULL) return NULL;
     
-    shape->type = RAYPALS_CONE;
-    shape->position = position;
-    shape->size = (Vector3){ radius * 2, height, radius * 2 };
-    shape->rotation = (Vector3){ 0.0f, 0.0f, 0.0f };
-    shape->color = color;
-    shape->wireframe = false;
-    shape->thickness = 2.0f;
-    shape->segments = segments;
-    shape->visible = true;
-    
+    shape->arena = activeArena;
+    shape->version = NextContentStamp();
     return shape;
 }
 
-RayPals3DShape* CreateCylinder(Vector3 position, float radius, float height, int segments, Color color) {
-    RayPals3DShape* shape = (RayPals3DShape*)malloc(sizeof(RayPals3DShape));
+static RayPals3DShape* AllocShape3D(void) {
+    RayPals3DShape* shape = (RayPals3DShape*)RayPalsAlloc(activeArena, sizeof(RayPals3DShape));
     if (shape == NULL) return NULL;
     
-    shape->type = RAYPALS_CYLINDER;
-    shape->position = position;
-    shape->size = (Vector3){ radius * 2, height, radius * 2 };
-    shape->rotation = (Vector3){ 0.0f, 0.0f, 0.0f };
-    shape->color = color;
-    shape->wireframe = false;
-    shape->thickness = 2.0f;
-    shape->segments = segments;
-    shape->visible = true;
-    
+    shape->arena = activeArena;
+    shape->transformDirty = true;
     return shape;
 }
 
 // ----------------------------------------------------------------------------
-// Drawing Functions
+// Sprite Cache Functions
 // ----------------------------------------------------------------------------
 
-void Draw2DShape(RayPals2DShape* shape) {
-    if (!shape || !shape->visible) return;
+static RayPalsLODSettings lodSettings = { false, 0.5f, 1.0f, 6, 128 };
+static unsigned int lodVersion = 1;  // Bumped by SetLODSettings so every cache rebuilds
+
+#define RAYPALS_LOD_OFF INT_MIN      // Bucket of caches built with the shapes' own segment counts
+#define RAYPALS_LOD_MAX_BUCKET 64    // Clamp for extreme scales (half-octave steps)
+
+void SetLODSettings(RayPalsLODSettings settings) {
+    if (settings.tolerance <= 0.0f) settings.tolerance = 0.5f;
+    if (settings.quality <= 0.0f) settings.quality = 1.0f;
+    if (settings.minSegments < 3) settings.minSegments = 3;
+    if (settings.maxSegments < settings.minSegments) settings.maxSegments = settings.minSegments;
     
-    // Save current matrix to restore later
-    rlPushMatrix();
+    lodSettings = settings;
+    lodVersion++;
+}
+
+RayPalsLODSettings GetLODSettings(void) {
+    return lodSettings;
+}
+
+// Largest on-screen distance allowed between a curve and its tessellation
+static float GetLODTolerance(void) {
+    return lodSettings.tolerance / lodSettings.quality;
+}
+
+int GetCircleLODSegments(float screenRadius) {
+    float tolerance = GetLODTolerance();
+    if (!(screenRadius > tolerance)) return lodSettings.minSegments;
     
-    // Translate to position and apply rotation
-    rlTranslatef(shape->position.x, shape->position.y, 0.0f);
-    rlRotatef(shape->rotation, 0.0f, 0.0f, 1.0f);
+    // A chord across 2*PI/n radians stays within r*(1 - cos(PI/n)) of the arc
+    float segments = ceilf(PI / acosf(1.0f - tolerance/screenRadius));
+    if (segments < lodSettings.minSegments) return lodSettings.minSegments;
+    if (segments > lodSettings.maxSegments) return lodSettings.maxSegments;
+    return (int)segments;
+}
+
+// Uniform scale from the current rlgl matrices (e.g. Camera2D zoom and any pushed transform)
+static float GetCurrentViewScale(void) {
+    Matrix view = rlGetMatrixModelview();
+    Matrix transform = rlGetMatrixTransform();
     
-    switch (shape->type) {
-        case RAYPALS_SQUARE:
-        case RAYPALS_RECTANGLE: {
-            float x = -shape->size.x/2;
-            float y = -shape->size.y/2;
-            
-            if (shape->filled) {
-                DrawRectangle(x, y, shape->size.x, shape->size.y, shape->color);
-            } else {
-                DrawRectangleLines(x, y, shape->size.x, shape->size.y, shape->color);
-            }
-        } break;
+    // Upper-left 2x2 of view * transform; the larger axis keeps the estimate conservative
+    float a = view.m0*transform.m0 + view.m4*transform.m1;
+    float b = view.m1*transform.m0 + view.m5*transform.m1;
+    float c = view.m0*transform.m4 + view.m4*transform.m5;
+    float d = view.m1*transform.m4 + view.m5*transform.m5;
+    float scaleX = a*a + b*b;
+    float scaleY = c*c + d*d;
+    
+    return sqrtf(scaleX > scaleY ? scaleX : scaleY);
+}
+
+// Quantizes pixels-per-unit into half-octave buckets so caches only rebuild on real zoom changes
+static int GetLODBucket(float screenScale) {
+    if (!lodSettings.enabled || !(screenScale > 0.0f)) return RAYPALS_LOD_OFF;
+    
+    int bucket = (int)floorf(log2f(screenScale) * 2.0f);
+    if (bucket < -RAYPALS_LOD_MAX_BUCKET) bucket = -RAYPALS_LOD_MAX_BUCKET;
+    if (bucket > RAYPALS_LOD_MAX_BUCKET) bucket = RAYPALS_LOD_MAX_BUCKET;
+    return bucket;
+}
+
+// Pixels per unit used to tessellate a bucket: its upper edge, so the error bound holds
+static float GetLODBucketScale(int bucket) {
+    if (bucket == RAYPALS_LOD_OFF) return 0.0f;
+    return exp2f((bucket + 1) / 2.0f);
+}
+
+// Segments for a circle of the given sprite-space radius: the shape's own count when
+// LOD is off (lodScale 0), otherwise the fewest that respect the tolerance on screen
+static int ChooseCircleSegments(float radius, float lodScale, int segments) {
+    if (lodScale <= 0.0f) return segments >= 3 ? segments : RAYPALS_DEFAULT_CIRCLE_SEGMENTS;
+    return GetCircleLODSegments(radius * lodScale);
+}
+
+// Local-space triangles of every shape in a sprite, rebuilt only when marked dirty or
+// when the LOD bucket changes. Lives in the owner's arena (if any) so ResetShapeArena
+// releases it with the sprite.
+struct RayPalsSpriteCache {
+    Vector2* vertices;         // Triangle vertices in sprite space
+    Color* colors;             // One color per vertex
+    int vertexCount;
+    int vertexCapacity;
+    int shapeCount;            // Number of sprite shapes the cache was built from
+    unsigned int* shapeVersions; // Version of each sprite shape the cache was built from
+    int versionCapacity;
+    unsigned int spriteVersion; // Sprite version the cache was built from
+    int lodBucket;             // LOD bucket the segment counts were chosen for
+    unsigned int lodVersion;   // LOD settings version the cache was built with
+    Rectangle localBounds;     // Sprite-space AABB of the visible shapes
+    Rectangle worldBounds;     // localBounds under the transform below
+    Vector2 boundsPosition;    // Sprite transform worldBounds was computed for
+    float boundsRotation;
+    float boundsScale;
+    bool worldBoundsValid;
+    RayPalsSpriteCache* next;  // Further LOD levels (sprite templates only)
+    RayPalsArena* arena;
+};
+
+#define RAYPALS_CACHE_CHUNK 768  // Vertices submitted per render batch check (whole triangles)
+
+static bool ReserveCacheVertices(RayPalsSpriteCache* cache, int additional) {
+    int required = cache->vertexCount + additional;
+    if (required <= cache->vertexCapacity) return true;
+    
+    int newCapacity = cache->vertexCapacity > 0 ? cache->vertexCapacity * 2 : 64;
+    if (newCapacity < required) newCapacity = required;
+    
+    Vector2* newVertices = (Vector2*)RayPalsRealloc(cache->arena, cache->vertices,
+                            sizeof(Vector2) * cache->vertexCapacity, sizeof(Vector2) * newCapacity);
+    if (newVertices == NULL) return false;
+    cache->vertices = newVertices;
+    
+    Color* newColors = (Color*)RayPalsRealloc(cache->arena, cache->colors,
+                        sizeof(Color) * cache->vertexCapacity, sizeof(Color) * newCapacity);
+    if (newColors == NULL) return false;
+    cache->colors = newColors;
+    
+    cache->vertexCapacity = newCapacity;
+    return true;
+}
+
+// Emits a line segment as a quad of the given width (outlines become triangles too)
+static bool AppendCacheLine(RayPalsSpriteCache* cache, Vector2 a, Vector2 b, float width) {
+    float dx = b.x - a.x;
+    float dy = b.y - a.y;
+    float length = sqrtf(dx*dx + dy*dy);
+    if (length <= 0.0f) return true;
+    if (!ReserveCacheVertices(cache, 6)) return false;
+    
+    float nx = -dy/length * width/2;
+    float ny = dx/length * width/2;
+    Vector2 a0 = { a.x + nx, a.y + ny }, a1 = { a.x - nx, a.y - ny };
+    Vector2 b0 = { b.x + nx, b.y + ny }, b1 = { b.x - nx, b.y - ny };
+    
+    Vector2* out = cache->vertices + cache->vertexCount;
+    out = EmitUnitTriangle(out, a0, a1, b1);
+    EmitUnitTriangle(out, a0, b1, b0);
+    cache->vertexCount += 6;
+    
+    return true;
+}
+
+static bool AppendCacheLoop(RayPalsSpriteCache* cache, const Vector2* points, int count, float width) {
+    for (int i = 0; i < count; i++) {
+        if (!AppendCacheLine(cache, points[i], points[(i + 1) % count], width)) return false;
+    }
+    return true;
+}
+
+static bool AppendCacheCircleLoop(RayPalsSpriteCache* cache, Vector2 center, float radius, int segments, float width) {
+    float angleStep = 2.0f * PI / segments;
+    
+    for (int i = 0; i < segments; i++) {
+        Vector2 a = { center.x + cosf(i * angleStep) * radius, center.y + sinf(i * angleStep) * radius };
+        Vector2 b = { center.x + cosf((i + 1) * angleStep) * radius, center.y + sinf((i + 1) * angleStep) * radius };
+        if (!AppendCacheLine(cache, a, b, width)) return false;
+    }
+    return true;
+}
+
+// Emits the outline of a shape in shape space (unrotated, centered on the origin)
+static bool AppendShapeOutline(RayPalsSpriteCache* cache, const RayPals2DShape* shape, float lodScale) {
+    const float width = 1.0f;  // raylib's *Lines functions draw one unit wide
+    float sx = shape->size.x;
+    float sy = shape->size.y;
+    int circleSegments = ChooseCircleSegments(sx/2, lodScale, shape->segments);
+    
+    switch (shape->type) {
+        case RAYPALS_SQUARE:
+        case RAYPALS_RECTANGLE: {
+            Vector2 corners[4] = { { -sx/2, -sy/2 }, { sx/2, -sy/2 }, { sx/2, sy/2 }, { -sx/2, sy/2 } };
+            return AppendCacheLoop(cache, corners, 4, width);
+        }
         
-        case RAYPALS_CIRCLE: {
-            float radius = shape->size.x/2;
-            
-            if (shape->filled) {
-                DrawCircle(0, 0, radius, shape->color);
-            } else {
-                DrawCircleLines(0, 0, radius, shape->color);
-            }
-        } break;
+        case RAYPALS_CIRCLE:
+            return AppendCacheCircleLoop(cache, (Vector2){ 0, 0 }, sx/2, circleSegments, width);
         
         case RAYPALS_TRIANGLE: {
-            float size = shape->size.x;
-            Vector2 v1 = { 0, -size/2 };
-            Vector2 v2 = { -size/2, size/2 };
-            Vector2 v3 = { size/2, size/2 };
-            
-            if (shape->filled) {
-                DrawTriangle(v1, v2, v3, shape->color);
-            } else {
-                DrawTriangleLines(v1, v2, v3, shape->color);
-            }
-        } break;
+            Vector2 corners[3] = { { 0, -sx/2 }, { -sx/2, sx/2 }, { sx/2, sx/2 } };
+            return AppendCacheLoop(cache, corners, 3, width);
+        }
         
         case RAYPALS_STAR: {
-            float outerRadius = shape->size.x/2;
-            float innerRadius = outerRadius/3;  // Changed from outerRadius/2 to outerRadius/3 for more pronounced points
-            int points = shape->points > 0 ? shape->points : 5;
-            
-            // Draw star using DrawPoly which is more reliable
-            Vector2 starCenter = { 0, 0 };
-            Vector2 starPoints[20]; // Maximum 10 points (2 vertices per point)
-            int vertexCount = points * 2;
-            
-            if (vertexCount > 20) vertexCount = 20; // Safety check
+            int points = shape->points >= 3 ? shape->points : 5;
+            float outerRadius = sx/2;
+            float innerRadius = outerRadius/3;
             
-            // Create vertices for star shape
             for (int i = 0; i < points * 2; i++) {
-                float radius = i % 2 == 0 ? outerRadius : innerRadius;
-                float angle = i * PI / points - PI/2;
-                starPoints[i].x = cosf(angle) * radius;
-                starPoints[i].y = sinf(angle) * radius;
-            }
-            
-            if (shape->filled) {
-                // Draw filled star polygon
-                DrawPoly(starCenter, points * 2, outerRadius, shape->rotation, shape->color);
-                
-                // Draw explicit triangles as a fallback/supplement
-                Vector2 center = { 0, 0 };
-                for (int i = 0; i < points * 2; i+=2) {
-                    int next = (i + 1) % (points * 2);
-                    int nextOuter = (i + 2) % (points * 2);
-                    DrawTriangle(center, starPoints[i], starPoints[next], shape->color);
-                    DrawTriangle(center, starPoints[next], starPoints[nextOuter], shape->color);
-                }
-            } else {
-                // Draw star outline
-                for (int i = 0; i < points * 2; i++) {
-                    int next = (i + 1) % (points * 2);
-                    DrawLineV(starPoints[i], starPoints[next], shape->color);
-                }
+                float angle1 = i * PI / points - PI/2;
+                float angle2 = (i + 1) * PI / points - PI/2;
+                float radius1 = i % 2 == 0 ? outerRadius : innerRadius;
+                float radius2 = i % 2 == 0 ? innerRadius : outerRadius;
+                Vector2 a = { cosf(angle1) * radius1, sinf(angle1) * radius1 };
+                Vector2 b = { cosf(angle2) * radius2, sinf(angle2) * radius2 };
+                if (!AppendCacheLine(cache, a, b, width)) return false;
             }
-        } break;
+            return true;
+        }
         
         case RAYPALS_POLYGON: {
-            float radius = shape->size.x/2;
-            
-            if (shape->filled) {
-                DrawPolygon(radius, shape->segments, shape->color);
-            } else {
-                DrawPolygonLines(radius, shape->segments, shape->color);
-            }
-        } break;
+            int sides = shape->segments >= 3 ? shape->segments : 3;
+            if (lodScale > 0.0f && circleSegments < sides) sides = circleSegments;
+            return AppendCacheCircleLoop(cache, (Vector2){ 0, 0 }, sx/2, sides, width);
+        }
         
         case RAYPALS_ARROW: {
-            float size = shape->size.x;
-            
-            if (shape->filled) {
-                DrawArrow(0, 0, size, shape->rotation, shape->color);
-            } else {
-                DrawArrowLines(0, 0, size, shape->rotation, shape->color);
-            }
-        } break;
+            Vector2 shaft[4] = { { -sx/2, -sx/10 }, { sx/2, -sx/10 }, { sx/2, sx/10 }, { -sx/2, sx/10 } };
+            Vector2 head[3] = { { sx/2, 0 }, { sx/4, -sx/4 }, { sx/4, sx/4 } };
+            return AppendCacheLoop(cache, shaft, 4, width) && AppendCacheLoop(cache, head, 3, width);
+        }
         
         case RAYPALS_WATER_DROP: {
-            float radius = shape->size.x/2;
-            DrawWaterDrop(radius, shape->color, shape->filled);
-        } break;
+            float radius = sx/2;
+            Vector2 tip[3] = { { 0, radius*0.9f }, { -radius*0.7f, -radius*0.1f }, { radius*0.7f, -radius*0.1f } };
+            int dropSegments = ChooseCircleSegments(radius*0.7f, lodScale, RAYPALS_DEFAULT_CIRCLE_SEGMENTS);
+            return AppendCacheCircleLoop(cache, (Vector2){ 0, -radius*0.3f }, radius*0.7f, dropSegments, width) &&
+                   AppendCacheLoop(cache, tip, 3, width);
+        }
         
-        case RAYPALS_SKELETON: {
-            // We'll draw a simple skeleton outline
-            // The actual drawing is a simplified stick figure
-            float width = shape->size.x;
-            float height = shape->size.y;
+        default: return true;
+    }
+}
+
+// Emits the stick figure drawn for RAYPALS_SKELETON in shape space
+static bool AppendSkeleton(RayPalsSpriteCache* cache, const RayPals2DShape* shape, float lodScale) {
+    float w = shape->size.x;
+    float h = shape->size.y;
+    Vector2 skull = { 0, -h*0.35f };
+    float boneWidth = shape->filled ? 1.0f : shape->thickness;
+    int skullSegments = ChooseCircleSegments(w*0.15f, lodScale, RAYPALS_DEFAULT_CIRCLE_SEGMENTS);
+    
+    if (shape->filled) {
+        int vertexCount = skullSegments * 3;
+        if (!ReserveCacheVertices(cache, vertexCount)) return false;
+        EmitUnitFan(cache->vertices + cache->vertexCount, skull, w*0.15f, skullSegments, 0.0f);
+        cache->vertexCount += vertexCount;
+    } else if (!AppendCacheCircleLoop(cache, skull, w*0.15f, skullSegments, 1.0f)) {
+        return false;
+    }
+    
+    Vector2 bones[7][2] = {
+        { { 0, -h*0.2f }, { 0, h*0.2f } },                  // Spine
+        { { -w*0.25f, -h*0.1f }, { w*0.25f, -h*0.1f } },    // Shoulders
+        { { -w*0.25f, h*0.2f }, { w*0.25f, h*0.2f } },      // Hips
+        { { -w*0.25f, -h*0.1f }, { -w*0.4f, 0 } },          // Left arm
+        { { w*0.25f, -h*0.1f }, { w*0.4f, 0 } },            // Right arm
+        { { 0, h*0.2f }, { -w*0.3f, h*0.4f } },             // Left leg
+        { { 0, h*0.2f }, { w*0.3f, h*0.4f } }               // Right leg
+    };
+    
+    for (int i = 0; i < 7; i++) {
+        if (!AppendCacheLine(cache, bones[i][0], bones[i][1], boneWidth)) return false;
+    }
+    return true;
+}
+
+// Appends the triangles of one shape in sprite space, with its color. lodScale is the
+// number of pixels per sprite-space unit to tessellate for, or 0 to keep the shape's
+// own segment counts.
+static bool AppendShapeTessellation(RayPalsSpriteCache* cache, const RayPals2DShape* shape, float lodScale) {
+    int start = cache->vertexCount;
+    
+    if (shape->type == RAYPALS_SKELETON) {
+        if (!AppendSkeleton(cache, shape, lodScale)) return false;
+    } else if (shape->filled) {
+        RayPalsShapeType type = shape->type;
+        int segments = shape->segments;
+        int points = type == RAYPALS_STAR ? shape->points : 0;
+        Vector2 scale = GetUnitShapeScale(type, shape->size);
+        
+        if (lodScale > 0.0f) {
+            float radius = shape->size.x/2;
             
-            // Just draw a skeleton icon (simplified X shape with a circle on top)
-            if (shape->filled) {
-                DrawCircle(0, -height*0.35f, width*0.15f, shape->color); // Skull
-                DrawLine(0, -height*0.2f, 0, height*0.2f, shape->color); // Spine
-                DrawLine(-width*0.25f, -height*0.1f, width*0.25f, -height*0.1f, shape->color); // Shoulders
-                DrawLine(-width*0.25f, height*0.2f, width*0.25f, height*0.2f, shape->color); // Hips
-                DrawLine(-width*0.25f, -height*0.1f, -width*0.4f, 0, shape->color); // Left arm
-                DrawLine(width*0.25f, -height*0.1f, width*0.4f, 0, shape->color); // Right arm
-                DrawLine(0, height*0.2f, -width*0.3f, height*0.4f, shape->color); // Left leg
-                DrawLine(0, height*0.2f, width*0.3f, height*0.4f, shape->color); // Right leg
-            } else {
-                float thickness = shape->thickness;
-                DrawCircleLines(0, -height*0.35f, width*0.15f, shape->color); // Skull
-                DrawLineEx((Vector2){0, -height*0.2f}, (Vector2){0, height*0.2f}, thickness, shape->color); // Spine
-                DrawLineEx((Vector2){-width*0.25f, -height*0.1f}, (Vector2){width*0.25f, -height*0.1f}, thickness, shape->color); // Shoulders
-                DrawLineEx((Vector2){-width*0.25f, height*0.2f}, (Vector2){width*0.25f, height*0.2f}, thickness, shape->color); // Hips
-                DrawLineEx((Vector2){-width*0.25f, -height*0.1f}, (Vector2){-width*0.4f, 0}, thickness, shape->color); // Left arm
-                DrawLineEx((Vector2){width*0.25f, -height*0.1f}, (Vector2){width*0.4f, 0}, thickness, shape->color); // Right arm
-                DrawLineEx((Vector2){0, height*0.2f}, (Vector2){-width*0.3f, height*0.4f}, thickness, shape->color); // Left leg
-                DrawLineEx((Vector2){0, height*0.2f}, (Vector2){width*0.3f, height*0.4f}, thickness, shape->color); // Right leg
+            switch (type) {
+                case RAYPALS_CIRCLE: segments = ChooseCircleSegments(radius, lodScale, segments); break;
+                case RAYPALS_WATER_DROP: segments = ChooseCircleSegments(radius*0.7f, lodScale, segments); break;
+                case RAYPALS_POLYGON: {
+                    int lodSegments = ChooseCircleSegments(radius, lodScale, segments);
+                    if (lodSegments < segments) segments = lodSegments;
+                } break;
+                case RAYPALS_STAR: {
+                    // Spikes shallower than twice the tolerance collapse into a polygon at the
+                    // mean radius, which stays within the tolerance of every tip and notch
+                    float spikeDepth = radius*2/3;
+                    if (spikeDepth * lodScale <= 2.0f * GetLODTolerance()) {
+                        type = RAYPALS_POLYGON;
+                        segments = ChooseCircleSegments(radius*2/3, lodScale, segments);
+                        points = 0;
+                        scale = (Vector2){ shape->size.x*2/3, shape->size.x*2/3 };
+                    }
+                } break;
+                default: break;
             }
-        } break;
+        }
         
-        default: break;
+        int vertexCount = GetUnitShapeVertexCount(type, segments, points);
+        if (!ReserveCacheVertices(cache, vertexCount)) return false;
+        
+        Vector2* vertices = cache->vertices + start;
+        cache->vertexCount += BuildUnitShapeTriangles(type, segments, points, vertices);
+        
+        for (int i = 0; i < cache->vertexCount - start; i++) {
+            vertices[i].x *= scale.x;
+            vertices[i].y *= scale.y;
+        }
+    } else if (!AppendShapeOutline(cache, shape, lodScale)) {
+        return false;
     }
     
-    // Restore matrix
-    rlPopMatrix();
+    // Move from shape space into sprite space
+    float cosine = cosf(shape->rotation * DEG2RAD);
+    float sine = sinf(shape->rotation * DEG2RAD);
+    
+    for (int i = start; i < cache->vertexCount; i++) {
+        Vector2 v = cache->vertices[i];
+        cache->vertices[i].x = shape->position.x + v.x*cosine - v.y*sine;
+        cache->vertices[i].y = shape->position.y + v.x*sine + v.y*cosine;
+        cache->colors[i] = shape->color;
+    }
+    
+    return true;
 }
 
-// Draw a 3D shape
-// If camera is NULL, assumes transformations are already set (e.g., called from Draw3DSprite)
-// If camera is provided, wraps drawing in BeginMode3D/EndMode3D
-void Draw3DShape(RayPals3DShape* shape, Camera *camera) { // Changed to Camera pointer
-    if (!shape || !shape->visible) return;
-
-    bool calledDirectly = (camera != NULL);
+static void FreeSpriteCache(RayPalsSpriteCache* cache) {
+    while (cache != NULL) {
+        RayPalsSpriteCache* next = cache->next;
+        RayPalsFree(cache->arena, cache->vertices);
+        RayPalsFree(cache->arena, cache->colors);
+        RayPalsFree(cache->arena, cache->shapeVersions);
+        RayPalsFree(cache->arena, cache);
+        cache = next;
+    }
+}
 
-    if (calledDirectly) {
-        BeginMode3D(*camera);
+// Extent of a shape around its own origin before rotation, including outline width
+static Rectangle GetShapeLocalExtents(const RayPals2DShape* shape) {
+    float sx = shape->size.x;
+    float sy = shape->size.y;
+    Rectangle extents;
+    
+    switch (shape->type) {
+        case RAYPALS_SQUARE:
+        case RAYPALS_RECTANGLE: extents = (Rectangle){ -sx/2, -sy/2, sx, sy }; break;
+        case RAYPALS_ARROW: extents = (Rectangle){ -sx/2, -sx/4, sx, sx/2 }; break;
+        case RAYPALS_WATER_DROP: extents = (Rectangle){ -sx*0.35f, -sx*0.5f, sx*0.7f, sx*0.95f }; break;
+        case RAYPALS_SKELETON: {
+            float top = -sy*0.35f - sx*0.15f;
+            extents = (Rectangle){ -sx*0.4f, top, sx*0.8f, sy*0.4f - top };
+        } break;
+        default: extents = (Rectangle){ -sx/2, -sx/2, sx, sx }; break;  // Circle, triangle, star, polygon
     }
+    
+    float pad = 0.0f;
+    if (shape->type == RAYPALS_SKELETON) pad = (!shape->filled && shape->thickness > 1.0f) ? shape->thickness/2 : 0.5f;
+    else if (!shape->filled) pad = 0.5f;
+    
+    return (Rectangle){ extents.x - pad, extents.y - pad, extents.width + 2*pad, extents.height + 2*pad };
+}
 
-    rlPushMatrix();
+// Axis-aligned box around a rectangle after rotation (degrees), scale and translation
+static Rectangle TransformBounds(Rectangle bounds, Vector2 translation, float rotation, float scale) {
+    float cosine = cosf(rotation * DEG2RAD) * scale;
+    float sine = sinf(rotation * DEG2RAD) * scale;
+    Vector2 corners[4] = {
+        { bounds.x, bounds.y }, { bounds.x + bounds.width, bounds.y },
+        { bounds.x, bounds.y + bounds.height }, { bounds.x + bounds.width, bounds.y + bounds.height }
+    };
     
-    // Apply shape transformations (relative to current matrix state)
-    rlTranslatef(shape->position.x, shape->position.y, shape->position.z);
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (int i = 0; i < 4; i++) {
+        float x = translation.x + corners[i].x*cosine - corners[i].y*sine;
+        float y = translation.y + corners[i].x*sine + corners[i].y*cosine;
+        if (x < minX) minX = x;
+        if (x > maxX) maxX = x;
+        if (y < minY) minY = y;
+        if (y > maxY) maxY = y;
+    }
     
-    // Apply rotations in order: Y (yaw), X (pitch), Z (roll)
-    rlRotatef(shape->rotation.y, 0.0f, 1.0f, 0.0f);
-    rlRotatef(shape->rotation.x, 1.0f, 0.0f, 0.0f);
-    rlRotatef(shape->rotation.z, 0.0f, 0.0f, 1.0f);
+    return (Rectangle){ minX, minY, maxX - minX, maxY - minY };
+}
+
+// Sprite-space bounds of the visible shapes (zero-sized at the origin if none are visible)
+static Rectangle ComputeShapesBounds(RayPals2DShape** shapes, const RayPals2DShape* shapeValues, int count) {
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
     
-    switch (shape->type) {
-        case RAYPALS_CUBE:
-            if (shape->wireframe)
-                DrawCubeWiresV((Vector3){ 0.0f, 0.0f, 0.0f }, shape->size, shape->color); // Use literal Vector3 zero
-            else
-                DrawCubeV((Vector3){ 0.0f, 0.0f, 0.0f }, shape->size, shape->color); // Use literal Vector3 zero
-            break;
-        case RAYPALS_SPHERE:
-            if (shape->wireframe)
-                DrawSphereWires((Vector3){ 0.0f, 0.0f, 0.0f }, shape->size.x / 2.0f, shape->segments, shape->segments, shape->color); // Use literal Vector3 zero
-            else
-                DrawSphereEx((Vector3){ 0.0f, 0.0f, 0.0f }, shape->size.x / 2.0f, shape->segments, shape->segments, shape->color); // Use literal Vector3 zero
-            break;
-        case RAYPALS_CONE:
-            // Draw cone using DrawCylinder with top radius 0
-            if (shape->wireframe)
-                DrawCylinderWires((Vector3){ 0.0f, 0.0f, 0.0f }, 0.0f, shape->size.x / 2.0f, shape->size.y, shape->segments, shape->color); // Use DrawCylinderWires
-            else
-                DrawCylinder((Vector3){ 0.0f, 0.0f, 0.0f }, 0.0f, shape->size.x / 2.0f, shape->size.y, shape->segments, shape->color); // Use DrawCylinder
-            break;
-        case RAYPALS_CYLINDER:
-            if (shape->wireframe)
-                DrawCylinderWires((Vector3){ 0.0f, 0.0f, 0.0f }, shape->size.x / 2.0f, shape->size.x / 2.0f, shape->size.y, shape->segments, shape->color); // Use literal Vector3 zero
-            else
-                DrawCylinder((Vector3){ 0.0f, 0.0f, 0.0f }, shape->size.x / 2.0f, shape->size.x / 2.0f, shape->size.y, shape->segments, shape->color); // Use literal Vector3 zero
-            break;
-        default:
-            // Unknown or unsupported 3D shape type
-            break;
+    for (int i = 0; i < count; i++) {
+        const RayPals2DShape* shape = shapes != NULL ? shapes[i] : &shapeValues[i];
+        if (!shape->visible) continue;
+        
+        Rectangle box = TransformBounds(GetShapeLocalExtents(shape), shape->position, shape->rotation, 1.0f);
+        if (box.x < minX) minX = box.x;
+        if (box.y < minY) minY = box.y;
+        if (box.x + box.width > maxX) maxX = box.x + box.width;
+        if (box.y + box.height > maxY) maxY = box.y + box.height;
     }
+    
+    if (minX > maxX) return (Rectangle){ 0, 0, 0, 0 };
+    return (Rectangle){ minX, minY, maxX - minX, maxY - minY };
+}
 
-    rlPopMatrix();
+static bool BoundsOverlap(Rectangle a, Rectangle b) {
+    return a.x <= b.x + b.width && b.x <= a.x + a.width &&
+           a.y <= b.y + b.height && b.y <= a.y + a.height;
+}
 
-    if (calledDirectly) {
-        EndMode3D();
+// Tessellates shapes (given as pointers, or by value when shapes is NULL) into a cache
+// for an LOD bucket, creating the cache on first use
+static bool RebuildShapeCache(RayPalsSpriteCache** cacheRef, RayPalsArena* arena, RayPals2DShape** shapes,
+                              const RayPals2DShape* shapeValues, int count, int lodBucket) {
+    if (*cacheRef == NULL) {
+        *cacheRef = (RayPalsSpriteCache*)RayPalsAlloc(arena, sizeof(RayPalsSpriteCache));
+        if (*cacheRef == NULL) return false;
+        (*cacheRef)->arena = arena;
+    }
+    
+    RayPalsSpriteCache* cache = *cacheRef;
+    float lodScale = GetLODBucketScale(lodBucket);
+    cache->vertexCount = 0;
+    cache->shapeCount = -1;  // Keeps the cache stale if tessellation fails part way
+    
+    for (int i = 0; i < count; i++) {
+        const RayPals2DShape* shape = shapes != NULL ? shapes[i] : &shapeValues[i];
+        if (!shape->visible) continue;
+        if (!AppendShapeTessellation(cache, shape, lodScale)) return false;
+    }
+    
+    // Shapes given by value belong to immutable templates and need no versions
+    if (shapes != NULL) {
+        if (count > cache->versionCapacity) {
+            unsigned int* versions = (unsigned int*)RayPalsRealloc(cache->arena, cache->shapeVersions,
+                                     sizeof(unsigned int) * cache->versionCapacity, sizeof(unsigned int) * count);
+            if (versions == NULL) return false;
+            cache->shapeVersions = versions;
+            cache->versionCapacity = count;
+        }
+        for (int i = 0; i < count; i++) cache->shapeVersions[i] = shapes[i]->version;
     }
+    
+    cache->shapeCount = count;
+    cache->lodBucket = lodBucket;
+    cache->lodVersion = lodVersion;
+    cache->localBounds = ComputeShapesBounds(shapes, shapeValues, count);
+    cache->worldBoundsValid = false;
+    return true;
 }
 
-// ----------------------------------------------------------------------------
-// Utility Functions
-// ----------------------------------------------------------------------------
+static bool IsCacheLODCurrent(const RayPalsSpriteCache* cache, int lodBucket) {
+    return cache->lodBucket == lodBucket && (lodBucket == RAYPALS_LOD_OFF || cache->lodVersion == lodVersion);
+}
 
-void SetShapeColor(RayPals2DShape* shape, Color color) {
-    if (shape) shape->color = color;
+// Compares versions rather than consuming one-shot flags, so a shape shared by several
+// sprites invalidates each of their caches, and reading the cache never hides an edit
+static bool IsSpriteCacheStale(const RayPalsSprite* sprite) {
+    const RayPalsSpriteCache* cache = sprite->cache;
+    if (cache == NULL || cache->spriteVersion != sprite->version || cache->shapeCount != sprite->shapeCount) return true;
+    
+    for (int i = 0; i < sprite->shapeCount; i++) {
+        if (sprite->shapes[i]->version != cache->shapeVersions[i]) return true;
+    }
+    return false;
 }
 
-void Set3DShapeColor(RayPals3DShape* shape, Color color) {
-    if (shape) shape->color = color;
+// The newest stamp among the sprite and its shapes, so it moves on every edit to any of them
+static unsigned int GetSpriteContentVersion(const RayPalsSprite* sprite) {
+    unsigned int version = sprite->version;
+    for (int i = 0; i < sprite->shapeCount; i++) {
+        if (IsStampNewer(sprite->shapes[i]->version, version)) version = sprite->shapes[i]->version;
+    }
+    return version;
 }
 
-void SetShapeRotation(RayPals2DShape* shape, float rotation) {
-    if (shape) shape->rotation = rotation;
+// Rebuilds the sprite's cached tessellation if anything changed since the last draw
+// or if it was built for another LOD bucket
+static bool UpdateSpriteCache(RayPalsSprite* sprite, int lodBucket) {
+    if (!IsSpriteCacheStale(sprite) && IsCacheLODCurrent(sprite->cache, lodBucket)) return true;
+    
+    if (!RebuildShapeCache(&sprite->cache, sprite->arena, sprite->shapes, NULL, sprite->shapeCount, lodBucket)) return false;
+    
+    sprite->cache->spriteVersion = sprite->version;
+    return true;
 }
 
-void Set3DShapeRotation(RayPals3DShape* shape, Vector3 rotation) {
-    if (shape) shape->rotation = rotation;
+static Color TintColor(Color color, Color tint) {
+    return (Color){
+        (unsigned char)((color.r * tint.r) / 255),
+        (unsigned char)((color.g * tint.g) / 255),
+        (unsigned char)((color.b * tint.b) / 255),
+        (unsigned char)((color.a * tint.a) / 255)
+    };
 }
 
-void SetShapePosition(RayPals2DShape* shape, Vector2 position) {
-    if (shape) shape->position = position;
+static RayPalsDrawStats drawStats = { 0 };
+
+// rlCheckRenderBatchLimit that counts the flushes it triggers
+static void CheckRenderBatchLimit(int vertexCount) {
+    if (rlCheckRenderBatchLimit(vertexCount)) drawStats.flushes++;
 }
 
-void Set3DShapePosition(RayPals3DShape* shape, Vector3 position) {
-    if (shape) shape->position = position;
+// 2D sprite transform as a matrix: rotation (degrees) and uniform scale, then position
+static Matrix MakeSpriteMatrix(Vector2 position, float rotation, float scale) {
+    float a = cosf(rotation * DEG2RAD) * scale;
+    float b = sinf(rotation * DEG2RAD) * scale;
+    
+    Matrix result = { 0 };
+    result.m0 = a;   result.m4 = -b;  result.m12 = position.x;
+    result.m1 = b;   result.m5 = a;   result.m13 = position.y;
+    result.m10 = 1.0f;
+    result.m15 = 1.0f;
+    return result;
 }
 
-void RotateShape(RayPals2DShape* shape, float deltaTime, float speed) {
-    if (!shape) return;
-    
-    // Update rotation based on speed and delta time
-    shape->rotation += speed * deltaTime;
-    
-    // Normalize rotation to 0-360 degrees
-    while (shape->rotation >= 360.0f) shape->rotation -= 360.0f;
-    while (shape->rotation < 0.0f) shape->rotation += 360.0f;
+// The matrix also remembers the fields it was built from, so direct writes to position,
+// rotation or scale rebuild it just like the setters do
+static const Matrix* RefreshSpriteMatrix(RayPalsSprite* sprite) {
+    if (sprite->transformDirty || sprite->position.x != sprite->matrixPosition.x || sprite->position.y != sprite->matrixPosition.y ||
+        sprite->rotation != sprite->matrixRotation || sprite->scale != sprite->matrixScale) {
+        sprite->worldMatrix = MakeSpriteMatrix(sprite->position, sprite->rotation, sprite->scale);
+        sprite->matrixPosition = sprite->position;
+        sprite->matrixRotation = sprite->rotation;
+        sprite->matrixScale = sprite->scale;
+        sprite->transformDirty = false;
+    }
+    return &sprite->worldMatrix;
 }
 
-void Rotate3DShape(RayPals3DShape* shape, float deltaTime, Vector3 speed) {
-    if (!shape) return;
-    
-    // Update rotation based on speed and delta time
-    shape->rotation.x += speed.x * deltaTime;
-    shape->rotation.y += speed.y * deltaTime;
-    shape->rotation.z += speed.z * deltaTime;
+// Emits cached triangles into an open RL_TRIANGLES run, transforming them on the CPU
+// by the 2D part of transform and multiplying every color by tint (WHITE leaves the
+// colors unchanged)
+static void EmitSpriteCache(const RayPalsSpriteCache* cache, const Matrix* transform, Color tint) {
+    if (cache->vertexCount == 0) return;
     
-    // Normalize rotation to 0-360 degrees
-    while (shape->rotation.x >= 360.0f) shape->rotation.x -= 360.0f;
-    while (shape->rotation.x < 0.0f) shape->rotation.x += 360.0f;
+    bool tinting = !ColorIsEqual(tint, WHITE);
+    float a = transform->m0, b = transform->m1, c = transform->m4, d = transform->m5;
+    Vector2 position = { transform->m12, transform->m13 };
     
-    while (shape->rotation.y >= 360.0f) shape->rotation.y -= 360.0f;
-    while (shape->rotation.y < 0.0f) shape->rotation.y += 360.0f;
+    for (int base = 0; base < cache->vertexCount; base += RAYPALS_CACHE_CHUNK) {
+        int end = base + RAYPALS_CACHE_CHUNK;
+        if (end > cache->vertexCount) end = cache->vertexCount;
+        
+        // Flushes the rlgl buffer between whole triangles if this chunk would overflow it
+        CheckRenderBatchLimit(end - base);
+        
+        Color current = cache->colors[base];
+        Color tinted = tinting ? TintColor(current, tint) : current;
+        rlColor4ub(tinted.r, tinted.g, tinted.b, tinted.a);
+        
+        for (int i = base; i < end; i++) {
+            Color color = cache->colors[i];
+            if (color.r != current.r || color.g != current.g || color.b != current.b || color.a != current.a) {
+                current = color;
+                tinted = tinting ? TintColor(current, tint) : current;
+                rlColor4ub(tinted.r, tinted.g, tinted.b, tinted.a);
+            }
+            Vector2 v = cache->vertices[i];
+            rlVertex2f(position.x + a*v.x + c*v.y, position.y + b*v.x + d*v.y);
+        }
+    }
     
-    while (shape->rotation.z >= 360.0f) shape->rotation.z -= 360.0f;
-    while (shape->rotation.z < 0.0f) shape->rotation.z += 360.0f;
+    drawStats.vertices += cache->vertexCount;
 }
 
-void UpdateShapeAnimation(RayPals2DShape* shape, RayPalsAnimation* animation, float deltaTime) {
-    if (!shape || !animation || !animation->isAnimated) return;
-    
-    // Update animation time
-    animation->animationTime += deltaTime * animation->animationSpeed;
-    
-    // Calculate animation factor (0.0 to 1.0)
-    float factor = sinf(animation->animationTime);
-    if (animation->pingPong) {
-        factor = (factor + 1.0f) / 2.0f;  // Convert to 0.0 - 1.0 range
-    } else {
-        // For non-pingpong animations, use absolute value to create a more pronounced effect
-        factor = fabsf(factor);
-    }
-    
-    // Apply rotation if rotation speed is not zero
-    if (animation->rotationSpeed != 0) {
-        shape->rotation += animation->rotationSpeed * deltaTime;
-        
-        // Normalize rotation to 0-360 degrees
-        while (shape->rotation >= 360.0f) shape->rotation -= 360.0f;
-        while (shape->rotation < 0.0f) shape->rotation += 360.0f;
-    }
-    
-    // Apply scale if min/max are different
-    if (animation->scaleMin != animation->scaleMax) {
-        // Store the original size if not already stored
-        if (animation->originalWidth == 0 && animation->originalHeight == 0) {
-            animation->originalWidth = shape->size.x;
-            animation->originalHeight = shape->size.y;
-        }
-        
-        float scale = animation->scaleMin + factor * (animation->scaleMax - animation->scaleMin);
-        
-        // Apply scale to the original size, not the current size
-        shape->size.x = animation->originalWidth * scale;
-        shape->size.y = animation->originalHeight * scale;
-    }
-    
-    // Apply color transition if colors are different
-    if (!ColorIsEqual(animation->colorStart, animation->colorEnd)) {
-        shape->color.r = (unsigned char)(animation->colorStart.r + factor * (animation->colorEnd.r - animation->colorStart.r));
-        shape->color.g = (unsigned char)(animation->colorStart.g + factor * (animation->colorEnd.g - animation->colorStart.g));
-        shape->color.b = (unsigned char)(animation->colorStart.b + factor * (animation->colorEnd.b - animation->colorStart.b));
-        shape->color.a = (unsigned char)(animation->colorStart.a + factor * (animation->colorEnd.a - animation->colorStart.a));
-    }
-}
-
-void Update3DShapeAnimation(RayPals3DShape* shape, RayPalsAnimation* animation, float deltaTime) {
-    if (!shape || !animation || !animation->isAnimated) return;
-    
-    // Update animation time
-    animation->animationTime += deltaTime * animation->animationSpeed;
-    
-    // Calculate animation factor (0.0 to 1.0)
-    float factor = sinf(animation->animationTime);
-    if (animation->pingPong) {
-        factor = (factor + 1.0f) / 2.0f;  // Convert to 0.0 - 1.0 range
-    } else {
-        // For non-pingpong animations, use absolute value for more pronounced effect
-        factor = fabsf(factor);
-    }
-    
-    // Apply rotation if rotation speed is not zero
-    if (animation->rotationSpeed != 0) {
-        shape->rotation.y += animation->rotationSpeed * deltaTime;
-        
-        // Normalize rotation
-        while (shape->rotation.y >= 360.0f) shape->rotation.y -= 360.0f;
-        while (shape->rotation.y < 0.0f) shape->rotation.y += 360.0f;
-    }
-    
-    // Apply scale if min/max are different
-    if (animation->scaleMin != animation->scaleMax) {
-        // Store the original size if not already stored
-        if (animation->originalWidth == 0) {
-            animation->originalWidth = shape->size.x;
-            animation->originalHeight = shape->size.y;
-            animation->originalDepth = shape->size.z;
-        }
-        
-        float scale = animation->scaleMin + factor * (animation->scaleMax - animation->scaleMin);
-        
-        // Apply scale to the original size, not the current size
-        shape->size.x = animation->originalWidth * scale;
-        shape->size.y = animation->originalHeight * scale;
-        shape->size.z = animation->originalDepth * scale;
-    }
+// Streams cached triangles under the current matrix in one rlBegin/rlEnd run
+static void DrawSpriteCache(const RayPalsSpriteCache* cache, Color tint) {
+    rlBegin(RL_TRIANGLES);
+    Matrix identity = MakeSpriteMatrix((Vector2){ 0, 0 }, 0.0f, 1.0f);
+    EmitSpriteCache(cache, &identity, tint);
+    rlEnd();
     
-    // Apply color transition if colors are different
-    if (!ColorIsEqual(animation->colorStart, animation->colorEnd)) {
-        shape->color.r = (unsigned char)(animation->colorStart.r + factor * (animation->colorEnd.r - animation->colorStart.r));
-        shape->color.g = (unsigned char)(animation->colorStart.g + factor * (animation->colorEnd.g - animation->colorStart.g));
-        shape->color.b = (unsigned char)(animation->colorStart.b + factor * (animation->colorEnd.b - animation->colorStart.b));
-        shape->color.a = (unsigned char)(animation->colorStart.a + factor * (animation->colorEnd.a - animation->colorStart.a));
-    }
-}
-
-void FreeShape(RayPals2DShape* shape) {
-    if (shape) {
-        free(shape);
-    }
-}
-
-void Free3DShape(RayPals3DShape* shape) {
-    if (shape) {
-        free(shape);
-    }
+    drawStats.batches++;
 }
 
 // ----------------------------------------------------------------------------
-// Sprite Functions
+// 2D Shape Functions
 // ----------------------------------------------------------------------------
 
-RayPalsSprite* CreateSprite(int initialCapacity) {
-    RayPalsSprite* sprite = (RayPalsSprite*)malloc(sizeof(RayPalsSprite));
-    if (sprite == NULL) return NULL;
-    
-    sprite->shapes = (RayPals2DShape**)malloc(sizeof(RayPals2DShape*) * initialCapacity);
-    if (sprite->shapes == NULL) {
-        free(sprite);
-        return NULL;
-    }
+RayPals2DShape* CreateSquare(Vector2 position, float size, Color color) {
+    RayPals2DShape* shape = AllocShape2D();
+    if (shape == NULL) return NULL;
     
-    sprite->shapeCount = 0;
-    sprite->position = (Vector2){ 0, 0 };
-    sprite->rotation = 0.0f;
-    sprite->scale = 1.0f;
-    sprite->visible = true;
+    shape->type = RAYPALS_SQUARE;
+    shape->position = position;
+    shape->size = (Vector2){ size, size };
+    shape->rotation = 0.0f;
+    shape->color = color;
+    shape->filled = true;
+    shape->thickness = 2.0f;
+    shape->segments = 0;
+    shape->points = 0;
+    shape->visible = true;
     
-    return sprite;
+    return shape;
 }
 
-void AddShapeToSprite(RayPalsSprite* sprite, RayPals2DShape* shape) {
-    if (!sprite || !shape) return;
+RayPals2DShape* CreateRectangle(Vector2 position, Vector2 size, Color color) {
+    RayPals2DShape* shape = AllocShape2D();
+    if (shape == NULL) return NULL;
     
-    // Resize the array if needed (simple implementation, not optimized)
-    RayPals2DShape** newShapes = (RayPals2DShape**)realloc(sprite->shapes, 
-                                  sizeof(RayPals2DShape*) * (sprite->shapeCount + 1));
-    if (newShapes == NULL) return;
+    shape->type = RAYPALS_RECTANGLE;
+    shape->position = position;
+    shape->size = size;
+    shape->rotation = 0.0f;
+    shape->color = color;
+    shape->filled = true;
+    shape->thickness = 2.0f;
+    shape->segments = 0;
+    shape->points = 0;
+    shape->visible = true;
     
-    sprite->shapes = newShapes;
-    sprite->shapes[sprite->shapeCount] = shape;
-    sprite->shapeCount++;
+    return shape;
 }
 
-RayPalsSprite* CreateSimpleCharacter(Vector2 position, float size, Color bodyColor, Color headColor) {
-    RayPalsSprite* sprite = CreateSprite(2);
-    if (sprite == NULL) return NULL;
-    
-    // Create body (circle)
-    RayPals2DShape* body = CreateCircle((Vector2){ 0, size/4 }, size/2, bodyColor);
-    if (body == NULL) {
-        FreeSprite(sprite);
-        return NULL;
-    }
+RayPals2DShape* CreateCircle(Vector2 position, float radius, Color color) {
+    RayPals2DShape* shape = AllocShape2D();
+    if (shape == NULL) return NULL;
     
-    // Create head (circle)
-    RayPals2DShape* head = CreateCircle((Vector2){ 0, -size/2 }, size/3, headColor);
-    if (head == NULL) {
-        FreeShape(body);
-        FreeSprite(sprite);
-        return NULL;
-    }
+    shape->type = RAYPALS_CIRCLE;
+    shape->position = position;
+    shape->size = (Vector2){ radius * 2, radius * 2 };
+    shape->rotation = 0.0f;
+    shape->color = color;
+    shape->filled = true;
+    shape->thickness = 2.0f;
+    shape->segments = 36;  // Default segment count
+    shape->points = 0;
+    shape->visible = true;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, head);
+    return shape;
+}
+
+RayPals2DShape* CreateTriangle(Vector2 position, float size, Color color) {
+    RayPals2DShape* shape = AllocShape2D();
+    if (shape == NULL) return NULL;
     
-    // Set sprite position
-    sprite->position = position;
+    shape->type = RAYPALS_TRIANGLE;
+    shape->position = position;
+    shape->size = (Vector2){ size, size };
+    shape->rotation = 0.0f;
+    shape->color = color;
+    shape->filled = true;
+    shape->thickness = 2.0f;
+    shape->segments = 0;
+    shape->points = 0;
+    shape->visible = true;
     
-    return sprite;
+    return shape;
 }
 
-RayPalsSprite* CreateSimpleTree(Vector2 position, float size, Color trunkColor, Color leafColor) {
-    RayPalsSprite* sprite = CreateSprite(2);
-    if (sprite == NULL) return NULL;
+RayPals2DShape* CreateStar(Vector2 position, float size, int points, Color color) {
+    RayPals2DShape* shape = AllocShape2D();
+    if (shape == NULL) return NULL;
     
-    // Create trunk (rectangle)
-    RayPals2DShape* trunk = CreateRectangle((Vector2){ 0, size/4 }, (Vector2){ size/5, size/2 }, trunkColor);
-    if (trunk == NULL) {
-        FreeSprite(sprite);
-        return NULL;
-    }
+    // Default to 5 points if invalid value is provided
+    if (points < 3) points = 5;
     
-    // Create leaves (triangle)
-    RayPals2DShape* leaves = CreateTriangle((Vector2){ 0, -size/3 }, size, leafColor);
-    if (leaves == NULL) {
-        FreeShape(trunk);
-        FreeSprite(sprite);
-        return NULL;
+    // Use yellow as default if no color is specified
+    if (color.r == 0 && color.g == 0 && color.b == 0 && color.a == 0) {
+        color = YELLOW;
     }
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, trunk);
-    AddShapeToSprite(sprite, leaves);
-    
-    // Set sprite position
-    sprite->position = position;
+    shape->type = RAYPALS_STAR;
+    shape->position = position;
+    shape->size = (Vector2){ size, size };
+    shape->rotation = 0.0f;
+    shape->color = color;
+    shape->filled = true;
+    shape->thickness = 2.0f;
+    shape->segments = 0;
+    shape->points = points;
+    shape->visible = true;
     
-    return sprite;
+    return shape;
 }
 
-RayPalsSprite* CreateCloud(Vector2 position, float size, Color color) {
-    RayPalsSprite* sprite = CreateSprite(4);
-    if (sprite == NULL) return NULL;
+RayPals2DShape* CreatePolygon(Vector2 position, float radius, int sides, Color color) {
+    if (sides < 3) sides = 3; // Minimum 3 sides
     
-    // Create cloud circles
-    RayPals2DShape* cloud1 = CreateCircle((Vector2){ -size/3, 0 }, size/3, color);
-    RayPals2DShape* cloud2 = CreateCircle((Vector2){ 0, -size/4 }, size/2.5f, color);
-    RayPals2DShape* cloud3 = CreateCircle((Vector2){ size/3, 0 }, size/3, color);
-    RayPals2DShape* cloud4 = CreateCircle((Vector2){ 0, size/8 }, size/3, color);
+    RayPals2DShape* shape = AllocShape2D();
+    if (shape == NULL) return NULL;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, cloud1);
-    AddShapeToSprite(sprite, cloud2);
-    AddShapeToSprite(sprite, cloud3);
-    AddShapeToSprite(sprite, cloud4);
-    
-    // Set sprite position
-    sprite->position = position;
+    shape->type = RAYPALS_POLYGON;
+    shape->position = position;
+    shape->size = (Vector2){ radius * 2, radius * 2 };
+    shape->rotation = 0.0f;
+    shape->color = color;
+    shape->filled = true;
+    shape->thickness = 2.0f;
+    shape->segments = sides;
+    shape->points = sides;
+    shape->visible = true;
     
-    return sprite;
+    return shape;
 }
 
-RayPalsSprite* CreateHouse(Vector2 position, float size, Color wallColor, Color roofColor) {
-    RayPalsSprite* sprite = CreateSprite(5);
-    if (sprite == NULL) return NULL;
-    
-    // House base
-    RayPals2DShape* base = CreateRectangle((Vector2){ 0, size/8 }, (Vector2){ size, size*0.8f }, wallColor);
-    
-    // Roof
-    RayPals2DShape* roof = CreateTriangle((Vector2){ 0, -size/2 }, size*1.2f, roofColor);
-    
-    // Door
-    RayPals2DShape* door = CreateRectangle((Vector2){ 0, size/3 }, (Vector2){ size/4, size/3 }, BROWN);
-    
-    // Windows
-    RayPals2DShape* window1 = CreateRectangle((Vector2){ -size/3, 0 }, (Vector2){ size/5, size/5 }, SKYBLUE);
-    RayPals2DShape* window2 = CreateRectangle((Vector2){ size/3, 0 }, (Vector2){ size/5, size/5 }, SKYBLUE);
-    
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, base);
-    AddShapeToSprite(sprite, roof);
-    AddShapeToSprite(sprite, door);
-    AddShapeToSprite(sprite, window1);
-    AddShapeToSprite(sprite, window2);
+RayPals2DShape* CreateArrow(Vector2 position, float size, float direction, Color color) {
+    RayPals2DShape* shape = AllocShape2D();
+    if (shape == NULL) return NULL;
     
-    // Set sprite position
-    sprite->position = position;
+    shape->type = RAYPALS_ARROW;
+    shape->position = position;
+    shape->size = (Vector2){ size, size };
+    shape->rotation = direction;
+    shape->color = color;
+    shape->filled = true;
+    shape->thickness = 2.0f;
+    shape->segments = 0;
+    shape->points = 0;
+    shape->visible = true;
     
-    return sprite;
+    return shape;
 }
 
-RayPalsSprite* CreateCastle(Vector2 position, float size, Color wallColor, Color roofColor) {
-    RayPalsSprite* sprite = CreateSprite(8);
-    if (sprite == NULL) return NULL;
-    
-    // Main castle body (rectangle)
-    RayPals2DShape* body = CreateRectangle((Vector2){ 0, size/4 }, (Vector2){ size, size*0.8f }, wallColor);
-    
-    // Main tower (rectangle)
-    RayPals2DShape* mainTower = CreateRectangle((Vector2){ 0, -size/3 }, (Vector2){ size*0.4f, size*0.6f }, wallColor);
-    
-    // Side towers (rectangles)
-    RayPals2DShape* leftTower = CreateRectangle((Vector2){ -size*0.4f, -size/3 }, (Vector2){ size*0.3f, size*0.5f }, wallColor);
-    RayPals2DShape* rightTower = CreateRectangle((Vector2){ size*0.4f, -size/3 }, (Vector2){ size*0.3f, size*0.5f }, wallColor);
-    
-    // Roofs (triangles)
-    RayPals2DShape* mainRoof = CreateTriangle((Vector2){ 0, -size*0.6f }, size*0.5f, roofColor);
-    RayPals2DShape* leftRoof = CreateTriangle((Vector2){ -size*0.4f, -size*0.55f }, size*0.4f, roofColor);
-    RayPals2DShape* rightRoof = CreateTriangle((Vector2){ size*0.4f, -size*0.55f }, size*0.4f, roofColor);
-    
-    // Castle gate (rectangle)
-    RayPals2DShape* gate = CreateRectangle((Vector2){ 0, size/3 }, (Vector2){ size*0.3f, size*0.4f }, BROWN);
+RayPals2DShape* CreateWaterDrop(Vector2 position, float size, float rotation, Color color) {
+    RayPals2DShape* shape = AllocShape2D();
+    if (shape == NULL) return NULL;
     
-    // Windows (circles)
-    RayPals2DShape* window1 = CreateCircle((Vector2){ -size*0.2f, 0 }, size*0.1f, SKYBLUE);
-    RayPals2DShape* window2 = CreateCircle((Vector2){ size*0.2f, 0 }, size*0.1f, SKYBLUE);
+    // Setup basic properties
+    shape->type = RAYPALS_WATER_DROP; // Use water drop type for proper rendering
+    shape->position = position;
+    shape->size = (Vector2){ size, size * 1.5f }; // Water drop is taller than wide
+    shape->rotation = rotation;
+    shape->color = color;
+    shape->filled = true;
+    shape->thickness = 2.0f;
+    shape->segments = 16; // Use enough segments for smooth drop shape
+    shape->points = 0;
+    shape->visible = true;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, mainTower);
-    AddShapeToSprite(sprite, leftTower);
-    AddShapeToSprite(sprite, rightTower);
-    AddShapeToSprite(sprite, mainRoof);
-    AddShapeToSprite(sprite, leftRoof);
-    AddShapeToSprite(sprite, rightRoof);
-    AddShapeToSprite(sprite, gate);
-    AddShapeToSprite(sprite, window1);
-    AddShapeToSprite(sprite, window2);
+    return shape;
+}
+
+// ----------------------------------------------------------------------------
+// 3D Shape Functions
+// ----------------------------------------------------------------------------
+
+RayPals3DShape* CreateCube(Vector3 position, Vector3 size, Color color) {
+    RayPals3DShape* shape = AllocShape3D();
+    if (shape == NULL) return NULL;
     
-    // Set sprite position
-    sprite->position = position;
+    shape->type = RAYPALS_CUBE;
+    shape->position = position;
+    shape->size = size;
+    shape->rotation = (Vector3){ 0.0f, 0.0f, 0.0f };
+    shape->color = color;
+    shape->wireframe = false;
+    shape->thickness = 2.0f;
+    shape->segments = 0;
+    shape->visible = true;
     
-    return sprite;
+    return shape;
 }
 
-RayPalsSprite* CreateBush(Vector2 position, float size, Color color) {
-    RayPalsSprite* sprite = CreateSprite(3);
-    if (sprite == NULL) return NULL;
+RayPals3DShape* CreateSphere(Vector3 position, float radius, int segments, Color color) {
+    RayPals3DShape* shape = AllocShape3D();
+    if (shape == NULL) return NULL;
     
-    // Bush circles
-    RayPals2DShape* bush1 = CreateCircle((Vector2){ -size/4, 0 }, size/2, color);
-    RayPals2DShape* bush2 = CreateCircle((Vector2){ size/4, 0 }, size/2, color);
-    RayPals2DShape* bush3 = CreateCircle((Vector2){ 0, -size/4 }, size/2, color);
+    shape->type = RAYPALS_SPHERE;
+    shape->position = position;
+    shape->size = (Vector3){ radius * 2, radius * 2, radius * 2 };
+    shape->rotation = (Vector3){ 0.0f, 0.0f, 0.0f };
+    shape->color = color;
+    shape->wireframe = false;
+    shape->thickness = 2.0f;
+    shape->segments = segments;
+    shape->visible = true;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, bush1);
-    AddShapeToSprite(sprite, bush2);
-    AddShapeToSprite(sprite, bush3);
+    return shape;
+}
+
+RayPals3DShape* CreateCone(Vector3 position, float radius, float height, int segments, Color color) {
+    RayPals3DShape* shape = AllocShape3D();
+    if (shape == NULL) return NULL;
     
-    // Set sprite position
-    sprite->position = position;
+    shape->type = RAYPALS_CONE;
+    shape->position = position;
+    shape->size = (Vector3){ radius * 2, height, radius * 2 };
+    shape->rotation = (Vector3){ 0.0f, 0.0f, 0.0f };
+    shape->color = color;
+    shape->wireframe = false;
+    shape->thickness = 2.0f;
+    shape->segments = segments;
+    shape->visible = true;
     
-    return sprite;
+    return shape;
 }
 
-RayPalsSprite* CreateRock(Vector2 position, float size, Color color) {
-    RayPalsSprite* sprite = CreateSprite(1);
-    if (sprite == NULL) return NULL;
+RayPals3DShape* CreateCylinder(Vector3 position, float radius, float height, int segments, Color color) {
+    RayPals3DShape* shape = AllocShape3D();
+    if (shape == NULL) return NULL;
     
-    // Just create a simple circle for the rock with the specified color
-    RayPals2DShape* rock = CreateCircle((Vector2){ 0, 0 }, size/2, color);
+    shape->type = RAYPALS_CYLINDER;
+    shape->position = position;
+    shape->size = (Vector3){ radius * 2, height, radius * 2 };
+    shape->rotation = (Vector3){ 0.0f, 0.0f, 0.0f };
+    shape->color = color;
+    shape->wireframe = false;
+    shape->thickness = 2.0f;
+    shape->segments = segments;
+    shape->visible = true;
     
-    // Add shape to sprite
-    AddShapeToSprite(sprite, rock);
+    return shape;
+}
+
+// ----------------------------------------------------------------------------
+// 3D Mesh Cache Functions
+// ----------------------------------------------------------------------------
+
+#define RAYPALS_MESH_BUCKETS 64         // Hash buckets of the unit mesh table
+#define RAYPALS_MESH_MAX_SEGMENTS 256   // Segment counts are clamped to [3, this]
+
+// Unit-sized primitive, built once per (type, segments, wireframe) and scaled at draw time:
+// a cube of side 1 and a sphere of radius 1 centered on the origin, and cylinders and cones
+// of radius 1 standing on the origin with height 1, following raylib's vertex order
+typedef struct RayPalsUnitMesh {
+    struct RayPalsUnitMesh* next;
+    RayPalsShapeType type;
+    int segments;
+    bool wireframe;
+    int mode;                  // RL_TRIANGLES or RL_LINES
+    int vertexCount;
+    Vector3* vertices;
+    Vector3* normals;
+} RayPalsUnitMesh;
+
+static RayPalsUnitMesh* unitMeshes[RAYPALS_MESH_BUCKETS] = { 0 };
+
+static Vector3* EmitMeshVertex(Vector3* out, Vector3** normals, Vector3 vertex, Vector3 normal) {
+    *(*normals)++ = normal;
+    *out++ = vertex;
+    return out;
+}
+
+static Vector3 GetUnitCirclePoint(int index, int segments, float y) {
+    float angle = (float)index * (2.0f * PI / segments);
+    return (Vector3){ sinf(angle), y, cosf(angle) };
+}
+
+// Writes the mesh when out is not NULL; returns its vertex count either way
+static int BuildUnitMesh(RayPalsShapeType type, int segments, bool wireframe, Vector3* out, Vector3* normals) {
+    Vector3* start = out;
+    int count = 0;
     
-    // Set sprite position
-    sprite->position = position;
+    switch (type) {
+        case RAYPALS_CUBE: {
+            if (wireframe) {
+                count = 24;
+                if (out == NULL) break;
+                
+                // Four edges along each axis
+                for (int axis = 0; axis < 3; axis++) {
+                    for (int corner = 0; corner < 4; corner++) {
+                        float a = (corner & 1) ? 0.5f : -0.5f, b = (corner & 2) ? 0.5f : -0.5f;
+                        float from[3], to[3];
+                        from[axis] = -0.5f;
+                        to[axis] = 0.5f;
+                        from[(axis + 1) % 3] = to[(axis + 1) % 3] = a;
+                        from[(axis + 2) % 3] = to[(axis + 2) % 3] = b;
+                        
+                        Vector3 normal = { 0 };
+                        out = EmitMeshVertex(out, &normals, (Vector3){ from[0], from[1], from[2] }, normal);
+                        out = EmitMeshVertex(out, &normals, (Vector3){ to[0], to[1], to[2] }, normal);
+                    }
+                }
+                break;
+            }
+            
+            count = 36;
+            if (out == NULL) break;
+            
+            // Each face spans axes u and v with u x v pointing outwards, so triangles wind counter-clockwise
+            const Vector3 faces[6][3] = {
+                { { 0, 0, 1 }, { 1, 0, 0 }, { 0, 1, 0 } }, { { 0, 0, -1 }, { 0, 1, 0 }, { 1, 0, 0 } },
+                { { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 0 } }, { { 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } },
+                { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } }, { { -1, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 } }
+            };
+            const float corners[6][2] = { { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 }, { -1, 1 }, { 1, -1 } };
+            
+            for (int face = 0; face < 6; face++) {
+                Vector3 n = faces[face][0], u = faces[face][1], v = faces[face][2];
+                for (int i = 0; i < 6; i++) {
+                    float s = corners[i][0] * 0.5f, t = corners[i][1] * 0.5f;
+                    Vector3 vertex = { n.x*0.5f + u.x*s + v.x*t, n.y*0.5f + u.y*s + v.y*t, n.z*0.5f + u.z*s + v.z*t };
+                    out = EmitMeshVertex(out, &normals, vertex, n);
+                }
+            }
+        } break;
+        
+        case RAYPALS_SPHERE: {
+            // Same bands as DrawSphereEx and DrawSphereWires with rings = slices = segments
+            int rings = segments, slices = segments;
+            count = wireframe ? (rings + 2) * slices * 6 : (rings + 1) * slices * 6;
+            if (out == NULL) break;
+            
+            float ringStep = PI / (rings + 1);
+            float sliceStep = 2.0f * PI / slices;
+            
+            for (int i = 0; i < (wireframe ? rings + 2 : rings + 1); i++) {
+                for (int j = 0; j < slices; j++) {
+                    // Points on the parallels above (i) and below (i + 1) at meridians j and j + 1
+                    Vector3 p[2][2];
+                    for (int r = 0; r < 2; r++) {
+                        float polar = (i + r) * ringStep;
+                        for (int s = 0; s < 2; s++) {
+                            float azimuth = (j + s) * sliceStep;
+                            p[r][s] = (Vector3){ sinf(polar) * sinf(azimuth), cosf(polar), sinf(polar) * cosf(azimuth) };
+                        }
+                    }
+                    
+                    if (wireframe) {
+                        Vector3 lines[6] = { p[0][0], p[1][1], p[1][1], p[1][0], p[1][0], p[0][0] };
+                        for (int k = 0; k < 6; k++) out = EmitMeshVertex(out, &normals, lines[k], lines[k]);
+                    } else {
+                        Vector3 triangles[6] = { p[0][0], p[1][0], p[1][1], p[0][0], p[1][1], p[0][1] };
+                        for (int k = 0; k < 6; k++) out = EmitMeshVertex(out, &normals, triangles[k], triangles[k]);
+                    }
+                }
+            }
+        } break;
+        
+        case RAYPALS_CYLINDER:
+        case RAYPALS_CONE: {
+            // Same faces as DrawCylinder and DrawCylinderWires with radiusTop 1 (cylinder) or 0 (cone)
+            bool cone = type == RAYPALS_CONE;
+            count = wireframe ? segments * 8 : (cone ? segments * 6 : segments * 12);
+            if (out == NULL) break;
+            
+            float top = cone ? 0.0f : 1.0f;
+            Vector3 up = { 0, 1, 0 }, down = { 0, -1, 0 };
+            
+            for (int i = 0; i < segments; i++) {
+                Vector3 bottomLeft = GetUnitCirclePoint(i, segments, 0.0f);
+                Vector3 bottomRight = GetUnitCirclePoint(i + 1, segments, 0.0f);
+                Vector3 topLeft = { bottomLeft.x * top, 1.0f, bottomLeft.z * top };
+                Vector3 topRight = { bottomRight.x * top, 1.0f, bottomRight.z * top };
+                
+                // Side normals lean up by the slope: 45 degrees for the unit cone
+                float lean = cone ? 0.70710678f : 0.0f, spread = cone ? 0.70710678f : 1.0f;
+                Vector3 leftNormal = { bottomLeft.x * spread, lean, bottomLeft.z * spread };
+                Vector3 rightNormal = { bottomRight.x * spread, lean, bottomRight.z * spread };
+                
+                if (wireframe) {
+                    Vector3 lines[8] = { bottomLeft, bottomRight, bottomRight, topRight, topRight, topLeft, topLeft, bottomLeft };
+                    for (int k = 0; k < 8; k++) out = EmitMeshVertex(out, &normals, lines[k], (Vector3){ 0 });
+                    continue;
+                }
+                
+                if (cone) {
+                    Vector3 apexNormal = GetUnitCirclePoint(2*i + 1, 2*segments, 0.0f);
+                    apexNormal = (Vector3){ apexNormal.x * spread, lean, apexNormal.z * spread };
+                    out = EmitMeshVertex(out, &normals, topLeft, apexNormal);
+                    out = EmitMeshVertex(out, &normals, bottomLeft, leftNormal);
+                    out = EmitMeshVertex(out, &normals, bottomRight, rightNormal);
+                } else {
+                    out = EmitMeshVertex(out, &normals, bottomLeft, leftNormal);
+                    out = EmitMeshVertex(out, &normals, bottomRight, rightNormal);
+                    out = EmitMeshVertex(out, &normals, topRight, rightNormal);
+                    out = EmitMeshVertex(out, &normals, topLeft, leftNormal);
+                    out = EmitMeshVertex(out, &normals, bottomLeft, leftNormal);
+                    out = EmitMeshVertex(out, &normals, topRight, rightNormal);
+                    
+                    out = EmitMeshVertex(out, &normals, (Vector3){ 0, 1, 0 }, up);
+                    out = EmitMeshVertex(out, &normals, topLeft, up);
+                    out = EmitMeshVertex(out, &normals, topRight, up);
+                }
+            }
+            
+            // Base, shared by both
+            for (int i = 0; i < segments && !wireframe; i++) {
+                out = EmitMeshVertex(out, &normals, (Vector3){ 0, 0, 0 }, down);
+                out = EmitMeshVertex(out, &normals, GetUnitCirclePoint(i + 1, segments, 0.0f), down);
+                out = EmitMeshVertex(out, &normals, GetUnitCirclePoint(i, segments, 0.0f), down);
+            }
+        } break;
+        
+        default: break;
+    }
     
-    return sprite;
+    return out != NULL ? (int)(out - start) : count;
 }
 
-RayPalsSprite* CreateRobotCharacter(Vector2 position, float size, Color primaryColor, Color secondaryColor) {
-    RayPalsSprite* sprite = CreateSprite(4);
-    if (sprite == NULL) return NULL;
-    
-    // Create robot parts
-    RayPals2DShape* body = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size*0.8f, size }, primaryColor);
-    RayPals2DShape* head = CreateRectangle((Vector2){ 0, -size*0.6f }, (Vector2){ size*0.6f, size*0.5f }, primaryColor);
+// Returns the cached unit mesh for a primitive, building it on first use (NULL if unsupported)
+static const RayPalsUnitMesh* Get3DUnitMesh(RayPalsShapeType type, int segments, bool wireframe) {
+    if (type != RAYPALS_CUBE && type != RAYPALS_SPHERE && type != RAYPALS_CYLINDER && type != RAYPALS_CONE) return NULL;
     
-    // Eyes
-    RayPals2DShape* eye1 = CreateCircle((Vector2){ -size*0.15f, -size*0.6f }, size*0.1f, secondaryColor);
-    RayPals2DShape* eye2 = CreateCircle((Vector2){ size*0.15f, -size*0.6f }, size*0.1f, secondaryColor);
+    if (type == RAYPALS_CUBE) segments = 0;
+    else if (segments < 3) segments = 3;
+    else if (segments > RAYPALS_MESH_MAX_SEGMENTS) segments = RAYPALS_MESH_MAX_SEGMENTS;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, head);
-    AddShapeToSprite(sprite, eye1);
-    AddShapeToSprite(sprite, eye2);
+    unsigned int bucket = ((unsigned int)type * 31u + (unsigned int)segments * 2u + (wireframe ? 1u : 0u)) % RAYPALS_MESH_BUCKETS;
+    for (RayPalsUnitMesh* mesh = unitMeshes[bucket]; mesh != NULL; mesh = mesh->next) {
+        if (mesh->type == type && mesh->segments == segments && mesh->wireframe == wireframe) return mesh;
+    }
     
-    // Set sprite position
-    sprite->position = position;
+    RayPalsUnitMesh* mesh = (RayPalsUnitMesh*)calloc(1, sizeof(RayPalsUnitMesh));
+    if (mesh == NULL) return NULL;
+    
+    mesh->type = type;
+    mesh->segments = segments;
+    mesh->wireframe = wireframe;
+    mesh->mode = wireframe ? RL_LINES : RL_TRIANGLES;
+    mesh->vertexCount = BuildUnitMesh(type, segments, wireframe, NULL, NULL);
+    mesh->vertices = (Vector3*)malloc(sizeof(Vector3) * mesh->vertexCount);
+    mesh->normals = (Vector3*)malloc(sizeof(Vector3) * mesh->vertexCount);
+    if (mesh->vertices == NULL || mesh->normals == NULL) {
+        free(mesh->vertices);
+        free(mesh->normals);
+        free(mesh);
+        return NULL;
+    }
     
-    return sprite;
+    BuildUnitMesh(type, segments, wireframe, mesh->vertices, mesh->normals);
+    mesh->next = unitMeshes[bucket];
+    unitMeshes[bucket] = mesh;
+    return mesh;
 }
 
-RayPalsSprite* CreateAnimalCharacter(Vector2 position, float size, Color bodyColor, Color detailColor) {
-    RayPalsSprite* sprite = CreateSprite(5);
-    if (sprite == NULL) return NULL;
-    
-    // Create animal parts (e.g., a simple cat)
-    RayPals2DShape* body = CreateCircle((Vector2){ 0, size*0.1f }, size*0.4f, bodyColor);
-    RayPals2DShape* head = CreateCircle((Vector2){ 0, -size*0.3f }, size*0.3f, bodyColor);
-    RayPals2DShape* ear1 = CreateTriangle((Vector2){ -size*0.2f, -size*0.5f }, size*0.2f, bodyColor);
-    RayPals2DShape* ear2 = CreateTriangle((Vector2){ size*0.2f, -size*0.5f }, size*0.2f, bodyColor);
-    
-    // Eyes
-    RayPals2DShape* eye1 = CreateCircle((Vector2){ -size*0.1f, -size*0.3f }, size*0.05f, detailColor);
-    RayPals2DShape* eye2 = CreateCircle((Vector2){ size*0.1f, -size*0.3f }, size*0.05f, detailColor);
-    
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, head);
-    AddShapeToSprite(sprite, ear1);
-    AddShapeToSprite(sprite, ear2);
-    AddShapeToSprite(sprite, eye1);
-    AddShapeToSprite(sprite, eye2);
-    
-    // Set sprite position
-    sprite->position = position;
-    
-    return sprite;
+// Scale that maps a primitive's unit mesh to the shape's size
+static Vector3 Get3DUnitMeshScale(const RayPals3DShape* shape) {
+    float radius = shape->size.x / 2.0f;
+    switch (shape->type) {
+        case RAYPALS_CUBE: return shape->size;
+        case RAYPALS_SPHERE: return (Vector3){ radius, radius, radius };
+        default: return (Vector3){ radius, shape->size.y, radius };  // Cylinders and cones
+    }
 }
 
-RayPalsSprite* CreateGhost(Vector2 position, float size, Color color) {
-    RayPalsSprite* sprite = CreateSprite(4);
-    if (sprite == NULL) return NULL;
-    
-    // Main ghost body (half-circle on top, wavy bottom)
-    RayPals2DShape* body = CreateCircle((Vector2){ 0, -size*0.15f }, size*0.4f, color);
-    body->filled = true;
-    
-    // Bottom part of ghost created with triangles
-    RayPals2DShape* bottom1 = CreateTriangle((Vector2){ -size*0.3f, size*0.3f }, size*0.3f, color);
-    RayPals2DShape* bottom2 = CreateTriangle((Vector2){ 0, size*0.3f }, size*0.3f, color);
-    RayPals2DShape* bottom3 = CreateTriangle((Vector2){ size*0.3f, size*0.3f }, size*0.3f, color);
-    
-    // Eyes
-    RayPals2DShape* eye1 = CreateCircle((Vector2){ -size*0.15f, -size*0.2f }, size*0.07f, BLACK);
-    RayPals2DShape* eye2 = CreateCircle((Vector2){ size*0.15f, -size*0.2f }, size*0.07f, BLACK);
-    
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, bottom1);
-    AddShapeToSprite(sprite, bottom2);
-    AddShapeToSprite(sprite, bottom3);
-    AddShapeToSprite(sprite, eye1);
-    AddShapeToSprite(sprite, eye2);
+// Streams a unit mesh through the current rlgl transform, which carries the shape's scale
+static void EmitUnitMesh(const RayPalsUnitMesh* mesh, Color color) {
+    rlBegin(mesh->mode);
+    rlColor4ub(color.r, color.g, color.b, color.a);
     
-    // Set sprite position
-    sprite->position = position;
+    for (int base = 0; base < mesh->vertexCount; base += RAYPALS_CACHE_CHUNK) {
+        int end = base + RAYPALS_CACHE_CHUNK;
+        if (end > mesh->vertexCount) end = mesh->vertexCount;
+        
+        // Chunks hold whole triangles and lines, so a flush never splits a primitive
+        CheckRenderBatchLimit(end - base);
+        
+        for (int i = base; i < end; i++) {
+            rlNormal3f(mesh->normals[i].x, mesh->normals[i].y, mesh->normals[i].z);
+            rlVertex3f(mesh->vertices[i].x, mesh->vertices[i].y, mesh->vertices[i].z);
+        }
+    }
     
-    return sprite;
+    rlEnd();
+    drawStats.vertices += mesh->vertexCount;
 }
 
-RayPalsSprite* CreateButton(Vector2 position, Vector2 size, Color bgColor, Color borderColor) {
-    RayPalsSprite* sprite = CreateSprite(2);
-    if (sprite == NULL) return NULL;
-    
-    // Button background
-    RayPals2DShape* background = CreateRectangle((Vector2){ 0, 0 }, size, bgColor);
-    background->filled = true;
-    
-    // Button border
-    RayPals2DShape* border = CreateRectangle((Vector2){ 0, 0 }, size, borderColor);
-    border->filled = false;
-    border->thickness = 2.0f;
-    
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, background);
-    AddShapeToSprite(sprite, border);
-    
-    // Set sprite position
-    sprite->position = position;
-    
-    return sprite;
+// Planes of the instance being transformed, shared by every 3D sprite template and grown
+// to the largest stride drawn so far (see GetInstanceScratch)
+static float* instanceScratch = NULL;
+static int instanceScratchStride = 0;
+
+void Free3DMeshCache(void) {
+    free(instanceScratch);
+    instanceScratch = NULL;
+    instanceScratchStride = 0;
+    
+    for (int bucket = 0; bucket < RAYPALS_MESH_BUCKETS; bucket++) {
+        while (unitMeshes[bucket] != NULL) {
+            RayPalsUnitMesh* mesh = unitMeshes[bucket];
+            unitMeshes[bucket] = mesh->next;
+            free(mesh->vertices);
+            free(mesh->normals);
+            free(mesh);
+        }
+    }
 }
 
-RayPalsSprite* CreateHealthBar(Vector2 position, float width, float fillPercent, Color emptyColor, Color fillColor) {
-    if (fillPercent < 0.0f) fillPercent = 0.0f;
-    if (fillPercent > 1.0f) fillPercent = 1.0f;
-    
-    RayPalsSprite* sprite = CreateSprite(2);
-    if (sprite == NULL) return NULL;
-    
-    float height = width * 0.15f;
-    
-    // Bar background
-    RayPals2DShape* background = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ width, height }, emptyColor);
-    background->filled = true;
-    
-    // Calculate fill width
-    float fillWidth = width * fillPercent;
-    float fillOffsetX = (width - fillWidth) * 0.5f;
-    
-    // Bar fill
-    RayPals2DShape* fill = CreateRectangle((Vector2){ -fillOffsetX, 0 }, (Vector2){ fillWidth, height * 0.8f }, fillColor);
-    fill->filled = true;
-    
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, background);
-    AddShapeToSprite(sprite, fill);
-    
-    // Set sprite position
-    sprite->position = position;
-    
-    return sprite;
+// ----------------------------------------------------------------------------
+// Transform Functions
+// ----------------------------------------------------------------------------
+
+// Versions handed out to 3D sprite matrices; shapes compare them to know whether their
+// cached world matrix was built under the current parent transform. Standalone shapes use
+// stamp 0 and a rebuilt local matrix invalidates the world matrix with the unused maximum.
+#define RAYPALS_STAMP_INVALID UINT_MAX
+static unsigned int transformStamp = 0;
+
+// Translate, rotate Y then X then Z (degrees), then scale: the order the 3D draw functions
+// used to apply through rlgl, so cached matrices reproduce the old output
+static Matrix MakeTransformMatrix(Vector3 position, Vector3 rotation, Vector3 scale) {
+    float cy = cosf(rotation.y*DEG2RAD), sy = sinf(rotation.y*DEG2RAD);
+    float cx = cosf(rotation.x*DEG2RAD), sx = sinf(rotation.x*DEG2RAD);
+    float cz = cosf(rotation.z*DEG2RAD), sz = sinf(rotation.z*DEG2RAD);
+    
+    // Columns of Ry*Rx*Rz, each scaled by its axis
+    Matrix result = { 0 };
+    result.m0 = (cy*cz + sy*sx*sz) * scale.x;  result.m4 = (sy*sx*cz - cy*sz) * scale.y;  result.m8 = sy*cx * scale.z;
+    result.m1 = cx*sz * scale.x;               result.m5 = cx*cz * scale.y;               result.m9 = -sx * scale.z;
+    result.m2 = (cy*sx*sz - sy*cz) * scale.x;  result.m6 = (sy*sz + cy*sx*cz) * scale.y;  result.m10 = cy*cx * scale.z;
+    result.m12 = position.x;
+    result.m13 = position.y;
+    result.m14 = position.z;
+    result.m15 = 1.0f;
+    return result;
 }
 
-void DrawSprite(RayPalsSprite* sprite) {
-    if (!sprite || !sprite->visible) return;
-    
-    // Save current matrix to restore later
-    rlPushMatrix();
+// Product a*b of two affine matrices (the bottom rows are assumed to be 0 0 0 1)
+static Matrix MultiplyTransforms(const Matrix* a, const Matrix* b) {
+    Matrix result = { 0 };
+    result.m0 = a->m0*b->m0 + a->m4*b->m1 + a->m8*b->m2;
+    result.m1 = a->m1*b->m0 + a->m5*b->m1 + a->m9*b->m2;
+    result.m2 = a->m2*b->m0 + a->m6*b->m1 + a->m10*b->m2;
+    result.m4 = a->m0*b->m4 + a->m4*b->m5 + a->m8*b->m6;
+    result.m5 = a->m1*b->m4 + a->m5*b->m5 + a->m9*b->m6;
+    result.m6 = a->m2*b->m4 + a->m6*b->m5 + a->m10*b->m6;
+    result.m8 = a->m0*b->m8 + a->m4*b->m9 + a->m8*b->m10;
+    result.m9 = a->m1*b->m8 + a->m5*b->m9 + a->m9*b->m10;
+    result.m10 = a->m2*b->m8 + a->m6*b->m9 + a->m10*b->m10;
+    result.m12 = a->m0*b->m12 + a->m4*b->m13 + a->m8*b->m14 + a->m12;
+    result.m13 = a->m1*b->m12 + a->m5*b->m13 + a->m9*b->m14 + a->m13;
+    result.m14 = a->m2*b->m12 + a->m6*b->m13 + a->m10*b->m14 + a->m14;
+    result.m15 = 1.0f;
+    return result;
+}
+
+static Vector3 TransformPoint(const Matrix* m, Vector3 v) {
+    return (Vector3){
+        m->m0*v.x + m->m4*v.y + m->m8*v.z + m->m12,
+        m->m1*v.x + m->m5*v.y + m->m9*v.z + m->m13,
+        m->m2*v.x + m->m6*v.y + m->m10*v.z + m->m14
+    };
+}
+
+static Vector3 TransformDirection(const Matrix* m, Vector3 v) {
+    return (Vector3){
+        m->m0*v.x + m->m4*v.y + m->m8*v.z,
+        m->m1*v.x + m->m5*v.y + m->m9*v.z,
+        m->m2*v.x + m->m6*v.y + m->m10*v.z
+    };
+}
+
+// Cofactor matrix of the linear part, signed by the determinant: the inverse transpose up
+// to a positive scale, which keeps normals perpendicular under non-uniform scaling
+static Matrix GetNormalMatrix(const Matrix* m) {
+    Matrix n = { 0 };
+    n.m0 = m->m5*m->m10 - m->m9*m->m6;   n.m4 = m->m9*m->m2 - m->m1*m->m10;   n.m8 = m->m1*m->m6 - m->m5*m->m2;
+    n.m1 = m->m8*m->m6 - m->m4*m->m10;   n.m5 = m->m0*m->m10 - m->m8*m->m2;   n.m9 = m->m4*m->m2 - m->m0*m->m6;
+    n.m2 = m->m4*m->m9 - m->m8*m->m5;    n.m6 = m->m8*m->m1 - m->m0*m->m9;    n.m10 = m->m0*m->m5 - m->m4*m->m1;
+    
+    if (m->m0*n.m0 + m->m4*n.m4 + m->m8*n.m8 < 0.0f) {
+        n.m0 = -n.m0; n.m1 = -n.m1; n.m2 = -n.m2;
+        n.m4 = -n.m4; n.m5 = -n.m5; n.m6 = -n.m6;
+        n.m8 = -n.m8; n.m9 = -n.m9; n.m10 = -n.m10;
+    }
+    n.m15 = 1.0f;
+    return n;
+}
+
+// Multiplies a cached matrix onto the current rlgl matrix (rlgl takes column-major floats)
+static void ApplyTransform(const Matrix* m) {
+    float values[16] = {
+        m->m0, m->m1, m->m2, m->m3, m->m4, m->m5, m->m6, m->m7,
+        m->m8, m->m9, m->m10, m->m11, m->m12, m->m13, m->m14, m->m15
+    };
+    rlMultMatrixf(values);
+}
+
+static const Matrix* Refresh3DSpriteMatrix(RayPals3DSprite* sprite) {
+    if (sprite->transformDirty || sprite->transformStamp == 0) {
+        sprite->worldMatrix = MakeTransformMatrix(sprite->position, sprite->rotation, sprite->scale);
+        if (++transformStamp == RAYPALS_STAMP_INVALID) transformStamp = 1;   // 0 marks a matrix never built
+        sprite->transformStamp = transformStamp;
+        sprite->transformDirty = false;
+    }
+    return &sprite->worldMatrix;
+}
+
+static const Matrix* Refresh3DShapeLocalMatrix(RayPals3DShape* shape) {
+    if (shape->transformDirty) {
+        shape->localMatrix = MakeTransformMatrix(shape->position, shape->rotation, Get3DUnitMeshScale(shape));
+        shape->transformDirty = false;
+        shape->parentStamp = RAYPALS_STAMP_INVALID;
+    }
+    return &shape->localMatrix;
+}
+
+// Bounds of a unit mesh under a matrix: the box through the absolute linear part, the
+// sphere around the transformed local center scaled by the longest axis
+static RayPalsBounds3D TransformUnitBounds(RayPalsShapeType type, const Matrix* m) {
+    Vector3 center = { 0, 0, 0 }, extent = { 0.5f, 0.5f, 0.5f };
+    float radius = 0.8660254f;   // Half the diagonal of the unit cube
+    if (type == RAYPALS_SPHERE) {
+        extent = (Vector3){ 1, 1, 1 };
+        radius = 1.0f;
+    } else if (type == RAYPALS_CYLINDER || type == RAYPALS_CONE) {
+        center = (Vector3){ 0, 0.5f, 0 };
+        extent = (Vector3){ 1, 0.5f, 1 };
+        radius = 1.118034f;
+    }
     
-    // Apply sprite transformations
-    rlTranslatef(sprite->position.x, sprite->position.y, 0.0f);
-    rlRotatef(sprite->rotation, 0.0f, 0.0f, 1.0f);
-    rlScalef(sprite->scale, sprite->scale, 1.0f);
+    Vector3 worldCenter = TransformPoint(m, center);
+    Vector3 worldExtent = {
+        fabsf(m->m0)*extent.x + fabsf(m->m4)*extent.y + fabsf(m->m8)*extent.z,
+        fabsf(m->m1)*extent.x + fabsf(m->m5)*extent.y + fabsf(m->m9)*extent.z,
+        fabsf(m->m2)*extent.x + fabsf(m->m6)*extent.y + fabsf(m->m10)*extent.z
+    };
+    float axisX = m->m0*m->m0 + m->m1*m->m1 + m->m2*m->m2;
+    float axisY = m->m4*m->m4 + m->m5*m->m5 + m->m6*m->m6;
+    float axisZ = m->m8*m->m8 + m->m9*m->m9 + m->m10*m->m10;
+    
+    RayPalsBounds3D bounds;
+    bounds.box.min = (Vector3){ worldCenter.x - worldExtent.x, worldCenter.y - worldExtent.y, worldCenter.z - worldExtent.z };
+    bounds.box.max = (Vector3){ worldCenter.x + worldExtent.x, worldCenter.y + worldExtent.y, worldCenter.z + worldExtent.z };
+    bounds.center = worldCenter;
+    bounds.radius = radius * sqrtf(fmaxf(axisX, fmaxf(axisY, axisZ)));
+    return bounds;
+}
+
+// World matrix of a shape's unit mesh, refreshed with its bounds when the shape or its
+// sprite changed; a standalone shape (NULL sprite) uses its local matrix
+static const Matrix* Refresh3DShapeWorldMatrix(RayPals3DShape* shape, RayPals3DSprite* sprite) {
+    const Matrix* local = Refresh3DShapeLocalMatrix(shape);
+    unsigned int stamp = 0;
+    if (sprite != NULL) {
+        Refresh3DSpriteMatrix(sprite);
+        stamp = sprite->transformStamp;
+    }
     
-    // Draw all shapes in the sprite
-    for (int i = 0; i < sprite->shapeCount; i++) {
-        Draw2DShape(sprite->shapes[i]);
+    if (shape->parentStamp != stamp) {
+        shape->worldMatrix = sprite != NULL ? MultiplyTransforms(&sprite->worldMatrix, local) : *local;
+        shape->bounds = TransformUnitBounds(shape->type, &shape->worldMatrix);
+        shape->parentStamp = stamp;
     }
+    return &shape->worldMatrix;
+}
+
+// Queues the sprite's leaf for the next refit of the tree it reports to
+static void Queue3DSpriteRefit(RayPals3DSprite* sprite) {
+    if (sprite->bvh == NULL || sprite->bvhQueued) return;
     
-    // Restore matrix
-    rlPopMatrix();
+    sprite->bvh->queuedLeaves[sprite->bvh->queuedCount++] = sprite->bvhLeaf;
+    sprite->bvhQueued = true;
 }
 
-void RotateSprite(RayPalsSprite* sprite, float deltaTime, float speed) {
+void Mark3DSpriteDirty(RayPals3DSprite* sprite) {
     if (!sprite) return;
     
-    sprite->rotation += speed * deltaTime;
-    
-    // Normalize rotation to 0-360 degrees
-    while (sprite->rotation >= 360.0f) sprite->rotation -= 360.0f;
-    while (sprite->rotation < 0.0f) sprite->rotation += 360.0f;
+    sprite->transformDirty = true;
+    for (int i = 0; i < sprite->shapeCount; i++) Mark3DShapeDirty(sprite->shapes[i]);
+    Queue3DSpriteRefit(sprite);
 }
 
-void SetSpritePosition(RayPalsSprite* sprite, Vector2 position) {
-    if (sprite) sprite->position = position;
+void Mark3DShapeDirty(RayPals3DShape* shape) {
+    if (shape) shape->transformDirty = true;
 }
 
-void SetSpriteRotation(RayPalsSprite* sprite, float rotation) {
-    if (sprite) sprite->rotation = rotation;
+Matrix Get3DSpriteMatrix(RayPals3DSprite* sprite) {
+    if (!sprite) return MakeTransformMatrix((Vector3){ 0, 0, 0 }, (Vector3){ 0, 0, 0 }, (Vector3){ 1, 1, 1 });
+    return *Refresh3DSpriteMatrix(sprite);
 }
 
-void SetSpriteScale(RayPalsSprite* sprite, float scale) {
-    if (sprite) sprite->scale = scale;
+Matrix Get3DShapeMatrix(RayPals3DShape* shape, RayPals3DSprite* sprite) {
+    if (!shape) return MakeTransformMatrix((Vector3){ 0, 0, 0 }, (Vector3){ 0, 0, 0 }, (Vector3){ 1, 1, 1 });
+    return *Refresh3DShapeWorldMatrix(shape, sprite);
 }
 
-void FreeSprite(RayPalsSprite* sprite) {
-    if (!sprite) return;
+// Sprite bounds, rebuilt only when the sprite moved or a shape's world matrix is out of
+// date, so an unchanged sprite costs one flag check per shape
+static const RayPalsBounds3D* Refresh3DSpriteBounds(RayPals3DSprite* sprite) {
+    Refresh3DSpriteMatrix(sprite);
     
-    // Free all shapes in the sprite
+    bool stale = sprite->boundsStamp != sprite->transformStamp;
+    for (int i = 0; i < sprite->shapeCount && !stale; i++) {
+        const RayPals3DShape* shape = sprite->shapes[i];
+        stale = shape != NULL && (shape->transformDirty || shape->parentStamp != sprite->transformStamp);
+    }
+    if (!stale) return &sprite->bounds;
+    
+    BoundingBox box = { sprite->position, sprite->position };
+    bool empty = true;
     for (int i = 0; i < sprite->shapeCount; i++) {
-        FreeShape(sprite->shapes[i]);
+        RayPals3DShape* shape = sprite->shapes[i];
+        if (shape == NULL) continue;
+        
+        Refresh3DShapeWorldMatrix(shape, sprite);
+        BoundingBox shapeBox = shape->bounds.box;
+        if (empty) {
+            box = shapeBox;
+            empty = false;
+            continue;
+        }
+        box.min = (Vector3){ fminf(box.min.x, shapeBox.min.x), fminf(box.min.y, shapeBox.min.y), fminf(box.min.z, shapeBox.min.z) };
+        box.max = (Vector3){ fmaxf(box.max.x, shapeBox.max.x), fmaxf(box.max.y, shapeBox.max.y), fmaxf(box.max.z, shapeBox.max.z) };
     }
     
-    // Free the shapes array and the sprite itself
-    free(sprite->shapes);
-    free(sprite);
+    // The sphere is centered on the box and reaches the far side of every shape sphere
+    Vector3 center = { (box.min.x + box.max.x)/2, (box.min.y + box.max.y)/2, (box.min.z + box.max.z)/2 };
+    float radius = 0.0f;
+    for (int i = 0; i < sprite->shapeCount; i++) {
+        const RayPals3DShape* shape = sprite->shapes[i];
+        if (shape == NULL) continue;
+        
+        Vector3 offset = { shape->bounds.center.x - center.x, shape->bounds.center.y - center.y, shape->bounds.center.z - center.z };
+        radius = fmaxf(radius, sqrtf(offset.x*offset.x + offset.y*offset.y + offset.z*offset.z) + shape->bounds.radius);
+    }
+    
+    sprite->bounds = (RayPalsBounds3D){ box, center, radius };
+    sprite->boundsStamp = sprite->transformStamp;
+    return &sprite->bounds;
 }
 
-RayPalsSprite* CreateCar(Vector2 position, float size, Color bodyColor, Color detailColor) {
-    RayPalsSprite* sprite = CreateSprite(5);
-    if (sprite == NULL) return NULL;
-    
-    // Car body (main rectangle)
-    RayPals2DShape* body = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size, size*0.5f }, bodyColor);
-    
-    // Car roof/cabin (smaller rectangle)
-    RayPals2DShape* roof = CreateRectangle((Vector2){ -size*0.1f, -size*0.15f }, (Vector2){ size*0.5f, size*0.3f }, bodyColor);
-    
-    // Wheels
-    RayPals2DShape* wheel1 = CreateCircle((Vector2){ -size*0.3f, size*0.25f }, size*0.15f, detailColor);
-    RayPals2DShape* wheel2 = CreateCircle((Vector2){ size*0.3f, size*0.25f }, size*0.15f, detailColor);
-    
-    // Windshield
-    RayPals2DShape* windshield = CreateRectangle((Vector2){ -size*0.1f, -size*0.15f }, (Vector2){ size*0.5f*0.8f, size*0.3f*0.8f }, SKYBLUE);
-    
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, roof);
-    AddShapeToSprite(sprite, wheel1);
-    AddShapeToSprite(sprite, wheel2);
-    AddShapeToSprite(sprite, windshield);
-    
-    // Set sprite position
-    sprite->position = position;
+RayPalsBounds3D Get3DShapeBounds(RayPals3DShape* shape, RayPals3DSprite* sprite) {
+    if (!shape) return (RayPalsBounds3D){ 0 };
     
-    return sprite;
+    Refresh3DShapeWorldMatrix(shape, sprite);
+    return shape->bounds;
 }
 
-RayPalsSprite* CreateTank(Vector2 position, float size, Color bodyColor, Color detailColor) {
-    RayPalsSprite* sprite = CreateSprite(4);
-    if (sprite == NULL) return NULL;
-    
-    // Tank base/body
-    RayPals2DShape* base = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size*1.2f, size*0.5f }, bodyColor);
-    
-    // Tank turret (circle)
-    RayPals2DShape* turret = CreateCircle((Vector2){ 0, -size*0.2f }, size*0.25f, bodyColor);
-    
-    // Tank cannon (rectangle)
-    RayPals2DShape* cannon = CreateRectangle((Vector2){ size*0.4f, -size*0.2f }, (Vector2){ size*0.6f, size*0.1f }, bodyColor);
-    
-    // Tank treads
-    RayPals2DShape* treads = CreateRectangle((Vector2){ 0, size*0.15f }, (Vector2){ size*1.1f, size*0.2f }, detailColor);
-    
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, treads);
-    AddShapeToSprite(sprite, base);
-    AddShapeToSprite(sprite, turret);
-    AddShapeToSprite(sprite, cannon);
-    
-    // Set sprite position
-    sprite->position = position;
-    
-    return sprite;
+RayPalsBounds3D Get3DSpriteBounds(RayPals3DSprite* sprite) {
+    if (!sprite) return (RayPalsBounds3D){ 0 };
+    return *Refresh3DSpriteBounds(sprite);
 }
 
-RayPalsSprite* CreateMotorcycle(Vector2 position, float size, Color bodyColor, Color detailColor) {
-    RayPalsSprite* sprite = CreateSprite(5);
-    if (sprite == NULL) return NULL;
-    
-    // Wheels
-    RayPals2DShape* wheel1 = CreateCircle((Vector2){ -size*0.3f, size*0.1f }, size*0.2f, detailColor);
-    RayPals2DShape* wheel2 = CreateCircle((Vector2){ size*0.3f, size*0.1f }, size*0.2f, detailColor);
-    
-    // Motorcycle body
-    RayPals2DShape* body = CreateRectangle((Vector2){ 0, -size*0.1f }, (Vector2){ size*0.8f, size*0.15f }, bodyColor);
-    
-    // Handlebars
-    RayPals2DShape* handlebar = CreateRectangle((Vector2){ size*0.3f, -size*0.2f }, (Vector2){ size*0.1f, size*0.2f }, bodyColor);
-    
-    // Seat
-    RayPals2DShape* seat = CreateRectangle((Vector2){ -size*0.1f, -size*0.2f }, (Vector2){ size*0.3f, size*0.1f }, BLACK);
+// ----------------------------------------------------------------------------
+// Drawing Functions
+// ----------------------------------------------------------------------------
+
+void Draw2DShape(RayPals2DShape* shape) {
+    if (!shape || !shape->visible) return;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, wheel1);
-    AddShapeToSprite(sprite, wheel2);
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, handlebar);
-    AddShapeToSprite(sprite, seat);
+    // Save current matrix to restore later
+    rlPushMatrix();
     
-    // Set sprite position
-    sprite->position = position;
+    // Translate to position and apply rotation
+    rlTranslatef(shape->position.x, shape->position.y, 0.0f);
+    rlRotatef(shape->rotation, 0.0f, 0.0f, 1.0f);
     
-    return sprite;
+    switch (shape->type) {
+        case RAYPALS_SQUARE:
+        case RAYPALS_RECTANGLE: {
+            float x = -shape->size.x/2;
+            float y = -shape->size.y/2;
+            
+            if (shape->filled) {
+                DrawRectangle(x, y, shape->size.x, shape->size.y, shape->color);
+            } else {
+                DrawRectangleLines(x, y, shape->size.x, shape->size.y, shape->color);
+            }
+        } break;
+        
+        case RAYPALS_CIRCLE: {
+            float radius = shape->size.x/2;
+            
+            if (shape->filled) {
+                DrawCircle(0, 0, radius, shape->color);
+            } else {
+                DrawCircleLines(0, 0, radius, shape->color);
+            }
+        } break;
+        
+        case RAYPALS_TRIANGLE: {
+            float size = shape->size.x;
+            Vector2 v1 = { 0, -size/2 };
+            Vector2 v2 = { -size/2, size/2 };
+            Vector2 v3 = { size/2, size/2 };
+            
+            if (shape->filled) {
+                DrawTriangle(v1, v2, v3, shape->color);
+            } else {
+                DrawTriangleLines(v1, v2, v3, shape->color);
+            }
+        } break;
+        
+        case RAYPALS_STAR: {
+            float outerRadius = shape->size.x/2;
+            float innerRadius = outerRadius/3;  // Changed from outerRadius/2 to outerRadius/3 for more pronounced points
+            int points = shape->points > 0 ? shape->points : 5;
+            
+            // Draw star using DrawPoly which is more reliable
+            Vector2 starCenter = { 0, 0 };
+            Vector2 starPoints[20]; // Maximum 10 points (2 vertices per point)
+            int vertexCount = points * 2;
+            
+            if (vertexCount > 20) vertexCount = 20; // Safety check
+            
+            // Create vertices for star shape
+            for (int i = 0; i < points * 2; i++) {
+                float radius = i % 2 == 0 ? outerRadius : innerRadius;
+                float angle = i * PI / points - PI/2;
+                starPoints[i].x = cosf(angle) * radius;
+                starPoints[i].y = sinf(angle) * radius;
+            }
+            
+            if (shape->filled) {
+                // Draw filled star polygon
+                DrawPoly(starCenter, points * 2, outerRadius, shape->rotation, shape->color);
+                
+                // Draw explicit triangles as a fallback/supplement
+                Vector2 center = { 0, 0 };
+                for (int i = 0; i < points * 2; i+=2) {
+                    int next = (i + 1) % (points * 2);
+                    int nextOuter = (i + 2) % (points * 2);
+                    DrawTriangle(center, starPoints[i], starPoints[next], shape->color);
+                    DrawTriangle(center, starPoints[next], starPoints[nextOuter], shape->color);
+                }
+            } else {
+                // Draw star outline
+                for (int i = 0; i < points * 2; i++) {
+                    int next = (i + 1) % (points * 2);
+                    DrawLineV(starPoints[i], starPoints[next], shape->color);
+                }
+            }
+        } break;
+        
+        case RAYPALS_POLYGON: {
+            float radius = shape->size.x/2;
+            
+            if (shape->filled) {
+                DrawPolygon(radius, shape->segments, shape->color);
+            } else {
+                DrawPolygonLines(radius, shape->segments, shape->color);
+            }
+        } break;
+        
+        case RAYPALS_ARROW: {
+            float size = shape->size.x;
+            
+            if (shape->filled) {
+                DrawArrow(0, 0, size, shape->rotation, shape->color);
+            } else {
+                DrawArrowLines(0, 0, size, shape->rotation, shape->color);
+            }
+        } break;
+        
+        case RAYPALS_WATER_DROP: {
+            float radius = shape->size.x/2;
+            DrawWaterDrop(radius, shape->color, shape->filled);
+        } break;
+        
+        case RAYPALS_SKELETON: {
+            // We'll draw a simple skeleton outline
+            // The actual drawing is a simplified stick figure
+            float width = shape->size.x;
+            float height = shape->size.y;
+            
+            // Just draw a skeleton icon (simplified X shape with a circle on top)
+            if (shape->filled) {
+                DrawCircle(0, -height*0.35f, width*0.15f, shape->color); // Skull
+                DrawLine(0, -height*0.2f, 0, height*0.2f, shape->color); // Spine
+                DrawLine(-width*0.25f, -height*0.1f, width*0.25f, -height*0.1f, shape->color); // Shoulders
+                DrawLine(-width*0.25f, height*0.2f, width*0.25f, height*0.2f, shape->color); // Hips
+                DrawLine(-width*0.25f, -height*0.1f, -width*0.4f, 0, shape->color); // Left arm
+                DrawLine(width*0.25f, -height*0.1f, width*0.4f, 0, shape->color); // Right arm
+                DrawLine(0, height*0.2f, -width*0.3f, height*0.4f, shape->color); // Left leg
+                DrawLine(0, height*0.2f, width*0.3f, height*0.4f, shape->color); // Right leg
+            } else {
+                float thickness = shape->thickness;
+                DrawCircleLines(0, -height*0.35f, width*0.15f, shape->color); // Skull
+                DrawLineEx((Vector2){0, -height*0.2f}, (Vector2){0, height*0.2f}, thickness, shape->color); // Spine
+                DrawLineEx((Vector2){-width*0.25f, -height*0.1f}, (Vector2){width*0.25f, -height*0.1f}, thickness, shape->color); // Shoulders
+                DrawLineEx((Vector2){-width*0.25f, height*0.2f}, (Vector2){width*0.25f, height*0.2f}, thickness, shape->color); // Hips
+                DrawLineEx((Vector2){-width*0.25f, -height*0.1f}, (Vector2){-width*0.4f, 0}, thickness, shape->color); // Left arm
+                DrawLineEx((Vector2){width*0.25f, -height*0.1f}, (Vector2){width*0.4f, 0}, thickness, shape->color); // Right arm
+                DrawLineEx((Vector2){0, height*0.2f}, (Vector2){-width*0.3f, height*0.4f}, thickness, shape->color); // Left leg
+                DrawLineEx((Vector2){0, height*0.2f}, (Vector2){width*0.3f, height*0.4f}, thickness, shape->color); // Right leg
+            }
+        } break;
+        
+        default: break;
+    }
+    
+    // Restore matrix
+    rlPopMatrix();
 }
 
-RayPalsSprite* CreateSkateboard(Vector2 position, float size, Color deckColor, Color wheelColor) {
-    RayPalsSprite* sprite = CreateSprite(3);
-    if (sprite == NULL) return NULL;
-    
-    // Deck (board)
-    RayPals2DShape* deck = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size, size*0.25f }, deckColor);
+// 3D LOD settings and the state the triangle budget carries across a frame
+static RayPals3DLODSettings lod3DSettings = { false, 1.0f, 0.2f, 6, 0 };
+static float lod3DBudgetScale = 1.0f;   // Tolerance multiplier steered by the triangle budget
+static int lod3DFrameTriangles = 0;     // 3D triangles drawn since Begin3DLODFrame, LOD or not
+static int lod3DBudgetCut = 0;          // Triangles the budget fallback removed this frame
+
+#define RAYPALS_LOD3D_MAX_BUDGET_SCALE 64.0f
+
+void Set3DLODSettings(RayPals3DLODSettings settings) {
+    if (settings.tolerance <= 0.0f) settings.tolerance = 1.0f;
+    if (settings.hysteresis < 0.0f) settings.hysteresis = 0.0f;
+    if (settings.minSegments < 3) settings.minSegments = 3;
+    if (settings.triangleBudget < 0) settings.triangleBudget = 0;
     
-    // Wheels
-    RayPals2DShape* frontWheels = CreateRectangle((Vector2){ -size*0.35f, size*0.15f }, (Vector2){ size*0.15f, size*0.1f }, wheelColor);
-    RayPals2DShape* backWheels = CreateRectangle((Vector2){ size*0.35f, size*0.15f }, (Vector2){ size*0.15f, size*0.1f }, wheelColor);
+    lod3DSettings = settings;
+    lod3DBudgetScale = 1.0f;
+}
+
+RayPals3DLODSettings Get3DLODSettings(void) {
+    return lod3DSettings;
+}
+
+// Coarsens the next frame if the last one wanted more triangles than the budget, and
+// relaxes again once it fits comfortably
+void Begin3DLODFrame(void) {
+    int demand = lod3DFrameTriangles + lod3DBudgetCut;
+    if (lod3DSettings.enabled && lod3DSettings.triangleBudget > 0) {
+        if (demand > lod3DSettings.triangleBudget) {
+            lod3DBudgetScale = fminf(lod3DBudgetScale * 1.25f, RAYPALS_LOD3D_MAX_BUDGET_SCALE);
+        } else if (demand < lod3DSettings.triangleBudget * 0.8f) {
+            lod3DBudgetScale = fmaxf(lod3DBudgetScale / 1.1f, 1.0f);
+        }
+    }
+    lod3DFrameTriangles = 0;
+    lod3DBudgetCut = 0;
+}
+
+// Every path that draws 3D triangles reports them here, so all of them count towards the budget
+static void Count3DTriangles(int triangles) {
+    drawStats.triangles += triangles;
+    lod3DFrameTriangles += triangles;
+}
+
+// Segments of a LOD step: the shape's own count halved level times, not below the minimum
+static int Get3DLODStepSegments(int segments, int level) {
+    if (level == 0) return segments;
+    return (segments >> level) > lod3DSettings.minSegments ? (segments >> level) : lod3DSettings.minSegments;
+}
+
+static int Get3DLODMaxLevel(int segments) {
+    int level = 0;
+    while ((segments >> level) > lod3DSettings.minSegments) level++;
+    return level;
+}
+
+static int Get3DLODTriangles(RayPalsShapeType type, int segments) {
+    const RayPalsUnitMesh* mesh = Get3DUnitMesh(type, segments, false);
+    return mesh ? mesh->vertexCount / 3 : 0;
+}
+
+// Projected radius in pixels of the round cross-section of a unit mesh under a transform
+static float Get3DShapeScreenRadius(RayPalsShapeType type, const Matrix* transform, const Camera* camera) {
+    Vector3 center = TransformPoint(transform, type == RAYPALS_SPHERE ? (Vector3){ 0, 0, 0 } : (Vector3){ 0, 0.5f, 0 });
+    float radiusX = sqrtf(transform->m0*transform->m0 + transform->m1*transform->m1 + transform->m2*transform->m2);
+    float radiusZ = sqrtf(transform->m8*transform->m8 + transform->m9*transform->m9 + transform->m10*transform->m10);
+    float radius = fmaxf(radiusX, radiusZ);
+    float halfHeight = GetScreenHeight() * 0.5f;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, deck);
-    AddShapeToSprite(sprite, frontWheels);
-    AddShapeToSprite(sprite, backWheels);
+    if (camera->projection == CAMERA_ORTHOGRAPHIC) return radius * halfHeight / (camera->fovy * 0.5f);
     
-    // Set sprite position
-    sprite->position = position;
+    Vector3 offset = { center.x - camera->position.x, center.y - camera->position.y, center.z - camera->position.z };
+    float distance = sqrtf(offset.x*offset.x + offset.y*offset.y + offset.z*offset.z);
+    if (distance <= radius) return INFINITY;
+    return radius * halfHeight / (distance * tanf(camera->fovy * 0.5f * DEG2RAD));
+}
+
+// Segment count to draw a shape with: its own without a camera or with LOD disabled,
+// otherwise its current step moved towards what the projected size needs
+static int Choose3DShapeSegments(RayPals3DShape* shape, const Matrix* transform, const Camera* camera) {
+    if (!lod3DSettings.enabled || camera == NULL) return shape->segments;
+    if (shape->type != RAYPALS_SPHERE && shape->type != RAYPALS_CYLINDER && shape->type != RAYPALS_CONE) return shape->segments;
+    
+    int segments = shape->segments < 3 ? 3 : (shape->segments > RAYPALS_MESH_MAX_SEGMENTS ? RAYPALS_MESH_MAX_SEGMENTS : shape->segments);
+    int maxLevel = Get3DLODMaxLevel(segments);
+    int level = shape->lodLevel < 0 ? 0 : (shape->lodLevel > maxLevel ? maxLevel : shape->lodLevel);
+    
+    // Same chord bound as GetCircleLODSegments: a chord across 2*PI/n radians stays
+    // within r*(1 - cos(PI/n)) of the arc
+    float tolerance = lod3DSettings.tolerance * lod3DBudgetScale;
+    float screenRadius = Get3DShapeScreenRadius(shape->type, transform, camera);
+    float needed = screenRadius > tolerance ? PI / acosf(1.0f - tolerance/screenRadius) : 0.0f;
+    
+    while (level > 0 && Get3DLODStepSegments(segments, level) < needed) level--;
+    float coarsen = needed * (1.0f + lod3DSettings.hysteresis);
+    while (level < maxLevel && Get3DLODStepSegments(segments, level + 1) >= coarsen) level++;
+    shape->lodLevel = level;
+    
+    // Past the budget, this draw falls to coarser steps without touching the hysteresis state;
+    // at the coarsest step it is drawn anyway, so the budget is a target rather than a cap
+    if (lod3DSettings.triangleBudget > 0 && !shape->wireframe) {
+        int wanted = Get3DLODTriangles(shape->type, Get3DLODStepSegments(segments, level));
+        int triangles = wanted;
+        while (level < maxLevel && lod3DFrameTriangles + triangles > lod3DSettings.triangleBudget) {
+            triangles = Get3DLODTriangles(shape->type, Get3DLODStepSegments(segments, ++level));
+        }
+        lod3DBudgetCut += wanted - triangles;
+    }
     
-    return sprite;
+    return Get3DLODStepSegments(segments, level);
 }
 
-RayPalsSprite* CreateSword(Vector2 position, float size, Color bladeColor, Color hiltColor) {
-    RayPalsSprite* sprite = CreateSprite(4);
-    if (sprite == NULL) return NULL;
+// Streams a shape's unit mesh under a cached matrix, on top of the current rlgl matrix;
+// the camera (may be NULL) only drives LOD
+static void Draw3DShapeTransformed(RayPals3DShape* shape, const Matrix* transform, const Camera* camera) {
+    int segments = Choose3DShapeSegments(shape, transform, camera);
+    const RayPalsUnitMesh* mesh = Get3DUnitMesh(shape->type, segments, shape->wireframe);
+    if (mesh == NULL) return;
     
-    // Modified sword with pointed tip
+    if (mesh->mode == RL_TRIANGLES) Count3DTriangles(mesh->vertexCount / 3);
     
-    // Blade - now with a pointed triangular tip
-    RayPals2DShape* blade = CreateRectangle(
-        (Vector2){ 0, -size*0.15f }, 
-        (Vector2){ size*0.15f, size*0.6f }, 
-        bladeColor
-    );
+    rlPushMatrix();
+    ApplyTransform(transform);
+    EmitUnitMesh(mesh, shape->color);
+    rlPopMatrix();
+}
+
+// Open Begin3DBatch scopes; while positive the outermost scope's camera is applied
+static int batch3DDepth = 0;
+static Camera batch3DCamera;   // Camera of the outermost batch, used for LOD
+
+void Begin3DBatch(Camera camera) {
+    if (batch3DDepth++ > 0) return;
     
-    // Add a pointed tip (triangle)
-    RayPals2DShape* tip = CreateTriangle(
-        (Vector2){ 0, -size*0.5f }, 
-        size*0.15f, 
-        bladeColor
-    );
+    BeginMode3D(camera);
+    batch3DCamera = camera;
+    drawStats.flushes++;
+}
+
+void End3DBatch(void) {
+    if (batch3DDepth == 0 || --batch3DDepth > 0) return;
     
-    // Hilt/Handle
-    RayPals2DShape* handle = CreateRectangle(
-        (Vector2){ 0, size*0.3f }, 
-        (Vector2){ size*0.08f, size*0.3f }, 
-        hiltColor
-    );
+    EndMode3D();
+    drawStats.flushes++;
+}
+
+// Draw a 3D shape
+// If camera is NULL, assumes transformations are already set (e.g., called from Draw3DSprite)
+// If camera is provided, wraps drawing in BeginMode3D/EndMode3D unless a 3D batch is open
+void Draw3DShape(RayPals3DShape* shape, Camera *camera) { // Changed to Camera pointer
+    if (!shape || !shape->visible) return;
+
+    // Each BeginMode3D/EndMode3D pair flushes the rlgl batch twice
+    bool calledDirectly = (camera != NULL && batch3DDepth == 0);
+
+    if (calledDirectly) {
+        BeginMode3D(*camera);
+        drawStats.flushes++;
+    }
+
+    // The cached local matrix holds the position, rotations and the unit mesh scale
+    Draw3DShapeTransformed(shape, Refresh3DShapeLocalMatrix(shape), batch3DDepth > 0 ? &batch3DCamera : camera);
+
+    if (calledDirectly) {
+        EndMode3D();
+        drawStats.flushes++;
+    }
+}
+
+void Draw3DShapes(RayPals3DShape** shapes, int count, Camera camera) {
+    if (!shapes || count <= 0) return;
     
-    // Guard (cross piece)
-    RayPals2DShape* guard = CreateRectangle(
-        (Vector2){ 0, size*0.1f }, 
-        (Vector2){ size*0.4f, size*0.08f }, 
-        hiltColor
-    );
+    // Nested inside Begin3DBatch this reuses the enclosing scope and costs no extra flushes;
+    // LOD then follows the enclosing scope's camera, the one the shapes are drawn with
+    Begin3DBatch(camera);
+    const Camera* lodCamera = batch3DDepth > 0 ? &batch3DCamera : &camera;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, blade);
-    AddShapeToSprite(sprite, tip);
-    AddShapeToSprite(sprite, handle);
-    AddShapeToSprite(sprite, guard);
+    for (int i = 0; i < count; i++) {
+        if (shapes[i] && shapes[i]->visible) Draw3DShapeTransformed(shapes[i], Refresh3DShapeLocalMatrix(shapes[i]), lodCamera);
+    }
     
-    // Set sprite position
-    sprite->position = position;
+    End3DBatch();
+}
+
+// ----------------------------------------------------------------------------
+// Utility Functions
+// ----------------------------------------------------------------------------
+
+void SetShapeColor(RayPals2DShape* shape, Color color) {
+    if (!shape) return;
     
-    return sprite;
+    shape->color = color;
+    shape->version = NextContentStamp();
 }
 
-RayPalsSprite* CreateArrowSprite(Vector2 position, float size, Color shaftColor, Color headColor) {
-    RayPalsSprite* sprite = CreateSprite(3);
-    if (sprite == NULL) return NULL;
+void Set3DShapeColor(RayPals3DShape* shape, Color color) {
+    if (shape) shape->color = color;
+}
+
+void SetShapeRotation(RayPals2DShape* shape, float rotation) {
+    if (!shape) return;
     
-    // Arrow shaft
-    RayPals2DShape* shaft = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size*0.8f, size*0.1f }, shaftColor);
-    
-    // Arrow head (triangle)
-    RayPals2DShape* head = CreateTriangle((Vector2){ size*0.5f, 0 }, size*0.3f, headColor);
-    head->rotation = 90.0f;  // Rotate to point rightward
-    
-    // Arrow fletching (back)
-    RayPals2DShape* fletching = CreateTriangle((Vector2){ -size*0.4f, 0 }, size*0.2f, headColor);
-    fletching->rotation = -90.0f;  // Rotate to point leftward
+    shape->rotation = rotation;
+    shape->version = NextContentStamp();
+}
+
+void Set3DShapeRotation(RayPals3DShape* shape, Vector3 rotation) {
+    if (!shape) return;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, shaft);
-    AddShapeToSprite(sprite, head);
-    AddShapeToSprite(sprite, fletching);
+    shape->rotation = rotation;
+    shape->transformDirty = true;
+}
+
+void SetShapePosition(RayPals2DShape* shape, Vector2 position) {
+    if (!shape) return;
     
-    // Set sprite position
-    sprite->position = position;
+    shape->position = position;
+    shape->version = NextContentStamp();
+}
+
+void Set3DShapePosition(RayPals3DShape* shape, Vector3 position) {
+    if (!shape) return;
     
-    return sprite;
+    shape->position = position;
+    shape->transformDirty = true;
 }
 
-RayPalsSprite* CreateSailboat(Vector2 position, float size, Color hullColor, Color sailColor) {
-    RayPalsSprite* sprite = CreateSprite(4);
-    if (sprite == NULL) return NULL;
+void RotateShape(RayPals2DShape* shape, float deltaTime, float speed) {
+    if (!shape) return;
     
-    // Boat hull (bottom half of a rectangle, with flat top)
-    RayPals2DShape* hull = CreateRectangle((Vector2){ 0, size*0.2f }, (Vector2){ size, size*0.3f }, hullColor);
+    // Update rotation based on speed and delta time
+    shape->rotation += speed * deltaTime;
     
-    // Sail (triangle)
-    RayPals2DShape* sail = CreateTriangle((Vector2){ 0, -size*0.2f }, size*0.8f, sailColor);
-    sail->rotation = 90.0f;  // Rotate for proper orientation
+    // Normalize rotation to 0-360 degrees
+    while (shape->rotation >= 360.0f) shape->rotation -= 360.0f;
+    while (shape->rotation < 0.0f) shape->rotation += 360.0f;
     
-    // Mast (vertical pole)
-    RayPals2DShape* mast = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size*0.05f, size*0.7f }, BROWN);
+    shape->version = NextContentStamp();
+}
+
+void Rotate3DShape(RayPals3DShape* shape, float deltaTime, Vector3 speed) {
+    if (!shape) return;
     
-    // Water line (visual effect)
-    RayPals2DShape* waterLine = CreateRectangle((Vector2){ 0, size*0.35f }, (Vector2){ size*1.1f, size*0.05f }, BLUE);
+    // Update rotation based on speed and delta time
+    shape->rotation.x += speed.x * deltaTime;
+    shape->rotation.y += speed.y * deltaTime;
+    shape->rotation.z += speed.z * deltaTime;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, waterLine);
-    AddShapeToSprite(sprite, hull);
-    AddShapeToSprite(sprite, mast);
-    AddShapeToSprite(sprite, sail);
+    // Normalize rotation to 0-360 degrees
+    while (shape->rotation.x >= 360.0f) shape->rotation.x -= 360.0f;
+    while (shape->rotation.x < 0.0f) shape->rotation.x += 360.0f;
     
-    // Set sprite position
-    sprite->position = position;
+    while (shape->rotation.y >= 360.0f) shape->rotation.y -= 360.0f;
+    while (shape->rotation.y < 0.0f) shape->rotation.y += 360.0f;
     
-    return sprite;
-}
-
-// Helper function to clamp color values
-static unsigned char ClampColor(int value) {
-    if (value < 0) return 0;
-    if (value > 255) return 255;
-    return (unsigned char)value;
+    while (shape->rotation.z >= 360.0f) shape->rotation.z -= 360.0f;
+    while (shape->rotation.z < 0.0f) shape->rotation.z += 360.0f;
+    
+    shape->transformDirty = true;
 }
 
-RayPalsSprite* CreateStarSprite(Vector2 position, float size, Color color) {
-    RayPalsSprite* sprite = CreateSprite(2);
-    if (sprite == NULL) return NULL;
+void UpdateShapeAnimation(RayPals2DShape* shape, RayPalsAnimation* animation, float deltaTime) {
+    if (!shape || !animation || !animation->isAnimated) return;
     
-    // Default to yellow if color is not specified (has 0 values)
-    if (color.r == 0 && color.g == 0 && color.b == 0 && color.a == 0) {
-        color = YELLOW;  // Use raylib's yellow color
+    // Update animation time
+    animation->animationTime += deltaTime * animation->animationSpeed;
+    
+    // Calculate animation factor (0.0 to 1.0)
+    float factor = sinf(animation->animationTime);
+    if (animation->pingPong) {
+        factor = (factor + 1.0f) / 2.0f;  // Convert to 0.0 - 1.0 range
+    } else {
+        // For non-pingpong animations, use absolute value to create a more pronounced effect
+        factor = fabsf(factor);
     }
     
-    // Create a main 5-pointed star - making it bigger for better visibility
-    RayPals2DShape* mainStar = CreateStar((Vector2){ 0, 0 }, size * 1.2f, 5, color);
-    if (mainStar == NULL) {
-        FreeSprite(sprite);
-        return NULL;
+    // Apply rotation if rotation speed is not zero
+    if (animation->rotationSpeed != 0) {
+        shape->rotation += animation->rotationSpeed * deltaTime;
+        
+        // Normalize rotation to 0-360 degrees
+        while (shape->rotation >= 360.0f) shape->rotation -= 360.0f;
+        while (shape->rotation < 0.0f) shape->rotation += 360.0f;
+        shape->version = NextContentStamp();
     }
     
-    // Create a smaller inner star with different color for visual interest
-    Color innerColor = (Color){ 
-        ClampColor(color.r + 40), 
-        ClampColor(color.g + 40), 
-        ClampColor(color.b + 40), 
-        color.a 
-    };
+    // Apply scale if min/max are different
+    if (animation->scaleMin != animation->scaleMax) {
+        // Store the original size if not already stored
+        if (animation->originalWidth == 0 && animation->originalHeight == 0) {
+            animation->originalWidth = shape->size.x;
+            animation->originalHeight = shape->size.y;
+        }
+        
+        float scale = animation->scaleMin + factor * (animation->scaleMax - animation->scaleMin);
+        
+        // Apply scale to the original size, not the current size
+        shape->size.x = animation->originalWidth * scale;
+        shape->size.y = animation->originalHeight * scale;
+        shape->version = NextContentStamp();
+    }
     
-    // Use slightly larger inner star for better visibility
-    RayPals2DShape* innerStar = CreateStar((Vector2){ 0, 0 }, size*0.7f, 5, innerColor);
-    if (innerStar == NULL) {
-        FreeShape(mainStar);
-        FreeSprite(sprite);
-        return NULL;
+    // Apply color transition if colors are different
+    if (!ColorIsEqual(animation->colorStart, animation->colorEnd)) {
+        shape->color.r = (unsigned char)(animation->colorStart.r + factor * (animation->colorEnd.r - animation->colorStart.r));
+        shape->color.g = (unsigned char)(animation->colorStart.g + factor * (animation->colorEnd.g - animation->colorStart.g));
+        shape->color.b = (unsigned char)(animation->colorStart.b + factor * (animation->colorEnd.b - animation->colorStart.b));
+        shape->color.a = (unsigned char)(animation->colorStart.a + factor * (animation->colorEnd.a - animation->colorStart.a));
+        shape->version = NextContentStamp();
     }
+}
+
+void Update3DShapeAnimation(RayPals3DShape* shape, RayPalsAnimation* animation, float deltaTime) {
+    if (!shape || !animation || !animation->isAnimated) return;
     
-    // Make sure stars are visible
-    mainStar->visible = true;
-    innerStar->visible = true;
+    // Update animation time
+    animation->animationTime += deltaTime * animation->animationSpeed;
     
-    // Add shapes to sprite in right order (inner star on top)
-    AddShapeToSprite(sprite, mainStar);
-    AddShapeToSprite(sprite, innerStar);
+    // Calculate animation factor (0.0 to 1.0)
+    float factor = sinf(animation->animationTime);
+    if (animation->pingPong) {
+        factor = (factor + 1.0f) / 2.0f;  // Convert to 0.0 - 1.0 range
+    } else {
+        // For non-pingpong animations, use absolute value for more pronounced effect
+        factor = fabsf(factor);
+    }
     
-    // Set sprite position
-    sprite->position = position;
-    sprite->visible = true;
+    // Apply rotation if rotation speed is not zero
+    if (animation->rotationSpeed != 0) {
+        shape->rotation.y += animation->rotationSpeed * deltaTime;
+        
+        // Normalize rotation
+        while (shape->rotation.y >= 360.0f) shape->rotation.y -= 360.0f;
+        while (shape->rotation.y < 0.0f) shape->rotation.y += 360.0f;
+        shape->transformDirty = true;
+    }
     
-    return sprite;
+    // Apply scale if min/max are different
+    if (animation->scaleMin != animation->scaleMax) {
+        // Store the original size if not already stored
+        if (animation->originalWidth == 0) {
+            animation->originalWidth = shape->size.x;
+            animation->originalHeight = shape->size.y;
+            animation->originalDepth = shape->size.z;
+        }
+        
+        float scale = animation->scaleMin + factor * (animation->scaleMax - animation->scaleMin);
+        
+        // Apply scale to the original size, not the current size
+        shape->size.x = animation->originalWidth * scale;
+        shape->size.y = animation->originalHeight * scale;
+        shape->size.z = animation->originalDepth * scale;
+        shape->transformDirty = true;
+    }
+    
+    // Apply color transition if colors are different
+    if (!ColorIsEqual(animation->colorStart, animation->colorEnd)) {
+        shape->color.r = (unsigned char)(animation->colorStart.r + factor * (animation->colorEnd.r - animation->colorStart.r));
+        shape->color.g = (unsigned char)(animation->colorStart.g + factor * (animation->colorEnd.g - animation->colorStart.g));
+        shape->color.b = (unsigned char)(animation->colorStart.b + factor * (animation->colorEnd.b - animation->colorStart.b));
+        shape->color.a = (unsigned char)(animation->colorStart.a + factor * (animation->colorEnd.a - animation->colorStart.a));
+    }
 }
 
-RayPalsSprite* CreateFlower(Vector2 position, float size, Color petalColor, Color centerColor) {
-    RayPalsSprite* sprite = CreateSprite(6);
+void FreeShape(RayPals2DShape* shape) {
+    if (shape) {
+        RayPalsFree(shape->arena, shape);
+    }
+}
+
+void Free3DShape(RayPals3DShape* shape) {
+    if (shape) {
+        RayPalsFree(shape->arena, shape);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Sprite Functions
+// ----------------------------------------------------------------------------
+
+RayPalsSprite* CreateSprite(int initialCapacity) {
+    RayPalsSprite* sprite = (RayPalsSprite*)RayPalsAlloc(activeArena, sizeof(RayPalsSprite));
     if (sprite == NULL) return NULL;
     
-    // Create flower center
-    RayPals2DShape* center = CreateCircle((Vector2){ 0, 0 }, size*0.2f, centerColor);
-    
-    // Create petals (5 circles around the center)
-    float petalSize = size*0.3f;
-    float petalDistance = size*0.25f;
-    
-    RayPals2DShape* petal1 = CreateCircle((Vector2){ 0, -petalDistance }, petalSize, petalColor);
-    RayPals2DShape* petal2 = CreateCircle((Vector2){ petalDistance, 0 }, petalSize, petalColor);
-    RayPals2DShape* petal3 = CreateCircle((Vector2){ 0, petalDistance }, petalSize, petalColor);
-    RayPals2DShape* petal4 = CreateCircle((Vector2){ -petalDistance, 0 }, petalSize, petalColor);
-    RayPals2DShape* petal5 = CreateCircle((Vector2){ 0, 0 }, petalSize*1.3f, petalColor);
-    petal5->filled = false;
-    petal5->thickness = 2.0f;
+    if (initialCapacity < 1) initialCapacity = 1;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, petal1);
-    AddShapeToSprite(sprite, petal2);
-    AddShapeToSprite(sprite, petal3);
-    AddShapeToSprite(sprite, petal4);
-    AddShapeToSprite(sprite, petal5);
-    AddShapeToSprite(sprite, center);
+    sprite->arena = activeArena;
+    sprite->version = NextContentStamp();
+    sprite->shapes = (RayPals2DShape**)RayPalsAlloc(sprite->arena, sizeof(RayPals2DShape*) * initialCapacity);
+    if (sprite->shapes == NULL) {
+        RayPalsFree(sprite->arena, sprite);
+        return NULL;
+    }
     
-    // Set sprite position
-    sprite->position = position;
+    sprite->shapeCount = 0;
+    sprite->shapeCapacity = initialCapacity;
+    sprite->position = (Vector2){ 0, 0 };
+    sprite->rotation = 0.0f;
+    sprite->scale = 1.0f;
+    sprite->visible = true;
+    sprite->transformDirty = true;
     
     return sprite;
 }
 
-RayPalsSprite* CreateCoin(Vector2 position, float size, Color color) {
-    RayPalsSprite* sprite = CreateSprite(2);
+RayPalsSprite* CreateInlineSprite(int initialCapacity) {
+    RayPalsSprite* sprite = CreateSprite(initialCapacity);
     if (sprite == NULL) return NULL;
     
-    // Coin base (circle)
-    RayPals2DShape* coinBase = CreateCircle((Vector2){ 0, 0 }, size/2, color);
+    sprite->shapeStorage = (RayPals2DShape*)RayPalsAlloc(sprite->arena,
+                            sizeof(RayPals2DShape) * sprite->shapeCapacity);
+    if (sprite->shapeStorage == NULL) {
+        FreeSprite(sprite);
+        return NULL;
+    }
     
-    // Coin border/detail (inner circle)
-    Color darkerColor = (Color){ 
-        (unsigned char)(color.r * 0.8f), 
-        (unsigned char)(color.g * 0.8f), 
-        (unsigned char)(color.b * 0.8f), 
-        color.a 
-    };
+    return sprite;
+}
+
+// Points the shapes array at the inline storage again after the storage moved
+static void RelinkInlineShapes(RayPalsSprite* sprite) {
+    for (int i = 0; i < sprite->shapeCount; i++) {
+        sprite->shapes[i] = &sprite->shapeStorage[i];
+    }
+}
+
+static bool IsInlineShapeOf(const RayPalsSprite* sprite, const RayPals2DShape* shape) {
+    uintptr_t first = (uintptr_t)sprite->shapeStorage;
+    uintptr_t last = (uintptr_t)(sprite->shapeStorage + sprite->shapeCount);
+    return (uintptr_t)shape >= first && (uintptr_t)shape < last;
+}
+
+// Grows the shape arrays geometrically so repeated adds cost amortized O(1)
+static bool ReserveSpriteShapes(RayPalsSprite* sprite, int required) {
+    if (required <= sprite->shapeCapacity) return true;
     
-    RayPals2DShape* coinInner = CreateCircle((Vector2){ 0, 0 }, size*0.35f, darkerColor);
-    coinInner->filled = false;
-    coinInner->thickness = 2.0f;
+    int newCapacity = sprite->shapeCapacity > 0 ? sprite->shapeCapacity * 2 : 4;
+    if (newCapacity < required) newCapacity = required;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, coinBase);
-    AddShapeToSprite(sprite, coinInner);
+    RayPals2DShape** newShapes = (RayPals2DShape**)RayPalsRealloc(sprite->arena, sprite->shapes,
+                                  sizeof(RayPals2DShape*) * sprite->shapeCount,
+                                  sizeof(RayPals2DShape*) * newCapacity);
+    if (newShapes == NULL) return false;
+    sprite->shapes = newShapes;
     
-    // Set sprite position
-    sprite->position = position;
+    if (sprite->shapeStorage != NULL) {
+        RayPals2DShape* newStorage = (RayPals2DShape*)RayPalsRealloc(sprite->arena, sprite->shapeStorage,
+                                      sizeof(RayPals2DShape) * sprite->shapeCount,
+                                      sizeof(RayPals2DShape) * newCapacity);
+        if (newStorage == NULL) return false;
+        
+        sprite->shapeStorage = newStorage;
+        RelinkInlineShapes(sprite);
+    }
     
-    return sprite;
+    sprite->shapeCapacity = newCapacity;
+    return true;
 }
 
-RayPalsSprite* CreateKey(Vector2 position, float size, Color color) {
-    RayPalsSprite* sprite = CreateSprite(3);
-    if (sprite == NULL) return NULL;
+// Appends a shape to a sprite whose arrays already have room for it
+static void AppendSpriteShape(RayPalsSprite* sprite, RayPals2DShape* shape) {
+    sprite->version = NextContentStamp();
+    
+    if (sprite->shapeStorage != NULL) {
+        // Inline sprites copy the shape by value and take over the original allocation
+        sprite->shapeStorage[sprite->shapeCount] = *shape;
+        sprite->shapeStorage[sprite->shapeCount].arena = sprite->arena;
+        sprite->shapes[sprite->shapeCount] = &sprite->shapeStorage[sprite->shapeCount];
+        sprite->shapeCount++;
+        FreeShape(shape);
+        return;
+    }
     
-    // Key handle (circle)
-    RayPals2DShape* handle = CreateCircle((Vector2){ size*0.3f, 0 }, size*0.2f, color);
+    sprite->shapes[sprite->shapeCount] = shape;
+    sprite->shapeCount++;
+}
+
+void AddShapeToSprite(RayPalsSprite* sprite, RayPals2DShape* shape) {
+    if (!sprite || !shape) return;
     
-    // Key shaft (rectangle)
-    RayPals2DShape* shaft = CreateRectangle((Vector2){ -size*0.15f, 0 }, (Vector2){ size*0.7f, size*0.1f }, color);
+    if (sprite->shapeStorage != NULL && IsInlineShapeOf(sprite, shape)) {
+        // Re-adding one of the sprite's own inline shapes: copy it before the storage can move
+        RayPals2DShape value = *shape;
+        if (!ReserveSpriteShapes(sprite, sprite->shapeCount + 1)) return;
+        
+        sprite->shapeStorage[sprite->shapeCount] = value;
+        sprite->shapes[sprite->shapeCount] = &sprite->shapeStorage[sprite->shapeCount];
+        sprite->shapeCount++;
+        sprite->version = NextContentStamp();
+        return;
+    }
     
-    // Key teeth (rectangle)
-    RayPals2DShape* teeth = CreateRectangle((Vector2){ -size*0.4f, 0 }, (Vector2){ size*0.2f, size*0.3f }, color);
+    if (!ReserveSpriteShapes(sprite, sprite->shapeCount + 1)) return;
+    AppendSpriteShape(sprite, shape);
+}
+
+RayPals2DShape* GetSpriteShape(RayPalsSprite* sprite, int index) {
+    if (!sprite || index < 0 || index >= sprite->shapeCount) return NULL;
+    return sprite->shapes[index];
+}
+
+void AddShapesToSprite(RayPalsSprite* sprite, RayPals2DShape** shapes, int count) {
+    if (!sprite || !shapes || count <= 0) return;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, handle);
-    AddShapeToSprite(sprite, shaft);
-    AddShapeToSprite(sprite, teeth);
+    // One reservation for the whole batch
+    if (!ReserveSpriteShapes(sprite, sprite->shapeCount + count)) return;
     
-    // Set sprite position
-    sprite->position = position;
+    for (int i = 0; i < count; i++) {
+        if (shapes[i] != NULL) AppendSpriteShape(sprite, shapes[i]);
+    }
+}
+
+void ShrinkSpriteToFit(RayPalsSprite* sprite) {
+    if (!sprite || sprite->arena != NULL) return;  // Arena memory cannot be returned piecemeal
     
-    return sprite;
+    int newCapacity = sprite->shapeCount > 0 ? sprite->shapeCount : 1;
+    if (newCapacity == sprite->shapeCapacity) return;
+    
+    RayPals2DShape** newShapes = (RayPals2DShape**)realloc(sprite->shapes, sizeof(RayPals2DShape*) * newCapacity);
+    if (newShapes == NULL) return;
+    sprite->shapes = newShapes;
+    
+    if (sprite->shapeStorage != NULL) {
+        RayPals2DShape* newStorage = (RayPals2DShape*)realloc(sprite->shapeStorage, sizeof(RayPals2DShape) * newCapacity);
+        if (newStorage == NULL) return;  // The larger block is still valid, keep using it
+        
+        sprite->shapeStorage = newStorage;
+        RelinkInlineShapes(sprite);
+    }
+    
+    sprite->shapeCapacity = newCapacity;
 }
 
-RayPalsSprite* CreateShield(Vector2 position, float size, Color mainColor, Color borderColor) {
+bool MakeSpriteInline(RayPalsSprite* sprite) {
+    if (!sprite) return false;
+    if (sprite->shapeStorage != NULL) return true;
+    
+    RayPals2DShape* storage = (RayPals2DShape*)RayPalsAlloc(sprite->arena, sizeof(RayPals2DShape) * sprite->shapeCapacity);
+    if (storage == NULL) return false;
+    
+    for (int i = 0; i < sprite->shapeCount; i++) {
+        storage[i] = *sprite->shapes[i];
+        storage[i].arena = sprite->arena;
+        FreeShape(sprite->shapes[i]);
+    }
+    
+    sprite->shapeStorage = storage;
+    RelinkInlineShapes(sprite);
+    
+    return true;
+}
+
+RayPalsSprite* CreateSimpleCharacter(Vector2 position, float size, Color bodyColor, Color headColor) {
     RayPalsSprite* sprite = CreateSprite(2);
     if (sprite == NULL) return NULL;
     
-    // Main shield body - simple inverted triangle
-    RayPals2DShape* body = CreateTriangle((Vector2){ 0, 0 }, size, mainColor);
-    body->rotation = 180.0f;  // Rotate to point downward
+    // Create body (circle)
+    RayPals2DShape* body = CreateCircle((Vector2){ 0, size/4 }, size/2, bodyColor);
+    if (body == NULL) {
+        FreeSprite(sprite);
+        return NULL;
+    }
     
-    // Shield border
-    RayPals2DShape* border = CreateTriangle((Vector2){ 0, 0 }, size*1.05f, borderColor);
-    border->rotation = 180.0f;  // Rotate to point downward
-    border->filled = false;
-    border->thickness = 2.0f;
+    // Create head (circle)
+    RayPals2DShape* head = CreateCircle((Vector2){ 0, -size/2 }, size/3, headColor);
+    if (head == NULL) {
+        FreeShape(body);
+        FreeSprite(sprite);
+        return NULL;
+    }
     
-    // Add shapes to sprite in drawing order
-    AddShapeToSprite(sprite, border);
+    // Add shapes to sprite
     AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, head);
     
     // Set sprite position
     sprite->position = position;
@@ -1492,31 +2481,28 @@ RayPalsSprite* CreateShield(Vector2 position, float size, Color mainColor, Color
     return sprite;
 }
 
-RayPalsSprite* CreateCrown(Vector2 position, float size, Color color, Color gemColor) {
-    RayPalsSprite* sprite = CreateSprite(7);
+RayPalsSprite* CreateSimpleTree(Vector2 position, float size, Color trunkColor, Color leafColor) {
+    RayPalsSprite* sprite = CreateSprite(2);
     if (sprite == NULL) return NULL;
     
-    // Crown base (rectangle)
-    RayPals2DShape* base = CreateRectangle((Vector2){ 0, size*0.1f }, (Vector2){ size, size*0.3f }, color);
-    
-    // Crown points (triangles)
-    RayPals2DShape* point1 = CreateTriangle((Vector2){ -size*0.3f, -size*0.1f }, size*0.2f, color);
-    RayPals2DShape* point2 = CreateTriangle((Vector2){ 0, -size*0.2f }, size*0.3f, color);
-    RayPals2DShape* point3 = CreateTriangle((Vector2){ size*0.3f, -size*0.1f }, size*0.2f, color);
+    // Create trunk (rectangle)
+    RayPals2DShape* trunk = CreateRectangle((Vector2){ 0, size/4 }, (Vector2){ size/5, size/2 }, trunkColor);
+    if (trunk == NULL) {
+        FreeSprite(sprite);
+        return NULL;
+    }
     
-    // Crown gems (circles)
-    RayPals2DShape* gem1 = CreateCircle((Vector2){ -size*0.3f, 0 }, size*0.1f, gemColor);
-    RayPals2DShape* gem2 = CreateCircle((Vector2){ 0, -size*0.1f }, size*0.12f, gemColor);
-    RayPals2DShape* gem3 = CreateCircle((Vector2){ size*0.3f, 0 }, size*0.1f, gemColor);
+    // Create leaves (triangle)
+    RayPals2DShape* leaves = CreateTriangle((Vector2){ 0, -size/3 }, size, leafColor);
+    if (leaves == NULL) {
+        FreeShape(trunk);
+        FreeSprite(sprite);
+        return NULL;
+    }
     
     // Add shapes to sprite
-    AddShapeToSprite(sprite, base);
-    AddShapeToSprite(sprite, point1);
-    AddShapeToSprite(sprite, point2);
-    AddShapeToSprite(sprite, point3);
-    AddShapeToSprite(sprite, gem1);
-    AddShapeToSprite(sprite, gem2);
-    AddShapeToSprite(sprite, gem3);
+    AddShapeToSprite(sprite, trunk);
+    AddShapeToSprite(sprite, leaves);
     
     // Set sprite position
     sprite->position = position;
@@ -1524,74 +2510,21 @@ RayPalsSprite* CreateCrown(Vector2 position, float size, Color color, Color gemC
     return sprite;
 }
 
-RayPalsSprite* CreateLightningBolt(Vector2 position, float size, Color color) {
-    RayPalsSprite* sprite = CreateSprite(7);
+RayPalsSprite* CreateCloud(Vector2 position, float size, Color color) {
+    RayPalsSprite* sprite = CreateSprite(4);
     if (sprite == NULL) return NULL;
     
-    // Create a Harry Potter style lightning bolt
-    // Using connected triangles for sharp zigzag
-    float width = size * 0.2f;
-    
-    // Create zigzag segments using triangles
-    // Define each segment as a rectangle
-    
-    // First segment (top-right)
-    RayPals2DShape* seg1 = CreateRectangle(
-        (Vector2){ -size*0.1f, -size*0.4f }, 
-        (Vector2){ width, size*0.2f }, 
-        color
-    );
-    seg1->rotation = -35.0f;
-    
-    // Second segment (middle-left)
-    RayPals2DShape* seg2 = CreateRectangle(
-        (Vector2){ -size*0.15f, -size*0.2f }, 
-        (Vector2){ width, size*0.25f }, 
-        color
-    );
-    seg2->rotation = 40.0f;
-    
-    // Third segment (middle-right)
-    RayPals2DShape* seg3 = CreateRectangle(
-        (Vector2){ 0, 0 }, 
-        (Vector2){ width, size*0.2f }, 
-        color
-    );
-    seg3->rotation = -35.0f;
-    
-    // Fourth segment (bottom-left)
-    RayPals2DShape* seg4 = CreateRectangle(
-        (Vector2){ 0, size*0.2f }, 
-        (Vector2){ width, size*0.25f }, 
-        color
-    );
-    seg4->rotation = 45.0f;
-    
-    // Add a glow effect with slightly larger, semi-transparent shapes
-    Color glowColor = color;
-    glowColor.a = 120; // Semi-transparent
-    
-    RayPals2DShape* glow1 = CreateRectangle(
-        (Vector2){ -size*0.1f, -size*0.4f }, 
-        (Vector2){ width*1.5f, size*0.2f*1.5f }, 
-        glowColor
-    );
-    glow1->rotation = -35.0f;
-    
-    RayPals2DShape* glow2 = CreateRectangle(
-        (Vector2){ 0, size*0.2f }, 
-        (Vector2){ width*1.5f, size*0.25f*1.5f }, 
-        glowColor
-    );
-    glow2->rotation = 45.0f;
+    // Create cloud circles
+    RayPals2DShape* cloud1 = CreateCircle((Vector2){ -size/3, 0 }, size/3, color);
+    RayPals2DShape* cloud2 = CreateCircle((Vector2){ 0, -size/4 }, size/2.5f, color);
+    RayPals2DShape* cloud3 = CreateCircle((Vector2){ size/3, 0 }, size/3, color);
+    RayPals2DShape* cloud4 = CreateCircle((Vector2){ 0, size/8 }, size/3, color);
     
-    // Add shapes to sprite (glows first, then bolt)
-    AddShapeToSprite(sprite, glow1);
-    AddShapeToSprite(sprite, glow2);
-    AddShapeToSprite(sprite, seg1);
-    AddShapeToSprite(sprite, seg2);
-    AddShapeToSprite(sprite, seg3);
-    AddShapeToSprite(sprite, seg4);
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, cloud1);
+    AddShapeToSprite(sprite, cloud2);
+    AddShapeToSprite(sprite, cloud3);
+    AddShapeToSprite(sprite, cloud4);
     
     // Set sprite position
     sprite->position = position;
@@ -1599,27 +2532,29 @@ RayPalsSprite* CreateLightningBolt(Vector2 position, float size, Color color) {
     return sprite;
 }
 
-RayPalsSprite* CreateFish(Vector2 position, float size, Color bodyColor, Color finColor) {
-    RayPalsSprite* sprite = CreateSprite(4);
+RayPalsSprite* CreateHouse(Vector2 position, float size, Color wallColor, Color roofColor) {
+    RayPalsSprite* sprite = CreateSprite(5);
     if (sprite == NULL) return NULL;
     
-    // Fish body (oval/ellipse using a circle with scaling)
-    RayPals2DShape* body = CreateCircle((Vector2){ 0, 0 }, size*0.4f, bodyColor);
+    // House base
+    RayPals2DShape* base = CreateRectangle((Vector2){ 0, size/8 }, (Vector2){ size, size*0.8f }, wallColor);
     
-    // Fish tail (triangle)
-    RayPals2DShape* tail = CreateTriangle((Vector2){ size*0.4f, 0 }, size*0.3f, finColor);
-    tail->rotation = 90.0f;
+    // Roof
+    RayPals2DShape* roof = CreateTriangle((Vector2){ 0, -size/2 }, size*1.2f, roofColor);
     
-    // Fish fins (triangles)
-    RayPals2DShape* topFin = CreateTriangle((Vector2){ 0, -size*0.3f }, size*0.2f, finColor);
-    RayPals2DShape* bottomFin = CreateTriangle((Vector2){ 0, size*0.3f }, size*0.2f, finColor);
-    bottomFin->rotation = 180.0f;
+    // Door
+    RayPals2DShape* door = CreateRectangle((Vector2){ 0, size/3 }, (Vector2){ size/4, size/3 }, BROWN);
+    
+    // Windows
+    RayPals2DShape* window1 = CreateRectangle((Vector2){ -size/3, 0 }, (Vector2){ size/5, size/5 }, SKYBLUE);
+    RayPals2DShape* window2 = CreateRectangle((Vector2){ size/3, 0 }, (Vector2){ size/5, size/5 }, SKYBLUE);
     
     // Add shapes to sprite
-    AddShapeToSprite(sprite, tail);
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, topFin);
-    AddShapeToSprite(sprite, bottomFin);
+    AddShapeToSprite(sprite, base);
+    AddShapeToSprite(sprite, roof);
+    AddShapeToSprite(sprite, door);
+    AddShapeToSprite(sprite, window1);
+    AddShapeToSprite(sprite, window2);
     
     // Set sprite position
     sprite->position = position;
@@ -1627,39 +2562,43 @@ RayPalsSprite* CreateFish(Vector2 position, float size, Color bodyColor, Color f
     return sprite;
 }
 
-RayPalsSprite* CreateGem(Vector2 position, float size, Color color) {
-    RayPalsSprite* sprite = CreateSprite(4);
+RayPalsSprite* CreateCastle(Vector2 position, float size, Color wallColor, Color roofColor) {
+    RayPalsSprite* sprite = CreateSprite(10);
     if (sprite == NULL) return NULL;
     
-    // Create a diamond shape - main body
-    RayPals2DShape* mainGem = CreatePolygon((Vector2){ 0, 0 }, size/2, 8, color);
-    mainGem->rotation = 22.5f;  // Rotate to get diamond orientation
+    // Main castle body (rectangle)
+    RayPals2DShape* body = CreateRectangle((Vector2){ 0, size/4 }, (Vector2){ size, size*0.8f }, wallColor);
     
-    // Create a smaller interior with lighter color for "sparkle"
-    Color lighterColor = (Color){ 
-        ClampColor(color.r + 80), 
-        ClampColor(color.g + 80), 
-        ClampColor(color.b + 80), 
-        color.a 
-    };
+    // Main tower (rectangle)
+    RayPals2DShape* mainTower = CreateRectangle((Vector2){ 0, -size/3 }, (Vector2){ size*0.4f, size*0.6f }, wallColor);
     
-    RayPals2DShape* innerGem = CreatePolygon((Vector2){ -size*0.05f, -size*0.05f }, size/2*0.6f, 8, lighterColor);
-    innerGem->rotation = 22.5f;
+    // Side towers (rectangles)
+    RayPals2DShape* leftTower = CreateRectangle((Vector2){ -size*0.4f, -size/3 }, (Vector2){ size*0.3f, size*0.5f }, wallColor);
+    RayPals2DShape* rightTower = CreateRectangle((Vector2){ size*0.4f, -size/3 }, (Vector2){ size*0.3f, size*0.5f }, wallColor);
     
-    // Add a small star for sparkle effect
-    RayPals2DShape* sparkle = CreateStar((Vector2){ -size*0.15f, -size*0.15f }, size*0.15f, 4, WHITE);
+    // Roofs (triangles)
+    RayPals2DShape* mainRoof = CreateTriangle((Vector2){ 0, -size*0.6f }, size*0.5f, roofColor);
+    RayPals2DShape* leftRoof = CreateTriangle((Vector2){ -size*0.4f, -size*0.55f }, size*0.4f, roofColor);
+    RayPals2DShape* rightRoof = CreateTriangle((Vector2){ size*0.4f, -size*0.55f }, size*0.4f, roofColor);
     
-    // Add border outline
-    RayPals2DShape* border = CreatePolygon((Vector2){ 0, 0 }, size/2*1.02f, 8, BLACK);
-    border->filled = false;
-    border->thickness = 1.5f;
-    border->rotation = 22.5f;
+    // Castle gate (rectangle)
+    RayPals2DShape* gate = CreateRectangle((Vector2){ 0, size/3 }, (Vector2){ size*0.3f, size*0.4f }, BROWN);
+    
+    // Windows (circles)
+    RayPals2DShape* window1 = CreateCircle((Vector2){ -size*0.2f, 0 }, size*0.1f, SKYBLUE);
+    RayPals2DShape* window2 = CreateCircle((Vector2){ size*0.2f, 0 }, size*0.1f, SKYBLUE);
     
     // Add shapes to sprite
-    AddShapeToSprite(sprite, border);
-    AddShapeToSprite(sprite, mainGem);
-    AddShapeToSprite(sprite, innerGem);
-    AddShapeToSprite(sprite, sparkle);
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, mainTower);
+    AddShapeToSprite(sprite, leftTower);
+    AddShapeToSprite(sprite, rightTower);
+    AddShapeToSprite(sprite, mainRoof);
+    AddShapeToSprite(sprite, leftRoof);
+    AddShapeToSprite(sprite, rightRoof);
+    AddShapeToSprite(sprite, gate);
+    AddShapeToSprite(sprite, window1);
+    AddShapeToSprite(sprite, window2);
     
     // Set sprite position
     sprite->position = position;
@@ -1667,29 +2606,59 @@ RayPalsSprite* CreateGem(Vector2 position, float size, Color color) {
     return sprite;
 }
 
-// ----------------------------------------------------------------------------
-// Animation Functions
-// ----------------------------------------------------------------------------
-
-// UpdateShapeAnimation and Update3DShapeAnimation functions are already defined above
+RayPalsSprite* CreateBush(Vector2 position, float size, Color color) {
+    RayPalsSprite* sprite = CreateSprite(3);
+    if (sprite == NULL) return NULL;
+    
+    // Bush circles
+    RayPals2DShape* bush1 = CreateCircle((Vector2){ -size/4, 0 }, size/2, color);
+    RayPals2DShape* bush2 = CreateCircle((Vector2){ size/4, 0 }, size/2, color);
+    RayPals2DShape* bush3 = CreateCircle((Vector2){ 0, -size/4 }, size/2, color);
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, bush1);
+    AddShapeToSprite(sprite, bush2);
+    AddShapeToSprite(sprite, bush3);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
 
-// The CreateWaterDrop function is already defined earlier in the file (line ~230)
-// No duplicate implementation needed here
+RayPalsSprite* CreateRock(Vector2 position, float size, Color color) {
+    RayPalsSprite* sprite = CreateSprite(1);
+    if (sprite == NULL) return NULL;
+    
+    // Just create a simple circle for the rock with the specified color
+    RayPals2DShape* rock = CreateCircle((Vector2){ 0, 0 }, size/2, color);
+    
+    // Add shape to sprite
+    AddShapeToSprite(sprite, rock);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
 
-RayPalsSprite* CreateWaterDropSprite(Vector2 position, float size, Color color) {
-    RayPalsSprite* sprite = CreateSprite(2);
+RayPalsSprite* CreateRobotCharacter(Vector2 position, float size, Color primaryColor, Color secondaryColor) {
+    RayPalsSprite* sprite = CreateSprite(4);
     if (sprite == NULL) return NULL;
     
-    // Create the drop shape using a circle for the main part and a triangle for the pointed end
-    RayPals2DShape* dropBody = CreateCircle((Vector2){ 0, -size*0.1f }, size*0.4f, color);
+    // Create robot parts
+    RayPals2DShape* body = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size*0.8f, size }, primaryColor);
+    RayPals2DShape* head = CreateRectangle((Vector2){ 0, -size*0.6f }, (Vector2){ size*0.6f, size*0.5f }, primaryColor);
     
-    // Create drop point (triangle)
-    RayPals2DShape* dropPoint = CreateTriangle((Vector2){ 0, size*0.3f }, size*0.4f, color);
-    dropPoint->rotation = 180.0f; // Point facing downward
+    // Eyes
+    RayPals2DShape* eye1 = CreateCircle((Vector2){ -size*0.15f, -size*0.6f }, size*0.1f, secondaryColor);
+    RayPals2DShape* eye2 = CreateCircle((Vector2){ size*0.15f, -size*0.6f }, size*0.1f, secondaryColor);
     
     // Add shapes to sprite
-    AddShapeToSprite(sprite, dropBody);
-    AddShapeToSprite(sprite, dropPoint);
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, head);
+    AddShapeToSprite(sprite, eye1);
+    AddShapeToSprite(sprite, eye2);
     
     // Set sprite position
     sprite->position = position;
@@ -1697,61 +2666,112 @@ RayPalsSprite* CreateWaterDropSprite(Vector2 position, float size, Color color)
     return sprite;
 }
 
-RayPalsSprite* CreateHorseSprite(Vector2 position, float size, Color bodyColor) {
+RayPalsSprite* CreateAnimalCharacter(Vector2 position, float size, Color bodyColor, Color detailColor) {
     RayPalsSprite* sprite = CreateSprite(6);
     if (sprite == NULL) return NULL;
     
-    // Body - slightly elongated rectangle
-    RayPals2DShape* body = CreateRectangle(
-        (Vector2){ 0, 0 }, 
-        (Vector2){ size*1.8f, size*0.8f }, 
-        bodyColor
-    );
+    // Create animal parts (e.g., a simple cat)
+    RayPals2DShape* body = CreateCircle((Vector2){ 0, size*0.1f }, size*0.4f, bodyColor);
+    RayPals2DShape* head = CreateCircle((Vector2){ 0, -size*0.3f }, size*0.3f, bodyColor);
+    RayPals2DShape* ear1 = CreateTriangle((Vector2){ -size*0.2f, -size*0.5f }, size*0.2f, bodyColor);
+    RayPals2DShape* ear2 = CreateTriangle((Vector2){ size*0.2f, -size*0.5f }, size*0.2f, bodyColor);
     
-    // Head - rectangle with rotation
-    RayPals2DShape* head = CreateRectangle(
-        (Vector2){ size*0.9f, -size*0.6f }, 
-        (Vector2){ size*0.8f, size*0.4f }, 
-        bodyColor
-    );
-    head->rotation = 45.0f;
+    // Eyes
+    RayPals2DShape* eye1 = CreateCircle((Vector2){ -size*0.1f, -size*0.3f }, size*0.05f, detailColor);
+    RayPals2DShape* eye2 = CreateCircle((Vector2){ size*0.1f, -size*0.3f }, size*0.05f, detailColor);
     
-    // Neck - connecting body and head
-    RayPals2DShape* neck = CreateRectangle(
-        (Vector2){ size*0.6f, -size*0.3f }, 
-        (Vector2){ size*0.4f, size*0.7f }, 
-        bodyColor
-    );
-    neck->rotation = 30.0f;
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, head);
+    AddShapeToSprite(sprite, ear1);
+    AddShapeToSprite(sprite, ear2);
+    AddShapeToSprite(sprite, eye1);
+    AddShapeToSprite(sprite, eye2);
     
-    // Tail
-    RayPals2DShape* tail = CreateRectangle(
-        (Vector2){ -size*0.9f, -size*0.4f }, 
-        (Vector2){ size*0.5f, size*0.2f }, 
-        bodyColor
-    );
-    tail->rotation = -35.0f;
+    // Set sprite position
+    sprite->position = position;
     
-    // Legs (front and back)
-    RayPals2DShape* frontLeg = CreateRectangle(
-        (Vector2){ size*0.5f, size*0.6f }, 
-        (Vector2){ size*0.2f, size*0.8f }, 
-        bodyColor
-    );
+    return sprite;
+}
+
+RayPalsSprite* CreateGhost(Vector2 position, float size, Color color) {
+    RayPalsSprite* sprite = CreateSprite(6);
+    if (sprite == NULL) return NULL;
     
-    RayPals2DShape* backLeg = CreateRectangle(
-        (Vector2){ -size*0.5f, size*0.6f }, 
-        (Vector2){ size*0.2f, size*0.8f }, 
-        bodyColor
-    );
+    // Main ghost body (half-circle on top, wavy bottom)
+    RayPals2DShape* body = CreateCircle((Vector2){ 0, -size*0.15f }, size*0.4f, color);
+    body->filled = true;
     
-    // Add shapes to sprite in proper order
-    AddShapeToSprite(sprite, tail);
+    // Bottom part of ghost created with triangles
+    RayPals2DShape* bottom1 = CreateTriangle((Vector2){ -size*0.3f, size*0.3f }, size*0.3f, color);
+    RayPals2DShape* bottom2 = CreateTriangle((Vector2){ 0, size*0.3f }, size*0.3f, color);
+    RayPals2DShape* bottom3 = CreateTriangle((Vector2){ size*0.3f, size*0.3f }, size*0.3f, color);
+    
+    // Eyes
+    RayPals2DShape* eye1 = CreateCircle((Vector2){ -size*0.15f, -size*0.2f }, size*0.07f, BLACK);
+    RayPals2DShape* eye2 = CreateCircle((Vector2){ size*0.15f, -size*0.2f }, size*0.07f, BLACK);
+    
+    // Add shapes to sprite
     AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, neck);
-    AddShapeToSprite(sprite, head);
-    AddShapeToSprite(sprite, frontLeg);
-    AddShapeToSprite(sprite, backLeg);
+    AddShapeToSprite(sprite, bottom1);
+    AddShapeToSprite(sprite, bottom2);
+    AddShapeToSprite(sprite, bottom3);
+    AddShapeToSprite(sprite, eye1);
+    AddShapeToSprite(sprite, eye2);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateButton(Vector2 position, Vector2 size, Color bgColor, Color borderColor) {
+    RayPalsSprite* sprite = CreateSprite(2);
+    if (sprite == NULL) return NULL;
+    
+    // Button background
+    RayPals2DShape* background = CreateRectangle((Vector2){ 0, 0 }, size, bgColor);
+    background->filled = true;
+    
+    // Button border
+    RayPals2DShape* border = CreateRectangle((Vector2){ 0, 0 }, size, borderColor);
+    border->filled = false;
+    border->thickness = 2.0f;
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, background);
+    AddShapeToSprite(sprite, border);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateHealthBar(Vector2 position, float width, float fillPercent, Color emptyColor, Color fillColor) {
+    if (fillPercent < 0.0f) fillPercent = 0.0f;
+    if (fillPercent > 1.0f) fillPercent = 1.0f;
+    
+    RayPalsSprite* sprite = CreateSprite(2);
+    if (sprite == NULL) return NULL;
+    
+    float height = width * 0.15f;
+    
+    // Bar background
+    RayPals2DShape* background = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ width, height }, emptyColor);
+    background->filled = true;
+    
+    // Calculate fill width
+    float fillWidth = width * fillPercent;
+    float fillOffsetX = (width - fillWidth) * 0.5f;
+    
+    // Bar fill
+    RayPals2DShape* fill = CreateRectangle((Vector2){ -fillOffsetX, 0 }, (Vector2){ fillWidth, height * 0.8f }, fillColor);
+    fill->filled = true;
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, background);
+    AddShapeToSprite(sprite, fill);
     
     // Set sprite position
     sprite->position = position;
@@ -1759,54 +2779,2468 @@ RayPalsSprite* CreateHorseSprite(Vector2 position, float size, Color bodyColor)
     return sprite;
 }
 
-RayPalsSprite* CreateYellowStar(Vector2 position, float size) {
-    // Create a bright yellow star that's clearly visible
-    Color brightYellow = (Color){ 255, 255, 0, 255 }; // Maximum brightness yellow
-    
-    // Create a star with yellow color and increased size for visibility
-    RayPalsSprite* star = CreateStarSprite(position, size * 1.2f, brightYellow);
-    
-    // Apply additional settings if needed
-    if (star) {
-        // Ensure the star is visible
-        star->visible = true;
+void DrawSprite(RayPalsSprite* sprite) {
+    if (!sprite || !sprite->visible) return;
+    
+    // Pick the LOD bucket from the on-screen scale before the sprite transform is pushed
+    int lodBucket = GetLODBucket(lodSettings.enabled ? GetCurrentViewScale() * sprite->scale : 0.0f);
+    
+    // Save current matrix to restore later
+    rlPushMatrix();
+    
+    // Apply the cached sprite transform
+    ApplyTransform(RefreshSpriteMatrix(sprite));
+    
+    drawStats.sprites++;
+    
+    // Stream the cached tessellation; fall back to per-shape drawing if it cannot be built
+    if (UpdateSpriteCache(sprite, lodBucket)) {
+        DrawSpriteCache(sprite->cache, WHITE);
+    } else if (sprite->shapeStorage != NULL) {
+        for (int i = 0; i < sprite->shapeCount; i++) {
+            Draw2DShape(&sprite->shapeStorage[i]);
+        }
+    } else {
+        for (int i = 0; i < sprite->shapeCount; i++) {
+            Draw2DShape(sprite->shapes[i]);
+        }
+    }
+    
+    // Restore matrix
+    rlPopMatrix();
+}
+
+void DrawSpriteBatched(RayPalsSprite* sprite) {
+    DrawSpritesBatched(&sprite, 1);
+}
+
+// World bounds of a sprite. A stale cache is rebuilt for lodBucket (the bucket the
+// caller is about to draw with); otherwise the cached local bounds are reused whatever
+// their LOD, and the world box is only recomputed when the transform moved.
+static Rectangle GetSpriteBoundsForBucket(RayPalsSprite* sprite, int lodBucket) {
+    if (IsSpriteCacheStale(sprite) && !UpdateSpriteCache(sprite, lodBucket)) {
+        Rectangle local = ComputeShapesBounds(sprite->shapes, NULL, sprite->shapeCount);
+        return TransformBounds(local, sprite->position, sprite->rotation, sprite->scale);
+    }
+    
+    RayPalsSpriteCache* cache = sprite->cache;
+    if (!cache->worldBoundsValid || cache->boundsPosition.x != sprite->position.x ||
+        cache->boundsPosition.y != sprite->position.y || cache->boundsRotation != sprite->rotation ||
+        cache->boundsScale != sprite->scale) {
+        cache->worldBounds = TransformBounds(cache->localBounds, sprite->position, sprite->rotation, sprite->scale);
+        cache->boundsPosition = sprite->position;
+        cache->boundsRotation = sprite->rotation;
+        cache->boundsScale = sprite->scale;
+        cache->worldBoundsValid = true;
+    }
+    
+    return cache->worldBounds;
+}
+
+// Draws sprites in one triangle run, skipping those outside view when view is not NULL.
+// Returns the number of sprites drawn.
+static int DrawSpriteList(RayPalsSprite** sprites, int count, const Rectangle* view) {
+    if (!sprites || count <= 0) return 0;
+    
+    // Bring every cache up to date first so the triangle run is not interrupted
+    float viewScale = lodSettings.enabled ? GetCurrentViewScale() : 0.0f;
+    bool fallback = false;
+    for (int i = 0; i < count; i++) {
+        RayPalsSprite* sprite = sprites[i];
+        if (!sprite || !sprite->visible) continue;
+        
+        int lodBucket = GetLODBucket(viewScale * sprite->scale);
+        if (view != NULL && !BoundsOverlap(GetSpriteBoundsForBucket(sprite, lodBucket), *view)) continue;
+        if (!UpdateSpriteCache(sprite, lodBucket)) fallback = true;
+    }
+    
+    int drawn = 0;
+    rlBegin(RL_TRIANGLES);
+    
+    for (int i = 0; i < count; i++) {
+        RayPalsSprite* sprite = sprites[i];
+        if (!sprite || !sprite->visible || IsSpriteCacheStale(sprite)) continue;
+        
+        // The bounds are cached, so testing again here costs a comparison of the transform
+        if (view != NULL && !BoundsOverlap(GetSpriteBoundsForBucket(sprite, sprite->cache->lodBucket), *view)) {
+            drawStats.culled++;
+            continue;
+        }
+        
+        EmitSpriteCache(sprite->cache, RefreshSpriteMatrix(sprite), WHITE);
+        drawStats.sprites++;
+        drawn++;
+    }
+    
+    rlEnd();
+    drawStats.batches++;
+    
+    // Sprites whose cache could not be allocated are drawn the immediate way afterwards
+    if (fallback) {
+        for (int i = 0; i < count; i++) {
+            RayPalsSprite* sprite = sprites[i];
+            if (!sprite || !sprite->visible || !IsSpriteCacheStale(sprite)) continue;
+            if (view != NULL && !BoundsOverlap(GetSpriteBoundsForBucket(sprite, RAYPALS_LOD_OFF), *view)) continue;
+            
+            DrawSprite(sprite);
+            drawn++;
+        }
+    }
+    
+    return drawn;
+}
+
+void DrawSpritesBatched(RayPalsSprite** sprites, int count) {
+    DrawSpriteList(sprites, count, NULL);
+}
+
+Rectangle GetSpriteBounds(RayPalsSprite* sprite) {
+    if (!sprite) return (Rectangle){ 0, 0, 0, 0 };
+    return GetSpriteBoundsForBucket(sprite, sprite->cache != NULL ? sprite->cache->lodBucket : RAYPALS_LOD_OFF);
+}
+
+Rectangle GetCameraViewBounds(Camera2D camera) {
+    float width = (float)GetScreenWidth();
+    float height = (float)GetScreenHeight();
+    Vector2 corners[4] = {
+        GetScreenToWorld2D((Vector2){ 0, 0 }, camera),
+        GetScreenToWorld2D((Vector2){ width, 0 }, camera),
+        GetScreenToWorld2D((Vector2){ 0, height }, camera),
+        GetScreenToWorld2D((Vector2){ width, height }, camera)
+    };
+    
+    // A rotated camera sees a rotated rectangle; keep the box around it
+    float minX = corners[0].x, minY = corners[0].y, maxX = corners[0].x, maxY = corners[0].y;
+    for (int i = 1; i < 4; i++) {
+        if (corners[i].x < minX) minX = corners[i].x;
+        if (corners[i].x > maxX) maxX = corners[i].x;
+        if (corners[i].y < minY) minY = corners[i].y;
+        if (corners[i].y > maxY) maxY = corners[i].y;
+    }
+    
+    return (Rectangle){ minX, minY, maxX - minX, maxY - minY };
+}
+
+int DrawSpritesCulled(RayPalsSprite** sprites, int count, Camera2D camera) {
+    Rectangle view = GetCameraViewBounds(camera);
+    return DrawSpriteList(sprites, count, &view);
+}
+
+RayPalsDrawStats GetDrawStats(void) {
+    return drawStats;
+}
+
+void ResetDrawStats(void) {
+    drawStats = (RayPalsDrawStats){ 0 };
+}
+
+void MarkSpriteDirty(RayPalsSprite* sprite) {
+    if (!sprite) return;
+    
+    sprite->version = NextContentStamp();
+    sprite->transformDirty = true;
+}
+
+Matrix GetSpriteMatrix(RayPalsSprite* sprite) {
+    if (!sprite) return MakeSpriteMatrix((Vector2){ 0, 0 }, 0.0f, 1.0f);
+    return *RefreshSpriteMatrix(sprite);
+}
+
+int GetSpriteCachedVertexCount(const RayPalsSprite* sprite) {
+    if (!sprite || !sprite->cache || IsSpriteCacheStale(sprite)) return 0;
+    return sprite->cache->vertexCount;
+}
+
+void RotateSprite(RayPalsSprite* sprite, float deltaTime, float speed) {
+    if (!sprite) return;
+    
+    sprite->rotation += speed * deltaTime;
+    
+    // Normalize rotation to 0-360 degrees
+    while (sprite->rotation >= 360.0f) sprite->rotation -= 360.0f;
+    while (sprite->rotation < 0.0f) sprite->rotation += 360.0f;
+    
+    sprite->transformDirty = true;
+}
+
+void SetSpritePosition(RayPalsSprite* sprite, Vector2 position) {
+    if (!sprite) return;
+    
+    sprite->position = position;
+    sprite->transformDirty = true;
+}
+
+void SetSpriteRotation(RayPalsSprite* sprite, float rotation) {
+    if (!sprite) return;
+    
+    sprite->rotation = rotation;
+    sprite->transformDirty = true;
+}
+
+void SetSpriteScale(RayPalsSprite* sprite, float scale) {
+    if (!sprite) return;
+    
+    sprite->scale = scale;
+    sprite->transformDirty = true;
+}
+
+void FreeSprite(RayPalsSprite* sprite) {
+    if (!sprite) return;
+    
+    // Free all shapes in the sprite (inline shapes go away with their storage)
+    if (sprite->shapeStorage != NULL) {
+        RayPalsFree(sprite->arena, sprite->shapeStorage);
+    } else {
+        for (int i = 0; i < sprite->shapeCount; i++) {
+            FreeShape(sprite->shapes[i]);
+        }
+    }
+    
+    // Free the cache, the shapes array and the sprite itself
+    FreeSpriteCache(sprite->cache);
+    RayPalsFree(sprite->arena, sprite->shapes);
+    RayPalsFree(sprite->arena, sprite);
+}
+
+RayPalsSprite* CreateCar(Vector2 position, float size, Color bodyColor, Color detailColor) {
+    RayPalsSprite* sprite = CreateSprite(5);
+    if (sprite == NULL) return NULL;
+    
+    // Car body (main rectangle)
+    RayPals2DShape* body = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size, size*0.5f }, bodyColor);
+    
+    // Car roof/cabin (smaller rectangle)
+    RayPals2DShape* roof = CreateRectangle((Vector2){ -size*0.1f, -size*0.15f }, (Vector2){ size*0.5f, size*0.3f }, bodyColor);
+    
+    // Wheels
+    RayPals2DShape* wheel1 = CreateCircle((Vector2){ -size*0.3f, size*0.25f }, size*0.15f, detailColor);
+    RayPals2DShape* wheel2 = CreateCircle((Vector2){ size*0.3f, size*0.25f }, size*0.15f, detailColor);
+    
+    // Windshield
+    RayPals2DShape* windshield = CreateRectangle((Vector2){ -size*0.1f, -size*0.15f }, (Vector2){ size*0.5f*0.8f, size*0.3f*0.8f }, SKYBLUE);
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, roof);
+    AddShapeToSprite(sprite, wheel1);
+    AddShapeToSprite(sprite, wheel2);
+    AddShapeToSprite(sprite, windshield);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateTank(Vector2 position, float size, Color bodyColor, Color detailColor) {
+    RayPalsSprite* sprite = CreateSprite(4);
+    if (sprite == NULL) return NULL;
+    
+    // Tank base/body
+    RayPals2DShape* base = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size*1.2f, size*0.5f }, bodyColor);
+    
+    // Tank turret (circle)
+    RayPals2DShape* turret = CreateCircle((Vector2){ 0, -size*0.2f }, size*0.25f, bodyColor);
+    
+    // Tank cannon (rectangle)
+    RayPals2DShape* cannon = CreateRectangle((Vector2){ size*0.4f, -size*0.2f }, (Vector2){ size*0.6f, size*0.1f }, bodyColor);
+    
+    // Tank treads
+    RayPals2DShape* treads = CreateRectangle((Vector2){ 0, size*0.15f }, (Vector2){ size*1.1f, size*0.2f }, detailColor);
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, treads);
+    AddShapeToSprite(sprite, base);
+    AddShapeToSprite(sprite, turret);
+    AddShapeToSprite(sprite, cannon);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateMotorcycle(Vector2 position, float size, Color bodyColor, Color detailColor) {
+    RayPalsSprite* sprite = CreateSprite(5);
+    if (sprite == NULL) return NULL;
+    
+    // Wheels
+    RayPals2DShape* wheel1 = CreateCircle((Vector2){ -size*0.3f, size*0.1f }, size*0.2f, detailColor);
+    RayPals2DShape* wheel2 = CreateCircle((Vector2){ size*0.3f, size*0.1f }, size*0.2f, detailColor);
+    
+    // Motorcycle body
+    RayPals2DShape* body = CreateRectangle((Vector2){ 0, -size*0.1f }, (Vector2){ size*0.8f, size*0.15f }, bodyColor);
+    
+    // Handlebars
+    RayPals2DShape* handlebar = CreateRectangle((Vector2){ size*0.3f, -size*0.2f }, (Vector2){ size*0.1f, size*0.2f }, bodyColor);
+    
+    // Seat
+    RayPals2DShape* seat = CreateRectangle((Vector2){ -size*0.1f, -size*0.2f }, (Vector2){ size*0.3f, size*0.1f }, BLACK);
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, wheel1);
+    AddShapeToSprite(sprite, wheel2);
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, handlebar);
+    AddShapeToSprite(sprite, seat);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateSkateboard(Vector2 position, float size, Color deckColor, Color wheelColor) {
+    RayPalsSprite* sprite = CreateSprite(3);
+    if (sprite == NULL) return NULL;
+    
+    // Deck (board)
+    RayPals2DShape* deck = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size, size*0.25f }, deckColor);
+    
+    // Wheels
+    RayPals2DShape* frontWheels = CreateRectangle((Vector2){ -size*0.35f, size*0.15f }, (Vector2){ size*0.15f, size*0.1f }, wheelColor);
+    RayPals2DShape* backWheels = CreateRectangle((Vector2){ size*0.35f, size*0.15f }, (Vector2){ size*0.15f, size*0.1f }, wheelColor);
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, deck);
+    AddShapeToSprite(sprite, frontWheels);
+    AddShapeToSprite(sprite, backWheels);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateSword(Vector2 position, float size, Color bladeColor, Color hiltColor) {
+    RayPalsSprite* sprite = CreateSprite(4);
+    if (sprite == NULL) return NULL;
+    
+    // Modified sword with pointed tip
+    
+    // Blade - now with a pointed triangular tip
+    RayPals2DShape* blade = CreateRectangle(
+        (Vector2){ 0, -size*0.15f }, 
+        (Vector2){ size*0.15f, size*0.6f }, 
+        bladeColor
+    );
+    
+    // Add a pointed tip (triangle)
+    RayPals2DShape* tip = CreateTriangle(
+        (Vector2){ 0, -size*0.5f }, 
+        size*0.15f, 
+        bladeColor
+    );
+    
+    // Hilt/Handle
+    RayPals2DShape* handle = CreateRectangle(
+        (Vector2){ 0, size*0.3f }, 
+        (Vector2){ size*0.08f, size*0.3f }, 
+        hiltColor
+    );
+    
+    // Guard (cross piece)
+    RayPals2DShape* guard = CreateRectangle(
+        (Vector2){ 0, size*0.1f }, 
+        (Vector2){ size*0.4f, size*0.08f }, 
+        hiltColor
+    );
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, blade);
+    AddShapeToSprite(sprite, tip);
+    AddShapeToSprite(sprite, handle);
+    AddShapeToSprite(sprite, guard);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateArrowSprite(Vector2 position, float size, Color shaftColor, Color headColor) {
+    RayPalsSprite* sprite = CreateSprite(3);
+    if (sprite == NULL) return NULL;
+    
+    // Arrow shaft
+    RayPals2DShape* shaft = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size*0.8f, size*0.1f }, shaftColor);
+    
+    // Arrow head (triangle)
+    RayPals2DShape* head = CreateTriangle((Vector2){ size*0.5f, 0 }, size*0.3f, headColor);
+    head->rotation = 90.0f;  // Rotate to point rightward
+    
+    // Arrow fletching (back)
+    RayPals2DShape* fletching = CreateTriangle((Vector2){ -size*0.4f, 0 }, size*0.2f, headColor);
+    fletching->rotation = -90.0f;  // Rotate to point leftward
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, shaft);
+    AddShapeToSprite(sprite, head);
+    AddShapeToSprite(sprite, fletching);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateSailboat(Vector2 position, float size, Color hullColor, Color sailColor) {
+    RayPalsSprite* sprite = CreateSprite(4);
+    if (sprite == NULL) return NULL;
+    
+    // Boat hull (bottom half of a rectangle, with flat top)
+    RayPals2DShape* hull = CreateRectangle((Vector2){ 0, size*0.2f }, (Vector2){ size, size*0.3f }, hullColor);
+    
+    // Sail (triangle)
+    RayPals2DShape* sail = CreateTriangle((Vector2){ 0, -size*0.2f }, size*0.8f, sailColor);
+    sail->rotation = 90.0f;  // Rotate for proper orientation
+    
+    // Mast (vertical pole)
+    RayPals2DShape* mast = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size*0.05f, size*0.7f }, BROWN);
+    
+    // Water line (visual effect)
+    RayPals2DShape* waterLine = CreateRectangle((Vector2){ 0, size*0.35f }, (Vector2){ size*1.1f, size*0.05f }, BLUE);
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, waterLine);
+    AddShapeToSprite(sprite, hull);
+    AddShapeToSprite(sprite, mast);
+    AddShapeToSprite(sprite, sail);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+// Helper function to clamp color values
+static unsigned char ClampColor(int value) {
+    if (value < 0) return 0;
+    if (value > 255) return 255;
+    return (unsigned char)value;
+}
+
+RayPalsSprite* CreateStarSprite(Vector2 position, float size, Color color) {
+    RayPalsSprite* sprite = CreateSprite(2);
+    if (sprite == NULL) return NULL;
+    
+    // Default to yellow if color is not specified (has 0 values)
+    if (color.r == 0 && color.g == 0 && color.b == 0 && color.a == 0) {
+        color = YELLOW;  // Use raylib's yellow color
+    }
+    
+    // Create a main 5-pointed star - making it bigger for better visibility
+    RayPals2DShape* mainStar = CreateStar((Vector2){ 0, 0 }, size * 1.2f, 5, color);
+    if (mainStar == NULL) {
+        FreeSprite(sprite);
+        return NULL;
+    }
+    
+    // Create a smaller inner star with different color for visual interest
+    Color innerColor = (Color){ 
+        ClampColor(color.r + 40), 
+        ClampColor(color.g + 40), 
+        ClampColor(color.b + 40), 
+        color.a 
+    };
+    
+    // Use slightly larger inner star for better visibility
+    RayPals2DShape* innerStar = CreateStar((Vector2){ 0, 0 }, size*0.7f, 5, innerColor);
+    if (innerStar == NULL) {
+        FreeShape(mainStar);
+        FreeSprite(sprite);
+        return NULL;
+    }
+    
+    // Make sure stars are visible
+    mainStar->visible = true;
+    innerStar->visible = true;
+    
+    // Add shapes to sprite in right order (inner star on top)
+    AddShapeToSprite(sprite, mainStar);
+    AddShapeToSprite(sprite, innerStar);
+    
+    // Set sprite position
+    sprite->position = position;
+    sprite->visible = true;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateFlower(Vector2 position, float size, Color petalColor, Color centerColor) {
+    RayPalsSprite* sprite = CreateSprite(6);
+    if (sprite == NULL) return NULL;
+    
+    // Create flower center
+    RayPals2DShape* center = CreateCircle((Vector2){ 0, 0 }, size*0.2f, centerColor);
+    
+    // Create petals (5 circles around the center)
+    float petalSize = size*0.3f;
+    float petalDistance = size*0.25f;
+    
+    RayPals2DShape* petal1 = CreateCircle((Vector2){ 0, -petalDistance }, petalSize, petalColor);
+    RayPals2DShape* petal2 = CreateCircle((Vector2){ petalDistance, 0 }, petalSize, petalColor);
+    RayPals2DShape* petal3 = CreateCircle((Vector2){ 0, petalDistance }, petalSize, petalColor);
+    RayPals2DShape* petal4 = CreateCircle((Vector2){ -petalDistance, 0 }, petalSize, petalColor);
+    RayPals2DShape* petal5 = CreateCircle((Vector2){ 0, 0 }, petalSize*1.3f, petalColor);
+    petal5->filled = false;
+    petal5->thickness = 2.0f;
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, petal1);
+    AddShapeToSprite(sprite, petal2);
+    AddShapeToSprite(sprite, petal3);
+    AddShapeToSprite(sprite, petal4);
+    AddShapeToSprite(sprite, petal5);
+    AddShapeToSprite(sprite, center);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateCoin(Vector2 position, float size, Color color) {
+    RayPalsSprite* sprite = CreateSprite(2);
+    if (sprite == NULL) return NULL;
+    
+    // Coin base (circle)
+    RayPals2DShape* coinBase = CreateCircle((Vector2){ 0, 0 }, size/2, color);
+    
+    // Coin border/detail (inner circle)
+    Color darkerColor = (Color){ 
+        (unsigned char)(color.r * 0.8f), 
+        (unsigned char)(color.g * 0.8f), 
+        (unsigned char)(color.b * 0.8f), 
+        color.a 
+    };
+    
+    RayPals2DShape* coinInner = CreateCircle((Vector2){ 0, 0 }, size*0.35f, darkerColor);
+    coinInner->filled = false;
+    coinInner->thickness = 2.0f;
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, coinBase);
+    AddShapeToSprite(sprite, coinInner);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateKey(Vector2 position, float size, Color color) {
+    RayPalsSprite* sprite = CreateSprite(3);
+    if (sprite == NULL) return NULL;
+    
+    // Key handle (circle)
+    RayPals2DShape* handle = CreateCircle((Vector2){ size*0.3f, 0 }, size*0.2f, color);
+    
+    // Key shaft (rectangle)
+    RayPals2DShape* shaft = CreateRectangle((Vector2){ -size*0.15f, 0 }, (Vector2){ size*0.7f, size*0.1f }, color);
+    
+    // Key teeth (rectangle)
+    RayPals2DShape* teeth = CreateRectangle((Vector2){ -size*0.4f, 0 }, (Vector2){ size*0.2f, size*0.3f }, color);
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, handle);
+    AddShapeToSprite(sprite, shaft);
+    AddShapeToSprite(sprite, teeth);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateShield(Vector2 position, float size, Color mainColor, Color borderColor) {
+    RayPalsSprite* sprite = CreateSprite(2);
+    if (sprite == NULL) return NULL;
+    
+    // Main shield body - simple inverted triangle
+    RayPals2DShape* body = CreateTriangle((Vector2){ 0, 0 }, size, mainColor);
+    body->rotation = 180.0f;  // Rotate to point downward
+    
+    // Shield border
+    RayPals2DShape* border = CreateTriangle((Vector2){ 0, 0 }, size*1.05f, borderColor);
+    border->rotation = 180.0f;  // Rotate to point downward
+    border->filled = false;
+    border->thickness = 2.0f;
+    
+    // Add shapes to sprite in drawing order
+    AddShapeToSprite(sprite, border);
+    AddShapeToSprite(sprite, body);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateCrown(Vector2 position, float size, Color color, Color gemColor) {
+    RayPalsSprite* sprite = CreateSprite(7);
+    if (sprite == NULL) return NULL;
+    
+    // Crown base (rectangle)
+    RayPals2DShape* base = CreateRectangle((Vector2){ 0, size*0.1f }, (Vector2){ size, size*0.3f }, color);
+    
+    // Crown points (triangles)
+    RayPals2DShape* point1 = CreateTriangle((Vector2){ -size*0.3f, -size*0.1f }, size*0.2f, color);
+    RayPals2DShape* point2 = CreateTriangle((Vector2){ 0, -size*0.2f }, size*0.3f, color);
+    RayPals2DShape* point3 = CreateTriangle((Vector2){ size*0.3f, -size*0.1f }, size*0.2f, color);
+    
+    // Crown gems (circles)
+    RayPals2DShape* gem1 = CreateCircle((Vector2){ -size*0.3f, 0 }, size*0.1f, gemColor);
+    RayPals2DShape* gem2 = CreateCircle((Vector2){ 0, -size*0.1f }, size*0.12f, gemColor);
+    RayPals2DShape* gem3 = CreateCircle((Vector2){ size*0.3f, 0 }, size*0.1f, gemColor);
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, base);
+    AddShapeToSprite(sprite, point1);
+    AddShapeToSprite(sprite, point2);
+    AddShapeToSprite(sprite, point3);
+    AddShapeToSprite(sprite, gem1);
+    AddShapeToSprite(sprite, gem2);
+    AddShapeToSprite(sprite, gem3);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateLightningBolt(Vector2 position, float size, Color color) {
+    RayPalsSprite* sprite = CreateSprite(6);
+    if (sprite == NULL) return NULL;
+    
+    // Create a Harry Potter style lightning bolt
+    // Using connected triangles for sharp zigzag
+    float width = size * 0.2f;
+    
+    // Create zigzag segments using triangles
+    // Define each segment as a rectangle
+    
+    // First segment (top-right)
+    RayPals2DShape* seg1 = CreateRectangle(
+        (Vector2){ -size*0.1f, -size*0.4f }, 
+        (Vector2){ width, size*0.2f }, 
+        color
+    );
+    seg1->rotation = -35.0f;
+    
+    // Second segment (middle-left)
+    RayPals2DShape* seg2 = CreateRectangle(
+        (Vector2){ -size*0.15f, -size*0.2f }, 
+        (Vector2){ width, size*0.25f }, 
+        color
+    );
+    seg2->rotation = 40.0f;
+    
+    // Third segment (middle-right)
+    RayPals2DShape* seg3 = CreateRectangle(
+        (Vector2){ 0, 0 }, 
+        (Vector2){ width, size*0.2f }, 
+        color
+    );
+    seg3->rotation = -35.0f;
+    
+    // Fourth segment (bottom-left)
+    RayPals2DShape* seg4 = CreateRectangle(
+        (Vector2){ 0, size*0.2f }, 
+        (Vector2){ width, size*0.25f }, 
+        color
+    );
+    seg4->rotation = 45.0f;
+    
+    // Add a glow effect with slightly larger, semi-transparent shapes
+    Color glowColor = color;
+    glowColor.a = 120; // Semi-transparent
+    
+    RayPals2DShape* glow1 = CreateRectangle(
+        (Vector2){ -size*0.1f, -size*0.4f }, 
+        (Vector2){ width*1.5f, size*0.2f*1.5f }, 
+        glowColor
+    );
+    glow1->rotation = -35.0f;
+    
+    RayPals2DShape* glow2 = CreateRectangle(
+        (Vector2){ 0, size*0.2f }, 
+        (Vector2){ width*1.5f, size*0.25f*1.5f }, 
+        glowColor
+    );
+    glow2->rotation = 45.0f;
+    
+    // Add shapes to sprite (glows first, then bolt)
+    AddShapeToSprite(sprite, glow1);
+    AddShapeToSprite(sprite, glow2);
+    AddShapeToSprite(sprite, seg1);
+    AddShapeToSprite(sprite, seg2);
+    AddShapeToSprite(sprite, seg3);
+    AddShapeToSprite(sprite, seg4);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateFish(Vector2 position, float size, Color bodyColor, Color finColor) {
+    RayPalsSprite* sprite = CreateSprite(4);
+    if (sprite == NULL) return NULL;
+    
+    // Fish body (oval/ellipse using a circle with scaling)
+    RayPals2DShape* body = CreateCircle((Vector2){ 0, 0 }, size*0.4f, bodyColor);
+    
+    // Fish tail (triangle)
+    RayPals2DShape* tail = CreateTriangle((Vector2){ size*0.4f, 0 }, size*0.3f, finColor);
+    tail->rotation = 90.0f;
+    
+    // Fish fins (triangles)
+    RayPals2DShape* topFin = CreateTriangle((Vector2){ 0, -size*0.3f }, size*0.2f, finColor);
+    RayPals2DShape* bottomFin = CreateTriangle((Vector2){ 0, size*0.3f }, size*0.2f, finColor);
+    bottomFin->rotation = 180.0f;
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, tail);
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, topFin);
+    AddShapeToSprite(sprite, bottomFin);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateGem(Vector2 position, float size, Color color) {
+    RayPalsSprite* sprite = CreateSprite(4);
+    if (sprite == NULL) return NULL;
+    
+    // Create a diamond shape - main body
+    RayPals2DShape* mainGem = CreatePolygon((Vector2){ 0, 0 }, size/2, 8, color);
+    mainGem->rotation = 22.5f;  // Rotate to get diamond orientation
+    
+    // Create a smaller interior with lighter color for "sparkle"
+    Color lighterColor = (Color){ 
+        ClampColor(color.r + 80), 
+        ClampColor(color.g + 80), 
+        ClampColor(color.b + 80), 
+        color.a 
+    };
+    
+    RayPals2DShape* innerGem = CreatePolygon((Vector2){ -size*0.05f, -size*0.05f }, size/2*0.6f, 8, lighterColor);
+    innerGem->rotation = 22.5f;
+    
+    // Add a small star for sparkle effect
+    RayPals2DShape* sparkle = CreateStar((Vector2){ -size*0.15f, -size*0.15f }, size*0.15f, 4, WHITE);
+    
+    // Add border outline
+    RayPals2DShape* border = CreatePolygon((Vector2){ 0, 0 }, size/2*1.02f, 8, BLACK);
+    border->filled = false;
+    border->thickness = 1.5f;
+    border->rotation = 22.5f;
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, border);
+    AddShapeToSprite(sprite, mainGem);
+    AddShapeToSprite(sprite, innerGem);
+    AddShapeToSprite(sprite, sparkle);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+// ----------------------------------------------------------------------------
+// Animation Functions
+// ----------------------------------------------------------------------------
+
+// UpdateShapeAnimation and Update3DShapeAnimation functions are already defined above
+
+// The CreateWaterDrop function is already defined earlier in the file (line ~230)
+// No duplicate implementation needed here
+
+RayPalsSprite* CreateWaterDropSprite(Vector2 position, float size, Color color) {
+    RayPalsSprite* sprite = CreateSprite(2);
+    if (sprite == NULL) return NULL;
+    
+    // Create the drop shape using a circle for the main part and a triangle for the pointed end
+    RayPals2DShape* dropBody = CreateCircle((Vector2){ 0, -size*0.1f }, size*0.4f, color);
+    
+    // Create drop point (triangle)
+    RayPals2DShape* dropPoint = CreateTriangle((Vector2){ 0, size*0.3f }, size*0.4f, color);
+    dropPoint->rotation = 180.0f; // Point facing downward
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, dropBody);
+    AddShapeToSprite(sprite, dropPoint);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateHorseSprite(Vector2 position, float size, Color bodyColor) {
+    RayPalsSprite* sprite = CreateSprite(6);
+    if (sprite == NULL) return NULL;
+    
+    // Body - slightly elongated rectangle
+    RayPals2DShape* body = CreateRectangle(
+        (Vector2){ 0, 0 }, 
+        (Vector2){ size*1.8f, size*0.8f }, 
+        bodyColor
+    );
+    
+    // Head - rectangle with rotation
+    RayPals2DShape* head = CreateRectangle(
+        (Vector2){ size*0.9f, -size*0.6f }, 
+        (Vector2){ size*0.8f, size*0.4f }, 
+        bodyColor
+    );
+    head->rotation = 45.0f;
+    
+    // Neck - connecting body and head
+    RayPals2DShape* neck = CreateRectangle(
+        (Vector2){ size*0.6f, -size*0.3f }, 
+        (Vector2){ size*0.4f, size*0.7f }, 
+        bodyColor
+    );
+    neck->rotation = 30.0f;
+    
+    // Tail
+    RayPals2DShape* tail = CreateRectangle(
+        (Vector2){ -size*0.9f, -size*0.4f }, 
+        (Vector2){ size*0.5f, size*0.2f }, 
+        bodyColor
+    );
+    tail->rotation = -35.0f;
+    
+    // Legs (front and back)
+    RayPals2DShape* frontLeg = CreateRectangle(
+        (Vector2){ size*0.5f, size*0.6f }, 
+        (Vector2){ size*0.2f, size*0.8f }, 
+        bodyColor
+    );
+    
+    RayPals2DShape* backLeg = CreateRectangle(
+        (Vector2){ -size*0.5f, size*0.6f }, 
+        (Vector2){ size*0.2f, size*0.8f }, 
+        bodyColor
+    );
+    
+    // Add shapes to sprite in proper order
+    AddShapeToSprite(sprite, tail);
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, neck);
+    AddShapeToSprite(sprite, head);
+    AddShapeToSprite(sprite, frontLeg);
+    AddShapeToSprite(sprite, backLeg);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateYellowStar(Vector2 position, float size) {
+    // Create a bright yellow star that's clearly visible
+    Color brightYellow = (Color){ 255, 255, 0, 255 }; // Maximum brightness yellow
+    
+    // Create a star with yellow color and increased size for visibility
+    RayPalsSprite* star = CreateStarSprite(position, size * 1.2f, brightYellow);
+    
+    // Apply additional settings if needed
+    if (star) {
+        // Ensure the star is visible
+        star->visible = true;
+    }
+    
+    return star;
+}
+
+RayPalsSprite* CreateExplosion(Vector2 position, float size, Color primaryColor, Color secondaryColor) {
+    RayPalsSprite* sprite = CreateSprite(8);
+    if (sprite == NULL) return NULL;
+    
+    // Create center of explosion
+    RayPals2DShape* center = CreateCircle((Vector2){ 0, 0 }, size * 0.4f, primaryColor);
+    
+    // Create outer explosion circles
+    RayPals2DShape* outerCircle1 = CreateCircle((Vector2){ size * 0.3f, size * 0.2f }, size * 0.25f, secondaryColor);
+    RayPals2DShape* outerCircle2 = CreateCircle((Vector2){ -size * 0.25f, size * 0.3f }, size * 0.2f, secondaryColor);
+    RayPals2DShape* outerCircle3 = CreateCircle((Vector2){ -size * 0.3f, -size * 0.2f }, size * 0.25f, secondaryColor);
+    RayPals2DShape* outerCircle4 = CreateCircle((Vector2){ size * 0.25f, -size * 0.3f }, size * 0.2f, secondaryColor);
+    
+    // Create some triangular "spikes" for a more dynamic look
+    RayPals2DShape* spike1 = CreateTriangle((Vector2){ size * 0.45f, 0 }, size * 0.4f, primaryColor);
+    spike1->rotation = 0.0f;
+    
+    RayPals2DShape* spike2 = CreateTriangle((Vector2){ 0, size * 0.45f }, size * 0.4f, primaryColor);
+    spike2->rotation = 90.0f;
+    
+    RayPals2DShape* spike3 = CreateTriangle((Vector2){ -size * 0.45f, 0 }, size * 0.4f, primaryColor);
+    spike3->rotation = 180.0f;
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, outerCircle1);
+    AddShapeToSprite(sprite, outerCircle2);
+    AddShapeToSprite(sprite, outerCircle3);
+    AddShapeToSprite(sprite, outerCircle4);
+    AddShapeToSprite(sprite, spike1);
+    AddShapeToSprite(sprite, spike2);
+    AddShapeToSprite(sprite, spike3);
+    AddShapeToSprite(sprite, center);  // Center on top for better visual
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateAirplane(Vector2 position, float size, Color bodyColor, Color detailColor) {
+    RayPalsSprite* sprite = CreateSprite(7);
+    if (sprite == NULL) return NULL;
+    
+    // Airplane fuselage (main body)
+    RayPals2DShape* body = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size * 1.2f, size * 0.25f }, bodyColor);
+    
+    // Airplane nose (front part)
+    RayPals2DShape* nose = CreateTriangle((Vector2){ size * 0.6f, 0 }, size * 0.4f, bodyColor);
+    nose->rotation = 90.0f;  // Point to the right
+    
+    // Airplane tail (back part)
+    RayPals2DShape* tail = CreateRectangle((Vector2){ -size * 0.5f, -size * 0.25f }, (Vector2){ size * 0.3f, size * 0.3f }, bodyColor);
+    
+    // Airplane wings
+    RayPals2DShape* wings = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size * 0.6f, size * 0.8f }, bodyColor);
+    
+    // Windows (detail)
+    RayPals2DShape* window1 = CreateCircle((Vector2){ size * 0.2f, 0 }, size * 0.05f, detailColor);
+    RayPals2DShape* window2 = CreateCircle((Vector2){ 0, 0 }, size * 0.05f, detailColor);
+    RayPals2DShape* window3 = CreateCircle((Vector2){ -size * 0.2f, 0 }, size * 0.05f, detailColor);
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, wings);
+    AddShapeToSprite(sprite, nose);
+    AddShapeToSprite(sprite, tail);
+    AddShapeToSprite(sprite, window1);
+    AddShapeToSprite(sprite, window2);
+    AddShapeToSprite(sprite, window3);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateSoldier(Vector2 position, float size, Color uniformColor, Color skinColor) {
+    RayPalsSprite* sprite = CreateSprite(8);
+    if (sprite == NULL) return NULL;
+    
+    // Body parts
+    RayPals2DShape* body = CreateRectangle((Vector2){ 0, size * 0.15f }, (Vector2){ size * 0.4f, size * 0.5f }, uniformColor);
+    
+    // Head with helmet
+    RayPals2DShape* head = CreateCircle((Vector2){ 0, -size * 0.25f }, size * 0.2f, skinColor);
+    RayPals2DShape* helmet = CreateRectangle((Vector2){ 0, -size * 0.35f }, (Vector2){ size * 0.4f, size * 0.15f }, uniformColor);
+    
+    // Arms
+    RayPals2DShape* leftArm = CreateRectangle((Vector2){ -size * 0.25f, size * 0.1f }, (Vector2){ size * 0.1f, size * 0.4f }, uniformColor);
+    leftArm->rotation = -15.0f;
+    
+    RayPals2DShape* rightArm = CreateRectangle((Vector2){ size * 0.25f, size * 0.1f }, (Vector2){ size * 0.1f, size * 0.4f }, uniformColor);
+    rightArm->rotation = 15.0f;
+    
+    // Legs
+    RayPals2DShape* leftLeg = CreateRectangle((Vector2){ -size * 0.15f, size * 0.5f }, (Vector2){ size * 0.15f, size * 0.4f }, uniformColor);
+    RayPals2DShape* rightLeg = CreateRectangle((Vector2){ size * 0.15f, size * 0.5f }, (Vector2){ size * 0.15f, size * 0.4f }, uniformColor);
+    
+    // Gun (optional)
+    RayPals2DShape* gun = CreateRectangle((Vector2){ size * 0.4f, size * 0.2f }, (Vector2){ size * 0.5f, size * 0.1f }, (Color){ 80, 80, 80, 255 });
+    
+    // Add shapes to sprite in correct order
+    AddShapeToSprite(sprite, leftLeg);
+    AddShapeToSprite(sprite, rightLeg);
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, leftArm);
+    AddShapeToSprite(sprite, rightArm);
+    AddShapeToSprite(sprite, head);
+    AddShapeToSprite(sprite, helmet);
+    AddShapeToSprite(sprite, gun);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateZombie(Vector2 position, float size, Color skinColor, Color clothesColor) {
+    RayPalsSprite* sprite = CreateSprite(9);
+    if (sprite == NULL) return NULL;
+    
+    // Create zombie with hunched posture and tattered clothes
+    
+    // Body - slightly tilted
+    RayPals2DShape* body = CreateRectangle((Vector2){ 0, size * 0.1f }, (Vector2){ size * 0.4f, size * 0.5f }, clothesColor);
+    body->rotation = 10.0f;  // Slight tilt
+    
+    // Tattered clothes effect
+    RayPals2DShape* tatters = CreateTriangle((Vector2){ size * 0.1f, size * 0.3f }, size * 0.3f, clothesColor);
+    tatters->rotation = 180.0f;
+    
+    // Head - green/gray skin
+    Color zombieSkin = skinColor;
+    zombieSkin.g += 40;  // Add greenish tint
+    zombieSkin.r -= 30;  // Reduce red for a sickly look
+    
+    RayPals2DShape* head = CreateCircle((Vector2){ size * 0.05f, -size * 0.25f }, size * 0.2f, zombieSkin);
+    
+    // Eyes - creepy white
+    RayPals2DShape* leftEye = CreateCircle((Vector2){ -size * 0.05f, -size * 0.27f }, size * 0.05f, WHITE);
+    RayPals2DShape* rightEye = CreateCircle((Vector2){ size * 0.12f, -size * 0.27f }, size * 0.05f, WHITE);
+    
+    // Arms - asymmetrical and outstretched
+    RayPals2DShape* leftArm = CreateRectangle((Vector2){ -size * 0.3f, size * 0.0f }, (Vector2){ size * 0.2f, size * 0.1f }, zombieSkin);
+    leftArm->rotation = -30.0f;
+    
+    RayPals2DShape* rightArm = CreateRectangle((Vector2){ size * 0.2f, size * 0.1f }, (Vector2){ size * 0.3f, size * 0.1f }, zombieSkin);
+    rightArm->rotation = 20.0f;
+    
+    // Legs - one dragging
+    RayPals2DShape* leftLeg = CreateRectangle((Vector2){ -size * 0.15f, size * 0.45f }, (Vector2){ size * 0.15f, size * 0.4f }, clothesColor);
+    leftLeg->rotation = -5.0f;
+    
+    RayPals2DShape* rightLeg = CreateRectangle((Vector2){ size * 0.12f, size * 0.5f }, (Vector2){ size * 0.15f, size * 0.45f }, clothesColor);
+    rightLeg->rotation = 15.0f;  // Dragging leg
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, rightLeg);
+    AddShapeToSprite(sprite, leftLeg);
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, tatters);
+    AddShapeToSprite(sprite, leftArm);
+    AddShapeToSprite(sprite, rightArm);
+    AddShapeToSprite(sprite, head);
+    AddShapeToSprite(sprite, leftEye);
+    AddShapeToSprite(sprite, rightEye);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateUFO(Vector2 position, float size, Color bodyColor, Color glowColor) {
+    RayPalsSprite* sprite = CreateSprite(7);
+    if (sprite == NULL) return NULL;
+    
+    // Main UFO saucer body - elliptical shape
+    RayPals2DShape* body = CreateCircle((Vector2){ 0, 0 }, size * 0.5f, bodyColor);
+    
+    // Top dome of the UFO
+    RayPals2DShape* dome = CreateCircle((Vector2){ 0, -size * 0.15f }, size * 0.25f, bodyColor);
+    
+    // Bottom rim of the UFO
+    RayPals2DShape* bottomRim = CreateRectangle(
+        (Vector2){ 0, size * 0.05f }, 
+        (Vector2){ size * 0.8f, size * 0.1f }, 
+        DARKGRAY
+    );
+    
+    // Glowing lights around the rim
+    Color lightColor = glowColor;
+    lightColor.a = 220; // Semi-transparent for glow effect
+    
+    RayPals2DShape* lights1 = CreateCircle((Vector2){ -size * 0.25f, size * 0.05f }, size * 0.08f, lightColor);
+    RayPals2DShape* lights2 = CreateCircle((Vector2){ 0, size * 0.05f }, size * 0.08f, lightColor);
+    RayPals2DShape* lights3 = CreateCircle((Vector2){ size * 0.25f, size * 0.05f }, size * 0.08f, lightColor);
+    
+    // Optional tractor beam effect
+    RayPals2DShape* beam = CreateTriangle(
+        (Vector2){ 0, size * 0.2f },
+        size * 0.5f,
+        (Color){ glowColor.r, glowColor.g, glowColor.b, 100 } // Very transparent
+    );
+    beam->rotation = 180.0f; // Point downward
+    
+    // Add shapes to sprite in appropriate order
+    AddShapeToSprite(sprite, beam);
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, bottomRim);
+    AddShapeToSprite(sprite, lights1);
+    AddShapeToSprite(sprite, lights2);
+    AddShapeToSprite(sprite, lights3);
+    AddShapeToSprite(sprite, dome);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateDragon(Vector2 position, float size, Color bodyColor, Color wingColor) {
+    RayPalsSprite* sprite = CreateSprite(10);
+    if (sprite == NULL) return NULL;
+    
+    // Dragon body (main elongated shape)
+    RayPals2DShape* body = CreateRectangle(
+        (Vector2){ 0, 0 }, 
+        (Vector2){ size * 1.2f, size * 0.4f }, 
+        bodyColor
+    );
+    
+    // Dragon head (triangle for snout effect)
+    RayPals2DShape* head = CreateTriangle(
+        (Vector2){ size * 0.7f, -size * 0.1f }, 
+        size * 0.4f, 
+        bodyColor
+    );
+    head->rotation = 90.0f; // Point to the right
+    
+    // Dragon neck
+    RayPals2DShape* neck = CreateRectangle(
+        (Vector2){ size * 0.4f, -size * 0.1f }, 
+        (Vector2){ size * 0.3f, size * 0.2f }, 
+        bodyColor
+    );
+    
+    // Dragon tail (curved)
+    RayPals2DShape* tail1 = CreateRectangle(
+        (Vector2){ -size * 0.5f, size * 0.0f }, 
+        (Vector2){ size * 0.4f, size * 0.15f }, 
+        bodyColor
+    );
+    tail1->rotation = -15.0f;
+    
+    RayPals2DShape* tail2 = CreateTriangle(
+        (Vector2){ -size * 0.8f, size * 0.1f }, 
+        size * 0.3f, 
+        bodyColor
+    );
+    tail2->rotation = -90.0f; // Point to the left
+    
+    // Dragon wings
+    RayPals2DShape* leftWing = CreateTriangle(
+        (Vector2){ size * 0.1f, -size * 0.3f }, 
+        size * 0.6f, 
+        wingColor
+    );
+    leftWing->rotation = 30.0f;
+    
+    RayPals2DShape* rightWing = CreateTriangle(
+        (Vector2){ -size * 0.1f, -size * 0.3f }, 
+        size * 0.6f, 
+        wingColor
+    );
+    rightWing->rotation = 150.0f;
+    
+    // Dragon eyes
+    Color eyeColor = RED;
+    RayPals2DShape* leftEye = CreateCircle(
+        (Vector2){ size * 0.6f, -size * 0.15f }, 
+        size * 0.05f, 
+        eyeColor
+    );
+    
+    // Dragon horns
+    RayPals2DShape* horn1 = CreateTriangle(
+        (Vector2){ size * 0.65f, -size * 0.25f }, 
+        size * 0.2f, 
+        bodyColor
+    );
+    horn1->rotation = 45.0f;
+    
+    RayPals2DShape* horn2 = CreateTriangle(
+        (Vector2){ size * 0.55f, -size * 0.25f }, 
+        size * 0.2f, 
+        bodyColor
+    );
+    horn2->rotation = 15.0f;
+    
+    // Add shapes to sprite in proper order
+    AddShapeToSprite(sprite, leftWing);
+    AddShapeToSprite(sprite, rightWing);
+    AddShapeToSprite(sprite, tail2);
+    AddShapeToSprite(sprite, tail1);
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, neck);
+    AddShapeToSprite(sprite, head);
+    AddShapeToSprite(sprite, horn1);
+    AddShapeToSprite(sprite, horn2);
+    AddShapeToSprite(sprite, leftEye);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateWizard(Vector2 position, float size, Color robeColor, Color hatColor) {
+    RayPalsSprite* sprite = CreateSprite(8);
+    if (sprite == NULL) return NULL;
+    
+    // Colors
+    Color faceColor = BEIGE;
+    Color staffColor = BROWN;
+    Color starColor = YELLOW;
+    
+    // Wizard robe (base)
+    RayPals2DShape* robe = CreateTriangle(
+        (Vector2){ 0, size * 0.3f }, 
+        size * 0.9f, 
+        robeColor
+    );
+    robe->rotation = 180.0f; // Point downward
+    
+    // Wizard body (upper part)
+    RayPals2DShape* body = CreateRectangle(
+        (Vector2){ 0, -size * 0.1f }, 
+        (Vector2){ size * 0.4f, size * 0.5f }, 
+        robeColor
+    );
+    
+    // Wizard head
+    RayPals2DShape* head = CreateCircle(
+        (Vector2){ 0, -size * 0.4f }, 
+        size * 0.15f, 
+        faceColor
+    );
+    
+    // Wizard hat (cone)
+    RayPals2DShape* hat = CreateTriangle(
+        (Vector2){ 0, -size * 0.65f }, 
+        size * 0.5f, 
+        hatColor
+    );
+    hat->rotation = 0.0f; // Point upward
+    
+    // Wizard hat brim
+    RayPals2DShape* hatBrim = CreateRectangle(
+        (Vector2){ 0, -size * 0.5f }, 
+        (Vector2){ size * 0.45f, size * 0.05f }, 
+        hatColor
+    );
+    
+    // Wizard beard
+    RayPals2DShape* beard = CreateTriangle(
+        (Vector2){ 0, -size * 0.3f }, 
+        size * 0.25f, 
+        WHITE
+    );
+    beard->rotation = 180.0f; // Point downward
+    
+    // Wizard staff
+    RayPals2DShape* staff = CreateRectangle(
+        (Vector2){ size * 0.3f, size * 0.1f }, 
+        (Vector2){ size * 0.05f, size * 0.8f }, 
+        staffColor
+    );
+    staff->rotation = -15.0f;
+    
+    // Wizard staff star
+    RayPals2DShape* staffStar = CreateStar(
+        (Vector2){ size * 0.35f, -size * 0.25f }, 
+        size * 0.15f, 
+        5, 
+        starColor
+    );
+    
+    // Add shapes to sprite in proper order
+    AddShapeToSprite(sprite, staff);
+    AddShapeToSprite(sprite, robe);
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, head);
+    AddShapeToSprite(sprite, beard);
+    AddShapeToSprite(sprite, hatBrim);
+    AddShapeToSprite(sprite, hat);
+    AddShapeToSprite(sprite, staffStar);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateTreasureChest(Vector2 position, float size, Color chestColor, Color goldColor, bool isOpen) {
+    RayPalsSprite* sprite = CreateSprite(isOpen ? 7 : 5);  // Gold pieces are only added when open
+    if (sprite == NULL) return NULL;
+    
+    // Colors
+    Color lockColor = DARKBROWN;
+    
+    // Chest base (main rectangle)
+    RayPals2DShape* base = CreateRectangle(
+        (Vector2){ 0, size * 0.1f }, 
+        (Vector2){ size * 0.8f, size * 0.5f }, 
+        chestColor
+    );
+    
+    // Chest lid
+    RayPals2DShape* lid = CreateRectangle(
+        isOpen ? (Vector2){ -size * 0.3f, -size * 0.25f } : (Vector2){ 0, -size * 0.15f }, 
+        (Vector2){ size * 0.8f, size * 0.3f }, 
+        chestColor
+    );
+    // Rotate the lid if open
+    lid->rotation = isOpen ? -60.0f : 0.0f;
+    
+    // Chest lock/clasp
+    RayPals2DShape* lock = CreateRectangle(
+        isOpen ? (Vector2){ -size * 0.3f, -size * 0.1f } : (Vector2){ 0, 0 }, 
+        (Vector2){ size * 0.15f, size * 0.15f }, 
+        lockColor
+    );
+    // Rotate the lock with the lid if open
+    lock->rotation = isOpen ? -60.0f : 0.0f;
+    
+    // Decorative elements (edges/corners)
+    RayPals2DShape* corner1 = CreateRectangle(
+        (Vector2){ size * 0.35f, size * 0.15f }, 
+        (Vector2){ size * 0.1f, size * 0.4f }, 
+        lockColor
+    );
+    
+    RayPals2DShape* corner2 = CreateRectangle(
+        (Vector2){ -size * 0.35f, size * 0.15f }, 
+        (Vector2){ size * 0.1f, size * 0.4f }, 
+        lockColor
+    );
+    
+    // Only create and add gold if chest is open
+    RayPals2DShape* gold1 = NULL;
+    RayPals2DShape* gold2 = NULL;
+    
+    if (isOpen) {
+        // Gold coins/treasure (circles) that are visible when open
+        gold1 = CreateCircle(
+            (Vector2){ -size * 0.1f, size * 0.0f }, 
+            size * 0.15f, 
+            goldColor
+        );
+        
+        gold2 = CreateCircle(
+            (Vector2){ size * 0.15f, size * 0.05f }, 
+            size * 0.12f, 
+            goldColor
+        );
+    }
+    
+    // Add shapes to sprite in proper order
+    AddShapeToSprite(sprite, base);
+    AddShapeToSprite(sprite, corner1);
+    AddShapeToSprite(sprite, corner2);
+    
+    // Add gold pieces if chest is open
+    if (isOpen) {
+        AddShapeToSprite(sprite, gold1);
+        AddShapeToSprite(sprite, gold2);
+    }
+    
+    // Add lid and lock last so they appear on top
+    AddShapeToSprite(sprite, lid);
+    AddShapeToSprite(sprite, lock);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreatePortal(Vector2 position, float size, Color outerColor, Color innerColor) {
+    RayPalsSprite* sprite = CreateSprite(8);
+    if (sprite == NULL) return NULL;
+    
+    // Create a swirling portal with multiple rings
+    
+    // Outer ring
+    RayPals2DShape* outerRing = CreateCircle(
+        (Vector2){ 0, 0 }, 
+        size * 0.5f, 
+        outerColor
+    );
+    outerRing->filled = false;
+    outerRing->thickness = 4.0f;
+    
+    // Create several inner rings with decreasing size and alternating colors
+    RayPals2DShape* ring1 = CreateCircle(
+        (Vector2){ 0, 0 }, 
+        size * 0.45f, 
+        innerColor
+    );
+    ring1->filled = false;
+    ring1->thickness = 3.0f;
+    
+    RayPals2DShape* ring2 = CreateCircle(
+        (Vector2){ 0, 0 }, 
+        size * 0.4f, 
+        outerColor
+    );
+    ring2->filled = false;
+    ring2->thickness = 3.0f;
+    
+    RayPals2DShape* ring3 = CreateCircle(
+        (Vector2){ 0, 0 }, 
+        size * 0.35f, 
+        innerColor
+    );
+    ring3->filled = false;
+    ring3->thickness = 3.0f;
+    
+    RayPals2DShape* ring4 = CreateCircle(
+        (Vector2){ 0, 0 }, 
+        size * 0.3f, 
+        outerColor
+    );
+    ring4->filled = false;
+    ring4->thickness = 3.0f;
+    
+    // Inner swirl (spiral effect using shapes)
+    RayPals2DShape* swirl1 = CreateCircle(
+        (Vector2){ size * 0.05f, size * 0.05f }, 
+        size * 0.25f, 
+        innerColor
+    );
+    swirl1->filled = true;
+    
+    RayPals2DShape* swirl2 = CreateCircle(
+        (Vector2){ -size * 0.08f, -size * 0.08f }, 
+        size * 0.15f, 
+        outerColor
+    );
+    swirl2->filled = true;
+    
+    // Core of the portal 
+    RayPals2DShape* core = CreateCircle(
+        (Vector2){ 0, 0 }, 
+        size * 0.1f, 
+        (Color){ 255, 255, 255, 200 }  // Bright center with some transparency
+    );
+    
+    // Add shapes to sprite in proper order (from back to front)
+    AddShapeToSprite(sprite, outerRing);
+    AddShapeToSprite(sprite, ring1);
+    AddShapeToSprite(sprite, ring2);
+    AddShapeToSprite(sprite, ring3);
+    AddShapeToSprite(sprite, ring4);
+    AddShapeToSprite(sprite, swirl1);
+    AddShapeToSprite(sprite, swirl2);
+    AddShapeToSprite(sprite, core);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateSnowman(Vector2 position, float size, Color snowColor, Color accessoryColor) {
+    RayPalsSprite* sprite = CreateSprite(10);
+    if (sprite == NULL) return NULL;
+    
+    // Bottom snowball (largest)
+    RayPals2DShape* bottom = CreateCircle(
+        (Vector2){ 0, size * 0.4f }, 
+        size * 0.4f, 
+        snowColor
+    );
+    
+    // Middle snowball
+    RayPals2DShape* middle = CreateCircle(
+        (Vector2){ 0, 0 }, 
+        size * 0.3f, 
+        snowColor
+    );
+    
+    // Head (top snowball - smallest)
+    RayPals2DShape* head = CreateCircle(
+        (Vector2){ 0, -size * 0.35f }, 
+        size * 0.2f, 
+        snowColor
+    );
+    
+    // Eyes
+    Color eyeColor = BLACK;
+    RayPals2DShape* leftEye = CreateCircle(
+        (Vector2){ -size * 0.08f, -size * 0.38f }, 
+        size * 0.03f, 
+        eyeColor
+    );
+    
+    RayPals2DShape* rightEye = CreateCircle(
+        (Vector2){ size * 0.08f, -size * 0.38f }, 
+        size * 0.03f, 
+        eyeColor
+    );
+    
+    // Carrot nose
+    Color carrotColor = ORANGE;
+    RayPals2DShape* nose = CreateTriangle(
+        (Vector2){ size * 0.1f, -size * 0.35f }, 
+        size * 0.15f, 
+        carrotColor
+    );
+    nose->rotation = 90.0f; // Point to the right
+    
+    // Hat (top hat)
+    RayPals2DShape* hatBrim = CreateRectangle(
+        (Vector2){ 0, -size * 0.55f }, 
+        (Vector2){ size * 0.5f, size * 0.05f }, 
+        accessoryColor
+    );
+    
+    RayPals2DShape* hatTop = CreateRectangle(
+        (Vector2){ 0, -size * 0.65f }, 
+        (Vector2){ size * 0.3f, size * 0.2f }, 
+        accessoryColor
+    );
+    
+    // Arms (sticks)
+    RayPals2DShape* leftArm = CreateRectangle(
+        (Vector2){ -size * 0.4f, -size * 0.05f }, 
+        (Vector2){ size * 0.4f, size * 0.03f }, 
+        BROWN
+    );
+    leftArm->rotation = 20.0f;
+    
+    RayPals2DShape* rightArm = CreateRectangle(
+        (Vector2){ size * 0.4f, -size * 0.05f }, 
+        (Vector2){ size * 0.4f, size * 0.03f }, 
+        BROWN
+    );
+    rightArm->rotation = -20.0f;
+    
+    // Add shapes to sprite in proper order
+    AddShapeToSprite(sprite, bottom);
+    AddShapeToSprite(sprite, leftArm);
+    AddShapeToSprite(sprite, rightArm);
+    AddShapeToSprite(sprite, middle);
+    AddShapeToSprite(sprite, head);
+    AddShapeToSprite(sprite, leftEye);
+    AddShapeToSprite(sprite, rightEye);
+    AddShapeToSprite(sprite, nose);
+    AddShapeToSprite(sprite, hatBrim);
+    AddShapeToSprite(sprite, hatTop);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreatePotion(Vector2 position, float size, Color bottleColor, Color liquidColor) {
+    RayPalsSprite* sprite = CreateSprite(8);
+    if (sprite == NULL) return NULL;
+    
+    // Potion bottle neck
+    RayPals2DShape* bottleNeck = CreateRectangle(
+        (Vector2){ 0, -size * 0.4f }, 
+        (Vector2){ size * 0.15f, size * 0.2f }, 
+        bottleColor
+    );
+    
+    // Potion bottle cap/cork
+    RayPals2DShape* bottleCap = CreateRectangle(
+        (Vector2){ 0, -size * 0.55f }, 
+        (Vector2){ size * 0.2f, size * 0.1f }, 
+        BROWN
+    );
+    
+    // Potion bottle body (wider at the bottom)
+    RayPals2DShape* bottleTop = CreateRectangle(
+        (Vector2){ 0, -size * 0.25f }, 
+        (Vector2){ size * 0.3f, size * 0.1f }, 
+        bottleColor
+    );
+    
+    RayPals2DShape* bottleBody = CreateRectangle(
+        (Vector2){ 0, size * 0.05f }, 
+        (Vector2){ size * 0.5f, size * 0.5f }, 
+        bottleColor
+    );
+    
+    // Round bottom of the bottle
+    RayPals2DShape* bottleBottom = CreateCircle(
+        (Vector2){ 0, size * 0.3f }, 
+        size * 0.25f, 
+        bottleColor
+    );
+    
+    // Liquid inside the bottle
+    RayPals2DShape* liquid = CreateRectangle(
+        (Vector2){ 0, size * 0.1f }, 
+        (Vector2){ size * 0.45f, size * 0.4f }, 
+        liquidColor
+    );
+    
+    // Bubble effects in the liquid
+    RayPals2DShape* bubble1 = CreateCircle(
+        (Vector2){ -size * 0.1f, 0 }, 
+        size * 0.05f, 
+        (Color){ 255, 255, 255, 150 } // Semi-transparent white
+    );
+    
+    RayPals2DShape* bubble2 = CreateCircle(
+        (Vector2){ size * 0.15f, size * 0.15f }, 
+        size * 0.03f, 
+        (Color){ 255, 255, 255, 150 } // Semi-transparent white
+    );
+    
+    // Add shapes to sprite in proper order
+    AddShapeToSprite(sprite, bottleBottom);
+    AddShapeToSprite(sprite, bottleBody);
+    AddShapeToSprite(sprite, liquid);
+    AddShapeToSprite(sprite, bubble1);
+    AddShapeToSprite(sprite, bubble2);
+    AddShapeToSprite(sprite, bottleTop);
+    AddShapeToSprite(sprite, bottleNeck);
+    AddShapeToSprite(sprite, bottleCap);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateCannon(Vector2 position, float size, Color cannonColor, Color wheelColor) {
+    RayPalsSprite* sprite = CreateSprite(8);
+    if (sprite == NULL) return NULL;
+    
+    // Cannon barrel (main part)
+    RayPals2DShape* barrel = CreateRectangle(
+        (Vector2){ size * 0.2f, -size * 0.1f }, 
+        (Vector2){ size * 0.8f, size * 0.25f }, 
+        cannonColor
+    );
+    
+    // Cannon end (muzzle)
+    RayPals2DShape* muzzle = CreateRectangle(
+        (Vector2){ size * 0.6f, -size * 0.1f }, 
+        (Vector2){ size * 0.1f, size * 0.3f }, 
+        cannonColor
+    );
+    
+    // Cannon base (carriage)
+    RayPals2DShape* base = CreateRectangle(
+        (Vector2){ 0, size * 0.1f }, 
+        (Vector2){ size * 0.6f, size * 0.3f }, 
+        cannonColor
+    );
+    
+    // Cannon wheels
+    RayPals2DShape* leftWheel = CreateCircle(
+        (Vector2){ -size * 0.2f, size * 0.3f }, 
+        size * 0.2f, 
+        wheelColor
+    );
+    
+    RayPals2DShape* rightWheel = CreateCircle(
+        (Vector2){ size * 0.2f, size * 0.3f }, 
+        size * 0.2f, 
+        wheelColor
+    );
+    
+    // Wheel hubs (decorative circles in the center of wheels)
+    RayPals2DShape* leftHub = CreateCircle(
+        (Vector2){ -size * 0.2f, size * 0.3f }, 
+        size * 0.05f, 
+        cannonColor
+    );
+    
+    RayPals2DShape* rightHub = CreateCircle(
+        (Vector2){ size * 0.2f, size * 0.3f }, 
+        size * 0.05f, 
+        cannonColor
+    );
+    
+    // Optional - cannon ball inside the barrel
+    RayPals2DShape* cannonBall = CreateCircle(
+        (Vector2){ size * 0.4f, -size * 0.1f }, 
+        size * 0.1f, 
+        BLACK
+    );
+    
+    // Add shapes to sprite in proper order
+    AddShapeToSprite(sprite, leftWheel);
+    AddShapeToSprite(sprite, rightWheel);
+    AddShapeToSprite(sprite, base);
+    AddShapeToSprite(sprite, barrel);
+    AddShapeToSprite(sprite, muzzle);
+    AddShapeToSprite(sprite, cannonBall);
+    AddShapeToSprite(sprite, leftHub);
+    AddShapeToSprite(sprite, rightHub);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+// ----------------------------------------------------------------------------
+// 3D Sprite Functions
+// ----------------------------------------------------------------------------
+
+RayPals3DSprite* Create3DSprite(int initialCapacity) {
+    RayPals3DSprite* sprite = (RayPals3DSprite*)RayPalsAlloc(activeArena, sizeof(RayPals3DSprite));
+    if (sprite == NULL) return NULL;
+    
+    if (initialCapacity < 1) initialCapacity = 1;
+    
+    sprite->arena = activeArena;
+    sprite->shapes = (RayPals3DShape**)RayPalsAlloc(sprite->arena, sizeof(RayPals3DShape*) * initialCapacity);
+    if (sprite->shapes == NULL) {
+        RayPalsFree(sprite->arena, sprite);
+        return NULL;
+    }
+    
+    sprite->shapeCount = 0;
+    sprite->shapeCapacity = initialCapacity;
+    sprite->position = (Vector3){ 0, 0, 0 };
+    sprite->rotation = (Vector3){ 0, 0, 0 };
+    sprite->scale = (Vector3){ 1, 1, 1 };
+    sprite->visible = true;
+    sprite->transformDirty = true;
+    
+    return sprite;
+}
+
+// Grows the shape array geometrically so repeated adds cost amortized O(1)
+static bool Reserve3DSpriteShapes(RayPals3DSprite* sprite, int required) {
+    if (required <= sprite->shapeCapacity) return true;
+    
+    int newCapacity = sprite->shapeCapacity > 0 ? sprite->shapeCapacity * 2 : 4;
+    if (newCapacity < required) newCapacity = required;
+    
+    RayPals3DShape** newShapes = (RayPals3DShape**)RayPalsRealloc(sprite->arena, sprite->shapes,
+                                  sizeof(RayPals3DShape*) * sprite->shapeCount,
+                                  sizeof(RayPals3DShape*) * newCapacity);
+    if (newShapes == NULL) return false;
+    
+    sprite->shapes = newShapes;
+    sprite->shapeCapacity = newCapacity;
+    return true;
+}
+
+void AddShapeTo3DSprite(RayPals3DSprite* sprite, RayPals3DShape* shape) {
+    if (!sprite || !shape) return;
+    
+    if (!Reserve3DSpriteShapes(sprite, sprite->shapeCount + 1)) return;
+    
+    sprite->shapes[sprite->shapeCount] = shape;
+    sprite->shapeCount++;
+    Queue3DSpriteRefit(sprite);
+}
+
+void AddShapesTo3DSprite(RayPals3DSprite* sprite, RayPals3DShape** shapes, int count) {
+    if (!sprite || !shapes || count <= 0) return;
+    
+    // One reservation for the whole batch
+    if (!Reserve3DSpriteShapes(sprite, sprite->shapeCount + count)) return;
+    
+    for (int i = 0; i < count; i++) {
+        if (shapes[i] == NULL) continue;
+        sprite->shapes[sprite->shapeCount] = shapes[i];
+        sprite->shapeCount++;
+    }
+    Queue3DSpriteRefit(sprite);
+}
+
+void Shrink3DSpriteToFit(RayPals3DSprite* sprite) {
+    if (!sprite || sprite->arena != NULL) return;  // Arena memory cannot be returned piecemeal
+    
+    int newCapacity = sprite->shapeCount > 0 ? sprite->shapeCount : 1;
+    if (newCapacity == sprite->shapeCapacity) return;
+    
+    RayPals3DShape** newShapes = (RayPals3DShape**)realloc(sprite->shapes, sizeof(RayPals3DShape*) * newCapacity);
+    if (newShapes == NULL) return;
+    
+    sprite->shapes = newShapes;
+    sprite->shapeCapacity = newCapacity;
+}
+
+void Draw3DSprite(RayPals3DSprite* sprite, Camera camera) {
+    if (!sprite || !sprite->visible) return;
+    
+    drawStats.sprites++;
+    
+    // Each shape's world matrix is cached against the sprite matrix, so an unmoved
+    // sprite costs one matrix multiply per shape and no trigonometry
+    for (int i = 0; i < sprite->shapeCount; i++) {
+        RayPals3DShape* shape = sprite->shapes[i];
+        if (!shape || !shape->visible) continue;
+        
+        Draw3DShapeTransformed(shape, Refresh3DShapeWorldMatrix(shape, sprite), &camera);
+    }
+}
+
+void Set3DSpritePosition(RayPals3DSprite* sprite, Vector3 position) {
+    if (!sprite) return;
+    
+    sprite->position = position;
+    sprite->transformDirty = true;
+    Queue3DSpriteRefit(sprite);
+}
+
+void Set3DSpriteRotation(RayPals3DSprite* sprite, Vector3 rotation) {
+    if (!sprite) return;
+    
+    sprite->rotation = rotation;
+    sprite->transformDirty = true;
+    Queue3DSpriteRefit(sprite);
+}
+
+void Set3DSpriteScale(RayPals3DSprite* sprite, Vector3 scale) {
+    if (!sprite) return;
+    
+    sprite->scale = scale;
+    sprite->transformDirty = true;
+    Queue3DSpriteRefit(sprite);
+}
+
+void Rotate3DSprite(RayPals3DSprite* sprite, float deltaTime, Vector3 speed) {
+    if (!sprite) return;
+    
+    sprite->rotation.x += speed.x * deltaTime;
+    sprite->rotation.y += speed.y * deltaTime;
+    sprite->rotation.z += speed.z * deltaTime;
+    
+    // Normalize rotations to 0-360 degrees
+    while (sprite->rotation.x >= 360.0f) sprite->rotation.x -= 360.0f;
+    while (sprite->rotation.x < 0.0f) sprite->rotation.x += 360.0f;
+    
+    while (sprite->rotation.y >= 360.0f) sprite->rotation.y -= 360.0f;
+    while (sprite->rotation.y < 0.0f) sprite->rotation.y += 360.0f;
+    
+    while (sprite->rotation.z >= 360.0f) sprite->rotation.z -= 360.0f;
+    while (sprite->rotation.z < 0.0f) sprite->rotation.z += 360.0f;
+    
+    sprite->transformDirty = true;
+    Queue3DSpriteRefit(sprite);
+}
+
+void Free3DSprite(RayPals3DSprite* sprite) {
+    if (!sprite) return;
+    
+    // Free all shapes in the sprite
+    for (int i = 0; i < sprite->shapeCount; i++) {
+        Free3DShape(sprite->shapes[i]);
+    }
+    
+    // Free the shapes array and the sprite itself
+    RayPalsFree(sprite->arena, sprite->shapes);
+    RayPalsFree(sprite->arena, sprite);
+}
+
+RayPals3DSprite* Create3DRobot(Vector3 position, float size, Color bodyColor, Color detailColor) {
+    RayPals3DSprite* sprite = Create3DSprite(6);
+    if (sprite == NULL) return NULL;
+    
+    // Robot body (main cube)
+    RayPals3DShape* body = CreateCube(
+        (Vector3){ 0, 0, 0 },
+        (Vector3){ size * 0.6f, size * 0.8f, size * 0.4f },
+        bodyColor
+    );
+    
+    // Robot head (smaller cube)
+    RayPals3DShape* head = CreateCube(
+        (Vector3){ 0, size * 0.6f, 0 },
+        (Vector3){ size * 0.4f, size * 0.4f, size * 0.4f },
+        bodyColor
+    );
+    
+    // Robot eyes (two small cylinders)
+    RayPals3DShape* leftEye = CreateCylinder(
+        (Vector3){ -size * 0.1f, size * 0.6f, size * 0.2f },
+        size * 0.05f,
+        size * 0.05f,
+        8,
+        detailColor
+    );
+    
+    RayPals3DShape* rightEye = CreateCylinder(
+        (Vector3){ size * 0.1f, size * 0.6f, size * 0.2f },
+        size * 0.05f,
+        size * 0.05f,
+        8,
+        detailColor
+    );
+    
+    // Robot arms (cylinders)
+    RayPals3DShape* leftArm = CreateCylinder(
+        (Vector3){ -size * 0.4f, 0, 0 },
+        size * 0.1f,
+        size * 0.6f,
+        8,
+        bodyColor
+    );
+    leftArm->rotation = (Vector3){ 0, 0, 90 };
+    
+    RayPals3DShape* rightArm = CreateCylinder(
+        (Vector3){ size * 0.4f, 0, 0 },
+        size * 0.1f,
+        size * 0.6f,
+        8,
+        bodyColor
+    );
+    rightArm->rotation = (Vector3){ 0, 0, -90 };
+    
+    // Add all shapes to the sprite
+    AddShapeTo3DSprite(sprite, body);
+    AddShapeTo3DSprite(sprite, head);
+    AddShapeTo3DSprite(sprite, leftEye);
+    AddShapeTo3DSprite(sprite, rightEye);
+    AddShapeTo3DSprite(sprite, leftArm);
+    AddShapeTo3DSprite(sprite, rightArm);
+    
+    // Set sprite position
+    Set3DSpritePosition(sprite, position);
+    
+    return sprite;
+}
+
+RayPals3DSprite* Create3DSpaceship(Vector3 position, float size, Color bodyColor, Color glassColor) {
+    RayPals3DSprite* sprite = Create3DSprite(5);
+    if (sprite == NULL) return NULL;
+    
+    // Main body (elongated cube)
+    RayPals3DShape* body = CreateCube(
+        (Vector3){ 0, 0, 0 },
+        (Vector3){ size * 1.5f, size * 0.3f, size * 0.8f },
+        bodyColor
+    );
+    
+    // Cockpit (sphere)
+    RayPals3DShape* cockpit = CreateSphere(
+        (Vector3){ size * 0.4f, size * 0.2f, 0 },
+        size * 0.2f,
+        16,
+        glassColor
+    );
+    
+    // Wings (two flat cubes)
+    RayPals3DShape* leftWing = CreateCube(
+        (Vector3){ 0, 0, -size * 0.6f },
+        (Vector3){ size * 0.8f, size * 0.1f, size * 0.4f },
+        bodyColor
+    );
+    
+    RayPals3DShape* rightWing = CreateCube(
+        (Vector3){ 0, 0, size * 0.6f },
+        (Vector3){ size * 0.8f, size * 0.1f, size * 0.4f },
+        bodyColor
+    );
+    
+    // Engine (cylinder)
+    RayPals3DShape* engine = CreateCylinder(
+        (Vector3){ -size * 0.6f, 0, 0 },
+        size * 0.2f,
+        size * 0.3f,
+        12,
+        bodyColor
+    );
+    engine->rotation = (Vector3){ 0, 0, 90 };
+    
+    // Add all shapes to the sprite
+    AddShapeTo3DSprite(sprite, body);
+    AddShapeTo3DSprite(sprite, cockpit);
+    AddShapeTo3DSprite(sprite, leftWing);
+    AddShapeTo3DSprite(sprite, rightWing);
+    AddShapeTo3DSprite(sprite, engine);
+    
+    // Set sprite position
+    Set3DSpritePosition(sprite, position);
+    
+    return sprite;
+}
+
+RayPals3DTree Create3DTree(Vector3 position, float scale, Color trunkColor, Color leavesColor) {
+    RayPals3DTree tree = { 0 };
+    tree.position = position;
+    tree.rotation = (Vector3){ 0.0f, 0.0f, 0.0f };
+    tree.scale = scale;
+    
+    // Create a 3D sprite with 2 shapes
+    tree.sprite = Create3DSprite(2);
+    if (!tree.sprite) return tree;
+    
+    // Set sprite position and scale
+    Set3DSpritePosition(tree.sprite, position);
+    Set3DSpriteScale(tree.sprite, (Vector3){ 1.0f, 1.0f, 1.0f });
+
+    // Create trunk (cylinder)
+    RayPals3DShape* trunk = CreateCylinder(
+        (Vector3){ 0, scale, 0 },  // Relative to tree position
+        0.3f * scale,
+        2.0f * scale,
+        12,
+        trunkColor
+    );
+    
+    // Create leaves (cone)
+    RayPals3DShape* leaves = CreateCone(
+        (Vector3){ 0, 3.0f * scale, 0 },  // Relative to tree position
+        1.5f * scale,
+        2.5f * scale,
+        12,
+        leavesColor
+    );
+    
+    // Add shapes to sprite
+    AddShapeTo3DSprite(tree.sprite, trunk);
+    AddShapeTo3DSprite(tree.sprite, leaves);
+
+    return tree;
+}
+
+void Free3DTree(RayPals3DTree* tree) {
+    if (tree == NULL) return;
+    
+    Free3DSprite(tree->sprite);
+    // Note: We're not freeing the tree itself as it might be stack-allocated
+}
+
+// Create a skeleton shape
+RayPals2DShape* CreateSkeleton(Vector2 position, float size, Color color) {
+    RayPals2DShape* shape = AllocShape2D();
+    if (shape == NULL) return NULL;
+    
+    shape->type = RAYPALS_SKELETON;
+    shape->position = position;
+    shape->size = (Vector2){ size, size * 1.5f }; // Skeletons are taller than wide
+    shape->rotation = 0.0f;
+    shape->color = color;
+    shape->filled = true;
+    shape->thickness = 2.0f;
+    shape->segments = 0;
+    shape->points = 0;
+    shape->visible = true;
+    
+    return shape;
+}
+
+RayPalsSprite* CreateSkeletonSprite(Vector2 position, float size, Color boneColor) {
+    RayPalsSprite* sprite = CreateSprite(9);
+    if (sprite == NULL) return NULL;
+    
+    // Skull (circle)
+    RayPals2DShape* skull = CreateCircle((Vector2){ 0, -size*0.35f }, size*0.15f, boneColor);
+    skull->filled = false;
+    skull->thickness = 2.0f;
+    
+    // Eye sockets (small circles)
+    RayPals2DShape* eyeLeft = CreateCircle((Vector2){ -size*0.06f, -size*0.36f }, size*0.03f, BLACK);
+    RayPals2DShape* eyeRight = CreateCircle((Vector2){ size*0.06f, -size*0.36f }, size*0.03f, BLACK);
+    
+    // Body (rectangle)
+    RayPals2DShape* spine = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size*0.05f, size*0.5f }, boneColor);
+    spine->filled = false;
+    spine->thickness = 2.0f;
+    
+    // Ribcage (horizontal lines)
+    RayPals2DShape* ribcage = CreateRectangle((Vector2){ 0, -size*0.15f }, (Vector2){ size*0.3f, size*0.25f }, boneColor);
+    ribcage->filled = false;
+    ribcage->thickness = 2.0f;
+    
+    // Arms
+    RayPals2DShape* armLeft = CreateRectangle((Vector2){ -size*0.2f, -size*0.1f }, (Vector2){ size*0.2f, size*0.05f }, boneColor);
+    armLeft->filled = false;
+    armLeft->thickness = 2.0f;
+    armLeft->rotation = 15.0f;
+    
+    RayPals2DShape* armRight = CreateRectangle((Vector2){ size*0.2f, -size*0.1f }, (Vector2){ size*0.2f, size*0.05f }, boneColor);
+    armRight->filled = false;
+    armRight->thickness = 2.0f;
+    armRight->rotation = -15.0f;
+    
+    // Legs
+    RayPals2DShape* legLeft = CreateRectangle((Vector2){ -size*0.1f, size*0.3f }, (Vector2){ size*0.05f, size*0.3f }, boneColor);
+    legLeft->filled = false;
+    legLeft->thickness = 2.0f;
+    legLeft->rotation = -15.0f;
+    
+    RayPals2DShape* legRight = CreateRectangle((Vector2){ size*0.1f, size*0.3f }, (Vector2){ size*0.05f, size*0.3f }, boneColor);
+    legRight->filled = false;
+    legRight->thickness = 2.0f;
+    legRight->rotation = 15.0f;
+    
+    // Add shapes to sprite
+    AddShapeToSprite(sprite, skull);
+    AddShapeToSprite(sprite, eyeLeft);
+    AddShapeToSprite(sprite, eyeRight);
+    AddShapeToSprite(sprite, spine);
+    AddShapeToSprite(sprite, ribcage);
+    AddShapeToSprite(sprite, armLeft);
+    AddShapeToSprite(sprite, armRight);
+    AddShapeToSprite(sprite, legLeft);
+    AddShapeToSprite(sprite, legRight);
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateWaterfallSprite(Vector2 position, float width, float height, Color color) {
+    // Calculate number of drops per row and spacing
+    int dropsPerRow = 5;
+    float dropSize = width / (dropsPerRow * 1.5f);
+    float horizontalSpacing = width / dropsPerRow;
+    float verticalSpacing = dropSize * 1.2f;
+    int rows = (int)(height / verticalSpacing) + 1;
+    
+    // Size the sprite for every drop up front so the shape array is allocated once
+    RayPalsSprite* sprite = CreateSprite(rows * dropsPerRow);
+    if (sprite == NULL) return NULL;
+    
+    // Add randomness to positions for natural look
+    srand(time(NULL));
+    
+    // Create multiple drops in a waterfall pattern
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < dropsPerRow; col++) {
+            // Add some randomness to positioning
+            float offsetX = ((float)rand() / RAND_MAX - 0.5f) * (horizontalSpacing * 0.4f);
+            float offsetY = ((float)rand() / RAND_MAX - 0.5f) * (verticalSpacing * 0.4f);
+            
+            // Calculate position of this drop
+            Vector2 dropPos = {
+                -width/2 + col * horizontalSpacing + horizontalSpacing/2 + offsetX,
+                -height/2 + row * verticalSpacing + offsetY
+            };
+            
+            // Create smaller drops higher up, larger drops lower down
+            float sizeVariation = 0.6f + 0.4f * (float)row / rows;
+            float thisDropSize = dropSize * sizeVariation;
+            
+            // Vary color slightly for visual interest
+            Color dropColor = color;
+            dropColor.a = (unsigned char)(200 + ((float)rand() / RAND_MAX) * 55);
+            
+            // Create the water drop and add it to the sprite
+            RayPals2DShape* drop = CreateWaterDrop(dropPos, thisDropSize, 0.0f, dropColor);
+            AddShapeToSprite(sprite, drop);
+        }
+    }
+    
+    // Set sprite position
+    sprite->position = position;
+    
+    return sprite;
+}
+
+RayPalsSprite* CreateApple(Vector2 position, float size, Color color, Color stemColor) {
+    RayPalsSprite* sprite = CreateSprite(3);
+    if (!sprite) return NULL;
+
+    // Main apple body (circle)
+    RayPals2DShape* body = CreateCircle((Vector2){0, 0}, size, color);
+    AddShapeToSprite(sprite, body);
+
+    // Stem (rectangle)
+    RayPals2DShape* stem = CreateRectangle((Vector2){0, -size/2}, (Vector2){size/8, size/3}, stemColor);
+    AddShapeToSprite(sprite, stem);
+
+    // Leaf (triangle)
+    RayPals2DShape* leaf = CreateTriangle((Vector2){size/4, -size/2}, size/4, stemColor);
+    SetShapeRotation(leaf, 45.0f);
+    AddShapeToSprite(sprite, leaf);
+
+    SetSpritePosition(sprite, position);
+    return sprite;
+}
+
+RayPalsSprite* CreateBanana(Vector2 position, float size, Color color, Color stemColor) {
+    RayPalsSprite* sprite = CreateSprite(3);
+    if (!sprite) return NULL;
+
+    // Main banana body (rectangle with rounded ends)
+    RayPals2DShape* body = CreateRectangle((Vector2){0, 0}, (Vector2){size, size/3}, color);
+    AddShapeToSprite(sprite, body);
+
+    // Stem (rectangle)
+    RayPals2DShape* stem = CreateRectangle((Vector2){-size/2, -size/6}, (Vector2){size/8, size/4}, stemColor);
+    AddShapeToSprite(sprite, stem);
+
+    // Curve (triangle for banana curve)
+    RayPals2DShape* curve = CreateTriangle((Vector2){size/4, 0}, size/4, color);
+    SetShapeRotation(curve, 30.0f);
+    AddShapeToSprite(sprite, curve);
+
+    SetSpritePosition(sprite, position);
+    return sprite;
+}
+
+RayPalsSprite* CreateOrange(Vector2 position, float size, Color color, Color stemColor) {
+    RayPalsSprite* sprite = CreateSprite(3);
+    if (!sprite) return NULL;
+
+    // Main orange body (circle)
+    RayPals2DShape* body = CreateCircle((Vector2){0, 0}, size, color);
+    AddShapeToSprite(sprite, body);
+
+    // Stem (rectangle)
+    RayPals2DShape* stem = CreateRectangle((Vector2){0, -size/2}, (Vector2){size/8, size/4}, stemColor);
+    AddShapeToSprite(sprite, stem);
+
+    // Leaf (triangle)
+    RayPals2DShape* leaf = CreateTriangle((Vector2){size/4, -size/2}, size/4, stemColor);
+    SetShapeRotation(leaf, 45.0f);
+    AddShapeToSprite(sprite, leaf);
+
+    SetSpritePosition(sprite, position);
+    return sprite;
+}
+
+RayPalsSprite* CreateWatermelon(Vector2 position, float size, Color rindColor, Color fleshColor, Color seedColor) {
+    RayPalsSprite* sprite = CreateSprite(5);
+    if (!sprite) return NULL;
+
+    // Main watermelon body (circle)
+    RayPals2DShape* body = CreateCircle((Vector2){0, 0}, size, rindColor);
+    AddShapeToSprite(sprite, body);
+
+    // Flesh (slightly smaller circle)
+    RayPals2DShape* flesh = CreateCircle((Vector2){0, 0}, size * 0.9f, fleshColor);
+    AddShapeToSprite(sprite, flesh);
+
+    // Seeds (small circles)
+    RayPals2DShape* seed1 = CreateCircle((Vector2){size/4, size/4}, size/8, seedColor);
+    RayPals2DShape* seed2 = CreateCircle((Vector2){-size/4, -size/4}, size/8, seedColor);
+    RayPals2DShape* seed3 = CreateCircle((Vector2){size/4, -size/4}, size/8, seedColor);
+    AddShapeToSprite(sprite, seed1);
+    AddShapeToSprite(sprite, seed2);
+    AddShapeToSprite(sprite, seed3);
+
+    SetSpritePosition(sprite, position);
+    return sprite;
+}
+
+RayPalsSprite* CreateGrape(Vector2 position, float size, Color color, Color stemColor) {
+    RayPalsSprite* sprite = CreateSprite(3);
+    if (!sprite) return NULL;
+
+    // Main grape body (circle)
+    RayPals2DShape* body = CreateCircle((Vector2){0, 0}, size, color);
+    AddShapeToSprite(sprite, body);
+
+    // Stem (rectangle)
+    RayPals2DShape* stem = CreateRectangle((Vector2){0, -size/2}, (Vector2){size/8, size/3}, stemColor);
+    AddShapeToSprite(sprite, stem);
+
+    // Highlight (small circle)
+    RayPals2DShape* highlight = CreateCircle((Vector2){-size/4, -size/4}, size/4, (Color){255, 255, 255, 128});
+    AddShapeToSprite(sprite, highlight);
+
+    SetSpritePosition(sprite, position);
+    return sprite;
+}
+
+RayPalsSprite* CreateGrapes(Vector2 position, float size, Color color, Color stemColor) {
+    RayPalsSprite* sprite = CreateSprite(17);  // Capacity for main stem, 8 grapes and 8 highlights
+    if (!sprite) return NULL;
+
+    // Main stem (rectangle)
+    RayPals2DShape* stem = CreateRectangle((Vector2){0, -size/2}, (Vector2){size/8, size/3}, stemColor);
+    AddShapeToSprite(sprite, stem);
+
+    // Create individual grapes (just the body and highlight, no stems)
+    // Top row
+    RayPals2DShape* grape1 = CreateCircle((Vector2){-size/4, -size/4}, size/4, color);
+    RayPals2DShape* grape2 = CreateCircle((Vector2){0, -size/4}, size/4, color);
+    RayPals2DShape* grape3 = CreateCircle((Vector2){size/4, -size/4}, size/4, color);
+    
+    // Middle row
+    RayPals2DShape* grape4 = CreateCircle((Vector2){-size/3, 0}, size/4, color);
+    RayPals2DShape* grape5 = CreateCircle((Vector2){0, 0}, size/4, color);
+    RayPals2DShape* grape6 = CreateCircle((Vector2){size/3, 0}, size/4, color);
+    
+    // Bottom row
+    RayPals2DShape* grape7 = CreateCircle((Vector2){-size/4, size/4}, size/4, color);
+    RayPals2DShape* grape8 = CreateCircle((Vector2){size/4, size/4}, size/4, color);
+
+    // Add highlights to each grape
+    RayPals2DShape* highlight1 = CreateCircle((Vector2){-size/4 - size/8, -size/4 - size/8}, size/8, (Color){255, 255, 255, 128});
+    RayPals2DShape* highlight2 = CreateCircle((Vector2){-size/8, -size/4 - size/8}, size/8, (Color){255, 255, 255, 128});
+    RayPals2DShape* highlight3 = CreateCircle((Vector2){size/4 - size/8, -size/4 - size/8}, size/8, (Color){255, 255, 255, 128});
+    RayPals2DShape* highlight4 = CreateCircle((Vector2){-size/3 - size/8, -size/8}, size/8, (Color){255, 255, 255, 128});
+    RayPals2DShape* highlight5 = CreateCircle((Vector2){-size/8, -size/8}, size/8, (Color){255, 255, 255, 128});
+    RayPals2DShape* highlight6 = CreateCircle((Vector2){size/3 - size/8, -size/8}, size/8, (Color){255, 255, 255, 128});
+    RayPals2DShape* highlight7 = CreateCircle((Vector2){-size/4 - size/8, size/4 - size/8}, size/8, (Color){255, 255, 255, 128});
+    RayPals2DShape* highlight8 = CreateCircle((Vector2){size/4 - size/8, size/4 - size/8}, size/8, (Color){255, 255, 255, 128});
+
+    // Add all grapes and highlights to the sprite
+    AddShapeToSprite(sprite, grape1);
+    AddShapeToSprite(sprite, grape2);
+    AddShapeToSprite(sprite, grape3);
+    AddShapeToSprite(sprite, grape4);
+    AddShapeToSprite(sprite, grape5);
+    AddShapeToSprite(sprite, grape6);
+    AddShapeToSprite(sprite, grape7);
+    AddShapeToSprite(sprite, grape8);
+    AddShapeToSprite(sprite, highlight1);
+    AddShapeToSprite(sprite, highlight2);
+    AddShapeToSprite(sprite, highlight3);
+    AddShapeToSprite(sprite, highlight4);
+    AddShapeToSprite(sprite, highlight5);
+    AddShapeToSprite(sprite, highlight6);
+    AddShapeToSprite(sprite, highlight7);
+    AddShapeToSprite(sprite, highlight8);
+
+    SetSpritePosition(sprite, position);
+    return sprite;
+}
+
+RayPalsSprite* CreateFrankenstein(Vector2 position, float size, Color skinColor, Color clothesColor) {
+    // Create a more iconic Frankenstein's monster
+    RayPalsSprite* sprite = CreateSprite(16);  // Increased number of parts for more detail
+    if (!sprite) return NULL;
+
+    // Make sure skin color has a proper green tint
+    Color monsterSkin = skinColor;
+    monsterSkin.g = (unsigned char)fmin(255, monsterSkin.g + 40);  // Enhance green
+    monsterSkin.r = (unsigned char)fmax(0, monsterSkin.r - 20);    // Reduce red
+
+    // Create jacket/coat (slightly broader than body)
+    RayPals2DShape* coat = CreateRectangle((Vector2){0, 0}, (Vector2){size * 0.65f, size * 1.1f}, clothesColor);
+    if (coat) {
+        AddShapeToSprite(sprite, coat);
+    }
+
+    // Create shirt/undershirt
+    RayPals2DShape* shirt = CreateRectangle((Vector2){0, -size * 0.35f}, (Vector2){size * 0.4f, size * 0.4f}, (Color){240, 240, 240, 255});
+    if (shirt) {
+        AddShapeToSprite(sprite, shirt);
+    }
+
+    // Create neck
+    RayPals2DShape* neck = CreateRectangle((Vector2){0, -size * 0.6f}, (Vector2){size * 0.25f, size * 0.15f}, monsterSkin);
+    if (neck) {
+        AddShapeToSprite(sprite, neck);
+    }
+
+    // Create head (classic flat-top)
+    RayPals2DShape* headBottom = CreateRectangle((Vector2){0, -size * 0.8f}, (Vector2){size * 0.4f, size * 0.3f}, monsterSkin);
+    if (headBottom) {
+        AddShapeToSprite(sprite, headBottom);
+    }
+
+    // Create flat top of head
+    RayPals2DShape* headTop = CreateRectangle((Vector2){0, -size * 0.99f}, (Vector2){size * 0.45f, size * 0.08f}, monsterSkin);
+    if (headTop) {
+        AddShapeToSprite(sprite, headTop);
+    }
+
+    // Create neck bolts (metallic)
+    RayPals2DShape* leftBoltBase = CreateRectangle((Vector2){-size * 0.2f, -size * 0.6f}, (Vector2){size * 0.15f, size * 0.05f}, DARKGRAY);
+    if (leftBoltBase) {
+        AddShapeToSprite(sprite, leftBoltBase);
+    }
+
+    RayPals2DShape* leftBoltHead = CreateCircle((Vector2){-size * 0.28f, -size * 0.6f}, size * 0.04f, GRAY);
+    if (leftBoltHead) {
+        AddShapeToSprite(sprite, leftBoltHead);
+    }
+
+    RayPals2DShape* rightBoltBase = CreateRectangle((Vector2){size * 0.2f, -size * 0.6f}, (Vector2){size * 0.15f, size * 0.05f}, DARKGRAY);
+    if (rightBoltBase) {
+        AddShapeToSprite(sprite, rightBoltBase);
+    }
+
+    RayPals2DShape* rightBoltHead = CreateCircle((Vector2){size * 0.28f, -size * 0.6f}, size * 0.04f, GRAY);
+    if (rightBoltHead) {
+        AddShapeToSprite(sprite, rightBoltHead);
+    }
+
+    // Create eyes (deep-set)
+    RayPals2DShape* leftEye = CreateCircle((Vector2){-size * 0.1f, -size * 0.82f}, size * 0.04f, BLACK);
+    if (leftEye) {
+        AddShapeToSprite(sprite, leftEye);
+    }
+
+    RayPals2DShape* rightEye = CreateCircle((Vector2){size * 0.1f, -size * 0.82f}, size * 0.04f, BLACK);
+    if (rightEye) {
+        AddShapeToSprite(sprite, rightEye);
     }
-    
-    return star;
+
+    // Create arms (slightly shorter to appear hunched)
+    RayPals2DShape* leftArm = CreateRectangle((Vector2){-size * 0.45f, size * 0.05f}, (Vector2){size * 0.25f, size * 0.6f}, monsterSkin);
+    if (leftArm) {
+        SetShapeRotation(leftArm, 10);  // Slightly angled outward
+        AddShapeToSprite(sprite, leftArm);
+    }
+
+    RayPals2DShape* rightArm = CreateRectangle((Vector2){size * 0.45f, size * 0.05f}, (Vector2){size * 0.25f, size * 0.6f}, monsterSkin);
+    if (rightArm) {
+        SetShapeRotation(rightArm, -10);  // Slightly angled outward
+        AddShapeToSprite(sprite, rightArm);
+    }
+
+    // Create pants
+    RayPals2DShape* pants = CreateRectangle((Vector2){0, size * 0.6f}, (Vector2){size * 0.45f, size * 0.6f}, DARKBROWN);
+    if (pants) {
+        AddShapeToSprite(sprite, pants);
+    }
+
+    // Create heavy boots
+    RayPals2DShape* leftBoot = CreateRectangle((Vector2){-size * 0.15f, size * 1.0f}, (Vector2){size * 0.2f, size * 0.2f}, BLACK);
+    if (leftBoot) {
+        AddShapeToSprite(sprite, leftBoot);
+    }
+
+    RayPals2DShape* rightBoot = CreateRectangle((Vector2){size * 0.15f, size * 1.0f}, (Vector2){size * 0.2f, size * 0.2f}, BLACK);
+    if (rightBoot) {
+        AddShapeToSprite(sprite, rightBoot);
+    }
+
+    // Set sprite position
+    SetSpritePosition(sprite, position);
+
+    return sprite;
 }
 
-RayPalsSprite* CreateExplosion(Vector2 position, float size, Color primaryColor, Color secondaryColor) {
+RayPalsSprite* CreateDracula(Vector2 position, float size, Color capeColor, Color skinColor) {
     RayPalsSprite* sprite = CreateSprite(8);
     if (sprite == NULL) return NULL;
     
-    // Create center of explosion
-    RayPals2DShape* center = CreateCircle((Vector2){ 0, 0 }, size * 0.4f, primaryColor);
+    // Create a pale skin color
+    Color vampireSkin = skinColor;
+    vampireSkin.r -= 30;  // Make skin paler
+    vampireSkin.g -= 20;
     
-    // Create outer explosion circles
-    RayPals2DShape* outerCircle1 = CreateCircle((Vector2){ size * 0.3f, size * 0.2f }, size * 0.25f, secondaryColor);
-    RayPals2DShape* outerCircle2 = CreateCircle((Vector2){ -size * 0.25f, size * 0.3f }, size * 0.2f, secondaryColor);
-    RayPals2DShape* outerCircle3 = CreateCircle((Vector2){ -size * 0.3f, -size * 0.2f }, size * 0.25f, secondaryColor);
-    RayPals2DShape* outerCircle4 = CreateCircle((Vector2){ size * 0.25f, -size * 0.3f }, size * 0.2f, secondaryColor);
+    // Cape (triangle)
+    RayPals2DShape* cape = CreateTriangle((Vector2){ 0, size * 0.3f }, size * 0.8f, capeColor);
+    cape->rotation = 180.0f; // Point downward
     
-    // Create some triangular "spikes" for a more dynamic look
-    RayPals2DShape* spike1 = CreateTriangle((Vector2){ size * 0.45f, 0 }, size * 0.4f, primaryColor);
-    spike1->rotation = 0.0f;
+    // Body (rectangle)
+    RayPals2DShape* body = CreateRectangle((Vector2){ 0, size * 0.1f }, (Vector2){ size * 0.3f, size * 0.4f }, BLACK);
     
-    RayPals2DShape* spike2 = CreateTriangle((Vector2){ 0, size * 0.45f }, size * 0.4f, primaryColor);
-    spike2->rotation = 90.0f;
+    // Head (circle)
+    RayPals2DShape* head = CreateCircle((Vector2){ 0, -size * 0.2f }, size * 0.15f, vampireSkin);
     
-    RayPals2DShape* spike3 = CreateTriangle((Vector2){ -size * 0.45f, 0 }, size * 0.4f, primaryColor);
-    spike3->rotation = 180.0f;
+    // Hair (triangle)
+    RayPals2DShape* hair = CreateTriangle((Vector2){ 0, -size * 0.35f }, size * 0.2f, BLACK);
+    
+    // Eyes (circles)
+    RayPals2DShape* eyeLeft = CreateCircle((Vector2){ -size * 0.05f, -size * 0.2f }, size * 0.03f, RED);
+    RayPals2DShape* eyeRight = CreateCircle((Vector2){ size * 0.05f, -size * 0.2f }, size * 0.03f, RED);
+    
+    // Fangs (triangles)
+    RayPals2DShape* fangLeft = CreateTriangle((Vector2){ -size * 0.05f, -size * 0.1f }, size * 0.05f, WHITE);
+    fangLeft->rotation = 180.0f;
+    RayPals2DShape* fangRight = CreateTriangle((Vector2){ size * 0.05f, -size * 0.1f }, size * 0.05f, WHITE);
+    fangRight->rotation = 180.0f;
     
     // Add shapes to sprite
-    AddShapeToSprite(sprite, outerCircle1);
-    AddShapeToSprite(sprite, outerCircle2);
-    AddShapeToSprite(sprite, outerCircle3);
-    AddShapeToSprite(sprite, outerCircle4);
-    AddShapeToSprite(sprite, spike1);
-    AddShapeToSprite(sprite, spike2);
-    AddShapeToSprite(sprite, spike3);
-    AddShapeToSprite(sprite, center);  // Center on top for better visual
+    AddShapeToSprite(sprite, cape);
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, head);
+    AddShapeToSprite(sprite, hair);
+    AddShapeToSprite(sprite, eyeLeft);
+    AddShapeToSprite(sprite, eyeRight);
+    AddShapeToSprite(sprite, fangLeft);
+    AddShapeToSprite(sprite, fangRight);
     
     // Set sprite position
     sprite->position = position;
@@ -1814,36 +5248,60 @@ RayPalsSprite* CreateExplosion(Vector2 position, float size, Color primaryColor,
     return sprite;
 }
 
-RayPalsSprite* CreateAirplane(Vector2 position, float size, Color bodyColor, Color detailColor) {
-    RayPalsSprite* sprite = CreateSprite(6);
+RayPalsSprite* CreateWerewolf(Vector2 position, float size, Color furColor, Color eyeColor) {
+    RayPalsSprite* sprite = CreateSprite(13);
     if (sprite == NULL) return NULL;
     
-    // Airplane fuselage (main body)
-    RayPals2DShape* body = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size * 1.2f, size * 0.25f }, bodyColor);
+    // Body (rectangle)
+    RayPals2DShape* body = CreateRectangle((Vector2){ 0, size * 0.1f }, (Vector2){ size * 0.4f, size * 0.5f }, furColor);
     
-    // Airplane nose (front part)
-    RayPals2DShape* nose = CreateTriangle((Vector2){ size * 0.6f, 0 }, size * 0.4f, bodyColor);
-    nose->rotation = 90.0f;  // Point to the right
+    // Head (circle)
+    RayPals2DShape* head = CreateCircle((Vector2){ 0, -size * 0.2f }, size * 0.2f, furColor);
     
-    // Airplane tail (back part)
-    RayPals2DShape* tail = CreateRectangle((Vector2){ -size * 0.5f, -size * 0.25f }, (Vector2){ size * 0.3f, size * 0.3f }, bodyColor);
+    // Snout (triangle)
+    RayPals2DShape* snout = CreateTriangle((Vector2){ 0, -size * 0.1f }, size * 0.15f, furColor);
+    snout->rotation = 180.0f;
     
-    // Airplane wings
-    RayPals2DShape* wings = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size * 0.6f, size * 0.8f }, bodyColor);
+    // Ears (triangles)
+    RayPals2DShape* earLeft = CreateTriangle((Vector2){ -size * 0.15f, -size * 0.35f }, size * 0.1f, furColor);
+    earLeft->rotation = -45.0f;
+    RayPals2DShape* earRight = CreateTriangle((Vector2){ size * 0.15f, -size * 0.35f }, size * 0.1f, furColor);
+    earRight->rotation = 45.0f;
     
-    // Windows (detail)
-    RayPals2DShape* window1 = CreateCircle((Vector2){ size * 0.2f, 0 }, size * 0.05f, detailColor);
-    RayPals2DShape* window2 = CreateCircle((Vector2){ 0, 0 }, size * 0.05f, detailColor);
-    RayPals2DShape* window3 = CreateCircle((Vector2){ -size * 0.2f, 0 }, size * 0.05f, detailColor);
+    // Eyes (circles)
+    RayPals2DShape* eyeLeft = CreateCircle((Vector2){ -size * 0.08f, -size * 0.25f }, size * 0.03f, eyeColor);
+    RayPals2DShape* eyeRight = CreateCircle((Vector2){ size * 0.08f, -size * 0.25f }, size * 0.03f, eyeColor);
+    
+    // Arms (rectangles)
+    RayPals2DShape* armLeft = CreateRectangle((Vector2){ -size * 0.25f, size * 0.1f }, (Vector2){ size * 0.15f, size * 0.3f }, furColor);
+    armLeft->rotation = -15.0f;
+    RayPals2DShape* armRight = CreateRectangle((Vector2){ size * 0.25f, size * 0.1f }, (Vector2){ size * 0.15f, size * 0.3f }, furColor);
+    armRight->rotation = 15.0f;
+    
+    // Legs (rectangles)
+    RayPals2DShape* legLeft = CreateRectangle((Vector2){ -size * 0.1f, size * 0.4f }, (Vector2){ size * 0.15f, size * 0.4f }, furColor);
+    RayPals2DShape* legRight = CreateRectangle((Vector2){ size * 0.1f, size * 0.4f }, (Vector2){ size * 0.15f, size * 0.4f }, furColor);
+    
+    // Claws (triangles)
+    RayPals2DShape* clawLeft = CreateTriangle((Vector2){ -size * 0.25f, size * 0.4f }, size * 0.05f, WHITE);
+    clawLeft->rotation = 90.0f;
+    RayPals2DShape* clawRight = CreateTriangle((Vector2){ size * 0.25f, size * 0.4f }, size * 0.05f, WHITE);
+    clawRight->rotation = -90.0f;
     
     // Add shapes to sprite
     AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, wings);
-    AddShapeToSprite(sprite, nose);
-    AddShapeToSprite(sprite, tail);
-    AddShapeToSprite(sprite, window1);
-    AddShapeToSprite(sprite, window2);
-    AddShapeToSprite(sprite, window3);
+    AddShapeToSprite(sprite, legLeft);
+    AddShapeToSprite(sprite, legRight);
+    AddShapeToSprite(sprite, armLeft);
+    AddShapeToSprite(sprite, armRight);
+    AddShapeToSprite(sprite, head);
+    AddShapeToSprite(sprite, snout);
+    AddShapeToSprite(sprite, earLeft);
+    AddShapeToSprite(sprite, earRight);
+    AddShapeToSprite(sprite, eyeLeft);
+    AddShapeToSprite(sprite, eyeRight);
+    AddShapeToSprite(sprite, clawLeft);
+    AddShapeToSprite(sprite, clawRight);
     
     // Set sprite position
     sprite->position = position;
@@ -1851,1587 +5309,4339 @@ RayPalsSprite* CreateAirplane(Vector2 position, float size, Color bodyColor, Col
     return sprite;
 }
 
-RayPalsSprite* CreateSoldier(Vector2 position, float size, Color uniformColor, Color skinColor) {
-    RayPalsSprite* sprite = CreateSprite(7);
-    if (sprite == NULL) return NULL;
-    
-    // Body parts
-    RayPals2DShape* body = CreateRectangle((Vector2){ 0, size * 0.15f }, (Vector2){ size * 0.4f, size * 0.5f }, uniformColor);
-    
-    // Head with helmet
-    RayPals2DShape* head = CreateCircle((Vector2){ 0, -size * 0.25f }, size * 0.2f, skinColor);
-    RayPals2DShape* helmet = CreateRectangle((Vector2){ 0, -size * 0.35f }, (Vector2){ size * 0.4f, size * 0.15f }, uniformColor);
-    
-    // Arms
-    RayPals2DShape* leftArm = CreateRectangle((Vector2){ -size * 0.25f, size * 0.1f }, (Vector2){ size * 0.1f, size * 0.4f }, uniformColor);
-    leftArm->rotation = -15.0f;
+RayPalsSprite* CreateMummy(Vector2 position, float size, Color bandageColor, Color eyeColor) {
+    RayPalsSprite* sprite = CreateSprite(8);  // 8 shapes: body, head, 2 eyes, 2 arms, 2 legs
+    if (!sprite) return NULL;
+
+    // Create body (wrapped in bandages)
+    RayPals2DShape* body = CreateRectangle((Vector2){0, 0}, (Vector2){size * 0.6f, size * 1.2f}, bandageColor);
+    if (body) {
+        AddShapeToSprite(sprite, body);
+    }
+
+    // Create head (wrapped in bandages)
+    RayPals2DShape* head = CreateCircle((Vector2){0, -size * 0.5f}, size * 0.2f, bandageColor);
+    if (head) {
+        AddShapeToSprite(sprite, head);
+    }
+
+    // Create eyes
+    RayPals2DShape* leftEye = CreateCircle((Vector2){-size * 0.1f, -size * 0.5f}, size * 0.05f, eyeColor);
+    if (leftEye) {
+        AddShapeToSprite(sprite, leftEye);
+    }
+
+    RayPals2DShape* rightEye = CreateCircle((Vector2){size * 0.1f, -size * 0.5f}, size * 0.05f, eyeColor);
+    if (rightEye) {
+        AddShapeToSprite(sprite, rightEye);
+    }
+
+    // Create arms (wrapped in bandages)
+    RayPals2DShape* leftArm = CreateRectangle((Vector2){-size * 0.4f, 0}, (Vector2){size * 0.3f, size * 0.6f}, bandageColor);
+    if (leftArm) {
+        SetShapeRotation(leftArm, 45);
+        AddShapeToSprite(sprite, leftArm);
+    }
+
+    RayPals2DShape* rightArm = CreateRectangle((Vector2){size * 0.4f, 0}, (Vector2){size * 0.3f, size * 0.6f}, bandageColor);
+    if (rightArm) {
+        SetShapeRotation(rightArm, -45);
+        AddShapeToSprite(sprite, rightArm);
+    }
+
+    // Create legs (wrapped in bandages)
+    RayPals2DShape* leftLeg = CreateRectangle((Vector2){-size * 0.2f, size * 0.7f}, (Vector2){size * 0.3f, size * 0.6f}, bandageColor);
+    if (leftLeg) {
+        AddShapeToSprite(sprite, leftLeg);
+    }
+
+    RayPals2DShape* rightLeg = CreateRectangle((Vector2){size * 0.2f, size * 0.7f}, (Vector2){size * 0.3f, size * 0.6f}, bandageColor);
+    if (rightLeg) {
+        AddShapeToSprite(sprite, rightLeg);
+    }
+
+    // Set sprite position
+    SetSpritePosition(sprite, position);
+
+    return sprite;
+}
+
+// ----------------------------------------------------------------------------
+// Sprite Template Functions
+// ----------------------------------------------------------------------------
+
+RayPalsSpriteTemplate* CreateSpriteTemplate(const RayPalsSprite* sprite) {
+    if (!sprite) return NULL;
     
-    RayPals2DShape* rightArm = CreateRectangle((Vector2){ size * 0.25f, size * 0.1f }, (Vector2){ size * 0.1f, size * 0.4f }, uniformColor);
-    rightArm->rotation = 15.0f;
+    RayPalsSpriteTemplate* spriteTemplate = (RayPalsSpriteTemplate*)RayPalsAlloc(activeArena, sizeof(RayPalsSpriteTemplate));
+    if (spriteTemplate == NULL) return NULL;
     
-    // Legs
-    RayPals2DShape* leftLeg = CreateRectangle((Vector2){ -size * 0.15f, size * 0.5f }, (Vector2){ size * 0.15f, size * 0.4f }, uniformColor);
-    RayPals2DShape* rightLeg = CreateRectangle((Vector2){ size * 0.15f, size * 0.5f }, (Vector2){ size * 0.15f, size * 0.4f }, uniformColor);
+    spriteTemplate->arena = activeArena;
     
-    // Gun (optional)
-    RayPals2DShape* gun = CreateRectangle((Vector2){ size * 0.4f, size * 0.2f }, (Vector2){ size * 0.5f, size * 0.1f }, (Color){ 80, 80, 80, 255 });
+    if (sprite->shapeCount > 0) {
+        spriteTemplate->shapes = (RayPals2DShape*)RayPalsAlloc(spriteTemplate->arena, sizeof(RayPals2DShape) * sprite->shapeCount);
+        if (spriteTemplate->shapes == NULL) {
+            RayPalsFree(spriteTemplate->arena, spriteTemplate);
+            return NULL;
+        }
+        
+        for (int i = 0; i < sprite->shapeCount; i++) {
+            spriteTemplate->shapes[i] = *sprite->shapes[i];
+            spriteTemplate->shapes[i].arena = spriteTemplate->arena;
+        }
+        spriteTemplate->shapeCount = sprite->shapeCount;
+    }
     
-    // Add shapes to sprite in correct order
-    AddShapeToSprite(sprite, leftLeg);
-    AddShapeToSprite(sprite, rightLeg);
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, leftArm);
-    AddShapeToSprite(sprite, rightArm);
-    AddShapeToSprite(sprite, head);
-    AddShapeToSprite(sprite, helmet);
-    AddShapeToSprite(sprite, gun);
+    // The template never changes, so its tessellation is built exactly once
+    if (!RebuildShapeCache(&spriteTemplate->cache, spriteTemplate->arena, sprite->shapes, NULL,
+                           sprite->shapeCount, RAYPALS_LOD_OFF)) {
+        FreeSpriteCache(spriteTemplate->cache);
+        spriteTemplate->cache = NULL;
+    }
     
-    // Set sprite position
-    sprite->position = position;
+    return spriteTemplate;
+}
+
+void FreeSpriteTemplate(RayPalsSpriteTemplate* spriteTemplate) {
+    if (!spriteTemplate) return;
     
-    return sprite;
+    FreeSpriteCache(spriteTemplate->cache);
+    RayPalsFree(spriteTemplate->arena, spriteTemplate->shapes);
+    RayPalsFree(spriteTemplate->arena, spriteTemplate);
 }
 
-RayPalsSprite* CreateZombie(Vector2 position, float size, Color skinColor, Color clothesColor) {
-    RayPalsSprite* sprite = CreateSprite(8);
-    if (sprite == NULL) return NULL;
+RayPalsSpriteInstance CreateSpriteInstance(const RayPalsSpriteTemplate* spriteTemplate, Vector2 position, float scale) {
+    RayPalsSpriteInstance instance = { 0 };
     
-    // Create zombie with hunched posture and tattered clothes
+    instance.spriteTemplate = spriteTemplate;
+    instance.position = position;
+    instance.scale = scale;
+    instance.tint = WHITE;
+    instance.visible = true;
     
-    // Body - slightly tilted
-    RayPals2DShape* body = CreateRectangle((Vector2){ 0, size * 0.1f }, (Vector2){ size * 0.4f, size * 0.5f }, clothesColor);
-    body->rotation = 10.0f;  // Slight tilt
+    return instance;
+}
+
+#define RAYPALS_TEMPLATE_LOD_LEVELS 8  // Cached LOD levels per template besides full detail
+
+// Returns the template's tessellation for an LOD bucket. The full-detail cache heads a
+// short list of LOD levels that are built on first use; once the list is full its last
+// entry is rebuilt for new buckets.
+static RayPalsSpriteCache* GetTemplateCache(const RayPalsSpriteTemplate* spriteTemplate, int lodBucket) {
+    RayPalsSpriteCache* head = spriteTemplate->cache;
+    if (head == NULL || lodBucket == RAYPALS_LOD_OFF) return head;
     
-    // Tattered clothes effect
-    RayPals2DShape* tatters = CreateTriangle((Vector2){ size * 0.1f, size * 0.3f }, size * 0.3f, clothesColor);
-    tatters->rotation = 180.0f;
+    RayPalsSpriteCache** link = &head->next;
+    for (int level = 1; *link != NULL; level++) {
+        if ((*link)->lodBucket == lodBucket || ((*link)->next == NULL && level == RAYPALS_TEMPLATE_LOD_LEVELS)) break;
+        link = &(*link)->next;
+    }
     
-    // Head - green/gray skin
-    Color zombieSkin = skinColor;
-    zombieSkin.g += 40;  // Add greenish tint
-    zombieSkin.r -= 30;  // Reduce red for a sickly look
+    if (*link != NULL && IsCacheLODCurrent(*link, lodBucket)) return *link;
     
-    RayPals2DShape* head = CreateCircle((Vector2){ size * 0.05f, -size * 0.25f }, size * 0.2f, zombieSkin);
+    if (!RebuildShapeCache(link, spriteTemplate->arena, NULL, spriteTemplate->shapes,
+                           spriteTemplate->shapeCount, lodBucket)) {
+        return head;
+    }
+    return *link;
+}
+
+void DrawSpriteInstance(const RayPalsSpriteInstance* instance) {
+    if (!instance || !instance->visible || !instance->spriteTemplate) return;
     
-    // Eyes - creepy white
-    RayPals2DShape* leftEye = CreateCircle((Vector2){ -size * 0.05f, -size * 0.27f }, size * 0.05f, WHITE);
-    RayPals2DShape* rightEye = CreateCircle((Vector2){ size * 0.12f, -size * 0.27f }, size * 0.05f, WHITE);
+    const RayPalsSpriteTemplate* spriteTemplate = instance->spriteTemplate;
+    bool tinted = !ColorIsEqual(instance->tint, WHITE);
+    int lodBucket = GetLODBucket(lodSettings.enabled ? GetCurrentViewScale() * instance->scale : 0.0f);
     
-    // Arms - asymmetrical and outstretched
-    RayPals2DShape* leftArm = CreateRectangle((Vector2){ -size * 0.3f, size * 0.0f }, (Vector2){ size * 0.2f, size * 0.1f }, zombieSkin);
-    leftArm->rotation = -30.0f;
+    // Same transform stack as DrawSprite
+    rlPushMatrix();
+    rlTranslatef(instance->position.x, instance->position.y, 0.0f);
+    rlRotatef(instance->rotation, 0.0f, 0.0f, 1.0f);
+    rlScalef(instance->scale, instance->scale, 1.0f);
     
-    RayPals2DShape* rightArm = CreateRectangle((Vector2){ size * 0.2f, size * 0.1f }, (Vector2){ size * 0.3f, size * 0.1f }, zombieSkin);
-    rightArm->rotation = 20.0f;
+    drawStats.sprites++;
     
-    // Legs - one dragging
-    RayPals2DShape* leftLeg = CreateRectangle((Vector2){ -size * 0.15f, size * 0.45f }, (Vector2){ size * 0.15f, size * 0.4f }, clothesColor);
-    leftLeg->rotation = -5.0f;
+    if (spriteTemplate->cache != NULL) {
+        DrawSpriteCache(GetTemplateCache(spriteTemplate, lodBucket), instance->tint);
+        rlPopMatrix();
+        return;
+    }
     
-    RayPals2DShape* rightLeg = CreateRectangle((Vector2){ size * 0.12f, size * 0.5f }, (Vector2){ size * 0.15f, size * 0.45f }, clothesColor);
-    rightLeg->rotation = 15.0f;  // Dragging leg
+    for (int i = 0; i < spriteTemplate->shapeCount; i++) {
+        if (tinted) {
+            // Tint a stack copy so the shared template stays immutable
+            RayPals2DShape shape = spriteTemplate->shapes[i];
+            shape.color = TintColor(shape.color, instance->tint);
+            Draw2DShape(&shape);
+        } else {
+            Draw2DShape(&spriteTemplate->shapes[i]);
+        }
+    }
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, rightLeg);
-    AddShapeToSprite(sprite, leftLeg);
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, tatters);
-    AddShapeToSprite(sprite, leftArm);
-    AddShapeToSprite(sprite, rightArm);
-    AddShapeToSprite(sprite, head);
-    AddShapeToSprite(sprite, leftEye);
-    AddShapeToSprite(sprite, rightEye);
+    rlPopMatrix();
+}
+
+Rectangle GetSpriteInstanceBounds(const RayPalsSpriteInstance* instance) {
+    if (!instance || !instance->spriteTemplate) return (Rectangle){ 0, 0, 0, 0 };
     
-    // Set sprite position
-    sprite->position = position;
+    const RayPalsSpriteTemplate* spriteTemplate = instance->spriteTemplate;
+    Rectangle local = spriteTemplate->cache != NULL ? spriteTemplate->cache->localBounds :
+                      ComputeShapesBounds(NULL, spriteTemplate->shapes, spriteTemplate->shapeCount);
     
-    return sprite;
+    return TransformBounds(local, instance->position, instance->rotation, instance->scale);
 }
 
-RayPalsSprite* CreateUFO(Vector2 position, float size, Color bodyColor, Color glowColor) {
-    RayPalsSprite* sprite = CreateSprite(5);
-    if (sprite == NULL) return NULL;
+// Draws instances in one triangle run, skipping those outside view when view is not NULL.
+// Returns the number of instances drawn.
+static int DrawSpriteInstanceList(const RayPalsSpriteInstance* instances, int count, const Rectangle* view) {
+    if (!instances || count <= 0) return 0;
+    
+    // Build any missing LOD levels before opening the triangle run
+    float viewScale = lodSettings.enabled ? GetCurrentViewScale() : 0.0f;
+    if (viewScale > 0.0f) {
+        for (int i = 0; i < count; i++) {
+            const RayPalsSpriteInstance* instance = &instances[i];
+            if (!instance->visible || !instance->spriteTemplate) continue;
+            if (view != NULL && !BoundsOverlap(GetSpriteInstanceBounds(instance), *view)) continue;
+            
+            GetTemplateCache(instance->spriteTemplate, GetLODBucket(viewScale * instance->scale));
+        }
+    }
     
-    // Main UFO saucer body - elliptical shape
-    RayPals2DShape* body = CreateCircle((Vector2){ 0, 0 }, size * 0.5f, bodyColor);
+    // Every instance is transformed on the CPU into one triangle run
+    int drawn = 0;
+    bool fallback = false;
+    rlBegin(RL_TRIANGLES);
     
-    // Top dome of the UFO
-    RayPals2DShape* dome = CreateCircle((Vector2){ 0, -size * 0.15f }, size * 0.25f, bodyColor);
+    for (int i = 0; i < count; i++) {
+        const RayPalsSpriteInstance* instance = &instances[i];
+        if (!instance->visible || !instance->spriteTemplate) continue;
+        
+        if (view != NULL && !BoundsOverlap(GetSpriteInstanceBounds(instance), *view)) {
+            drawStats.culled++;
+            continue;
+        }
+        
+        if (instance->spriteTemplate->cache == NULL) {
+            fallback = true;
+            continue;
+        }
+        
+        // Instances are plain values without dirty tracking, so their matrix is built per draw
+        RayPalsSpriteCache* cache = GetTemplateCache(instance->spriteTemplate, GetLODBucket(viewScale * instance->scale));
+        Matrix transform = MakeSpriteMatrix(instance->position, instance->rotation, instance->scale);
+        EmitSpriteCache(cache, &transform, instance->tint);
+        drawStats.sprites++;
+        drawn++;
+    }
     
-    // Bottom rim of the UFO
-    RayPals2DShape* bottomRim = CreateRectangle(
-        (Vector2){ 0, size * 0.05f }, 
-        (Vector2){ size * 0.8f, size * 0.1f }, 
-        DARKGRAY
-    );
+    rlEnd();
+    drawStats.batches++;
     
-    // Glowing lights around the rim
-    Color lightColor = glowColor;
-    lightColor.a = 220; // Semi-transparent for glow effect
+    if (fallback) {
+        for (int i = 0; i < count; i++) {
+            const RayPalsSpriteInstance* instance = &instances[i];
+            if (!instance->visible || !instance->spriteTemplate || instance->spriteTemplate->cache != NULL) continue;
+            if (view != NULL && !BoundsOverlap(GetSpriteInstanceBounds(instance), *view)) continue;
+            
+            DrawSpriteInstance(instance);
+            drawn++;
+        }
+    }
     
-    RayPals2DShape* lights1 = CreateCircle((Vector2){ -size * 0.25f, size * 0.05f }, size * 0.08f, lightColor);
-    RayPals2DShape* lights2 = CreateCircle((Vector2){ 0, size * 0.05f }, size * 0.08f, lightColor);
-    RayPals2DShape* lights3 = CreateCircle((Vector2){ size * 0.25f, size * 0.05f }, size * 0.08f, lightColor);
+    return drawn;
+}
+
+void DrawSpriteInstances(const RayPalsSpriteInstance* instances, int count) {
+    DrawSpriteInstanceList(instances, count, NULL);
+}
+
+int DrawSpriteInstancesCulled(const RayPalsSpriteInstance* instances, int count, Camera2D camera) {
+    Rectangle view = GetCameraViewBounds(camera);
+    return DrawSpriteInstanceList(instances, count, &view);
+}
+
+// ----------------------------------------------------------------------------
+// Shape Batch Functions
+// ----------------------------------------------------------------------------
+
+#define RAYPALS_BATCH_CHUNK 256  // Elements transformed per pass when drawing
+
+static bool IsBatchableShapeType(RayPalsShapeType type) {
+    return GetUnitShapeVertexCount(type, 0, 0) > 0;
+}
+
+// Reallocates every per-element array of a batch to the new capacity
+static bool ReserveShapeBatch(RayPalsShapeBatch* batch, int required) {
+    if (required <= batch->capacity) return true;
     
-    // Optional tractor beam effect
-    RayPals2DShape* beam = CreateTriangle(
-        (Vector2){ 0, size * 0.2f },
-        size * 0.5f,
-        (Color){ glowColor.r, glowColor.g, glowColor.b, 100 } // Very transparent
-    );
-    beam->rotation = 180.0f; // Point downward
+    int newCapacity = batch->capacity > 0 ? batch->capacity * 2 : 64;
+    if (newCapacity < required) newCapacity = required;
     
-    // Add shapes to sprite in appropriate order
-    AddShapeToSprite(sprite, beam);
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, bottomRim);
-    AddShapeToSprite(sprite, lights1);
-    AddShapeToSprite(sprite, lights2);
-    AddShapeToSprite(sprite, lights3);
-    AddShapeToSprite(sprite, dome);
+    float** floatArrays[] = {
+        &batch->positionX, &batch->positionY, &batch->sizeX, &batch->sizeY,
+        &batch->rotation, &batch->velocityX, &batch->velocityY, &batch->angularVelocity
+    };
     
-    // Set sprite position
-    sprite->position = position;
+    for (size_t i = 0; i < sizeof(floatArrays)/sizeof(floatArrays[0]); i++) {
+        float* newArray = (float*)RayPalsRealloc(batch->arena, *floatArrays[i],
+                           sizeof(float) * batch->count, sizeof(float) * newCapacity);
+        if (newArray == NULL) return false;
+        *floatArrays[i] = newArray;
+    }
     
-    return sprite;
+    Color* newColors = (Color*)RayPalsRealloc(batch->arena, batch->color,
+                        sizeof(Color) * batch->count, sizeof(Color) * newCapacity);
+    if (newColors == NULL) return false;
+    batch->color = newColors;
+    
+    batch->capacity = newCapacity;
+    return true;
 }
 
-RayPalsSprite* CreateDragon(Vector2 position, float size, Color bodyColor, Color wingColor) {
-    RayPalsSprite* sprite = CreateSprite(9);
-    if (sprite == NULL) return NULL;
+RayPalsShapeBatch* CreateShapeBatch(RayPalsShapeType type, int initialCapacity) {
+    if (!IsBatchableShapeType(type)) return NULL;
     
-    // Dragon body (main elongated shape)
-    RayPals2DShape* body = CreateRectangle(
-        (Vector2){ 0, 0 }, 
-        (Vector2){ size * 1.2f, size * 0.4f }, 
-        bodyColor
-    );
+    RayPalsShapeBatch* batch = (RayPalsShapeBatch*)RayPalsAlloc(activeArena, sizeof(RayPalsShapeBatch));
+    if (batch == NULL) return NULL;
     
-    // Dragon head (triangle for snout effect)
-    RayPals2DShape* head = CreateTriangle(
-        (Vector2){ size * 0.7f, -size * 0.1f }, 
-        size * 0.4f, 
-        bodyColor
-    );
-    head->rotation = 90.0f; // Point to the right
+    batch->arena = activeArena;
+    batch->type = type;
     
-    // Dragon neck
-    RayPals2DShape* neck = CreateRectangle(
-        (Vector2){ size * 0.4f, -size * 0.1f }, 
-        (Vector2){ size * 0.3f, size * 0.2f }, 
-        bodyColor
-    );
+    // Same defaults as the individual shape constructors
+    switch (type) {
+        case RAYPALS_CIRCLE:
+        case RAYPALS_WATER_DROP: batch->segments = RAYPALS_DEFAULT_CIRCLE_SEGMENTS; break;
+        case RAYPALS_STAR: batch->segments = 5; break;
+        case RAYPALS_POLYGON: batch->segments = 6; break;
+        default: batch->segments = 0; break;
+    }
     
-    // Dragon tail (curved)
-    RayPals2DShape* tail1 = CreateRectangle(
-        (Vector2){ -size * 0.5f, size * 0.0f }, 
-        (Vector2){ size * 0.4f, size * 0.15f }, 
-        bodyColor
-    );
-    tail1->rotation = -15.0f;
+    if (!ReserveShapeBatch(batch, initialCapacity > 0 ? initialCapacity : 1)) {
+        FreeShapeBatch(batch);
+        return NULL;
+    }
     
-    RayPals2DShape* tail2 = CreateTriangle(
-        (Vector2){ -size * 0.8f, size * 0.1f }, 
-        size * 0.3f, 
-        bodyColor
-    );
-    tail2->rotation = -90.0f; // Point to the left
+    return batch;
+}
+
+int AddShapeToBatch(RayPalsShapeBatch* batch, Vector2 position, Vector2 size, float rotation, Color color) {
+    if (!batch) return -1;
+    if (!ReserveShapeBatch(batch, batch->count + 1)) return -1;
+    
+    int index = batch->count++;
+    batch->positionX[index] = position.x;
+    batch->positionY[index] = position.y;
+    batch->sizeX[index] = size.x;
+    batch->sizeY[index] = size.y;
+    batch->rotation[index] = rotation;
+    batch->velocityX[index] = 0.0f;
+    batch->velocityY[index] = 0.0f;
+    batch->angularVelocity[index] = 0.0f;
+    batch->color[index] = color;
+    
+    return index;
+}
+
+void RemoveShapeFromBatch(RayPalsShapeBatch* batch, int index) {
+    if (!batch || index < 0 || index >= batch->count) return;
+    
+    // Swap the last element into the hole to keep the arrays dense
+    int last = --batch->count;
+    batch->positionX[index] = batch->positionX[last];
+    batch->positionY[index] = batch->positionY[last];
+    batch->sizeX[index] = batch->sizeX[last];
+    batch->sizeY[index] = batch->sizeY[last];
+    batch->rotation[index] = batch->rotation[last];
+    batch->velocityX[index] = batch->velocityX[last];
+    batch->velocityY[index] = batch->velocityY[last];
+    batch->angularVelocity[index] = batch->angularVelocity[last];
+    batch->color[index] = batch->color[last];
+}
+
+void SetBatchShapeVelocity(RayPalsShapeBatch* batch, int index, Vector2 velocity, float angularVelocity) {
+    if (!batch || index < 0 || index >= batch->count) return;
     
-    // Dragon wings
-    RayPals2DShape* leftWing = CreateTriangle(
-        (Vector2){ size * 0.1f, -size * 0.3f }, 
-        size * 0.6f, 
-        wingColor
-    );
-    leftWing->rotation = 30.0f;
+    batch->velocityX[index] = velocity.x;
+    batch->velocityY[index] = velocity.y;
+    batch->angularVelocity[index] = angularVelocity;
+}
+
+void UpdateShapeBatch(RayPalsShapeBatch* batch, float deltaTime) {
+    if (!batch) return;
+    
+    // Independent straight-line loops over separate arrays vectorize cleanly
+    int count = batch->count;
+    float* restrict positionX = batch->positionX;
+    float* restrict positionY = batch->positionY;
+    float* restrict rotation = batch->rotation;
+    const float* restrict velocityX = batch->velocityX;
+    const float* restrict velocityY = batch->velocityY;
+    const float* restrict angularVelocity = batch->angularVelocity;
+    
+    for (int i = 0; i < count; i++) positionX[i] += velocityX[i] * deltaTime;
+    for (int i = 0; i < count; i++) positionY[i] += velocityY[i] * deltaTime;
+    for (int i = 0; i < count; i++) rotation[i] += angularVelocity[i] * deltaTime;
+}
+
+void TransformShapeBatch(RayPalsShapeBatch* batch, Vector2 translation, float rotation, float scale) {
+    if (!batch) return;
+    
+    int count = batch->count;
+    float cosine = cosf(rotation * DEG2RAD);
+    float sine = sinf(rotation * DEG2RAD);
+    float* restrict positionX = batch->positionX;
+    float* restrict positionY = batch->positionY;
+    float* restrict sizeX = batch->sizeX;
+    float* restrict sizeY = batch->sizeY;
+    float* restrict angles = batch->rotation;
+    
+    // Rotate and scale about the origin, then translate
+    for (int i = 0; i < count; i++) {
+        float x = positionX[i];
+        float y = positionY[i];
+        positionX[i] = (x*cosine - y*sine)*scale + translation.x;
+        positionY[i] = (x*sine + y*cosine)*scale + translation.y;
+    }
+    for (int i = 0; i < count; i++) sizeX[i] *= scale;
+    for (int i = 0; i < count; i++) sizeY[i] *= scale;
+    for (int i = 0; i < count; i++) angles[i] += rotation;
+}
+
+// Rebuilds the unit-space template when the batch is new or its segment count changed
+static bool PrepareShapeBatchTemplate(RayPalsShapeBatch* batch) {
+    if (batch->unitVertices != NULL && batch->unitSegments == batch->segments) return true;
     
-    RayPals2DShape* rightWing = CreateTriangle(
-        (Vector2){ -size * 0.1f, -size * 0.3f }, 
-        size * 0.6f, 
-        wingColor
-    );
-    rightWing->rotation = 150.0f;
+    int points = batch->type == RAYPALS_STAR ? batch->segments : 0;
+    int vertexCount = GetUnitShapeVertexCount(batch->type, batch->segments, points);
+    Vector2* vertices = (Vector2*)realloc(batch->unitVertices, sizeof(Vector2) * vertexCount);
+    if (vertices == NULL) return false;
     
-    // Dragon eyes
-    Color eyeColor = RED;
-    RayPals2DShape* leftEye = CreateCircle(
-        (Vector2){ size * 0.6f, -size * 0.15f }, 
-        size * 0.05f, 
-        eyeColor
-    );
+    batch->unitVertices = vertices;
+    batch->unitVertexCount = BuildUnitShapeTriangles(batch->type, batch->segments, points, vertices);
+    batch->unitSegments = batch->segments;
     
-    // Dragon horns
-    RayPals2DShape* horn1 = CreateTriangle(
-        (Vector2){ size * 0.65f, -size * 0.25f }, 
-        size * 0.2f, 
-        bodyColor
-    );
-    horn1->rotation = 45.0f;
+    return true;
+}
+
+void DrawShapeBatch(RayPalsShapeBatch* batch) {
+    if (!batch || batch->count == 0 || !PrepareShapeBatchTemplate(batch)) return;
     
-    RayPals2DShape* horn2 = CreateTriangle(
-        (Vector2){ size * 0.55f, -size * 0.25f }, 
-        size * 0.2f, 
-        bodyColor
-    );
-    horn2->rotation = 15.0f;
+    const Vector2* unit = batch->unitVertices;
+    int unitCount = batch->unitVertexCount;
+    float cosines[RAYPALS_BATCH_CHUNK];
+    float sines[RAYPALS_BATCH_CHUNK];
     
-    // Add shapes to sprite in proper order
-    AddShapeToSprite(sprite, leftWing);
-    AddShapeToSprite(sprite, rightWing);
-    AddShapeToSprite(sprite, tail2);
-    AddShapeToSprite(sprite, tail1);
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, neck);
-    AddShapeToSprite(sprite, head);
-    AddShapeToSprite(sprite, horn1);
-    AddShapeToSprite(sprite, horn2);
-    AddShapeToSprite(sprite, leftEye);
+    rlBegin(RL_TRIANGLES);
+    
+    for (int base = 0; base < batch->count; base += RAYPALS_BATCH_CHUNK) {
+        int chunk = batch->count - base;
+        if (chunk > RAYPALS_BATCH_CHUNK) chunk = RAYPALS_BATCH_CHUNK;
+        
+        // Evaluate the trigonometry for a whole chunk before touching rlgl
+        for (int i = 0; i < chunk; i++) {
+            float angle = batch->rotation[base + i] * DEG2RAD;
+            cosines[i] = cosf(angle);
+            sines[i] = sinf(angle);
+        }
+        
+        for (int i = 0; i < chunk; i++) {
+            int index = base + i;
+            Vector2 scale = GetUnitShapeScale(batch->type, (Vector2){ batch->sizeX[index], batch->sizeY[index] });
+            
+            // Columns of the element's rotate-and-scale matrix
+            float ax = cosines[i]*scale.x, ay = sines[i]*scale.x;
+            float bx = -sines[i]*scale.y, by = cosines[i]*scale.y;
+            float px = batch->positionX[index];
+            float py = batch->positionY[index];
+            Color color = batch->color[index];
+            
+            // Flushes the rlgl buffer mid-run if this element would overflow it
+            CheckRenderBatchLimit(unitCount);
+            rlColor4ub(color.r, color.g, color.b, color.a);
+            
+            for (int v = 0; v < unitCount; v++) {
+                rlVertex2f(px + ax*unit[v].x + bx*unit[v].y, py + ay*unit[v].x + by*unit[v].y);
+            }
+        }
+    }
+    
+    rlEnd();
+    
+    drawStats.vertices += batch->count * unitCount;
+    drawStats.batches++;
+}
+
+void FreeShapeBatch(RayPalsShapeBatch* batch) {
+    if (!batch) return;
+    
+    RayPalsFree(batch->arena, batch->positionX);
+    RayPalsFree(batch->arena, batch->positionY);
+    RayPalsFree(batch->arena, batch->sizeX);
+    RayPalsFree(batch->arena, batch->sizeY);
+    RayPalsFree(batch->arena, batch->rotation);
+    RayPalsFree(batch->arena, batch->velocityX);
+    RayPalsFree(batch->arena, batch->velocityY);
+    RayPalsFree(batch->arena, batch->angularVelocity);
+    RayPalsFree(batch->arena, batch->color);
+    free(batch->unitVertices);
+    RayPalsFree(batch->arena, batch);
+}
+
+// ----------------------------------------------------------------------------
+// Worker Pool Functions
+// ----------------------------------------------------------------------------
+
+typedef void (*RayPalsWorkerTask)(void* data, int index, int worker);
+typedef struct RayPalsWorkerPool RayPalsWorkerPool;
+
+// Persistent threads that split the indices of a parallel loop with the calling thread.
+// Indices are handed out one at a time, so which thread runs an index is unspecified;
+// tasks must only write to data owned by their index (or by their worker slot).
+struct RayPalsWorkerPool {
+    RayPalsMutex lock;
+    RayPalsCondition wake;     // Signaled when a new loop starts or the pool shuts down
+    RayPalsCondition done;     // Signaled when the last worker leaves a loop
+    RayPalsThread* threads;
+    int threadCount;           // Worker threads, not counting the caller
+    unsigned int generation;   // Bumped for every loop so sleeping workers notice it
+    int busyWorkers;
+    bool quit;
+    RayPalsWorkerTask task;
+    void* data;
+    int nextIndex;
+    int indexCount;
+};
+
+// Runs task on indices until the loop is exhausted; called with the lock held
+static void RunWorkerTasks(RayPalsWorkerPool* pool, int worker) {
+    while (pool->nextIndex < pool->indexCount) {
+        int index = pool->nextIndex++;
+        RayPalsUnlockMutex(&pool->lock);
+        pool->task(pool->data, index, worker);
+        RayPalsLockMutex(&pool->lock);
+    }
+}
+
+typedef struct {
+    RayPalsWorkerPool* pool;
+    int worker;
+} RayPalsWorkerStart;
+
+static void WorkerMain(RayPalsWorkerStart* start) {
+    RayPalsWorkerPool* pool = start->pool;
+    int worker = start->worker;
+    free(start);
     
-    // Set sprite position
-    sprite->position = position;
+    // Pools start at generation 0; reading it here could skip a loop started before this thread ran
+    unsigned int seen = 0;
+    RayPalsLockMutex(&pool->lock);
     
-    return sprite;
+    for (;;) {
+        while (!pool->quit && pool->generation == seen) RayPalsWaitCondition(&pool->wake, &pool->lock);
+        if (pool->quit) break;
+        
+        seen = pool->generation;
+        RunWorkerTasks(pool, worker);
+        if (--pool->busyWorkers == 0) RayPalsBroadcastCondition(&pool->done);
+    }
+    
+    RayPalsUnlockMutex(&pool->lock);
 }
 
-RayPalsSprite* CreateWizard(Vector2 position, float size, Color robeColor, Color hatColor) {
-    RayPalsSprite* sprite = CreateSprite(8);
-    if (sprite == NULL) return NULL;
-    
-    // Colors
-    Color faceColor = BEIGE;
-    Color staffColor = BROWN;
-    Color starColor = YELLOW;
+static void WorkerThreadEntry(void* start) { WorkerMain((RayPalsWorkerStart*)start); }
+
+// Starts threadCount - 1 workers; the caller of RunWorkerPool is the last thread
+static RayPalsWorkerPool* CreateWorkerPool(int threadCount) {
+    RayPalsWorkerPool* pool = (RayPalsWorkerPool*)calloc(1, sizeof(RayPalsWorkerPool));
+    if (pool == NULL) return NULL;
     
-    // Wizard robe (base)
-    RayPals2DShape* robe = CreateTriangle(
-        (Vector2){ 0, size * 0.3f }, 
-        size * 0.9f, 
-        robeColor
-    );
-    robe->rotation = 180.0f; // Point downward
+    pool->threads = (RayPalsThread*)calloc(threadCount > 1 ? threadCount - 1 : 1, sizeof(RayPalsThread));
+    if (pool->threads == NULL) {
+        free(pool);
+        return NULL;
+    }
     
-    // Wizard body (upper part)
-    RayPals2DShape* body = CreateRectangle(
-        (Vector2){ 0, -size * 0.1f }, 
-        (Vector2){ size * 0.4f, size * 0.5f }, 
-        robeColor
-    );
+    RayPalsInitMutex(&pool->lock);
+    RayPalsInitCondition(&pool->wake);
+    RayPalsInitCondition(&pool->done);
     
-    // Wizard head
-    RayPals2DShape* head = CreateCircle(
-        (Vector2){ 0, -size * 0.4f }, 
-        size * 0.15f, 
-        faceColor
-    );
+    for (int i = 0; i < threadCount - 1; i++) {
+        RayPalsWorkerStart* start = (RayPalsWorkerStart*)malloc(sizeof(RayPalsWorkerStart));
+        if (start == NULL) break;
+        start->pool = pool;
+        start->worker = i + 1;
+        
+        if (!RayPalsStartThread(&pool->threads[i], WorkerThreadEntry, start)) {
+            free(start);
+            break;
+        }
+        pool->threadCount++;
+    }
     
-    // Wizard hat (cone)
-    RayPals2DShape* hat = CreateTriangle(
-        (Vector2){ 0, -size * 0.65f }, 
-        size * 0.5f, 
-        hatColor
-    );
-    hat->rotation = 0.0f; // Point upward
+    return pool;
+}
+
+// Calls task(data, index, worker) for every index in [0, count) across the pool and the
+// calling thread (worker 0), returning once all of them have finished
+static void RunWorkerPool(RayPalsWorkerPool* pool, int count, RayPalsWorkerTask task, void* data) {
+    RayPalsLockMutex(&pool->lock);
+    pool->task = task;
+    pool->data = data;
+    pool->nextIndex = 0;
+    pool->indexCount = count;
+    pool->busyWorkers = pool->threadCount;
+    pool->generation++;
+    RayPalsBroadcastCondition(&pool->wake);
+    
+    RunWorkerTasks(pool, 0);
+    while (pool->busyWorkers > 0) RayPalsWaitCondition(&pool->done, &pool->lock);
+    RayPalsUnlockMutex(&pool->lock);
+}
+
+static void FreeWorkerPool(RayPalsWorkerPool* pool) {
+    if (!pool) return;
     
-    // Wizard hat brim
-    RayPals2DShape* hatBrim = CreateRectangle(
-        (Vector2){ 0, -size * 0.5f }, 
-        (Vector2){ size * 0.45f, size * 0.05f }, 
-        hatColor
-    );
+    RayPalsLockMutex(&pool->lock);
+    pool->quit = true;
+    RayPalsBroadcastCondition(&pool->wake);
+    RayPalsUnlockMutex(&pool->lock);
     
-    // Wizard beard
-    RayPals2DShape* beard = CreateTriangle(
-        (Vector2){ 0, -size * 0.3f }, 
-        size * 0.25f, 
-        WHITE
-    );
-    beard->rotation = 180.0f; // Point downward
+    for (int i = 0; i < pool->threadCount; i++) RayPalsJoinThread(pool->threads[i]);
     
-    // Wizard staff
-    RayPals2DShape* staff = CreateRectangle(
-        (Vector2){ size * 0.3f, size * 0.1f }, 
-        (Vector2){ size * 0.05f, size * 0.8f }, 
-        staffColor
-    );
-    staff->rotation = -15.0f;
+    RayPalsDestroyCondition(&pool->done);
+    RayPalsDestroyCondition(&pool->wake);
+    RayPalsDestroyMutex(&pool->lock);
+    free(pool->threads);
+    free(pool);
+}
+
+// ----------------------------------------------------------------------------
+// Software Canvas Functions
+// ----------------------------------------------------------------------------
+
+#define RAYPALS_CANVAS_SUBPIXEL_BITS 4                                // Vertices snap to 1/16 pixel
+#define RAYPALS_CANVAS_SUBPIXELS (1 << RAYPALS_CANVAS_SUBPIXEL_BITS)
+#define RAYPALS_CANVAS_MAX_COORD 4194304.0f                           // Clamp in pixels that keeps edge products in 64 bits
+
+static long long FloorDivide(long long numerator, long long denominator) {
+    long long quotient = numerator / denominator;
+    if ((numerator % denominator != 0) && ((numerator < 0) != (denominator < 0))) quotient--;
+    return quotient;
+}
+
+static long long CeilDivide(long long numerator, long long denominator) {
+    return -FloorDivide(-numerator, denominator);
+}
+
+static long long ToCanvasFixed(float value) {
+    if (value < -RAYPALS_CANVAS_MAX_COORD) value = -RAYPALS_CANVAS_MAX_COORD;
+    if (value > RAYPALS_CANVAS_MAX_COORD) value = RAYPALS_CANVAS_MAX_COORD;
+    return llrintf(value * RAYPALS_CANVAS_SUBPIXELS);
+}
+
+// Span kernels: fill a run of pixels with one color, or source-over blend one color
+// into them. Every kernel produces exactly the scalar results, so the selected kernel
+// never changes the image, only the speed.
+typedef void (*RayPalsSpanKernel)(Color* pixels, int count, Color color);
+
+typedef struct {
+    RayPalsSpanKernel fill;
+    RayPalsSpanKernel blend;
+} RayPalsSpanKernels;
+
+static void FillSpanScalar(Color* pixels, int count, Color color) {
+    for (int i = 0; i < count; i++) pixels[i] = color;
+}
+
+// Blends one pixel; the SIMD kernels use it for pixels whose destination is not opaque
+static void BlendCanvasPixel(Color* pixel, Color color) {
+    int alpha = color.a;
+    int inverse = 255 - alpha;
+    Color dst = *pixel;
+    
+    if (dst.a == 255) {
+        // Opaque destination (the common case): a plain lerp that stays opaque
+        pixel->r = (unsigned char)((color.r*alpha + dst.r*inverse + 127) / 255);
+        pixel->g = (unsigned char)((color.g*alpha + dst.g*inverse + 127) / 255);
+        pixel->b = (unsigned char)((color.b*alpha + dst.b*inverse + 127) / 255);
+        return;
+    }
     
-    // Wizard staff star
-    RayPals2DShape* staffStar = CreateStar(
-        (Vector2){ size * 0.35f, -size * 0.25f }, 
-        size * 0.15f, 
-        5, 
-        starColor
-    );
+    // Non-premultiplied storage: weight both colors by their coverage of the result
+    int dstWeight = dst.a * inverse;
+    int outAlpha = alpha*255 + dstWeight;  // Result alpha scaled by 255
+    if (outAlpha == 0) return;
     
-    // Add shapes to sprite in proper order
-    AddShapeToSprite(sprite, staff);
-    AddShapeToSprite(sprite, robe);
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, head);
-    AddShapeToSprite(sprite, beard);
-    AddShapeToSprite(sprite, hatBrim);
-    AddShapeToSprite(sprite, hat);
-    AddShapeToSprite(sprite, staffStar);
+    pixel->r = (unsigned char)((color.r*alpha*255 + dst.r*dstWeight + outAlpha/2) / outAlpha);
+    pixel->g = (unsigned char)((color.g*alpha*255 + dst.g*dstWeight + outAlpha/2) / outAlpha);
+    pixel->b = (unsigned char)((color.b*alpha*255 + dst.b*dstWeight + outAlpha/2) / outAlpha);
+    pixel->a = (unsigned char)((outAlpha + 127) / 255);
+}
+
+static void BlendSpanScalar(Color* pixels, int count, Color color) {
+    for (int i = 0; i < count; i++) BlendCanvasPixel(&pixels[i], color);
+}
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define RAYPALS_CANVAS_X86
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define RAYPALS_TARGET_SSE2
+#define RAYPALS_TARGET_AVX2
+#else
+#define RAYPALS_TARGET_SSE2 __attribute__((target("sse2")))
+#define RAYPALS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// The opaque-destination lerp in 16-bit lanes: x = dst*(255 - a) + (src*a + 127), with
+// the alpha lane's source term 255*a so the result stays 255. x never exceeds 65152,
+// where (x + 1 + (x >> 8)) >> 8 equals x / 255 exactly.
+RAYPALS_TARGET_SSE2 static __m128i BlendLanesSSE2(__m128i dst, __m128i inverse, __m128i source) {
+    __m128i x = _mm_add_epi16(_mm_mullo_epi16(dst, inverse), source);
+    x = _mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8));
+    return _mm_srli_epi16(x, 8);
+}
+
+RAYPALS_TARGET_SSE2 static void FillSpanSSE2(Color* pixels, int count, Color color) {
+    int value;
+    memcpy(&value, &color, sizeof(value));
+    __m128i colors = _mm_set1_epi32(value);
     
-    // Set sprite position
-    sprite->position = position;
+    int i = 0;
+    for (; i + 4 <= count; i += 4) _mm_storeu_si128((__m128i*)&pixels[i], colors);
+    for (; i < count; i++) pixels[i] = color;
+}
+
+RAYPALS_TARGET_SSE2 static void BlendSpanSSE2(Color* pixels, int count, Color color) {
+    int alpha = color.a;
+    __m128i zero = _mm_setzero_si128();
+    __m128i inverse = _mm_set1_epi16((short)(255 - alpha));
+    __m128i source = _mm_setr_epi16((short)(color.r*alpha + 127), (short)(color.g*alpha + 127),
+                                    (short)(color.b*alpha + 127), (short)(255*alpha + 127),
+                                    (short)(color.r*alpha + 127), (short)(color.g*alpha + 127),
+                                    (short)(color.b*alpha + 127), (short)(255*alpha + 127));
+    __m128i alphaMask = _mm_set1_epi32((int)0xFF000000u);
+    
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i dst = _mm_loadu_si128((const __m128i*)&pixels[i]);
+        
+        // Any translucent destination pixel takes the exact scalar path for the group
+        __m128i opaque = _mm_cmpeq_epi32(_mm_and_si128(dst, alphaMask), alphaMask);
+        if (_mm_movemask_epi8(opaque) != 0xFFFF) {
+            for (int j = 0; j < 4; j++) BlendCanvasPixel(&pixels[i + j], color);
+            continue;
+        }
+        
+        __m128i low = BlendLanesSSE2(_mm_unpacklo_epi8(dst, zero), inverse, source);
+        __m128i high = BlendLanesSSE2(_mm_unpackhi_epi8(dst, zero), inverse, source);
+        _mm_storeu_si128((__m128i*)&pixels[i], _mm_packus_epi16(low, high));
+    }
+    for (; i < count; i++) BlendCanvasPixel(&pixels[i], color);
+}
+
+RAYPALS_TARGET_AVX2 static __m256i BlendLanesAVX2(__m256i dst, __m256i inverse, __m256i source) {
+    __m256i x = _mm256_add_epi16(_mm256_mullo_epi16(dst, inverse), source);
+    x = _mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8));
+    return _mm256_srli_epi16(x, 8);
+}
+
+RAYPALS_TARGET_AVX2 static void FillSpanAVX2(Color* pixels, int count, Color color) {
+    int value;
+    memcpy(&value, &color, sizeof(value));
+    __m256i colors = _mm256_set1_epi32(value);
     
-    return sprite;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) _mm256_storeu_si256((__m256i*)&pixels[i], colors);
+    for (; i < count; i++) pixels[i] = color;
 }
 
-RayPalsSprite* CreateTreasureChest(Vector2 position, float size, Color chestColor, Color goldColor, bool isOpen) {
-    RayPalsSprite* sprite = CreateSprite(7);
-    if (sprite == NULL) return NULL;
+RAYPALS_TARGET_AVX2 static void BlendSpanAVX2(Color* pixels, int count, Color color) {
+    int alpha = color.a;
+    __m256i zero = _mm256_setzero_si256();
+    __m256i inverse = _mm256_set1_epi16((short)(255 - alpha));
+    __m256i source = _mm256_set1_epi64x((long long)(
+                     (unsigned long long)(unsigned short)(color.r*alpha + 127) |
+                     (unsigned long long)(unsigned short)(color.g*alpha + 127) << 16 |
+                     (unsigned long long)(unsigned short)(color.b*alpha + 127) << 32 |
+                     (unsigned long long)(unsigned short)(255*alpha + 127) << 48));
+    __m256i alphaMask = _mm256_set1_epi32((int)0xFF000000u);
+    
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i dst = _mm256_loadu_si256((const __m256i*)&pixels[i]);
+        
+        __m256i opaque = _mm256_cmpeq_epi32(_mm256_and_si256(dst, alphaMask), alphaMask);
+        if (_mm256_movemask_epi8(opaque) != -1) {
+            for (int j = 0; j < 8; j++) BlendCanvasPixel(&pixels[i + j], color);
+            continue;
+        }
+        
+        // Unpack and pack both work within 128-bit halves, so pixel order is preserved
+        __m256i low = BlendLanesAVX2(_mm256_unpacklo_epi8(dst, zero), inverse, source);
+        __m256i high = BlendLanesAVX2(_mm256_unpackhi_epi8(dst, zero), inverse, source);
+        _mm256_storeu_si256((__m256i*)&pixels[i], _mm256_packus_epi16(low, high));
+    }
     
-    // Colors
-    Color lockColor = DARKBROWN;
+    // The remaining 0-7 pixels still benefit from a 4-wide pass
+    BlendSpanSSE2(&pixels[i], count - i, color);
+}
+
+static void ReadCPUID(unsigned int leaf, unsigned int subleaf, unsigned int registers[4]) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    for (int i = 0; i < 4; i++) registers[i] = (unsigned int)info[i];
+#else
+    __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+// AVX2 needs the CPU feature and an OS that saves the YMM registers (XCR0 bits 1 and 2)
+static bool DetectAVX2(void) {
+    unsigned int registers[4];
+    ReadCPUID(0, 0, registers);
+    if (registers[0] < 7) return false;
+    
+    ReadCPUID(1, 0, registers);
+    bool osxsave = (registers[2] & (1u << 27)) != 0;
+    bool avx = (registers[2] & (1u << 28)) != 0;
+    if (!osxsave || !avx) return false;
+    
+#if defined(_MSC_VER)
+    unsigned long long xcr0 = _xgetbv(0);
+#else
+    unsigned int xcr0Low, xcr0High;
+    __asm__ volatile ("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+    unsigned long long xcr0 = ((unsigned long long)xcr0High << 32) | xcr0Low;
+#endif
+    if ((xcr0 & 6) != 6) return false;
+    
+    ReadCPUID(7, 0, registers);
+    return (registers[1] & (1u << 5)) != 0;
+}
+
+static bool DetectSSE2(void) {
+    unsigned int registers[4];
+    ReadCPUID(1, 0, registers);
+    return (registers[3] & (1u << 26)) != 0;
+}
+#endif
+
+static RayPalsCanvasKernel canvasKernel = RAYPALS_CANVAS_KERNEL_AUTO;  // Resolved on first use
+static RayPalsSpanKernels spanKernels = { FillSpanScalar, BlendSpanScalar };
+
+bool IsCanvasKernelSupported(RayPalsCanvasKernel kernel) {
+    switch (kernel) {
+        case RAYPALS_CANVAS_KERNEL_AUTO:
+        case RAYPALS_CANVAS_KERNEL_SCALAR: return true;
+#if defined(RAYPALS_CANVAS_X86)
+        case RAYPALS_CANVAS_KERNEL_SSE2: return DetectSSE2();
+        case RAYPALS_CANVAS_KERNEL_AVX2: return DetectSSE2() && DetectAVX2();
+#endif
+        default: return false;
+    }
+}
+
+bool SetCanvasKernel(RayPalsCanvasKernel kernel) {
+    if (!IsCanvasKernelSupported(kernel)) return false;
     
-    // Chest base (main rectangle)
-    RayPals2DShape* base = CreateRectangle(
-        (Vector2){ 0, size * 0.1f }, 
-        (Vector2){ size * 0.8f, size * 0.5f }, 
-        chestColor
-    );
+    if (kernel == RAYPALS_CANVAS_KERNEL_AUTO) {
+        kernel = RAYPALS_CANVAS_KERNEL_SCALAR;
+        if (IsCanvasKernelSupported(RAYPALS_CANVAS_KERNEL_SSE2)) kernel = RAYPALS_CANVAS_KERNEL_SSE2;
+        if (IsCanvasKernelSupported(RAYPALS_CANVAS_KERNEL_AVX2)) kernel = RAYPALS_CANVAS_KERNEL_AVX2;
+    }
     
-    // Chest lid
-    RayPals2DShape* lid = CreateRectangle(
-        isOpen ? (Vector2){ -size * 0.3f, -size * 0.25f } : (Vector2){ 0, -size * 0.15f }, 
-        (Vector2){ size * 0.8f, size * 0.3f }, 
-        chestColor
-    );
-    // Rotate the lid if open
-    lid->rotation = isOpen ? -60.0f : 0.0f;
+    switch (kernel) {
+#if defined(RAYPALS_CANVAS_X86)
+        case RAYPALS_CANVAS_KERNEL_SSE2: spanKernels = (RayPalsSpanKernels){ FillSpanSSE2, BlendSpanSSE2 }; break;
+        case RAYPALS_CANVAS_KERNEL_AVX2: spanKernels = (RayPalsSpanKernels){ FillSpanAVX2, BlendSpanAVX2 }; break;
+#endif
+        default: spanKernels = (RayPalsSpanKernels){ FillSpanScalar, BlendSpanScalar }; break;
+    }
+    canvasKernel = kernel;
+    return true;
+}
+
+RayPalsCanvasKernel GetCanvasKernel(void) {
+    if (canvasKernel == RAYPALS_CANVAS_KERNEL_AUTO) SetCanvasKernel(RAYPALS_CANVAS_KERNEL_AUTO);
+    return canvasKernel;
+}
+
+// Source-over blends one color into a run of pixels of the same row
+static void BlendCanvasSpan(const RayPalsSpanKernels* kernels, Color* pixels, int count, Color color) {
+    if (color.a == 255) kernels->fill(pixels, count, color);
+    else if (color.a != 0) kernels->blend(pixels, count, color);
+}
+
+// A triangle snapped to canvas subpixels, wound so its interior is on the positive
+// side of every edge, with the pixels its bounding box covers (clipped to the image)
+typedef struct {
+    int x[3], y[3];            // Vertices in 1/16 pixels
+    int firstColumn, lastColumn;
+    int firstRow, lastRow;
+    Color color;
+} RayPalsCanvasTriangle;
+
+// Snaps and clips a triangle given in pixel coordinates; false if it covers no pixel center
+static bool SetupCanvasTriangle(const RayPalsCanvas* canvas, Vector2 a, Vector2 b, Vector2 c, Color color,
+                                RayPalsCanvasTriangle* triangle) {
+    if (color.a == 0) return false;
+    
+    int width = canvas->image.width;
+    int height = canvas->image.height;
+    float minX = fminf(a.x, fminf(b.x, c.x)), maxX = fmaxf(a.x, fmaxf(b.x, c.x));
+    float minY = fminf(a.y, fminf(b.y, c.y)), maxY = fmaxf(a.y, fmaxf(b.y, c.y));
+    
+    // Written so NaN coordinates are rejected too
+    if (!(maxX >= 0.0f && minX <= (float)width && maxY >= 0.0f && minY <= (float)height)) return false;
+    
+    long long x[3] = { ToCanvasFixed(a.x), ToCanvasFixed(b.x), ToCanvasFixed(c.x) };
+    long long y[3] = { ToCanvasFixed(a.y), ToCanvasFixed(b.y), ToCanvasFixed(c.y) };
+    
+    long long area = (x[1] - x[0])*(y[2] - y[0]) - (y[1] - y[0])*(x[2] - x[0]);
+    if (area == 0) return false;
+    if (area < 0) {
+        // Make the interior the positive side of every edge
+        long long swap = x[1]; x[1] = x[2]; x[2] = swap;
+        swap = y[1]; y[1] = y[2]; y[2] = swap;
+    }
     
-    // Chest lock/clasp
-    RayPals2DShape* lock = CreateRectangle(
-        isOpen ? (Vector2){ -size * 0.3f, -size * 0.1f } : (Vector2){ 0, 0 }, 
-        (Vector2){ size * 0.15f, size * 0.15f }, 
-        lockColor
-    );
-    // Rotate the lock with the lid if open
-    lock->rotation = isOpen ? -60.0f : 0.0f;
+    const long long half = RAYPALS_CANVAS_SUBPIXELS/2;
+    long long fixedMinX = x[0] < x[1] ? (x[0] < x[2] ? x[0] : x[2]) : (x[1] < x[2] ? x[1] : x[2]);
+    long long fixedMaxX = x[0] > x[1] ? (x[0] > x[2] ? x[0] : x[2]) : (x[1] > x[2] ? x[1] : x[2]);
+    long long fixedMinY = y[0] < y[1] ? (y[0] < y[2] ? y[0] : y[2]) : (y[1] < y[2] ? y[1] : y[2]);
+    long long fixedMaxY = y[0] > y[1] ? (y[0] > y[2] ? y[0] : y[2]) : (y[1] > y[2] ? y[1] : y[2]);
+    
+    // Pixels whose centers (i + 0.5) lie inside the bounding box, clipped to the image
+    long long firstColumn = CeilDivide(fixedMinX - half, RAYPALS_CANVAS_SUBPIXELS);
+    long long lastColumn = FloorDivide(fixedMaxX - half, RAYPALS_CANVAS_SUBPIXELS);
+    long long firstRow = CeilDivide(fixedMinY - half, RAYPALS_CANVAS_SUBPIXELS);
+    long long lastRow = FloorDivide(fixedMaxY - half, RAYPALS_CANVAS_SUBPIXELS);
+    if (firstColumn < 0) firstColumn = 0;
+    if (lastColumn > width - 1) lastColumn = width - 1;
+    if (firstRow < 0) firstRow = 0;
+    if (lastRow > height - 1) lastRow = height - 1;
+    if (firstColumn > lastColumn || firstRow > lastRow) return false;
+    
+    for (int i = 0; i < 3; i++) {
+        triangle->x[i] = (int)x[i];
+        triangle->y[i] = (int)y[i];
+    }
+    triangle->firstColumn = (int)firstColumn;
+    triangle->lastColumn = (int)lastColumn;
+    triangle->firstRow = (int)firstRow;
+    triangle->lastRow = (int)lastRow;
+    triangle->color = color;
+    return true;
+}
+
+// Fills the pixels of a set-up triangle that lie inside a clip rectangle with the given
+// span kernels and returns how many were blended. Edge functions are evaluated exactly on the snapped vertices, and
+// pixel centers that fall on an edge belong to the triangle only if the edge is a top or
+// left edge, so meshes are covered watertight with no pixel blended twice. Coverage does
+// not depend on the clip rectangle, which is what keeps tiled rendering bit-identical.
+static long long FillCanvasTriangle(const RayPalsSpanKernels* kernels, Color* pixels, int width,
+                                    const RayPalsCanvasTriangle* triangle,
+                                    int firstColumn, int lastColumn, int firstRow, int lastRow) {
+    if (triangle->firstColumn > firstColumn) firstColumn = triangle->firstColumn;
+    if (triangle->lastColumn < lastColumn) lastColumn = triangle->lastColumn;
+    if (triangle->firstRow > firstRow) firstRow = triangle->firstRow;
+    if (triangle->lastRow < lastRow) lastRow = triangle->lastRow;
+    if (firstColumn > lastColumn) return 0;
+    
+    // Edge i runs from vertex i to vertex i+1: E(p) = dx*(p.y - y0) - dy*(p.x - x0)
+    long long edgeDX[3], edgeDY[3], edgeBias[3];
+    for (int i = 0; i < 3; i++) {
+        int next = (i + 1) % 3;
+        edgeDX[i] = (long long)triangle->x[next] - triangle->x[i];
+        edgeDY[i] = (long long)triangle->y[next] - triangle->y[i];
+        
+        // Left edges (interior grows with x) and top edges (horizontal, interior below)
+        // keep the centers they pass through; the rest need E > 0
+        bool topLeft = -edgeDY[i] > 0 || (edgeDY[i] == 0 && edgeDX[i] > 0);
+        edgeBias[i] = topLeft ? 0 : -1;
+    }
     
-    // Decorative elements (edges/corners)
-    RayPals2DShape* corner1 = CreateRectangle(
-        (Vector2){ size * 0.35f, size * 0.15f }, 
-        (Vector2){ size * 0.1f, size * 0.4f }, 
-        lockColor
-    );
+    const long long half = RAYPALS_CANVAS_SUBPIXELS/2;
+    long long filled = 0;
     
-    RayPals2DShape* corner2 = CreateRectangle(
-        (Vector2){ -size * 0.35f, size * 0.15f }, 
-        (Vector2){ size * 0.1f, size * 0.4f }, 
-        lockColor
-    );
+    for (int row = firstRow; row <= lastRow; row++) {
+        long long centerY = (long long)row*RAYPALS_CANVAS_SUBPIXELS + half;
+        long long left = firstColumn;
+        long long right = lastColumn;
+        
+        // Each edge bounds the span from one side: solve A*centerX + C >= 0 for the column,
+        // where A = -dy and centerX = column*SUBPIXELS + half
+        for (int i = 0; i < 3 && left <= right; i++) {
+            long long slope = -edgeDY[i];
+            long long constant = edgeDX[i]*(centerY - triangle->y[i]) + edgeDY[i]*triangle->x[i] + edgeBias[i] + slope*half;
+            
+            if (slope > 0) {
+                long long bound = CeilDivide(-constant, slope*RAYPALS_CANVAS_SUBPIXELS);
+                if (bound > left) left = bound;
+            } else if (slope < 0) {
+                long long bound = FloorDivide(constant, -slope*RAYPALS_CANVAS_SUBPIXELS);
+                if (bound < right) right = bound;
+            } else if (constant < 0) {
+                right = left - 1;
+            }
+        }
+        
+        if (left > right) continue;
+        
+        BlendCanvasSpan(kernels, &pixels[(size_t)row*width + left], (int)(right - left + 1), triangle->color);
+        filled += right - left + 1;
+    }
     
-    // Only create and add gold if chest is open
-    RayPals2DShape* gold1 = NULL;
-    RayPals2DShape* gold2 = NULL;
+    return filled;
+}
+
+// Triangles recorded for FlushCanvas while a canvas renders with several threads. A
+// flush runs three parallel passes: set up and count the triangles of each chunk per
+// tile, scatter them into per-tile lists at offsets assigned chunk by chunk (so every
+// list stays in submission order), then rasterize the tiles. Every array keeps its
+// capacity between flushes, so a steady scene does not allocate.
+typedef struct {
+    Vector2 a, b, c;           // Vertices in pixel coordinates
+    Color color;
+} RayPalsCanvasRecord;
+
+struct RayPalsCanvasQueue {
+    RayPalsCanvasRecord* records;
+    RayPalsCanvasTriangle* triangles;  // Set-up records, same indices
+    int recordCount;
+    int recordCapacity;
+    int* chunkTileCounts;      // Per chunk and tile: triangle count, then the chunk's write offset
+    int* tileStarts;           // Offsets into tileTriangles, one per tile plus an end marker
+    int* tileTriangles;        // Triangle indices grouped by tile, in submission order
+    int chunkTileCapacity;
+    int tileCapacity;
+    int binCapacity;
+    long long* workerPixels;   // Pixels blended by each thread during a flush
+    int* workerTriangles;      // Triangles set up by each thread during a flush
+    bool clearPending;         // ClearCanvas was called since the last flush
+    Color clearColor;
+    RayPalsWorkerPool* pool;
+};
+
+#define RAYPALS_CANVAS_TILE_SIZE 64     // Tile edge in pixels (a 16 KB tile stays in L1)
+#define RAYPALS_CANVAS_CHUNK 2048       // Triangles set up and binned per task
+#define RAYPALS_CANVAS_MAX_THREADS 64   // Upper bound for SetCanvasThreads
+
+static bool QueueCanvasTriangle(RayPalsCanvasQueue* queue, Vector2 a, Vector2 b, Vector2 c, Color color) {
+    if (queue->recordCount == queue->recordCapacity) {
+        int newCapacity = queue->recordCapacity > 0 ? queue->recordCapacity * 2 : 4096;
+        
+        RayPalsCanvasRecord* newRecords = (RayPalsCanvasRecord*)realloc(queue->records,
+                                           sizeof(RayPalsCanvasRecord) * newCapacity);
+        if (newRecords == NULL) return false;
+        queue->records = newRecords;
+        
+        RayPalsCanvasTriangle* newTriangles = (RayPalsCanvasTriangle*)realloc(queue->triangles,
+                                               sizeof(RayPalsCanvasTriangle) * newCapacity);
+        if (newTriangles == NULL) return false;
+        queue->triangles = newTriangles;
+        
+        queue->recordCapacity = newCapacity;
+    }
     
-    if (isOpen) {
-        // Gold coins/treasure (circles) that are visible when open
-        gold1 = CreateCircle(
-            (Vector2){ -size * 0.1f, size * 0.0f }, 
-            size * 0.15f, 
-            goldColor
-        );
+    queue->records[queue->recordCount++] = (RayPalsCanvasRecord){ a, b, c, color };
+    return true;
+}
+
+// Draws a triangle given in pixel coordinates, or records it when rendering is tiled
+static void RasterizeCanvasTriangle(RayPalsCanvas* canvas, Vector2 a, Vector2 b, Vector2 c, Color color) {
+    if (canvas->queue != NULL) {
+        if (QueueCanvasTriangle(canvas->queue, a, b, c, color)) return;
         
-        gold2 = CreateCircle(
-            (Vector2){ size * 0.15f, size * 0.05f }, 
-            size * 0.12f, 
-            goldColor
-        );
+        // Out of memory: draw what was recorded, then this triangle, to keep the order
+        FlushCanvas(canvas);
     }
     
-    // Add shapes to sprite in proper order
-    AddShapeToSprite(sprite, base);
-    AddShapeToSprite(sprite, corner1);
-    AddShapeToSprite(sprite, corner2);
+    RayPalsCanvasTriangle triangle;
+    if (!SetupCanvasTriangle(canvas, a, b, c, color, &triangle)) return;
     
-    // Add gold pieces if chest is open
-    if (isOpen) {
-        AddShapeToSprite(sprite, gold1);
-        AddShapeToSprite(sprite, gold2);
+    canvas->stats.triangles++;
+    canvas->stats.pixels += FillCanvasTriangle(&spanKernels, (Color*)canvas->image.data, canvas->image.width, &triangle,
+                                               0, canvas->image.width - 1, 0, canvas->image.height - 1);
+}
+
+// Maps local coordinates to canvas pixels: the sprite transform (position, rotation in
+// degrees, scale) followed by the canvas camera, composed into one 2x3 matrix
+typedef struct {
+    float m00, m01, m10, m11;  // Rotate-and-scale part
+    float tx, ty;              // Translation
+} RayPalsCanvasTransform;
+
+static RayPalsCanvasTransform GetCanvasTransform(const RayPalsCanvas* canvas, Vector2 position, float rotation, float scale) {
+    Camera2D camera = canvas->camera;
+    float cameraCos = cosf(camera.rotation * DEG2RAD) * camera.zoom;
+    float cameraSin = sinf(camera.rotation * DEG2RAD) * camera.zoom;
+    float angle = (rotation + camera.rotation) * DEG2RAD;
+    float linear = camera.zoom * scale;
+    
+    // Same order as GetWorldToScreen2D: subtract the target, rotate and zoom, add the offset
+    float relativeX = position.x - camera.target.x;
+    float relativeY = position.y - camera.target.y;
+    
+    return (RayPalsCanvasTransform){
+        cosf(angle) * linear, -sinf(angle) * linear,
+        sinf(angle) * linear, cosf(angle) * linear,
+        camera.offset.x + cameraCos*relativeX - cameraSin*relativeY,
+        camera.offset.y + cameraSin*relativeX + cameraCos*relativeY
+    };
+}
+
+static Vector2 ApplyCanvasTransform(RayPalsCanvasTransform transform, Vector2 v) {
+    return (Vector2){
+        transform.tx + transform.m00*v.x + transform.m01*v.y,
+        transform.ty + transform.m10*v.x + transform.m11*v.y
+    };
+}
+
+// Rasterizes cached sprite-space triangles under a sprite transform, tinted like EmitSpriteCache
+static void RasterizeCanvasCache(RayPalsCanvas* canvas, const RayPalsSpriteCache* cache,
+                                 Vector2 position, float rotation, float scale, Color tint) {
+    RayPalsCanvasTransform transform = GetCanvasTransform(canvas, position, rotation, scale);
+    bool tinting = !ColorIsEqual(tint, WHITE);
+    
+    for (int i = 0; i + 2 < cache->vertexCount; i += 3) {
+        Color color = tinting ? TintColor(cache->colors[i], tint) : cache->colors[i];
+        RasterizeCanvasTriangle(canvas,
+                                ApplyCanvasTransform(transform, cache->vertices[i]),
+                                ApplyCanvasTransform(transform, cache->vertices[i + 1]),
+                                ApplyCanvasTransform(transform, cache->vertices[i + 2]), color);
+    }
+}
+
+// LOD bucket for drawing at the given sprite scale through the canvas camera
+static int GetCanvasLODBucket(const RayPalsCanvas* canvas, float scale) {
+    return GetLODBucket(fabsf(canvas->camera.zoom * scale));
+}
+
+RayPalsCanvas* CreateCanvas(int width, int height) {
+    if (width <= 0 || height <= 0) return NULL;
+    
+    // Pick the span kernels here, before any worker thread can read them
+    GetCanvasKernel();
+    
+    RayPalsCanvas* canvas = (RayPalsCanvas*)calloc(1, sizeof(RayPalsCanvas));
+    if (canvas == NULL) return NULL;
+    
+    // Heap pixels so the image can also be released with raylib's UnloadImage
+    canvas->image.data = calloc((size_t)width * (size_t)height, sizeof(Color));
+    if (canvas->image.data == NULL) {
+        free(canvas);
+        return NULL;
     }
     
-    // Add lid and lock last so they appear on top
-    AddShapeToSprite(sprite, lid);
-    AddShapeToSprite(sprite, lock);
+    canvas->image.width = width;
+    canvas->image.height = height;
+    canvas->image.mipmaps = 1;
+    canvas->image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    canvas->camera.zoom = 1.0f;
+    canvas->threadCount = 1;
+    
+    return canvas;
+}
+
+void ClearCanvas(RayPalsCanvas* canvas, Color color) {
+    if (!canvas) return;
+    
+    // Tiled canvases drop what the clear would overwrite and clear each tile in the flush
+    if (canvas->queue != NULL) {
+        canvas->queue->recordCount = 0;
+        canvas->queue->clearPending = true;
+        canvas->queue->clearColor = color;
+        return;
+    }
     
-    // Set sprite position
-    sprite->position = position;
+    Color* pixels = (Color*)canvas->image.data;
+    for (int row = 0; row < canvas->image.height; row++) {
+        spanKernels.fill(&pixels[(size_t)row*canvas->image.width], canvas->image.width, color);
+    }
+}
+
+void SetCanvasCamera(RayPalsCanvas* canvas, Camera2D camera) {
+    if (!canvas) return;
+    canvas->camera = camera;
+}
+
+void DrawCanvasTriangle(RayPalsCanvas* canvas, Vector2 v1, Vector2 v2, Vector2 v3, Color color) {
+    if (!canvas) return;
     
-    return sprite;
+    RayPalsCanvasTransform transform = GetCanvasTransform(canvas, (Vector2){ 0, 0 }, 0.0f, 1.0f);
+    RasterizeCanvasTriangle(canvas, ApplyCanvasTransform(transform, v1), ApplyCanvasTransform(transform, v2),
+                            ApplyCanvasTransform(transform, v3), color);
 }
 
-RayPalsSprite* CreatePortal(Vector2 position, float size, Color outerColor, Color innerColor) {
-    RayPalsSprite* sprite = CreateSprite(8);
-    if (sprite == NULL) return NULL;
+void DrawShapeToCanvas(RayPalsCanvas* canvas, RayPals2DShape* shape) {
+    if (!canvas || !shape || !shape->visible) return;
     
-    // Create a swirling portal with multiple rings
+    // Loose shapes have no cache of their own; tessellate into the canvas scratch buffer
+    RayPals2DShape* shapes[1] = { shape };
+    if (!RebuildShapeCache(&canvas->scratch, NULL, shapes, NULL, 1, GetCanvasLODBucket(canvas, 1.0f))) return;
     
-    // Outer ring
-    RayPals2DShape* outerRing = CreateCircle(
-        (Vector2){ 0, 0 }, 
-        size * 0.5f, 
-        outerColor
-    );
-    outerRing->filled = false;
-    outerRing->thickness = 4.0f;
+    RasterizeCanvasCache(canvas, canvas->scratch, (Vector2){ 0, 0 }, 0.0f, 1.0f, WHITE);
+}
+
+void DrawSpriteToCanvas(RayPalsCanvas* canvas, RayPalsSprite* sprite) {
+    if (!canvas || !sprite || !sprite->visible) return;
+    if (!UpdateSpriteCache(sprite, GetCanvasLODBucket(canvas, sprite->scale))) return;
     
-    // Create several inner rings with decreasing size and alternating colors
-    RayPals2DShape* ring1 = CreateCircle(
-        (Vector2){ 0, 0 }, 
-        size * 0.45f, 
-        innerColor
-    );
-    ring1->filled = false;
-    ring1->thickness = 3.0f;
+    RasterizeCanvasCache(canvas, sprite->cache, sprite->position, sprite->rotation, sprite->scale, WHITE);
+}
+
+void DrawSpriteInstanceToCanvas(RayPalsCanvas* canvas, const RayPalsSpriteInstance* instance) {
+    if (!canvas || !instance || !instance->visible || !instance->spriteTemplate) return;
     
-    RayPals2DShape* ring2 = CreateCircle(
-        (Vector2){ 0, 0 }, 
-        size * 0.4f, 
-        outerColor
-    );
-    ring2->filled = false;
-    ring2->thickness = 3.0f;
+    RayPalsSpriteCache* cache = GetTemplateCache(instance->spriteTemplate, GetCanvasLODBucket(canvas, instance->scale));
+    if (cache == NULL) return;
     
-    RayPals2DShape* ring3 = CreateCircle(
-        (Vector2){ 0, 0 }, 
-        size * 0.35f, 
-        innerColor
-    );
-    ring3->filled = false;
-    ring3->thickness = 3.0f;
+    RasterizeCanvasCache(canvas, cache, instance->position, instance->rotation, instance->scale, instance->tint);
+}
+
+// State shared by the tasks of one flush
+typedef struct {
+    RayPalsCanvas* canvas;
+    int tilesX;
+    int tileCount;
+} RayPalsCanvasFlush;
+
+static void GetCanvasChunkRange(const RayPalsCanvasQueue* queue, int chunk, int* first, int* end) {
+    *first = chunk * RAYPALS_CANVAS_CHUNK;
+    *end = *first + RAYPALS_CANVAS_CHUNK;
+    if (*end > queue->recordCount) *end = queue->recordCount;
+}
+
+// Pass 1: sets up the triangles of a chunk and counts how many land in each tile
+static void SetupCanvasChunk(void* data, int chunk, int worker) {
+    RayPalsCanvasFlush* flush = (RayPalsCanvasFlush*)data;
+    RayPalsCanvasQueue* queue = flush->canvas->queue;
+    int* counts = &queue->chunkTileCounts[(size_t)chunk * flush->tileCount];
+    memset(counts, 0, sizeof(int) * flush->tileCount);
     
-    RayPals2DShape* ring4 = CreateCircle(
-        (Vector2){ 0, 0 }, 
-        size * 0.3f, 
-        outerColor
-    );
-    ring4->filled = false;
-    ring4->thickness = 3.0f;
+    int first, end;
+    GetCanvasChunkRange(queue, chunk, &first, &end);
     
-    // Inner swirl (spiral effect using shapes)
-    RayPals2DShape* swirl1 = CreateCircle(
-        (Vector2){ size * 0.05f, size * 0.05f }, 
-        size * 0.25f, 
-        innerColor
-    );
-    swirl1->filled = true;
+    for (int i = first; i < end; i++) {
+        const RayPalsCanvasRecord* record = &queue->records[i];
+        RayPalsCanvasTriangle* triangle = &queue->triangles[i];
+        
+        if (!SetupCanvasTriangle(flush->canvas, record->a, record->b, record->c, record->color, triangle)) {
+            triangle->firstRow = 1;  // Empty row range marks the triangle as skipped
+            triangle->lastRow = 0;
+            continue;
+        }
+        queue->workerTriangles[worker]++;
+        
+        for (int tileY = triangle->firstRow / RAYPALS_CANVAS_TILE_SIZE; tileY <= triangle->lastRow / RAYPALS_CANVAS_TILE_SIZE; tileY++) {
+            for (int tileX = triangle->firstColumn / RAYPALS_CANVAS_TILE_SIZE; tileX <= triangle->lastColumn / RAYPALS_CANVAS_TILE_SIZE; tileX++) {
+                counts[tileY*flush->tilesX + tileX]++;
+            }
+        }
+    }
+}
+
+// Pass 2: writes the chunk's triangle indices at the offsets the prefix sum reserved
+static void BinCanvasChunk(void* data, int chunk, int worker) {
+    (void)worker;
+    RayPalsCanvasFlush* flush = (RayPalsCanvasFlush*)data;
+    RayPalsCanvasQueue* queue = flush->canvas->queue;
+    int* offsets = &queue->chunkTileCounts[(size_t)chunk * flush->tileCount];
     
-    RayPals2DShape* swirl2 = CreateCircle(
-        (Vector2){ -size * 0.08f, -size * 0.08f }, 
-        size * 0.15f, 
-        outerColor
-    );
-    swirl2->filled = true;
+    int first, end;
+    GetCanvasChunkRange(queue, chunk, &first, &end);
     
-    // Core of the portal 
-    RayPals2DShape* core = CreateCircle(
-        (Vector2){ 0, 0 }, 
-        size * 0.1f, 
-        (Color){ 255, 255, 255, 200 }  // Bright center with some transparency
-    );
+    for (int i = first; i < end; i++) {
+        const RayPalsCanvasTriangle* triangle = &queue->triangles[i];
+        if (triangle->firstRow > triangle->lastRow) continue;
+        
+        for (int tileY = triangle->firstRow / RAYPALS_CANVAS_TILE_SIZE; tileY <= triangle->lastRow / RAYPALS_CANVAS_TILE_SIZE; tileY++) {
+            for (int tileX = triangle->firstColumn / RAYPALS_CANVAS_TILE_SIZE; tileX <= triangle->lastColumn / RAYPALS_CANVAS_TILE_SIZE; tileX++) {
+                queue->tileTriangles[offsets[tileY*flush->tilesX + tileX]++] = i;
+            }
+        }
+    }
+}
+
+// Pass 3: clears (if requested) and rasterizes one tile; triangles run in submission
+// order, so every pixel sees exactly the blends the immediate path would apply
+static void FlushCanvasTile(void* data, int tile, int worker) {
+    RayPalsCanvasFlush* flush = (RayPalsCanvasFlush*)data;
+    RayPalsCanvas* canvas = flush->canvas;
+    RayPalsCanvasQueue* queue = canvas->queue;
+    Color* pixels = (Color*)canvas->image.data;
+    int width = canvas->image.width;
+    
+    int firstColumn = (tile % flush->tilesX) * RAYPALS_CANVAS_TILE_SIZE;
+    int firstRow = (tile / flush->tilesX) * RAYPALS_CANVAS_TILE_SIZE;
+    int lastColumn = firstColumn + RAYPALS_CANVAS_TILE_SIZE - 1;
+    int lastRow = firstRow + RAYPALS_CANVAS_TILE_SIZE - 1;
+    if (lastColumn > width - 1) lastColumn = width - 1;
+    if (lastRow > canvas->image.height - 1) lastRow = canvas->image.height - 1;
+    
+    if (queue->clearPending) {
+        for (int row = firstRow; row <= lastRow; row++) {
+            Color* line = &pixels[(size_t)row*width];
+            spanKernels.fill(&line[firstColumn], lastColumn - firstColumn + 1, queue->clearColor);
+        }
+    }
     
-    // Add shapes to sprite in proper order (from back to front)
-    AddShapeToSprite(sprite, outerRing);
-    AddShapeToSprite(sprite, ring1);
-    AddShapeToSprite(sprite, ring2);
-    AddShapeToSprite(sprite, ring3);
-    AddShapeToSprite(sprite, ring4);
-    AddShapeToSprite(sprite, swirl1);
-    AddShapeToSprite(sprite, swirl2);
-    AddShapeToSprite(sprite, core);
+    long long filled = 0;
+    for (int i = queue->tileStarts[tile]; i < queue->tileStarts[tile + 1]; i++) {
+        filled += FillCanvasTriangle(&spanKernels, pixels, width, &queue->triangles[queue->tileTriangles[i]],
+                                     firstColumn, lastColumn, firstRow, lastRow);
+    }
+    queue->workerPixels[worker] += filled;
+}
+
+static void RunCanvasTasks(RayPalsCanvasQueue* queue, int count, RayPalsWorkerTask task, void* data) {
+    if (queue->pool != NULL) {
+        RunWorkerPool(queue->pool, count, task, data);
+    } else {
+        for (int i = 0; i < count; i++) task(data, i, 0);
+    }
+}
+
+// Grows an int array kept between flushes
+static bool ReserveCanvasInts(int** array, int* capacity, size_t required) {
+    if (required > INT_MAX) return false;
+    if ((int)required <= *capacity) return true;
     
-    // Set sprite position
-    sprite->position = position;
+    size_t newCapacity = *capacity > 0 ? (size_t)*capacity : 1024;
+    while (newCapacity < required) newCapacity *= 2;
+    if (newCapacity > INT_MAX) newCapacity = INT_MAX;
     
-    return sprite;
+    int* newArray = (int*)realloc(*array, sizeof(int) * newCapacity);
+    if (newArray == NULL) return false;
+    *array = newArray;
+    *capacity = (int)newCapacity;
+    return true;
 }
 
-RayPalsSprite* CreateSnowman(Vector2 position, float size, Color snowColor, Color accessoryColor) {
-    RayPalsSprite* sprite = CreateSprite(8);
-    if (sprite == NULL) return NULL;
-    
-    // Bottom snowball (largest)
-    RayPals2DShape* bottom = CreateCircle(
-        (Vector2){ 0, size * 0.4f }, 
-        size * 0.4f, 
-        snowColor
-    );
+// Replays the queue on the calling thread over the whole image (used when binning
+// cannot allocate); the result is the same, only slower
+static void FlushCanvasUntiled(RayPalsCanvas* canvas) {
+    RayPalsCanvasQueue* queue = canvas->queue;
+    Color* pixels = (Color*)canvas->image.data;
+    int width = canvas->image.width;
+    int height = canvas->image.height;
     
-    // Middle snowball
-    RayPals2DShape* middle = CreateCircle(
-        (Vector2){ 0, 0 }, 
-        size * 0.3f, 
-        snowColor
-    );
+    if (queue->clearPending) {
+        for (int row = 0; row < height; row++) spanKernels.fill(&pixels[(size_t)row*width], width, queue->clearColor);
+    }
     
-    // Head (top snowball - smallest)
-    RayPals2DShape* head = CreateCircle(
-        (Vector2){ 0, -size * 0.35f }, 
-        size * 0.2f, 
-        snowColor
-    );
+    for (int i = 0; i < queue->recordCount; i++) {
+        const RayPalsCanvasRecord* record = &queue->records[i];
+        RayPalsCanvasTriangle triangle;
+        if (!SetupCanvasTriangle(canvas, record->a, record->b, record->c, record->color, &triangle)) continue;
+        
+        canvas->stats.triangles++;
+        canvas->stats.pixels += FillCanvasTriangle(&spanKernels, pixels, width, &triangle, 0, width - 1, 0, height - 1);
+    }
     
-    // Eyes
-    Color eyeColor = BLACK;
-    RayPals2DShape* leftEye = CreateCircle(
-        (Vector2){ -size * 0.08f, -size * 0.38f }, 
-        size * 0.03f, 
-        eyeColor
-    );
+    queue->recordCount = 0;
+    queue->clearPending = false;
+}
+
+void FlushCanvas(RayPalsCanvas* canvas) {
+    if (!canvas || canvas->queue == NULL) return;
     
-    RayPals2DShape* rightEye = CreateCircle(
-        (Vector2){ size * 0.08f, -size * 0.38f }, 
-        size * 0.03f, 
-        eyeColor
-    );
+    RayPalsCanvasQueue* queue = canvas->queue;
+    if (queue->recordCount == 0 && !queue->clearPending) return;
     
-    // Carrot nose
-    Color carrotColor = ORANGE;
-    RayPals2DShape* nose = CreateTriangle(
-        (Vector2){ size * 0.1f, -size * 0.35f }, 
-        size * 0.15f, 
-        carrotColor
-    );
-    nose->rotation = 90.0f; // Point to the right
+    int tilesX = (canvas->image.width + RAYPALS_CANVAS_TILE_SIZE - 1) / RAYPALS_CANVAS_TILE_SIZE;
+    int tilesY = (canvas->image.height + RAYPALS_CANVAS_TILE_SIZE - 1) / RAYPALS_CANVAS_TILE_SIZE;
+    int tileCount = tilesX * tilesY;
+    int chunkCount = (queue->recordCount + RAYPALS_CANVAS_CHUNK - 1) / RAYPALS_CANVAS_CHUNK;
+    RayPalsCanvasFlush flush = { canvas, tilesX, tileCount };
     
-    // Hat (top hat)
-    RayPals2DShape* hatBrim = CreateRectangle(
-        (Vector2){ 0, -size * 0.55f }, 
-        (Vector2){ size * 0.5f, size * 0.05f }, 
-        accessoryColor
-    );
+    if (!ReserveCanvasInts(&queue->tileStarts, &queue->tileCapacity, (size_t)tileCount + 1) ||
+        !ReserveCanvasInts(&queue->chunkTileCounts, &queue->chunkTileCapacity, (size_t)chunkCount * tileCount + 1)) {
+        FlushCanvasUntiled(canvas);
+        return;
+    }
     
-    RayPals2DShape* hatTop = CreateRectangle(
-        (Vector2){ 0, -size * 0.65f }, 
-        (Vector2){ size * 0.3f, size * 0.2f }, 
-        accessoryColor
-    );
+    int threadCount = queue->pool != NULL ? queue->pool->threadCount + 1 : 1;
+    for (int i = 0; i < threadCount; i++) {
+        queue->workerPixels[i] = 0;
+        queue->workerTriangles[i] = 0;
+    }
     
-    // Arms (sticks)
-    RayPals2DShape* leftArm = CreateRectangle(
-        (Vector2){ -size * 0.4f, -size * 0.05f }, 
-        (Vector2){ size * 0.4f, size * 0.03f }, 
-        BROWN
-    );
-    leftArm->rotation = 20.0f;
+    RunCanvasTasks(queue, chunkCount, SetupCanvasChunk, &flush);
+    
+    // Tile-major prefix sum: each tile's list holds chunk 0's triangles, then chunk 1's...
+    long long pairs = 0;
+    for (int tile = 0; tile < tileCount; tile++) {
+        queue->tileStarts[tile] = (int)pairs;
+        for (int chunk = 0; chunk < chunkCount; chunk++) {
+            int* count = &queue->chunkTileCounts[(size_t)chunk*tileCount + tile];
+            int tileTriangles = *count;
+            *count = (int)pairs;
+            pairs += tileTriangles;
+            if (pairs > INT_MAX) break;
+        }
+        if (pairs > INT_MAX) break;
+    }
     
-    RayPals2DShape* rightArm = CreateRectangle(
-        (Vector2){ size * 0.4f, -size * 0.05f }, 
-        (Vector2){ size * 0.4f, size * 0.03f }, 
-        BROWN
-    );
-    rightArm->rotation = -20.0f;
+    if (pairs > INT_MAX || !ReserveCanvasInts(&queue->tileTriangles, &queue->binCapacity, (size_t)pairs)) {
+        FlushCanvasUntiled(canvas);
+        return;
+    }
+    queue->tileStarts[tileCount] = (int)pairs;
     
-    // Add shapes to sprite in proper order
-    AddShapeToSprite(sprite, bottom);
-    AddShapeToSprite(sprite, leftArm);
-    AddShapeToSprite(sprite, rightArm);
-    AddShapeToSprite(sprite, middle);
-    AddShapeToSprite(sprite, head);
-    AddShapeToSprite(sprite, leftEye);
-    AddShapeToSprite(sprite, rightEye);
-    AddShapeToSprite(sprite, nose);
-    AddShapeToSprite(sprite, hatBrim);
-    AddShapeToSprite(sprite, hatTop);
+    RunCanvasTasks(queue, chunkCount, BinCanvasChunk, &flush);
+    RunCanvasTasks(queue, tileCount, FlushCanvasTile, &flush);
     
-    // Set sprite position
-    sprite->position = position;
+    for (int i = 0; i < threadCount; i++) {
+        canvas->stats.pixels += queue->workerPixels[i];
+        canvas->stats.triangles += queue->workerTriangles[i];
+    }
+    canvas->stats.tileTriangles += pairs;
     
-    return sprite;
+    queue->recordCount = 0;
+    queue->clearPending = false;
 }
 
-RayPalsSprite* CreatePotion(Vector2 position, float size, Color bottleColor, Color liquidColor) {
-    RayPalsSprite* sprite = CreateSprite(6);
-    if (sprite == NULL) return NULL;
-    
-    // Potion bottle neck
-    RayPals2DShape* bottleNeck = CreateRectangle(
-        (Vector2){ 0, -size * 0.4f }, 
-        (Vector2){ size * 0.15f, size * 0.2f }, 
-        bottleColor
-    );
-    
-    // Potion bottle cap/cork
-    RayPals2DShape* bottleCap = CreateRectangle(
-        (Vector2){ 0, -size * 0.55f }, 
-        (Vector2){ size * 0.2f, size * 0.1f }, 
-        BROWN
-    );
-    
-    // Potion bottle body (wider at the bottom)
-    RayPals2DShape* bottleTop = CreateRectangle(
-        (Vector2){ 0, -size * 0.25f }, 
-        (Vector2){ size * 0.3f, size * 0.1f }, 
-        bottleColor
-    );
-    
-    RayPals2DShape* bottleBody = CreateRectangle(
-        (Vector2){ 0, size * 0.05f }, 
-        (Vector2){ size * 0.5f, size * 0.5f }, 
-        bottleColor
-    );
+static void FreeCanvasQueue(RayPalsCanvasQueue* queue) {
+    if (!queue) return;
+    
+    FreeWorkerPool(queue->pool);
+    free(queue->records);
+    free(queue->triangles);
+    free(queue->chunkTileCounts);
+    free(queue->tileStarts);
+    free(queue->tileTriangles);
+    free(queue->workerPixels);
+    free(queue->workerTriangles);
+    free(queue);
+}
+
+void SetCanvasThreads(RayPalsCanvas* canvas, int threadCount) {
+    if (!canvas) return;
+    
+    if (threadCount <= 0) threadCount = RayPalsGetProcessorCount();
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > RAYPALS_CANVAS_MAX_THREADS) threadCount = RAYPALS_CANVAS_MAX_THREADS;
+    if (threadCount == canvas->threadCount) return;
+    
+    // Finish the work recorded for the old pool before replacing it
+    FlushCanvas(canvas);
+    FreeCanvasQueue(canvas->queue);
+    canvas->queue = NULL;
+    canvas->threadCount = 1;
+    if (threadCount == 1) return;
+    
+    RayPalsCanvasQueue* queue = (RayPalsCanvasQueue*)calloc(1, sizeof(RayPalsCanvasQueue));
+    if (queue == NULL) return;
+    
+    queue->pool = CreateWorkerPool(threadCount);
+    queue->workerPixels = (long long*)calloc(threadCount, sizeof(long long));
+    queue->workerTriangles = (int*)calloc(threadCount, sizeof(int));
+    if (queue->pool == NULL || queue->workerPixels == NULL || queue->workerTriangles == NULL) {
+        FreeCanvasQueue(queue);
+        return;
+    }
     
-    // Round bottom of the bottle
-    RayPals2DShape* bottleBottom = CreateCircle(
-        (Vector2){ 0, size * 0.3f }, 
-        size * 0.25f, 
-        bottleColor
-    );
+    canvas->queue = queue;
+    canvas->threadCount = queue->pool->threadCount + 1;
+}
+
+void ResetCanvasStats(RayPalsCanvas* canvas) {
+    if (!canvas) return;
+    canvas->stats = (RayPalsCanvasStats){ 0 };
+}
+
+void FreeCanvas(RayPalsCanvas* canvas) {
+    if (!canvas) return;
     
-    // Liquid inside the bottle
-    RayPals2DShape* liquid = CreateRectangle(
-        (Vector2){ 0, size * 0.1f }, 
-        (Vector2){ size * 0.45f, size * 0.4f }, 
-        liquidColor
-    );
+    FreeCanvasQueue(canvas->queue);
+    FreeSpriteCache(canvas->scratch);
+    free(canvas->image.data);
+    free(canvas);
+}
+
+// ----------------------------------------------------------------------------
+// Sprite Atlas Functions
+// ----------------------------------------------------------------------------
+
+#define RAYPALS_ATLAS_PADDING 2  // Per side: a transparent border inside the source rect and a gutter outside it
+#define RAYPALS_ATLAS_TIERS 4    // Resolution tiers per key, each baked at twice the scale of the previous
+
+typedef struct {
+    RayPalsBakeKey key;        // factory points to the entry's own copy
+    unsigned int hash;         // Covers the key and the tier
+    int tier;
+    int x, y, width, height;   // Slot in the atlas, padding included
+    int shelf;
+    Rectangle source;          // Texels drawn for the entry (content plus its transparent border)
+    Rectangle bounds;          // Sprite-space rectangle the source maps to
+    unsigned int lastUse;      // Packer clock at the last bake or draw
+    unsigned int version;      // Content stamp when the sprite was snapshot; newer sprites re-bake it
+} RayPalsAtlasEntry;
+
+typedef struct {
+    int y;
+    int height;
+} RayPalsAtlasShelf;
+
+// A tier rasterized away from the atlas: a snapshot of the sprite's triangles in, slot pixels out
+typedef struct RayPalsBakeJob {
+    struct RayPalsBakeJob* next;
+    RayPalsBakeKey key;        // factory points to the job's own copy until the entry takes it
+    unsigned int hash;
+    int tier;
+    unsigned int generation;   // Packer generation when queued; older jobs are dropped
+    unsigned int version;      // Content stamp when the sprite was snapshot
+    Vector2* vertices;         // Triangle list in sprite space
+    Color* colors;
+    int vertexCount;
+    Rectangle localBounds;
+    float scale;
+    int contentWidth, contentHeight;
+    int width, height;         // Slot size, padding included
+    Color* pixels;             // width * height slot image
+    RayPalsSpanKernels kernels; // Taken when queued, so SetCanvasKernel cannot swap them mid-bake
+    int triangles;
+    long long pixelCount;
+    bool started;              // Guarded by bakeLock
+    bool done;                 // Guarded by bakeLock
+} RayPalsBakeJob;
+
+struct RayPalsAtlasPacker {
+    RayPalsAtlasEntry* entries;
+    int entryCount;
+    int entryCapacity;
+    int* table;                // Open-addressing hash table of entry indices (-1 = empty)
+    int tableSize;             // Power of two, at least twice entryCount
+    RayPalsAtlasShelf* shelves;  // Horizontal bands, stacked from the top in creation order
+    int shelfCount;
+    int shelfCapacity;
+    unsigned int clock;
+    bool uploadPending;        // Pixels changed since the texture was last updated
+    int dirtyMinX, dirtyMinY, dirtyMaxX, dirtyMaxY;
+    
+    // Background baking. Only the main thread links and unlinks jobs (under bakeLock);
+    // the baker thread only claims and completes them.
+    RayPalsBakeJob* jobs;      // Uncommitted jobs in queue order
+    RayPalsMutex bakeLock;
+    RayPalsCondition bakeWake; // Signaled when a job is queued or the baker must quit
+    RayPalsCondition bakeDone; // Signaled when the baker completes a job
+    RayPalsThread bakeThread;
+    bool bakerStarted;
+    bool bakerQuit;
+    unsigned int generation;   // Bumped to drop every queued job (written under bakeLock)
+};
+
+// FNV-1a over every field of the key (the factory by content) and the tier
+static unsigned int HashBakeKey(const RayPalsBakeKey* key, int tier) {
+    unsigned int hash = 2166136261u;
+    
+    if (key->factory != NULL) {
+        for (const char* c = key->factory; *c != '\0'; c++) hash = (hash ^ (unsigned char)*c) * 16777619u;
+    }
     
-    // Bubble effects in the liquid
-    RayPals2DShape* bubble1 = CreateCircle(
-        (Vector2){ -size * 0.1f, 0 }, 
-        size * 0.05f, 
-        (Color){ 255, 255, 255, 150 } // Semi-transparent white
-    );
+    unsigned char bytes[sizeof(float) + sizeof(key->colors) + sizeof(int) + 1];
+    memcpy(bytes, &key->size, sizeof(float));
+    memcpy(bytes + sizeof(float), key->colors, sizeof(key->colors));
+    memcpy(bytes + sizeof(float) + sizeof(key->colors), &key->variant, sizeof(int));
+    bytes[sizeof(bytes) - 1] = (unsigned char)tier;
+    for (size_t i = 0; i < sizeof(bytes); i++) hash = (hash ^ bytes[i]) * 16777619u;
     
-    RayPals2DShape* bubble2 = CreateCircle(
-        (Vector2){ size * 0.15f, size * 0.15f }, 
-        size * 0.03f, 
-        (Color){ 255, 255, 255, 150 } // Semi-transparent white
-    );
+    return hash;
+}
+
+static bool BakeKeysEqual(const RayPalsBakeKey* a, const RayPalsBakeKey* b) {
+    if ((a->factory == NULL) != (b->factory == NULL)) return false;
+    if (a->factory != NULL && strcmp(a->factory, b->factory) != 0) return false;
+    if (a->size != b->size || a->variant != b->variant) return false;
     
-    // Add shapes to sprite in proper order
-    AddShapeToSprite(sprite, bottleBottom);
-    AddShapeToSprite(sprite, bottleBody);
-    AddShapeToSprite(sprite, liquid);
-    AddShapeToSprite(sprite, bubble1);
-    AddShapeToSprite(sprite, bubble2);
-    AddShapeToSprite(sprite, bottleTop);
-    AddShapeToSprite(sprite, bottleNeck);
-    AddShapeToSprite(sprite, bottleCap);
+    for (int i = 0; i < 4; i++) {
+        if (!ColorIsEqual(a->colors[i], b->colors[i])) return false;
+    }
+    return true;
+}
+
+static float GetAtlasTierScale(const RayPalsSpriteAtlas* atlas, int tier) {
+    return atlas->bakeScale * (float)(1 << tier);
+}
+
+// Lowest tier with at least one texel per screen pixel, or the top tier
+static int GetAtlasTier(const RayPalsSpriteAtlas* atlas, float screenScale) {
+    int tier = 0;
+    while (tier < RAYPALS_ATLAS_TIERS - 1 && GetAtlasTierScale(atlas, tier) < screenScale*0.999f) tier++;
+    return tier;
+}
+
+// Slot size for content of the given size, or false if the atlas could never hold it
+static bool GetAtlasSlotSize(const RayPalsSpriteAtlas* atlas, int contentWidth, int contentHeight, int* width, int* height) {
+    *width = contentWidth + 2*RAYPALS_ATLAS_PADDING;
+    *height = contentHeight + 2*RAYPALS_ATLAS_PADDING;
     
-    // Set sprite position
-    sprite->position = position;
+    return *width <= atlas->canvas->image.width && *height <= atlas->canvas->image.height &&
+           (size_t)*width * *height * sizeof(Color) <= atlas->byteBudget;
+}
+
+// Rebuilt after every insertion or removal; baking is rare next to lookups
+static bool RebuildAtlasTable(RayPalsAtlasPacker* packer) {
+    int tableSize = 16;
+    while (tableSize < packer->entryCount * 2) tableSize *= 2;
     
-    return sprite;
+    if (tableSize != packer->tableSize) {
+        int* newTable = (int*)realloc(packer->table, sizeof(int) * tableSize);
+        if (newTable == NULL) return false;
+        packer->table = newTable;
+        packer->tableSize = tableSize;
+    }
+    
+    for (int i = 0; i < tableSize; i++) packer->table[i] = -1;
+    for (int i = 0; i < packer->entryCount; i++) {
+        int slot = (int)(packer->entries[i].hash & (unsigned int)(tableSize - 1));
+        while (packer->table[slot] != -1) slot = (slot + 1) & (tableSize - 1);
+        packer->table[slot] = i;
+    }
+    return true;
 }
 
-RayPalsSprite* CreateCannon(Vector2 position, float size, Color cannonColor, Color wheelColor) {
-    RayPalsSprite* sprite = CreateSprite(7);
-    if (sprite == NULL) return NULL;
+static int FindAtlasEntry(const RayPalsAtlasPacker* packer, const RayPalsBakeKey* key, unsigned int hash, int tier) {
+    if (packer->tableSize == 0) return -1;
     
-    // Cannon barrel (main part)
-    RayPals2DShape* barrel = CreateRectangle(
-        (Vector2){ size * 0.2f, -size * 0.1f }, 
-        (Vector2){ size * 0.8f, size * 0.25f }, 
-        cannonColor
-    );
+    int slot = (int)(hash & (unsigned int)(packer->tableSize - 1));
+    while (packer->table[slot] != -1) {
+        const RayPalsAtlasEntry* entry = &packer->entries[packer->table[slot]];
+        if (entry->hash == hash && entry->tier == tier && BakeKeysEqual(&entry->key, key)) return packer->table[slot];
+        slot = (slot + 1) & (packer->tableSize - 1);
+    }
+    return -1;
+}
+
+static void RemoveAtlasEntry(RayPalsSpriteAtlas* atlas, int index) {
+    RayPalsAtlasPacker* packer = atlas->packer;
+    RayPalsAtlasEntry* entry = &packer->entries[index];
+    
+    atlas->stats.bytesUsed -= (size_t)entry->width * entry->height * sizeof(Color);
+    free((char*)entry->key.factory);
+    packer->entries[index] = packer->entries[--packer->entryCount];
+    atlas->stats.entries = packer->entryCount;
+    
+    // Release trailing shelves that became empty so their rows can form new shelves
+    while (packer->shelfCount > 0) {
+        bool used = false;
+        for (int i = 0; i < packer->entryCount && !used; i++) used = packer->entries[i].shelf == packer->shelfCount - 1;
+        if (used) break;
+        packer->shelfCount--;
+    }
     
-    // Cannon end (muzzle)
-    RayPals2DShape* muzzle = CreateRectangle(
-        (Vector2){ size * 0.6f, -size * 0.1f }, 
-        (Vector2){ size * 0.1f, size * 0.3f }, 
-        cannonColor
-    );
+    RebuildAtlasTable(packer);
+}
+
+static bool EvictLeastRecentlyUsed(RayPalsSpriteAtlas* atlas) {
+    RayPalsAtlasPacker* packer = atlas->packer;
+    if (packer->entryCount == 0) return false;
     
-    // Cannon base (carriage)
-    RayPals2DShape* base = CreateRectangle(
-        (Vector2){ 0, size * 0.1f }, 
-        (Vector2){ size * 0.6f, size * 0.3f }, 
-        cannonColor
-    );
+    int oldest = 0;
+    for (int i = 1; i < packer->entryCount; i++) {
+        if (packer->entries[i].lastUse < packer->entries[oldest].lastUse) oldest = i;
+    }
     
-    // Cannon wheels
-    RayPals2DShape* leftWheel = CreateCircle(
-        (Vector2){ -size * 0.2f, size * 0.3f }, 
-        size * 0.2f, 
-        wheelColor
-    );
+    RemoveAtlasEntry(atlas, oldest);
+    atlas->stats.evictions++;
+    return true;
+}
+
+// Leftmost x where a slot of the given width fits between the entries of a shelf, or -1
+static int FindShelfGap(const RayPalsAtlasPacker* packer, int shelf, int width, int atlasWidth) {
+    int best = -1;
     
-    RayPals2DShape* rightWheel = CreateCircle(
-        (Vector2){ size * 0.2f, size * 0.3f }, 
-        size * 0.2f, 
-        wheelColor
-    );
+    // Every gap starts at x = 0 or at the right edge of an entry
+    for (int candidate = -1; candidate < packer->entryCount; candidate++) {
+        const RayPalsAtlasEntry* left = candidate >= 0 ? &packer->entries[candidate] : NULL;
+        if (left != NULL && left->shelf != shelf) continue;
+        
+        int x = left != NULL ? left->x + left->width : 0;
+        if (x + width > atlasWidth || (best >= 0 && x >= best)) continue;
+        
+        bool open = true;
+        for (int i = 0; i < packer->entryCount && open; i++) {
+            const RayPalsAtlasEntry* other = &packer->entries[i];
+            open = other->shelf != shelf || other->x >= x + width || other->x + other->width <= x;
+        }
+        if (open) best = x;
+    }
     
-    // Wheel hubs (decorative circles in the center of wheels)
-    RayPals2DShape* leftHub = CreateCircle(
-        (Vector2){ -size * 0.2f, size * 0.3f }, 
-        size * 0.05f, 
-        cannonColor
-    );
+    return best;
+}
+
+// Shelf packing: the tightest existing shelf with a gap, else a new shelf on top
+static bool FindAtlasSpace(RayPalsSpriteAtlas* atlas, int width, int height, int* x, int* y, int* shelf) {
+    RayPalsAtlasPacker* packer = atlas->packer;
+    int atlasWidth = atlas->canvas->image.width;
+    int bestShelf = -1, bestX = 0;
     
-    RayPals2DShape* rightHub = CreateCircle(
-        (Vector2){ size * 0.2f, size * 0.3f }, 
-        size * 0.05f, 
-        cannonColor
-    );
+    for (int i = 0; i < packer->shelfCount; i++) {
+        int shelfHeight = packer->shelves[i].height;
+        if (shelfHeight < height || (bestShelf >= 0 && shelfHeight >= packer->shelves[bestShelf].height)) continue;
+        
+        // Tall shelves only take short slots when they are empty, to limit wasted rows
+        int gap = FindShelfGap(packer, i, width, atlasWidth);
+        if (gap < 0) continue;
+        if (shelfHeight > height + height/2 + 4 && gap != 0) continue;
+        
+        bestShelf = i;
+        bestX = gap;
+    }
     
-    // Optional - cannon ball inside the barrel
-    RayPals2DShape* cannonBall = CreateCircle(
-        (Vector2){ size * 0.4f, -size * 0.1f }, 
-        size * 0.1f, 
-        BLACK
-    );
+    if (bestShelf >= 0) {
+        *x = bestX;
+        *y = packer->shelves[bestShelf].y;
+        *shelf = bestShelf;
+        return true;
+    }
     
-    // Add shapes to sprite in proper order
-    AddShapeToSprite(sprite, leftWheel);
-    AddShapeToSprite(sprite, rightWheel);
-    AddShapeToSprite(sprite, base);
-    AddShapeToSprite(sprite, barrel);
-    AddShapeToSprite(sprite, muzzle);
-    AddShapeToSprite(sprite, cannonBall);
-    AddShapeToSprite(sprite, leftHub);
-    AddShapeToSprite(sprite, rightHub);
+    int top = packer->shelfCount > 0 ? packer->shelves[packer->shelfCount - 1].y + packer->shelves[packer->shelfCount - 1].height : 0;
+    if (top + height > atlas->canvas->image.height || width > atlasWidth) return false;
     
-    // Set sprite position
-    sprite->position = position;
+    if (packer->shelfCount == packer->shelfCapacity) {
+        int newCapacity = packer->shelfCapacity > 0 ? packer->shelfCapacity * 2 : 16;
+        RayPalsAtlasShelf* newShelves = (RayPalsAtlasShelf*)realloc(packer->shelves, sizeof(RayPalsAtlasShelf) * newCapacity);
+        if (newShelves == NULL) return false;
+        packer->shelves = newShelves;
+        packer->shelfCapacity = newCapacity;
+    }
     
-    return sprite;
+    packer->shelves[packer->shelfCount] = (RayPalsAtlasShelf){ top, height };
+    *x = 0;
+    *y = top;
+    *shelf = packer->shelfCount++;
+    return true;
 }
 
-// ----------------------------------------------------------------------------
-// 3D Sprite Functions
-// ----------------------------------------------------------------------------
+static void MarkAtlasRegion(RayPalsAtlasPacker* packer, int x, int y, int width, int height) {
+    if (!packer->uploadPending) {
+        packer->dirtyMinX = x;
+        packer->dirtyMinY = y;
+        packer->dirtyMaxX = x + width;
+        packer->dirtyMaxY = y + height;
+        packer->uploadPending = true;
+        return;
+    }
+    
+    if (x < packer->dirtyMinX) packer->dirtyMinX = x;
+    if (y < packer->dirtyMinY) packer->dirtyMinY = y;
+    if (x + width > packer->dirtyMaxX) packer->dirtyMaxX = x + width;
+    if (y + height > packer->dirtyMaxY) packer->dirtyMaxY = y + height;
+}
 
-RayPals3DSprite* Create3DSprite(int initialCapacity) {
-    RayPals3DSprite* sprite = (RayPals3DSprite*)malloc(sizeof(RayPals3DSprite));
-    if (sprite == NULL) return NULL;
+static void FreeBakeJob(RayPalsBakeJob* job) {
+    free((char*)job->key.factory);
+    free(job->vertices);
+    free(job->colors);
+    free(job->pixels);
+    free(job);
+}
+
+// Snapshots the sprite's triangles at the tier's scale; NULL if the tier cannot fit the atlas.
+// The tessellation is the job's own, so the sprite's cache keeps the LOD it is drawn with.
+static RayPalsBakeJob* CreateBakeJob(RayPalsSpriteAtlas* atlas, const RayPalsBakeKey* key, int tier, RayPalsSprite* sprite) {
+    float scale = GetAtlasTierScale(atlas, tier);
+    RayPalsSpriteCache* cache = NULL;
+    if (!RebuildShapeCache(&cache, NULL, sprite->shapes, NULL, sprite->shapeCount, GetLODBucket(scale))) {
+        FreeSpriteCache(cache);
+        return NULL;
+    }
     
-    sprite->shapes = (RayPals3DShape**)malloc(sizeof(RayPals3DShape*) * initialCapacity);
-    if (sprite->shapes == NULL) {
-        free(sprite);
+    int contentWidth = (int)ceilf(cache->localBounds.width*scale);
+    int contentHeight = (int)ceilf(cache->localBounds.height*scale);
+    if (contentWidth < 1) contentWidth = 1;
+    if (contentHeight < 1) contentHeight = 1;
+    
+    int width, height;
+    RayPalsBakeJob* job = NULL;
+    if (GetAtlasSlotSize(atlas, contentWidth, contentHeight, &width, &height)) {
+        job = (RayPalsBakeJob*)calloc(1, sizeof(RayPalsBakeJob));
+    }
+    if (job == NULL) {
+        FreeSpriteCache(cache);
         return NULL;
     }
     
-    sprite->shapeCount = 0;
-    sprite->position = (Vector3){ 0, 0, 0 };
-    sprite->rotation = (Vector3){ 0, 0, 0 };
-    sprite->scale = (Vector3){ 1, 1, 1 };
-    sprite->visible = true;
+    job->key = *key;
+    job->key.factory = NULL;
+    job->hash = HashBakeKey(key, tier);
+    job->tier = tier;
+    job->generation = atlas->packer->generation;
+    job->version = contentStamp;
+    job->vertexCount = cache->vertexCount;
+    job->localBounds = cache->localBounds;
+    job->scale = scale;
+    job->contentWidth = contentWidth;
+    job->contentHeight = contentHeight;
+    job->width = width;
+    job->height = height;
+    job->kernels = spanKernels;
+    
+    // The job takes over the heap buffers of its private cache
+    job->vertices = cache->vertices;
+    job->colors = cache->colors;
+    cache->vertices = NULL;
+    cache->colors = NULL;
+    FreeSpriteCache(cache);
+    
+    job->pixels = (Color*)malloc((size_t)width * height * sizeof(Color));
+    if (key->factory != NULL) {
+        char* factory = (char*)malloc(strlen(key->factory) + 1);
+        if (factory != NULL) strcpy(factory, key->factory);
+        job->key.factory = factory;
+    }
     
-    return sprite;
+    if (job->pixels == NULL || (key->factory != NULL && job->key.factory == NULL)) {
+        FreeBakeJob(job);
+        return NULL;
+    }
+    return job;
 }
 
-void AddShapeTo3DSprite(RayPals3DSprite* sprite, RayPals3DShape* shape) {
-    if (!sprite || !shape) return;
+// Rasterizes a job's snapshot into its own slot image; safe to run on any thread
+static void RasterizeBakeJob(RayPalsBakeJob* job) {
+    job->kernels.fill(job->pixels, job->width * job->height, BLANK);
     
-    // Resize the array if needed
-    RayPals3DShape** newShapes = (RayPals3DShape**)realloc(sprite->shapes, 
-                                  sizeof(RayPals3DShape*) * (sprite->shapeCount + 1));
-    if (newShapes == NULL) return;
+    RayPalsCanvas target = { 0 };
+    target.image.width = job->width;
+    target.image.height = job->height;
     
-    sprite->shapes = newShapes;
-    sprite->shapes[sprite->shapeCount] = shape;
-    sprite->shapeCount++;
+    // Sprite space to texels, with the content starting inside the padding
+    float scale = job->scale;
+    float originX = RAYPALS_ATLAS_PADDING - job->localBounds.x*scale;
+    float originY = RAYPALS_ATLAS_PADDING - job->localBounds.y*scale;
+    
+    for (int i = 0; i + 2 < job->vertexCount; i += 3) {
+        Vector2 a = { originX + job->vertices[i].x*scale, originY + job->vertices[i].y*scale };
+        Vector2 b = { originX + job->vertices[i + 1].x*scale, originY + job->vertices[i + 1].y*scale };
+        Vector2 c = { originX + job->vertices[i + 2].x*scale, originY + job->vertices[i + 2].y*scale };
+        
+        RayPalsCanvasTriangle triangle;
+        if (!SetupCanvasTriangle(&target, a, b, c, job->colors[i], &triangle)) continue;
+        
+        // Clipped to the inside of the gutter so no neighbor can be touched
+        job->triangles++;
+        job->pixelCount += FillCanvasTriangle(&job->kernels, job->pixels, job->width, &triangle, 1, job->width - 2, 1, job->height - 2);
+    }
 }
 
-void Draw3DSprite(RayPals3DSprite* sprite, Camera camera) {
-    if (!sprite || !sprite->visible) return;
+// Places a rasterized job in the atlas, reusing the tier's slot when it still fits; returns the entry or -1
+static int CommitBakeJob(RayPalsSpriteAtlas* atlas, RayPalsBakeJob* job) {
+    RayPalsAtlasPacker* packer = atlas->packer;
+    int index = FindAtlasEntry(packer, &job->key, job->hash, job->tier);
     
-    // Save current matrix
-    rlPushMatrix();
+    if (index >= 0 && (packer->entries[index].width < job->width || packer->entries[index].height < job->height)) {
+        RemoveAtlasEntry(atlas, index);
+        index = -1;
+    }
+    
+    if (index < 0) {
+        size_t bytes = (size_t)job->width * job->height * sizeof(Color);
+        while (atlas->stats.bytesUsed + bytes > atlas->byteBudget) {
+            if (!EvictLeastRecentlyUsed(atlas)) return -1;
+        }
+        
+        int x, y, shelf;
+        while (!FindAtlasSpace(atlas, job->width, job->height, &x, &y, &shelf)) {
+            if (!EvictLeastRecentlyUsed(atlas)) return -1;
+        }
+        
+        if (packer->entryCount == packer->entryCapacity) {
+            int newCapacity = packer->entryCapacity > 0 ? packer->entryCapacity * 2 : 32;
+            RayPalsAtlasEntry* newEntries = (RayPalsAtlasEntry*)realloc(packer->entries, sizeof(RayPalsAtlasEntry) * newCapacity);
+            if (newEntries == NULL) return -1;
+            packer->entries = newEntries;
+            packer->entryCapacity = newCapacity;
+        }
+        
+        // The entry takes over the job's copy of the factory name
+        index = packer->entryCount++;
+        RayPalsAtlasEntry* entry = &packer->entries[index];
+        *entry = (RayPalsAtlasEntry){ 0 };
+        entry->key = job->key;
+        entry->hash = job->hash;
+        entry->tier = job->tier;
+        entry->x = x;
+        entry->y = y;
+        entry->width = job->width;
+        entry->height = job->height;
+        entry->shelf = shelf;
+        job->key.factory = NULL;
+        
+        atlas->stats.bytesUsed += bytes;
+        atlas->stats.entries = packer->entryCount;
+        RebuildAtlasTable(packer);
+    }
+    
+    RayPalsAtlasEntry* entry = &packer->entries[index];
+    entry->version = job->version;
+    Color* pixels = (Color*)atlas->canvas->image.data;
+    int atlasWidth = atlas->canvas->image.width;
+    
+    // A reused slot can be larger than the job; its remainder is cleared
+    for (int row = 0; row < entry->height; row++) {
+        Color* destination = &pixels[(size_t)(entry->y + row)*atlasWidth + entry->x];
+        if (row < job->height) {
+            memcpy(destination, &job->pixels[(size_t)row*job->width], sizeof(Color) * job->width);
+            if (entry->width > job->width) spanKernels.fill(destination + job->width, entry->width - job->width, BLANK);
+        } else {
+            spanKernels.fill(destination, entry->width, BLANK);
+        }
+    }
     
-    // Apply sprite transformations
-    rlTranslatef(sprite->position.x, sprite->position.y, sprite->position.z);
+    // The source includes one transparent texel on each side so bilinear edges fade out
+    float border = 1.0f / job->scale;
+    entry->source = (Rectangle){ (float)(entry->x + 1), (float)(entry->y + 1), (float)(job->contentWidth + 2), (float)(job->contentHeight + 2) };
+    entry->bounds = (Rectangle){ job->localBounds.x - border, job->localBounds.y - border,
+                                 (job->contentWidth + 2) / job->scale, (job->contentHeight + 2) / job->scale };
+    entry->lastUse = ++packer->clock;
     
-    // Apply rotations in order: Y (yaw), X (pitch), Z (roll)
-    rlRotatef(sprite->rotation.y, 0.0f, 1.0f, 0.0f);
-    rlRotatef(sprite->rotation.x, 1.0f, 0.0f, 0.0f);
-    rlRotatef(sprite->rotation.z, 0.0f, 0.0f, 1.0f);
+    MarkAtlasRegion(packer, entry->x, entry->y, entry->width, entry->height);
+    atlas->canvas->stats.triangles += job->triangles;
+    atlas->canvas->stats.pixels += job->pixelCount;
+    atlas->stats.bakes++;
     
-    rlScalef(sprite->scale.x, sprite->scale.y, sprite->scale.z);
+    return index;
+}
+
+static void BakerMain(RayPalsAtlasPacker* packer) {
+    RayPalsLockMutex(&packer->bakeLock);
     
-    // Draw all shapes in the sprite RELATIVE to the sprite's transform
-    // We assume Draw3DShape applies its own relative transforms correctly
-    // and doesn't need the camera parameter when called this way.
-    for (int i = 0; i < sprite->shapeCount; i++) {
-        // Pass a dummy camera or modify Draw3DShape to handle NULL?
-        // For now, let's assume Draw3DShape can handle drawing within the current matrix state.
-        // We will modify Draw3DShape if needed. Let's try calling it without the camera.
-        // NOTE: This will likely require modifying Draw3DShape signature or implementation.
-        Draw3DShape(sprite->shapes[i], NULL); // Removed camera parameter
+    for (;;) {
+        RayPalsBakeJob* job = packer->jobs;
+        while (job != NULL && job->started) job = job->next;
+        
+        if (job == NULL) {
+            if (packer->bakerQuit) break;
+            RayPalsWaitCondition(&packer->bakeWake, &packer->bakeLock);
+            continue;
+        }
+        
+        // Jobs dropped while queued are completed without rasterizing
+        job->started = true;
+        bool current = job->generation == packer->generation;
+        RayPalsUnlockMutex(&packer->bakeLock);
+        
+        if (current) RasterizeBakeJob(job);
+        
+        RayPalsLockMutex(&packer->bakeLock);
+        job->done = true;
+        RayPalsBroadcastCondition(&packer->bakeDone);
     }
     
-    // Restore matrix
-    rlPopMatrix();
+    RayPalsUnlockMutex(&packer->bakeLock);
 }
 
-void Set3DSpritePosition(RayPals3DSprite* sprite, Vector3 position) {
-    if (sprite) sprite->position = position;
-}
+static void BakerThreadEntry(void* packer) { BakerMain((RayPalsAtlasPacker*)packer); }
 
-void Set3DSpriteRotation(RayPals3DSprite* sprite, Vector3 rotation) {
-    if (sprite) sprite->rotation = rotation;
+// Hands a job to the baker thread, starting it on first use; false if no thread could be started
+static bool QueueBakeJob(RayPalsAtlasPacker* packer, RayPalsBakeJob* job) {
+    if (!packer->bakerStarted) {
+        if (!RayPalsStartThread(&packer->bakeThread, BakerThreadEntry, packer)) return false;
+        packer->bakerStarted = true;
+    }
+    
+    RayPalsLockMutex(&packer->bakeLock);
+    RayPalsBakeJob** tail = &packer->jobs;
+    while (*tail != NULL) tail = &(*tail)->next;
+    *tail = job;
+    RayPalsBroadcastCondition(&packer->bakeWake);
+    RayPalsUnlockMutex(&packer->bakeLock);
+    return true;
 }
 
-void Set3DSpriteScale(RayPals3DSprite* sprite, Vector3 scale) {
-    if (sprite) sprite->scale = scale;
+static bool IsBakeJobQueued(const RayPalsAtlasPacker* packer, const RayPalsBakeKey* key, unsigned int hash, int tier) {
+    for (const RayPalsBakeJob* job = packer->jobs; job != NULL; job = job->next) {
+        if (job->hash == hash && job->tier == tier && job->generation == packer->generation && BakeKeysEqual(&job->key, key)) return true;
+    }
+    return false;
 }
 
-void Rotate3DSprite(RayPals3DSprite* sprite, float deltaTime, Vector3 speed) {
-    if (!sprite) return;
+// Commits the jobs the baker finished (all of them when wait is set), dropping outdated ones
+static void CollectBakeJobs(RayPalsSpriteAtlas* atlas, bool wait) {
+    RayPalsAtlasPacker* packer = atlas->packer;
+    if (packer->jobs == NULL) return;
     
-    sprite->rotation.x += speed.x * deltaTime;
-    sprite->rotation.y += speed.y * deltaTime;
-    sprite->rotation.z += speed.z * deltaTime;
+    RayPalsBakeJob* finished = NULL;
+    RayPalsBakeJob** finishedTail = &finished;
     
-    // Normalize rotations to 0-360 degrees
-    while (sprite->rotation.x >= 360.0f) sprite->rotation.x -= 360.0f;
-    while (sprite->rotation.x < 0.0f) sprite->rotation.x += 360.0f;
+    RayPalsLockMutex(&packer->bakeLock);
+    for (;;) {
+        bool pending = false;
+        for (RayPalsBakeJob* job = packer->jobs; job != NULL; job = job->next) pending |= !job->done;
+        if (!wait || !pending) break;
+        RayPalsWaitCondition(&packer->bakeDone, &packer->bakeLock);
+    }
     
-    while (sprite->rotation.y >= 360.0f) sprite->rotation.y -= 360.0f;
-    while (sprite->rotation.y < 0.0f) sprite->rotation.y += 360.0f;
+    RayPalsBakeJob** link = &packer->jobs;
+    while (*link != NULL) {
+        RayPalsBakeJob* job = *link;
+        if (!job->done) {
+            link = &job->next;
+            continue;
+        }
+        *link = job->next;
+        job->next = NULL;
+        *finishedTail = job;
+        finishedTail = &job->next;
+    }
+    RayPalsUnlockMutex(&packer->bakeLock);
     
-    while (sprite->rotation.z >= 360.0f) sprite->rotation.z -= 360.0f;
-    while (sprite->rotation.z < 0.0f) sprite->rotation.z += 360.0f;
+    while (finished != NULL) {
+        RayPalsBakeJob* job = finished;
+        finished = job->next;
+        
+        if (job->generation == packer->generation && CommitBakeJob(atlas, job) >= 0) atlas->stats.backgroundBakes++;
+        FreeBakeJob(job);
+    }
+    
+    int pending = 0;
+    for (const RayPalsBakeJob* job = packer->jobs; job != NULL; job = job->next) pending++;
+    atlas->stats.pendingBakes = pending;
 }
 
-void Free3DSprite(RayPals3DSprite* sprite) {
-    if (!sprite) return;
-    
-    // Free all shapes in the sprite
-    for (int i = 0; i < sprite->shapeCount; i++) {
-        Free3DShape(sprite->shapes[i]);
+// Makes every queued job outdated; the baker skips them and collection frees them
+static void DropBakeJobs(RayPalsAtlasPacker* packer) {
+    RayPalsLockMutex(&packer->bakeLock);
+    packer->generation++;
+    RayPalsUnlockMutex(&packer->bakeLock);
+}
+
+// Bakes a tier on the calling thread, stepping down to lower tiers that fit; returns the entry or -1
+static int BakeAtlasTier(RayPalsSpriteAtlas* atlas, const RayPalsBakeKey* key, int tier, RayPalsSprite* sprite) {
+    for (; tier >= 0; tier--) {
+        RayPalsBakeJob* job = CreateBakeJob(atlas, key, tier, sprite);
+        if (job == NULL) continue;
+        
+        RasterizeBakeJob(job);
+        int index = CommitBakeJob(atlas, job);
+        FreeBakeJob(job);
+        return index;
     }
-    
-    // Free the shapes array and the sprite itself
-    free(sprite->shapes);
-    free(sprite);
+    return -1;
 }
 
-RayPals3DSprite* Create3DRobot(Vector3 position, float size, Color bodyColor, Color detailColor) {
-    RayPals3DSprite* sprite = Create3DSprite(6);
-    if (sprite == NULL) return NULL;
-    
-    // Robot body (main cube)
-    RayPals3DShape* body = CreateCube(
-        (Vector3){ 0, 0, 0 },
-        (Vector3){ size * 0.6f, size * 0.8f, size * 0.4f },
-        bodyColor
-    );
-    
-    // Robot head (smaller cube)
-    RayPals3DShape* head = CreateCube(
-        (Vector3){ 0, size * 0.6f, 0 },
-        (Vector3){ size * 0.4f, size * 0.4f, size * 0.4f },
-        bodyColor
-    );
+// Finds the entry to draw a sprite with, baking or queueing the tier for its on-screen size; returns -1 on failure
+static int BakeAtlasEntry(RayPalsSpriteAtlas* atlas, const RayPalsBakeKey* key, RayPalsSprite* sprite, bool background) {
+    RayPalsAtlasPacker* packer = atlas->packer;
+    CollectBakeJobs(atlas, false);
     
-    // Robot eyes (two small cylinders)
-    RayPals3DShape* leftEye = CreateCylinder(
-        (Vector3){ -size * 0.1f, size * 0.6f, size * 0.2f },
-        size * 0.05f,
-        size * 0.05f,
-        8,
-        detailColor
-    );
+    unsigned int hashes[RAYPALS_ATLAS_TIERS];
+    int entries[RAYPALS_ATLAS_TIERS];
+    for (int tier = 0; tier < RAYPALS_ATLAS_TIERS; tier++) hashes[tier] = HashBakeKey(key, tier);
     
-    RayPals3DShape* rightEye = CreateCylinder(
-        (Vector3){ size * 0.1f, size * 0.6f, size * 0.2f },
-        size * 0.05f,
-        size * 0.05f,
-        8,
-        detailColor
-    );
+    int wanted = GetAtlasTier(atlas, sprite->scale * atlas->zoom);
+    unsigned int version = GetSpriteContentVersion(sprite);
     
-    // Robot arms (cylinders)
-    RayPals3DShape* leftArm = CreateCylinder(
-        (Vector3){ -size * 0.4f, 0, 0 },
-        size * 0.1f,
-        size * 0.6f,
-        8,
-        bodyColor
-    );
-    leftArm->rotation = (Vector3){ 0, 0, 90 };
+    bool edited = false;
+    for (int tier = 0; tier < RAYPALS_ATLAS_TIERS; tier++) {
+        entries[tier] = FindAtlasEntry(packer, key, hashes[tier], tier);
+        if (entries[tier] >= 0 && IsStampNewer(version, packer->entries[entries[tier]].version)) edited = true;
+    }
     
-    RayPals3DShape* rightArm = CreateCylinder(
-        (Vector3){ size * 0.4f, 0, 0 },
-        size * 0.1f,
-        size * 0.6f,
-        8,
-        bodyColor
-    );
-    rightArm->rotation = (Vector3){ 0, 0, -90 };
+    // A sprite edited (or created) after a tier was snapshot makes every tier stale:
+    // the wanted one is re-baked now, the rest on demand
+    if (edited) {
+        for (int tier = 0; tier < RAYPALS_ATLAS_TIERS; tier++) {
+            int index = tier != wanted ? FindAtlasEntry(packer, key, hashes[tier], tier) : -1;
+            if (index >= 0) RemoveAtlasEntry(atlas, index);
+        }
+        if (packer->jobs != NULL) DropBakeJobs(packer);
+        return BakeAtlasTier(atlas, key, wanted, sprite);
+    }
     
-    // Add all shapes to the sprite
-    AddShapeTo3DSprite(sprite, body);
-    AddShapeTo3DSprite(sprite, head);
-    AddShapeTo3DSprite(sprite, leftEye);
-    AddShapeTo3DSprite(sprite, rightEye);
-    AddShapeTo3DSprite(sprite, leftArm);
-    AddShapeTo3DSprite(sprite, rightArm);
+    // A clean sprite reuses whatever entry its key already has, even if another sprite baked it
+    if (entries[wanted] >= 0) {
+        packer->entries[entries[wanted]].lastUse = ++packer->clock;
+        atlas->stats.hits++;
+        return entries[wanted];
+    }
     
-    // Set sprite position
-    Set3DSpritePosition(sprite, position);
+    // Closest baked tier, preferring the sharper one
+    int fallback = -1;
+    for (int distance = 1; distance < RAYPALS_ATLAS_TIERS && fallback < 0; distance++) {
+        if (wanted + distance < RAYPALS_ATLAS_TIERS && entries[wanted + distance] >= 0) fallback = wanted + distance;
+        else if (wanted - distance >= 0 && entries[wanted - distance] >= 0) fallback = wanted - distance;
+    }
+    if (fallback < 0) return BakeAtlasTier(atlas, key, wanted, sprite);
+    
+    // Tiers above the fallback that could not fit the atlas are never requested
+    const RayPalsAtlasEntry* known = &packer->entries[entries[fallback]];
+    int contentWidth = (int)known->source.width - 2, contentHeight = (int)known->source.height - 2;
+    int width, height;
+    while (wanted > fallback &&
+           !GetAtlasSlotSize(atlas, contentWidth << (wanted - fallback), contentHeight << (wanted - fallback), &width, &height)) {
+        wanted--;
+    }
     
-    return sprite;
+    if (wanted != fallback) {
+        if (!background) return BakeAtlasTier(atlas, key, wanted, sprite);
+        
+        // Draw the fallback while the wanted tier is baked off the main thread
+        if (!IsBakeJobQueued(packer, key, hashes[wanted], wanted)) {
+            RayPalsBakeJob* job = CreateBakeJob(atlas, key, wanted, sprite);
+            if (job != NULL && QueueBakeJob(packer, job)) {
+                atlas->stats.pendingBakes++;
+            } else if (job != NULL) {
+                RasterizeBakeJob(job);
+                int index = CommitBakeJob(atlas, job);
+                FreeBakeJob(job);
+                if (index >= 0) return index;
+            }
+            
+            // Baking may have evicted the fallback
+            entries[fallback] = FindAtlasEntry(packer, key, hashes[fallback], fallback);
+            if (entries[fallback] < 0) return BakeAtlasTier(atlas, key, wanted, sprite);
+        }
+    }
+    
+    packer->entries[entries[fallback]].lastUse = ++packer->clock;
+    atlas->stats.hits++;
+    return entries[fallback];
 }
 
-RayPals3DSprite* Create3DSpaceship(Vector3 position, float size, Color bodyColor, Color glassColor) {
-    RayPals3DSprite* sprite = Create3DSprite(5);
-    if (sprite == NULL) return NULL;
+// Creates the texture on first use, then uploads only the region baked since the last draw
+static void UploadSpriteAtlas(RayPalsSpriteAtlas* atlas) {
+    RayPalsAtlasPacker* packer = atlas->packer;
     
-    // Main body (elongated cube)
-    RayPals3DShape* body = CreateCube(
-        (Vector3){ 0, 0, 0 },
-        (Vector3){ size * 1.5f, size * 0.3f, size * 0.8f },
-        bodyColor
-    );
+    if (atlas->texture.id == 0) {
+        atlas->texture = LoadTextureFromImage(atlas->canvas->image);
+        SetTextureFilter(atlas->texture, TEXTURE_FILTER_BILINEAR);
+        packer->uploadPending = false;
+        atlas->stats.uploads++;
+        return;
+    }
     
-    // Cockpit (sphere)
-    RayPals3DShape* cockpit = CreateSphere(
-        (Vector3){ size * 0.4f, size * 0.2f, 0 },
-        size * 0.2f,
-        16,
-        glassColor
-    );
+    if (!packer->uploadPending) return;
     
-    // Wings (two flat cubes)
-    RayPals3DShape* leftWing = CreateCube(
-        (Vector3){ 0, 0, -size * 0.6f },
-        (Vector3){ size * 0.8f, size * 0.1f, size * 0.4f },
-        bodyColor
-    );
+    int width = packer->dirtyMaxX - packer->dirtyMinX;
+    int height = packer->dirtyMaxY - packer->dirtyMinY;
+    Color* region = (Color*)malloc((size_t)width * height * sizeof(Color));
+    if (region == NULL) return;
     
-    RayPals3DShape* rightWing = CreateCube(
-        (Vector3){ 0, 0, size * 0.6f },
-        (Vector3){ size * 0.8f, size * 0.1f, size * 0.4f },
-        bodyColor
-    );
+    const Color* pixels = (const Color*)atlas->canvas->image.data;
+    for (int row = 0; row < height; row++) {
+        memcpy(&region[(size_t)row*width], &pixels[(size_t)(packer->dirtyMinY + row)*atlas->canvas->image.width + packer->dirtyMinX],
+               sizeof(Color) * width);
+    }
     
-    // Engine (cylinder)
-    RayPals3DShape* engine = CreateCylinder(
-        (Vector3){ -size * 0.6f, 0, 0 },
-        size * 0.2f,
-        size * 0.3f,
-        12,
-        bodyColor
-    );
-    engine->rotation = (Vector3){ 0, 0, 90 };
+    // Quads already batched may sample slots that were just re-baked; draw them first
+    rlDrawRenderBatchActive();
+    UpdateTextureRec(atlas->texture, (Rectangle){ (float)packer->dirtyMinX, (float)packer->dirtyMinY, (float)width, (float)height }, region);
+    free(region);
     
-    // Add all shapes to the sprite
-    AddShapeTo3DSprite(sprite, body);
-    AddShapeTo3DSprite(sprite, cockpit);
-    AddShapeTo3DSprite(sprite, leftWing);
-    AddShapeTo3DSprite(sprite, rightWing);
-    AddShapeTo3DSprite(sprite, engine);
+    packer->uploadPending = false;
+    atlas->stats.uploads++;
+}
+
+RayPalsSpriteAtlas* CreateSpriteAtlas(int width, int height, size_t byteBudget) {
+    RayPalsSpriteAtlas* atlas = (RayPalsSpriteAtlas*)calloc(1, sizeof(RayPalsSpriteAtlas));
+    if (atlas == NULL) return NULL;
     
-    // Set sprite position
-    Set3DSpritePosition(sprite, position);
+    atlas->canvas = CreateCanvas(width, height);
+    atlas->packer = (RayPalsAtlasPacker*)calloc(1, sizeof(RayPalsAtlasPacker));
+    if (atlas->canvas == NULL || atlas->packer == NULL) {
+        free(atlas->packer);
+        atlas->packer = NULL;
+        FreeSpriteAtlas(atlas);
+        return NULL;
+    }
     
-    return sprite;
+    RayPalsInitMutex(&atlas->packer->bakeLock);
+    RayPalsInitCondition(&atlas->packer->bakeWake);
+    RayPalsInitCondition(&atlas->packer->bakeDone);
+    
+    size_t capacity = (size_t)width * height * sizeof(Color);
+    atlas->byteBudget = byteBudget > 0 && byteBudget < capacity ? byteBudget : capacity;
+    atlas->bakeScale = 1.0f;
+    atlas->zoom = 1.0f;
+    
+    return atlas;
 }
 
-RayPals3DTree Create3DTree(Vector3 position, float scale, Color trunkColor, Color leavesColor) {
-    RayPals3DTree tree = { 0 };
-    tree.position = position;
-    tree.rotation = (Vector3){ 0.0f, 0.0f, 0.0f };
-    tree.scale = scale;
+void SetAtlasBakeScale(RayPalsSpriteAtlas* atlas, float bakeScale) {
+    if (!atlas || !(bakeScale > 0.0f) || bakeScale == atlas->bakeScale) return;
     
-    // Create a 3D sprite with 2 shapes
-    tree.sprite = Create3DSprite(2);
-    if (!tree.sprite) return tree;
+    ClearSpriteAtlas(atlas);
+    atlas->bakeScale = bakeScale;
+}
+
+void SetAtlasZoom(RayPalsSpriteAtlas* atlas, float zoom) {
+    if (atlas && zoom > 0.0f) atlas->zoom = zoom;
+}
+
+Rectangle BakeSprite(RayPalsSpriteAtlas* atlas, RayPalsBakeKey key, RayPalsSprite* sprite) {
+    if (!atlas || !sprite) return (Rectangle){ 0 };
     
-    // Set sprite position and scale
-    Set3DSpritePosition(tree.sprite, position);
-    Set3DSpriteScale(tree.sprite, (Vector3){ 1.0f, 1.0f, 1.0f });
+    int index = BakeAtlasEntry(atlas, &key, sprite, false);
+    return index >= 0 ? atlas->packer->entries[index].source : (Rectangle){ 0 };
+}
 
-    // Create trunk (cylinder)
-    RayPals3DShape* trunk = CreateCylinder(
-        (Vector3){ 0, scale, 0 },  // Relative to tree position
-        0.3f * scale,
-        2.0f * scale,
-        12,
-        trunkColor
-    );
+bool DrawSpriteBaked(RayPalsSpriteAtlas* atlas, RayPalsBakeKey key, RayPalsSprite* sprite) {
+    if (!sprite || !sprite->visible) return false;
     
-    // Create leaves (cone)
-    RayPals3DShape* leaves = CreateCone(
-        (Vector3){ 0, 3.0f * scale, 0 },  // Relative to tree position
-        1.5f * scale,
-        2.5f * scale,
-        12,
-        leavesColor
-    );
+    int index = atlas != NULL ? BakeAtlasEntry(atlas, &key, sprite, true) : -1;
+    if (index < 0) {
+        DrawSprite(sprite);
+        return false;
+    }
     
-    // Add shapes to sprite
-    AddShapeTo3DSprite(tree.sprite, trunk);
-    AddShapeTo3DSprite(tree.sprite, leaves);
+    UploadSpriteAtlas(atlas);
+    
+    // Places the bounds under the sprite transform; the origin is the sprite position
+    const RayPalsAtlasEntry* entry = &atlas->packer->entries[index];
+    float scale = sprite->scale;
+    Rectangle dest = { sprite->position.x, sprite->position.y, entry->bounds.width*scale, entry->bounds.height*scale };
+    Vector2 origin = { -entry->bounds.x*scale, -entry->bounds.y*scale };
+    DrawTexturePro(atlas->texture, entry->source, dest, origin, sprite->rotation, WHITE);
+    
+    drawStats.sprites++;
+    drawStats.vertices += 4;
+    return true;
+}
 
-    return tree;
+void FlushSpriteAtlas(RayPalsSpriteAtlas* atlas) {
+    if (atlas && atlas->packer) CollectBakeJobs(atlas, true);
 }
 
-void Free3DTree(RayPals3DTree* tree) {
-    if (tree == NULL) return;
+void ClearSpriteAtlas(RayPalsSpriteAtlas* atlas) {
+    if (!atlas || !atlas->packer) return;
     
-    Free3DSprite(tree->sprite);
-    // Note: We're not freeing the tree itself as it might be stack-allocated
+    RayPalsAtlasPacker* packer = atlas->packer;
+    if (packer->jobs != NULL) DropBakeJobs(packer);
+    
+    for (int i = 0; i < packer->entryCount; i++) free((char*)packer->entries[i].key.factory);
+    packer->entryCount = 0;
+    packer->shelfCount = 0;
+    RebuildAtlasTable(packer);
+    
+    atlas->stats.entries = 0;
+    atlas->stats.bytesUsed = 0;
 }
 
-// Create a skeleton shape
-RayPals2DShape* CreateSkeleton(Vector2 position, float size, Color color) {
-    RayPals2DShape* shape = (RayPals2DShape*)malloc(sizeof(RayPals2DShape));
-    if (shape == NULL) return NULL;
+void FreeSpriteAtlas(RayPalsSpriteAtlas* atlas) {
+    if (!atlas) return;
+    
+    RayPalsAtlasPacker* packer = atlas->packer;
+    if (packer != NULL) {
+        if (packer->bakerStarted) {
+            // Queued jobs are outdated first so the baker skips them on its way out
+            RayPalsLockMutex(&packer->bakeLock);
+            packer->generation++;
+            packer->bakerQuit = true;
+            RayPalsBroadcastCondition(&packer->bakeWake);
+            RayPalsUnlockMutex(&packer->bakeLock);
+            RayPalsJoinThread(packer->bakeThread);
+        }
+        
+        while (packer->jobs != NULL) {
+            RayPalsBakeJob* job = packer->jobs;
+            packer->jobs = job->next;
+            FreeBakeJob(job);
+        }
+        
+        ClearSpriteAtlas(atlas);
+        RayPalsDestroyCondition(&packer->bakeDone);
+        RayPalsDestroyCondition(&packer->bakeWake);
+        RayPalsDestroyMutex(&packer->bakeLock);
+        free(packer->entries);
+        free(packer->table);
+        free(packer->shelves);
+        free(packer);
+    }
+    if (atlas->texture.id != 0) UnloadTexture(atlas->texture);
+    FreeCanvas(atlas->canvas);
+    free(atlas);
+}
+
+// ----------------------------------------------------------------------------
+// Retained Scene Functions
+// ----------------------------------------------------------------------------
+
+#define RAYPALS_RETAINED_PADDING 2      // Pixels added around sprite bounds for antialiased edges and outlines
+#define RAYPALS_RETAINED_MAX_RECTS 16   // Dirty rectangles kept apart before the closest ones are merged
+
+// Screen rectangle in whole pixels, [x0, x1) x [y0, y1)
+typedef struct {
+    int x0, y0, x1, y1;
+} RayPalsPixelRect;
+
+// What a submitted sprite looked like, enough to tell whether its pixels changed
+typedef struct {
+    RayPalsSprite* sprite;     // Only compared by address once the frame has ended
+    Vector2 position;
+    float rotation;
+    float scale;
+    unsigned int version;      // Content version of the sprite and its shapes when submitted
+    RayPalsPixelRect bounds;   // Screen area covered, empty for invisible sprites
+} RayPalsRetainedItem;
+
+struct RayPalsRetainedState {
+    RayPalsRetainedItem* previous;  // Submissions of the last composed frame
+    int previousCount;
+    RayPalsRetainedItem* current;   // Submissions since BeginRetainedScene
+    int currentCount;
+    int capacity;                   // Of both arrays
+    RayPalsPixelRect rects[RAYPALS_RETAINED_MAX_RECTS];
+    int rectCount;
+    bool fullRedraw;
+};
+
+static bool IsPixelRectEmpty(RayPalsPixelRect rect) {
+    return rect.x1 <= rect.x0 || rect.y1 <= rect.y0;
+}
+
+static long long GetPixelRectArea(RayPalsPixelRect rect) {
+    return IsPixelRectEmpty(rect) ? 0 : (long long)(rect.x1 - rect.x0) * (rect.y1 - rect.y0);
+}
+
+static RayPalsPixelRect UnionPixelRects(RayPalsPixelRect a, RayPalsPixelRect b) {
+    return (RayPalsPixelRect){ a.x0 < b.x0 ? a.x0 : b.x0, a.y0 < b.y0 ? a.y0 : b.y0,
+                               a.x1 > b.x1 ? a.x1 : b.x1, a.y1 > b.y1 ? a.y1 : b.y1 };
+}
+
+static bool PixelRectsOverlap(RayPalsPixelRect a, RayPalsPixelRect b) {
+    return a.x0 < b.x1 && b.x0 < a.x1 && a.y0 < b.y1 && b.y0 < a.y1;
+}
+
+// Screen pixels a world rectangle covers under the camera, padded and clipped to the target
+static RayPalsPixelRect GetScreenPixelRect(Rectangle world, Camera2D camera, int width, int height) {
+    Vector2 corners[4] = {
+        GetWorldToScreen2D((Vector2){ world.x, world.y }, camera),
+        GetWorldToScreen2D((Vector2){ world.x + world.width, world.y }, camera),
+        GetWorldToScreen2D((Vector2){ world.x, world.y + world.height }, camera),
+        GetWorldToScreen2D((Vector2){ world.x + world.width, world.y + world.height }, camera)
+    };
     
-    shape->type = RAYPALS_SKELETON;
-    shape->position = position;
-    shape->size = (Vector2){ size, size * 1.5f }; // Skeletons are taller than wide
-    shape->rotation = 0.0f;
-    shape->color = color;
-    shape->filled = true;
-    shape->thickness = 2.0f;
-    shape->segments = 0;
-    shape->points = 0;
-    shape->visible = true;
+    float minX = corners[0].x, maxX = corners[0].x, minY = corners[0].y, maxY = corners[0].y;
+    for (int i = 1; i < 4; i++) {
+        minX = fminf(minX, corners[i].x);
+        maxX = fmaxf(maxX, corners[i].x);
+        minY = fminf(minY, corners[i].y);
+        maxY = fmaxf(maxY, corners[i].y);
+    }
     
-    return shape;
+    // Written so NaN coordinates give an empty rectangle
+    if (!(maxX >= 0.0f && minX <= (float)width && maxY >= 0.0f && minY <= (float)height)) return (RayPalsPixelRect){ 0 };
+    
+    RayPalsPixelRect rect = {
+        (int)floorf(fmaxf(minX, 0.0f)) - RAYPALS_RETAINED_PADDING, (int)floorf(fmaxf(minY, 0.0f)) - RAYPALS_RETAINED_PADDING,
+        (int)ceilf(fminf(maxX, (float)width)) + RAYPALS_RETAINED_PADDING, (int)ceilf(fminf(maxY, (float)height)) + RAYPALS_RETAINED_PADDING
+    };
+    if (rect.x0 < 0) rect.x0 = 0;
+    if (rect.y0 < 0) rect.y0 = 0;
+    if (rect.x1 > width) rect.x1 = width;
+    if (rect.y1 > height) rect.y1 = height;
+    return rect;
 }
 
-RayPalsSprite* CreateSkeletonSprite(Vector2 position, float size, Color boneColor) {
-    RayPalsSprite* sprite = CreateSprite(8);
-    if (sprite == NULL) return NULL;
+// Adds a region to redraw, merging it with every region it overlaps so the list stays disjoint
+static void AddDirtyRect(RayPalsRetainedState* state, RayPalsPixelRect rect) {
+    if (IsPixelRectEmpty(rect)) return;
     
-    // Skull (circle)
-    RayPals2DShape* skull = CreateCircle((Vector2){ 0, -size*0.35f }, size*0.15f, boneColor);
-    skull->filled = false;
-    skull->thickness = 2.0f;
+    for (;;) {
+        bool merged = false;
+        for (int i = 0; i < state->rectCount; i++) {
+            if (!PixelRectsOverlap(state->rects[i], rect)) continue;
+            
+            rect = UnionPixelRects(rect, state->rects[i]);
+            state->rects[i] = state->rects[--state->rectCount];
+            merged = true;
+            break;
+        }
+        if (merged) continue;
+        
+        if (state->rectCount < RAYPALS_RETAINED_MAX_RECTS) break;
+        
+        // Full list: fold the rectangle into the region whose union grows the least
+        int best = 0;
+        long long bestGrowth = 0;
+        for (int i = 0; i < state->rectCount; i++) {
+            long long growth = GetPixelRectArea(UnionPixelRects(rect, state->rects[i])) - GetPixelRectArea(state->rects[i]);
+            if (i == 0 || growth < bestGrowth) {
+                best = i;
+                bestGrowth = growth;
+            }
+        }
+        rect = UnionPixelRects(rect, state->rects[best]);
+        state->rects[best] = state->rects[--state->rectCount];
+    }
     
-    // Eye sockets (small circles)
-    RayPals2DShape* eyeLeft = CreateCircle((Vector2){ -size*0.06f, -size*0.36f }, size*0.03f, BLACK);
-    RayPals2DShape* eyeRight = CreateCircle((Vector2){ size*0.06f, -size*0.36f }, size*0.03f, BLACK);
+    state->rects[state->rectCount++] = rect;
+}
+
+static bool RetainedItemsMatch(const RayPalsRetainedItem* a, const RayPalsRetainedItem* b) {
+    return a->sprite == b->sprite && a->version == b->version && a->position.x == b->position.x && a->position.y == b->position.y &&
+           a->rotation == b->rotation && a->scale == b->scale && a->bounds.x0 == b->bounds.x0 && a->bounds.y0 == b->bounds.y0 &&
+           a->bounds.x1 == b->bounds.x1 && a->bounds.y1 == b->bounds.y1;
+}
+
+RayPalsRetainedScene* CreateRetainedScene(int width, int height, Color background) {
+    if (width <= 0 || height <= 0) return NULL;
     
-    // Body (rectangle)
-    RayPals2DShape* spine = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ size*0.05f, size*0.5f }, boneColor);
-    spine->filled = false;
-    spine->thickness = 2.0f;
+    RayPalsRetainedScene* scene = (RayPalsRetainedScene*)calloc(1, sizeof(RayPalsRetainedScene));
+    if (scene == NULL) return NULL;
     
-    // Ribcage (horizontal lines)
-    RayPals2DShape* ribcage = CreateRectangle((Vector2){ 0, -size*0.15f }, (Vector2){ size*0.3f, size*0.25f }, boneColor);
-    ribcage->filled = false;
-    ribcage->thickness = 2.0f;
+    scene->state = (RayPalsRetainedState*)calloc(1, sizeof(RayPalsRetainedState));
+    scene->target = LoadRenderTexture(width, height);
+    if (scene->state == NULL || scene->target.id == 0) {
+        FreeRetainedScene(scene);
+        return NULL;
+    }
     
-    // Arms
-    RayPals2DShape* armLeft = CreateRectangle((Vector2){ -size*0.2f, -size*0.1f }, (Vector2){ size*0.2f, size*0.05f }, boneColor);
-    armLeft->filled = false;
-    armLeft->thickness = 2.0f;
-    armLeft->rotation = 15.0f;
+    scene->background = background;
+    scene->camera.zoom = 1.0f;
+    scene->state->fullRedraw = true;
     
-    RayPals2DShape* armRight = CreateRectangle((Vector2){ size*0.2f, -size*0.1f }, (Vector2){ size*0.2f, size*0.05f }, boneColor);
-    armRight->filled = false;
-    armRight->thickness = 2.0f;
-    armRight->rotation = -15.0f;
+    return scene;
+}
+
+void SetRetainedSceneCamera(RayPalsRetainedScene* scene, Camera2D camera) {
+    if (!scene) return;
     
-    // Legs
-    RayPals2DShape* legLeft = CreateRectangle((Vector2){ -size*0.1f, size*0.3f }, (Vector2){ size*0.05f, size*0.3f }, boneColor);
-    legLeft->filled = false;
-    legLeft->thickness = 2.0f;
-    legLeft->rotation = -15.0f;
+    // Every pixel moves with the camera, so only a full redraw is correct
+    if (memcmp(&scene->camera, &camera, sizeof(Camera2D)) != 0) scene->state->fullRedraw = true;
+    scene->camera = camera;
+}
+
+void SetRetainedSceneBackground(RayPalsRetainedScene* scene, Color background) {
+    if (!scene || ColorIsEqual(scene->background, background)) return;
     
-    RayPals2DShape* legRight = CreateRectangle((Vector2){ size*0.1f, size*0.3f }, (Vector2){ size*0.05f, size*0.3f }, boneColor);
-    legRight->filled = false;
-    legRight->thickness = 2.0f;
-    legRight->rotation = 15.0f;
+    scene->background = background;
+    scene->state->fullRedraw = true;
+}
+
+void InvalidateRetainedScene(RayPalsRetainedScene* scene) {
+    if (scene) scene->state->fullRedraw = true;
+}
+
+void InvalidateRetainedRect(RayPalsRetainedScene* scene, Rectangle rect) {
+    if (!scene) return;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, skull);
-    AddShapeToSprite(sprite, eyeLeft);
-    AddShapeToSprite(sprite, eyeRight);
-    AddShapeToSprite(sprite, spine);
-    AddShapeToSprite(sprite, ribcage);
-    AddShapeToSprite(sprite, armLeft);
-    AddShapeToSprite(sprite, armRight);
-    AddShapeToSprite(sprite, legLeft);
-    AddShapeToSprite(sprite, legRight);
+    RayPalsPixelRect pixels = {
+        (int)floorf(rect.x), (int)floorf(rect.y), (int)ceilf(rect.x + rect.width), (int)ceilf(rect.y + rect.height)
+    };
+    if (pixels.x0 < 0) pixels.x0 = 0;
+    if (pixels.y0 < 0) pixels.y0 = 0;
+    if (pixels.x1 > scene->target.texture.width) pixels.x1 = scene->target.texture.width;
+    if (pixels.y1 > scene->target.texture.height) pixels.y1 = scene->target.texture.height;
+    AddDirtyRect(scene->state, pixels);
+}
+
+void BeginRetainedScene(RayPalsRetainedScene* scene) {
+    if (scene) scene->state->currentCount = 0;
+}
+
+void DrawSpriteRetained(RayPalsRetainedScene* scene, RayPalsSprite* sprite) {
+    if (!scene || !sprite) return;
     
-    // Set sprite position
-    sprite->position = position;
+    RayPalsRetainedState* state = scene->state;
+    if (state->currentCount == state->capacity) {
+        int newCapacity = state->capacity > 0 ? state->capacity * 2 : 64;
+        RayPalsRetainedItem* newPrevious = (RayPalsRetainedItem*)realloc(state->previous, sizeof(RayPalsRetainedItem) * newCapacity);
+        if (newPrevious != NULL) state->previous = newPrevious;
+        RayPalsRetainedItem* newCurrent = (RayPalsRetainedItem*)realloc(state->current, sizeof(RayPalsRetainedItem) * newCapacity);
+        if (newCurrent != NULL) state->current = newCurrent;
+        
+        // Without room the sprite cannot be tracked; redraw everything so it still shows
+        if (newPrevious == NULL || newCurrent == NULL) {
+            state->fullRedraw = true;
+            return;
+        }
+        state->capacity = newCapacity;
+    }
     
-    return sprite;
+    // Versions are compared with the last frame's, so drawing the sprite elsewhere in
+    // between (which rebuilds its cache) cannot hide an edit
+    RayPalsRetainedItem* item = &state->current[state->currentCount++];
+    item->sprite = sprite;
+    item->position = sprite->position;
+    item->rotation = sprite->rotation;
+    item->scale = sprite->scale;
+    item->version = GetSpriteContentVersion(sprite);
+    item->bounds = sprite->visible ? GetScreenPixelRect(GetSpriteBounds(sprite), scene->camera,
+                                                         scene->target.texture.width, scene->target.texture.height)
+                                   : (RayPalsPixelRect){ 0 };
 }
 
-RayPalsSprite* CreateWaterfallSprite(Vector2 position, float width, float height, Color color) {
-    const int maxDrops = 30; // Maximum number of water drops
-    RayPalsSprite* sprite = CreateSprite(maxDrops);
-    if (sprite == NULL) return NULL;
+void EndRetainedScene(RayPalsRetainedScene* scene) {
+    if (!scene) return;
     
-    // Calculate number of drops per row and spacing
-    int dropsPerRow = 5;
-    float dropSize = width / (dropsPerRow * 1.5f);
-    float horizontalSpacing = width / dropsPerRow;
-    float verticalSpacing = dropSize * 1.2f;
-    int rows = (int)(height / verticalSpacing) + 1;
+    RayPalsRetainedState* state = scene->state;
+    int width = scene->target.texture.width;
+    int height = scene->target.texture.height;
+    
+    // Sprites are matched by submission order; a mismatch dirties both the old and new area
+    if (state->fullRedraw) {
+        state->rectCount = 0;
+        AddDirtyRect(state, (RayPalsPixelRect){ 0, 0, width, height });
+    } else {
+        int count = state->currentCount > state->previousCount ? state->currentCount : state->previousCount;
+        for (int i = 0; i < count; i++) {
+            const RayPalsRetainedItem* before = i < state->previousCount ? &state->previous[i] : NULL;
+            const RayPalsRetainedItem* after = i < state->currentCount ? &state->current[i] : NULL;
+            if (before != NULL && after != NULL && RetainedItemsMatch(before, after)) continue;
+            
+            if (before != NULL) AddDirtyRect(state, before->bounds);
+            if (after != NULL) AddDirtyRect(state, after->bounds);
+        }
+    }
     
-    // Add randomness to positions for natural look
-    srand(time(NULL));
+    scene->stats.sprites = state->currentCount;
+    scene->stats.dirtyRects = state->rectCount;
+    scene->stats.redrawnPixels = 0;
+    scene->stats.redrawnSprites = 0;
     
-    // Create multiple drops in a waterfall pattern
-    for (int row = 0; row < rows; row++) {
-        for (int col = 0; col < dropsPerRow; col++) {
-            // Add some randomness to positioning
-            float offsetX = ((float)rand() / RAND_MAX - 0.5f) * (horizontalSpacing * 0.4f);
-            float offsetY = ((float)rand() / RAND_MAX - 0.5f) * (verticalSpacing * 0.4f);
-            
-            // Calculate position of this drop
-            Vector2 dropPos = {
-                -width/2 + col * horizontalSpacing + horizontalSpacing/2 + offsetX,
-                -height/2 + row * verticalSpacing + offsetY
-            };
+    if (state->rectCount > 0) {
+        BeginTextureMode(scene->target);
+        
+        for (int r = 0; r < state->rectCount; r++) {
+            RayPalsPixelRect rect = state->rects[r];
+            scene->stats.redrawnPixels += GetPixelRectArea(rect);
             
-            // Create smaller drops higher up, larger drops lower down
-            float sizeVariation = 0.6f + 0.4f * (float)row / rows;
-            float thisDropSize = dropSize * sizeVariation;
+            // The clear honors the scissor box, so only this region is reset
+            BeginScissorMode(rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0);
+            ClearBackground(scene->background);
+            BeginMode2D(scene->camera);
             
-            // Vary color slightly for visual interest
-            Color dropColor = color;
-            dropColor.a = (unsigned char)(200 + ((float)rand() / RAND_MAX) * 55);
+            for (int i = 0; i < state->currentCount; i++) {
+                const RayPalsRetainedItem* item = &state->current[i];
+                if (!PixelRectsOverlap(item->bounds, rect)) continue;
+                
+                DrawSprite(item->sprite);
+                scene->stats.redrawnSprites++;
+            }
             
-            // Create the water drop and add it to the sprite
-            RayPals2DShape* drop = CreateWaterDrop(dropPos, thisDropSize, 0.0f, dropColor);
-            AddShapeToSprite(sprite, drop);
+            EndMode2D();
+            EndScissorMode();
         }
+        
+        EndTextureMode();
     }
     
-    // Set sprite position
-    sprite->position = position;
+    // This frame's submissions become the reference for the next one
+    RayPalsRetainedItem* swap = state->previous;
+    state->previous = state->current;
+    state->current = swap;
+    state->previousCount = state->currentCount;
+    state->currentCount = 0;
+    state->rectCount = 0;
+    state->fullRedraw = false;
+}
+
+void DrawRetainedScene(const RayPalsRetainedScene* scene, Vector2 position) {
+    if (!scene) return;
     
-    return sprite;
+    // Render textures are stored bottom-up, so the source is flipped vertically
+    Rectangle source = { 0, 0, (float)scene->target.texture.width, -(float)scene->target.texture.height };
+    DrawTextureRec(scene->target.texture, source, position, WHITE);
 }
 
-RayPalsSprite* CreateApple(Vector2 position, float size, Color color, Color stemColor) {
-    RayPalsSprite* sprite = CreateSprite(3);
-    if (!sprite) return NULL;
+void FreeRetainedScene(RayPalsRetainedScene* scene) {
+    if (!scene) return;
+    
+    if (scene->state != NULL) {
+        free(scene->state->previous);
+        free(scene->state->current);
+        free(scene->state);
+    }
+    if (scene->target.id != 0) UnloadRenderTexture(scene->target);
+    free(scene);
+}
 
-    // Main apple body (circle)
-    RayPals2DShape* body = CreateCircle((Vector2){0, 0}, size, color);
-    AddShapeToSprite(sprite, body);
+// ----------------------------------------------------------------------------
+// Render Queue Functions
+// ----------------------------------------------------------------------------
 
-    // Stem (rectangle)
-    RayPals2DShape* stem = CreateRectangle((Vector2){0, -size/2}, (Vector2){size/8, size/3}, stemColor);
-    AddShapeToSprite(sprite, stem);
+struct RayPalsQueueItem {
+    RayPalsSprite* sprite;            // NULL for instances
+    RayPalsSpriteInstance instance;   // Copied at submission
+    RayPalsBlendMode blend;
+};
+
+// Float bits reordered so that unsigned comparison matches float order, then inverted
+// so that the farthest depth has the smallest key
+static unsigned int GetDepthSortBits(float depth) {
+    unsigned int bits;
+    memcpy(&bits, &depth, sizeof(bits));
+    bits = (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+    return ~bits;
+}
 
-    // Leaf (triangle)
-    RayPals2DShape* leaf = CreateTriangle((Vector2){size/4, -size/2}, size/4, stemColor);
-    SetShapeRotation(leaf, 45.0f);
-    AddShapeToSprite(sprite, leaf);
+// Draw state in the given number of bits: 0 for sprites, a template hash with the top bit set for instances
+static unsigned int GetQueueState(const RayPalsSpriteTemplate* spriteTemplate, int bits) {
+    if (spriteTemplate == NULL) return 0;
+    
+    unsigned long long address = (uintptr_t)spriteTemplate;
+    unsigned int hash = (unsigned int)((address >> 4) ^ (address >> 32)) * 2654435761u;
+    return (1u << (bits - 1)) | (hash >> (33 - bits));
+}
 
-    SetSpritePosition(sprite, position);
-    return sprite;
+static unsigned long long MakeQueueKey(int layer, float depth, RayPalsBlendMode blend, const RayPalsSpriteTemplate* spriteTemplate) {
+    if (layer < 0) layer = 0;
+    if (layer > 255) layer = 255;
+    
+    unsigned long long key = (unsigned long long)layer << 56;
+    unsigned long long depthBits = GetDepthSortBits(depth);
+    
+    if (blend == RAYPALS_BLEND_OPAQUE) {
+        return key | (unsigned long long)GetQueueState(spriteTemplate, 23) << 32 | depthBits;
+    }
+    return key | 1ull << 55 | depthBits << 23 | (unsigned long long)((blend - 1) & 3) << 21 | GetQueueState(spriteTemplate, 21);
 }
 
-RayPalsSprite* CreateBanana(Vector2 position, float size, Color color, Color stemColor) {
-    RayPalsSprite* sprite = CreateSprite(3);
-    if (!sprite) return NULL;
+static bool ReserveRenderQueue(RayPalsRenderQueue* queue, int required) {
+    if (required <= queue->capacity) return true;
+    
+    int newCapacity = queue->capacity > 0 ? queue->capacity * 2 : 256;
+    if (newCapacity < required) newCapacity = required;
+    
+    RayPalsQueueItem* items = (RayPalsQueueItem*)realloc(queue->items, sizeof(RayPalsQueueItem) * newCapacity);
+    if (items == NULL) return false;
+    queue->items = items;
+    
+    RayPalsQueueKey* order = (RayPalsQueueKey*)realloc(queue->order, sizeof(RayPalsQueueKey) * newCapacity);
+    if (order == NULL) return false;
+    queue->order = order;
+    
+    RayPalsQueueKey* scratch = (RayPalsQueueKey*)realloc(queue->scratch, sizeof(RayPalsQueueKey) * newCapacity);
+    if (scratch == NULL) return false;
+    queue->scratch = scratch;
+    
+    queue->capacity = newCapacity;
+    return true;
+}
 
-    // Main banana body (rectangle with rounded ends)
-    RayPals2DShape* body = CreateRectangle((Vector2){0, 0}, (Vector2){size, size/3}, color);
-    AddShapeToSprite(sprite, body);
+static void QueueItem(RayPalsRenderQueue* queue, const RayPalsQueueItem* item, unsigned long long key) {
+    if (queue->count == queue->capacity && !ReserveRenderQueue(queue, queue->count + 1)) return;
+    
+    queue->items[queue->count] = *item;
+    queue->order[queue->count] = (RayPalsQueueKey){ key, queue->count };
+    queue->count++;
+    queue->sorted = false;
+}
 
-    // Stem (rectangle)
-    RayPals2DShape* stem = CreateRectangle((Vector2){-size/2, -size/6}, (Vector2){size/8, size/4}, stemColor);
-    AddShapeToSprite(sprite, stem);
+RayPalsRenderQueue* CreateRenderQueue(int capacity) {
+    RayPalsRenderQueue* queue = (RayPalsRenderQueue*)calloc(1, sizeof(RayPalsRenderQueue));
+    if (queue == NULL) return NULL;
+    
+    if (capacity > 0 && !ReserveRenderQueue(queue, capacity)) {
+        FreeRenderQueue(queue);
+        return NULL;
+    }
+    return queue;
+}
 
-    // Curve (triangle for banana curve)
-    RayPals2DShape* curve = CreateTriangle((Vector2){size/4, 0}, size/4, color);
-    SetShapeRotation(curve, 30.0f);
-    AddShapeToSprite(sprite, curve);
+void QueueSprite(RayPalsRenderQueue* queue, RayPalsSprite* sprite, int layer, float depth, RayPalsBlendMode blend) {
+    if (!queue || !sprite || !sprite->visible) return;
+    
+    RayPalsQueueItem item = { 0 };
+    item.sprite = sprite;
+    item.blend = blend;
+    QueueItem(queue, &item, MakeQueueKey(layer, depth, blend, NULL));
+}
 
-    SetSpritePosition(sprite, position);
-    return sprite;
+void QueueSpriteInstance(RayPalsRenderQueue* queue, const RayPalsSpriteInstance* instance, int layer, float depth, RayPalsBlendMode blend) {
+    if (!queue || !instance || !instance->visible || !instance->spriteTemplate) return;
+    
+    RayPalsQueueItem item = { 0 };
+    item.instance = *instance;
+    item.blend = blend;
+    QueueItem(queue, &item, MakeQueueKey(layer, depth, blend, instance->spriteTemplate));
 }
 
-RayPalsSprite* CreateOrange(Vector2 position, float size, Color color, Color stemColor) {
-    RayPalsSprite* sprite = CreateSprite(3);
-    if (!sprite) return NULL;
+// LSD radix sort on 8-bit digits. All histograms come from one read of the keys, and
+// digits every key shares (usually most of the layer and state bits) are skipped.
+void SortRenderQueue(RayPalsRenderQueue* queue) {
+    if (!queue || queue->sorted) return;
+    
+    int count = queue->count;
+    int histograms[8][256];
+    memset(histograms, 0, sizeof(histograms));
+    
+    for (int i = 0; i < count; i++) {
+        unsigned long long key = queue->order[i].key;
+        for (int digit = 0; digit < 8; digit++) histograms[digit][(key >> (digit*8)) & 0xFF]++;
+    }
+    
+    queue->stats.sortPasses = 0;
+    for (int digit = 0; digit < 8 && count > 1; digit++) {
+        int* histogram = histograms[digit];
+        if (histogram[(queue->order[0].key >> (digit*8)) & 0xFF] == count) continue;
+        
+        int offset = 0;
+        for (int bucket = 0; bucket < 256; bucket++) {
+            int bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        
+        for (int i = 0; i < count; i++) {
+            RayPalsQueueKey entry = queue->order[i];
+            queue->scratch[histogram[(entry.key >> (digit*8)) & 0xFF]++] = entry;
+        }
+        
+        RayPalsQueueKey* swap = queue->order;
+        queue->order = queue->scratch;
+        queue->scratch = swap;
+        queue->stats.sortPasses++;
+    }
+    
+    queue->sorted = true;
+}
 
-    // Main orange body (circle)
-    RayPals2DShape* body = CreateCircle((Vector2){0, 0}, size, color);
-    AddShapeToSprite(sprite, body);
+void FlushRenderQueue(RayPalsRenderQueue* queue) {
+    if (!queue) return;
+    
+    SortRenderQueue(queue);
+    
+    // Bring every cache up to date first so the triangle runs are not interrupted
+    float viewScale = lodSettings.enabled ? GetCurrentViewScale() : 0.0f;
+    for (int i = 0; i < queue->count; i++) {
+        RayPalsQueueItem* item = &queue->items[i];
+        if (item->sprite != NULL) {
+            UpdateSpriteCache(item->sprite, GetLODBucket(viewScale * item->sprite->scale));
+        } else if (item->instance.spriteTemplate->cache != NULL) {
+            GetTemplateCache(item->instance.spriteTemplate, GetLODBucket(viewScale * item->instance.scale));
+        }
+    }
+    
+    queue->stats.items = 0;
+    queue->stats.blendChanges = 0;
+    int mode = BLEND_ALPHA;
+    bool open = false;
+    
+    for (int i = 0; i < queue->count; i++) {
+        const RayPalsQueueItem* item = &queue->items[queue->order[i].item];
+        
+        int itemMode = item->blend == RAYPALS_BLEND_ADDITIVE ? BLEND_ADDITIVE :
+                       item->blend == RAYPALS_BLEND_MULTIPLIED ? BLEND_MULTIPLIED : BLEND_ALPHA;
+        if (itemMode != mode) {
+            if (open) {
+                rlEnd();
+                drawStats.batches++;
+                open = false;
+            }
+            BeginBlendMode(itemMode);
+            drawStats.flushes++;
+            mode = itemMode;
+            queue->stats.blendChanges++;
+        }
+        
+        // Items whose cache could not be allocated are drawn the immediate way between runs
+        RayPalsSprite* sprite = item->sprite;
+        bool cached = sprite != NULL ? !IsSpriteCacheStale(sprite) : item->instance.spriteTemplate->cache != NULL;
+        if (!cached) {
+            if (open) {
+                rlEnd();
+                drawStats.batches++;
+                open = false;
+            }
+            if (sprite != NULL) DrawSprite(sprite);
+            else DrawSpriteInstance(&item->instance);
+            queue->stats.items++;
+            continue;
+        }
+        
+        if (!open) {
+            rlBegin(RL_TRIANGLES);
+            open = true;
+        }
+        
+        if (sprite != NULL) {
+            EmitSpriteCache(sprite->cache, RefreshSpriteMatrix(sprite), WHITE);
+        } else {
+            const RayPalsSpriteInstance* instance = &item->instance;
+            RayPalsSpriteCache* cache = GetTemplateCache(instance->spriteTemplate, GetLODBucket(viewScale * instance->scale));
+            Matrix transform = MakeSpriteMatrix(instance->position, instance->rotation, instance->scale);
+            EmitSpriteCache(cache, &transform, instance->tint);
+        }
+        drawStats.sprites++;
+        queue->stats.items++;
+    }
+    
+    if (open) {
+        rlEnd();
+        drawStats.batches++;
+    }
+    if (mode != BLEND_ALPHA) {
+        EndBlendMode();
+        drawStats.flushes++;
+    }
+    
+    queue->count = 0;
+    queue->sorted = false;
+}
 
-    // Stem (rectangle)
-    RayPals2DShape* stem = CreateRectangle((Vector2){0, -size/2}, (Vector2){size/8, size/4}, stemColor);
-    AddShapeToSprite(sprite, stem);
+void ClearRenderQueue(RayPalsRenderQueue* queue) {
+    if (!queue) return;
+    
+    queue->count = 0;
+    queue->sorted = false;
+}
 
-    // Leaf (triangle)
-    RayPals2DShape* leaf = CreateTriangle((Vector2){size/4, -size/2}, size/4, stemColor);
-    SetShapeRotation(leaf, 45.0f);
-    AddShapeToSprite(sprite, leaf);
+void FreeRenderQueue(RayPalsRenderQueue* queue) {
+    if (!queue) return;
+    
+    free(queue->items);
+    free(queue->order);
+    free(queue->scratch);
+    free(queue);
+}
 
-    SetSpritePosition(sprite, position);
-    return sprite;
+// ----------------------------------------------------------------------------
+// Static 3D Batch Functions
+// ----------------------------------------------------------------------------
+
+// Vertices of one color and primitive mode, already in world space
+struct RayPalsStaticGroup {
+    Color color;
+    int mode;                  // RL_TRIANGLES or RL_LINES
+    int count;                 // Vertices in the group
+    Vector3* vertices;
+    Vector3* normals;
+};
+
+// Unit mesh a sprite shape contributes to a static batch (NULL if it contributes nothing)
+static const RayPalsUnitMesh* GetStaticShapeMesh(const RayPals3DShape* shape) {
+    if (!shape || !shape->visible) return NULL;
+    return Get3DUnitMesh(shape->type, shape->segments, shape->wireframe);
 }
 
-RayPalsSprite* CreateWatermelon(Vector2 position, float size, Color rindColor, Color fleshColor, Color seedColor) {
-    RayPalsSprite* sprite = CreateSprite(5);
-    if (!sprite) return NULL;
+static int FindStaticGroup(const RayPals3DStaticBatch* batch, Color color, int mode) {
+    for (int g = 0; g < batch->groupCount; g++) {
+        const RayPalsStaticGroup* group = &batch->groups[g];
+        if (group->mode == mode && group->color.r == color.r && group->color.g == color.g &&
+            group->color.b == color.b && group->color.a == color.a) return g;
+    }
+    return -1;
+}
 
-    // Main watermelon body (circle)
-    RayPals2DShape* body = CreateCircle((Vector2){0, 0}, size, rindColor);
-    AddShapeToSprite(sprite, body);
+// Transforms a shape's unit mesh into a group starting at vertex index at, using the
+// shape's cached world matrix under its sprite
+static void WriteStaticShape(RayPalsStaticGroup* group, int at, RayPals3DSprite* sprite,
+                             RayPals3DShape* shape, const RayPalsUnitMesh* mesh) {
+    const Matrix* world = Refresh3DShapeWorldMatrix(shape, sprite);
+    Matrix normalMatrix = GetNormalMatrix(world);
+    
+    Vector3* vertices = group->vertices + at;
+    Vector3* normals = group->normals + at;
+    for (int i = 0; i < mesh->vertexCount; i++) {
+        vertices[i] = TransformPoint(world, mesh->vertices[i]);
+        
+        Vector3 normal = TransformDirection(&normalMatrix, mesh->normals[i]);
+        float length = sqrtf(normal.x*normal.x + normal.y*normal.y + normal.z*normal.z);
+        if (length > 0.0f) normal = (Vector3){ normal.x/length, normal.y/length, normal.z/length };
+        normals[i] = normal;
+    }
+}
 
-    // Flesh (slightly smaller circle)
-    RayPals2DShape* flesh = CreateCircle((Vector2){0, 0}, size * 0.9f, fleshColor);
-    AddShapeToSprite(sprite, flesh);
+static void ReleaseStaticGroups(RayPals3DStaticBatch* batch) {
+    for (int g = 0; g < batch->groupCount; g++) {
+        free(batch->groups[g].vertices);
+        free(batch->groups[g].normals);
+    }
+    free(batch->groups);
+    free(batch->spans);
+    batch->groups = NULL;
+    batch->spans = NULL;
+    batch->groupCount = 0;
+    batch->vertexCount = 0;
+}
 
-    // Seeds (small circles)
-    RayPals2DShape* seed1 = CreateCircle((Vector2){size/4, size/4}, size/8, seedColor);
-    RayPals2DShape* seed2 = CreateCircle((Vector2){-size/4, -size/4}, size/8, seedColor);
-    RayPals2DShape* seed3 = CreateCircle((Vector2){size/4, -size/4}, size/8, seedColor);
-    AddShapeToSprite(sprite, seed1);
-    AddShapeToSprite(sprite, seed2);
-    AddShapeToSprite(sprite, seed3);
+// Lays out every group from scratch: each sprite gets one contiguous range per group,
+// in sprite order, recorded in spans as (first vertex, count) pairs
+static bool RebakeStaticBatch(RayPals3DStaticBatch* batch) {
+    ReleaseStaticGroups(batch);
+    batch->rebuilds++;
+    
+    // First pass discovers the groups and their sizes
+    int groupCapacity = 0;
+    for (int s = 0; s < batch->spriteCount; s++) {
+        const RayPals3DSprite* sprite = batch->sprites[s];
+        if (!sprite || !sprite->visible) continue;
+        
+        for (int i = 0; i < sprite->shapeCount; i++) {
+            const RayPalsUnitMesh* mesh = GetStaticShapeMesh(sprite->shapes[i]);
+            if (mesh == NULL) continue;
+            
+            int g = FindStaticGroup(batch, sprite->shapes[i]->color, mesh->mode);
+            if (g < 0) {
+                if (batch->groupCount == groupCapacity) {
+                    int capacity = groupCapacity > 0 ? groupCapacity * 2 : 8;
+                    RayPalsStaticGroup* groups = (RayPalsStaticGroup*)realloc(batch->groups, sizeof(RayPalsStaticGroup) * capacity);
+                    if (groups == NULL) {
+                        ReleaseStaticGroups(batch);
+                        return false;
+                    }
+                    batch->groups = groups;
+                    groupCapacity = capacity;
+                }
+                g = batch->groupCount++;
+                batch->groups[g] = (RayPalsStaticGroup){ sprite->shapes[i]->color, mesh->mode, 0, NULL, NULL };
+            }
+            batch->groups[g].count += mesh->vertexCount;
+        }
+    }
+    
+    batch->spans = (int*)calloc((size_t)batch->spriteCount * batch->groupCount * 2 + 1, sizeof(int));
+    if (batch->spans == NULL) {
+        ReleaseStaticGroups(batch);
+        return false;
+    }
+    
+    for (int g = 0; g < batch->groupCount; g++) {
+        RayPalsStaticGroup* group = &batch->groups[g];
+        group->vertices = (Vector3*)malloc(sizeof(Vector3) * (group->count + 1));
+        group->normals = (Vector3*)malloc(sizeof(Vector3) * (group->count + 1));
+        if (group->vertices == NULL || group->normals == NULL) {
+            ReleaseStaticGroups(batch);
+            return false;
+        }
+        batch->vertexCount += group->count;
+    }
+    for (int g = 0; g < batch->groupCount; g++) batch->groups[g].count = 0;   // Reused as write cursors below
+    
+    // Second pass transforms the shapes into place
+    for (int s = 0; s < batch->spriteCount; s++) {
+        RayPals3DSprite* sprite = batch->sprites[s];
+        int* spans = batch->spans + (size_t)s * batch->groupCount * 2;
+        for (int g = 0; g < batch->groupCount; g++) spans[g*2] = batch->groups[g].count;
+        if (!sprite || !sprite->visible) continue;
+        
+        for (int i = 0; i < sprite->shapeCount; i++) {
+            const RayPalsUnitMesh* mesh = GetStaticShapeMesh(sprite->shapes[i]);
+            if (mesh == NULL) continue;
+            
+            RayPalsStaticGroup* group = &batch->groups[FindStaticGroup(batch, sprite->shapes[i]->color, mesh->mode)];
+            WriteStaticShape(group, group->count, sprite, sprite->shapes[i], mesh);
+            group->count += mesh->vertexCount;
+        }
+        
+        for (int g = 0; g < batch->groupCount; g++) spans[g*2 + 1] = batch->groups[g].count - spans[g*2];
+    }
+    
+    return true;
+}
 
-    SetSpritePosition(sprite, position);
-    return sprite;
+RayPals3DStaticBatch* Create3DStaticBatch(RayPals3DSprite** sprites, int count) {
+    if (count < 0 || (count > 0 && !sprites)) return NULL;
+    
+    RayPals3DStaticBatch* batch = (RayPals3DStaticBatch*)calloc(1, sizeof(RayPals3DStaticBatch));
+    if (batch == NULL) return NULL;
+    
+    batch->sprites = (RayPals3DSprite**)malloc(sizeof(RayPals3DSprite*) * (count + 1));
+    if (batch->sprites == NULL) {
+        free(batch);
+        return NULL;
+    }
+    if (count > 0) memcpy(batch->sprites, sprites, sizeof(RayPals3DSprite*) * count);
+    batch->spriteCount = count;
+    
+    if (!RebakeStaticBatch(batch)) {
+        Free3DStaticBatch(batch);
+        return NULL;
+    }
+    return batch;
 }
 
-RayPalsSprite* CreateGrape(Vector2 position, float size, Color color, Color stemColor) {
-    RayPalsSprite* sprite = CreateSprite(3);
-    if (!sprite) return NULL;
+bool Update3DStaticBatch(RayPals3DStaticBatch* batch, int index) {
+    if (!batch || index < 0 || index >= batch->spriteCount) return false;
+    
+    RayPals3DSprite* sprite = batch->sprites[index];
+    const int* spans = batch->spans + (size_t)index * batch->groupCount * 2;
+    bool baked = sprite && sprite->visible;
+    
+    // The sprite can be rewritten in place only if it still fills exactly its old ranges
+    int* counts = (int*)calloc(batch->groupCount + 1, sizeof(int));
+    if (counts == NULL) return RebakeStaticBatch(batch);
+    
+    bool inPlace = true;
+    for (int i = 0; baked && inPlace && i < sprite->shapeCount; i++) {
+        const RayPalsUnitMesh* mesh = GetStaticShapeMesh(sprite->shapes[i]);
+        if (mesh == NULL) continue;
+        
+        int g = FindStaticGroup(batch, sprite->shapes[i]->color, mesh->mode);
+        if (g < 0) inPlace = false;
+        else counts[g] += mesh->vertexCount;
+    }
+    for (int g = 0; inPlace && g < batch->groupCount; g++) inPlace = counts[g] == spans[g*2 + 1];
+    
+    if (!inPlace) {
+        free(counts);
+        return RebakeStaticBatch(batch);
+    }
+    
+    // Same layout: the counts become write cursors into the sprite's ranges
+    for (int g = 0; g < batch->groupCount; g++) counts[g] = spans[g*2];
+    
+    for (int i = 0; baked && i < sprite->shapeCount; i++) {
+        const RayPalsUnitMesh* mesh = GetStaticShapeMesh(sprite->shapes[i]);
+        if (mesh == NULL) continue;
+        
+        int g = FindStaticGroup(batch, sprite->shapes[i]->color, mesh->mode);
+        WriteStaticShape(&batch->groups[g], counts[g], sprite, sprite->shapes[i], mesh);
+        counts[g] += mesh->vertexCount;
+    }
+    
+    free(counts);
+    batch->updates++;
+    return true;
+}
 
-    // Main grape body (circle)
-    RayPals2DShape* body = CreateCircle((Vector2){0, 0}, size, color);
-    AddShapeToSprite(sprite, body);
+bool Rebuild3DStaticBatch(RayPals3DStaticBatch* batch) {
+    if (!batch) return false;
+    return RebakeStaticBatch(batch);
+}
 
-    // Stem (rectangle)
-    RayPals2DShape* stem = CreateRectangle((Vector2){0, -size/2}, (Vector2){size/8, size/3}, stemColor);
-    AddShapeToSprite(sprite, stem);
+void Draw3DStaticBatch(RayPals3DStaticBatch* batch) {
+    if (!batch) return;
+    
+    for (int g = 0; g < batch->groupCount; g++) {
+        const RayPalsStaticGroup* group = &batch->groups[g];
+        if (group->count == 0) continue;
+        
+        rlBegin(group->mode);
+        rlColor4ub(group->color.r, group->color.g, group->color.b, group->color.a);
+        
+        for (int base = 0; base < group->count; base += RAYPALS_CACHE_CHUNK) {
+            int end = base + RAYPALS_CACHE_CHUNK;
+            if (end > group->count) end = group->count;
+            
+            // Shapes contribute whole primitives and the chunk is a multiple of 6
+            CheckRenderBatchLimit(end - base);
+            
+            for (int i = base; i < end; i++) {
+                rlNormal3f(group->normals[i].x, group->normals[i].y, group->normals[i].z);
+                rlVertex3f(group->vertices[i].x, group->vertices[i].y, group->vertices[i].z);
+            }
+        }
+        
+        rlEnd();
+        drawStats.vertices += group->count;
+        drawStats.batches++;
+        if (group->mode == RL_TRIANGLES) Count3DTriangles(group->count / 3);
+    }
+}
 
-    // Highlight (small circle)
-    RayPals2DShape* highlight = CreateCircle((Vector2){-size/4, -size/4}, size/4, (Color){255, 255, 255, 128});
-    AddShapeToSprite(sprite, highlight);
+void Free3DStaticBatch(RayPals3DStaticBatch* batch) {
+    if (!batch) return;
+    
+    ReleaseStaticGroups(batch);
+    free(batch->sprites);
+    free(batch);
+}
 
-    SetSpritePosition(sprite, position);
-    return sprite;
+// ----------------------------------------------------------------------------
+// Frustum Culling Functions
+// ----------------------------------------------------------------------------
+
+// Same view matrix as raylib's GetCameraMatrix (MatrixLookAt)
+static Matrix GetCameraViewMatrix(Camera camera) {
+    Vector3 eye = camera.position;
+    Vector3 z = { eye.x - camera.target.x, eye.y - camera.target.y, eye.z - camera.target.z };
+    float length = sqrtf(z.x*z.x + z.y*z.y + z.z*z.z);
+    if (length > 0.0f) z = (Vector3){ z.x/length, z.y/length, z.z/length };
+    
+    Vector3 up = camera.up;
+    Vector3 x = { up.y*z.z - up.z*z.y, up.z*z.x - up.x*z.z, up.x*z.y - up.y*z.x };
+    length = sqrtf(x.x*x.x + x.y*x.y + x.z*x.z);
+    if (length > 0.0f) x = (Vector3){ x.x/length, x.y/length, x.z/length };
+    
+    Vector3 y = { z.y*x.z - z.z*x.y, z.z*x.x - z.x*x.z, z.x*x.y - z.y*x.x };
+    
+    Matrix view = { 0 };
+    view.m0 = x.x;  view.m4 = x.y;  view.m8 = x.z;   view.m12 = -(x.x*eye.x + x.y*eye.y + x.z*eye.z);
+    view.m1 = y.x;  view.m5 = y.y;  view.m9 = y.z;   view.m13 = -(y.x*eye.x + y.y*eye.y + y.z*eye.z);
+    view.m2 = z.x;  view.m6 = z.y;  view.m10 = z.z;  view.m14 = -(z.x*eye.x + z.y*eye.y + z.z*eye.z);
+    view.m15 = 1.0f;
+    return view;
 }
 
-RayPalsSprite* CreateGrapes(Vector2 position, float size, Color color, Color stemColor) {
-    RayPalsSprite* sprite = CreateSprite(9);  // Capacity for main stem and 8 grapes
-    if (!sprite) return NULL;
+static Vector4 ScaleAddRows(Vector4 a, float scaleA, Vector4 b, float scaleB) {
+    return (Vector4){ a.x*scaleA + b.x*scaleB, a.y*scaleA + b.y*scaleB, a.z*scaleA + b.z*scaleB, a.w*scaleA + b.w*scaleB };
+}
+
+// Gribb-Hartmann: the planes are sums and differences of the rows of projection * view
+RayPalsFrustum GetCameraFrustum(Camera camera) {
+    // BeginMode3D takes the aspect of the bound framebuffer, which inside BeginTextureMode
+    // is the render texture rather than the screen
+    float width = (float)rlGetFramebufferWidth(), height = (float)rlGetFramebufferHeight();
+    if (width <= 0.0f || height <= 0.0f) {
+        width = (float)GetScreenWidth();
+        height = (float)GetScreenHeight();
+    }
+    float aspect = height > 0.0f ? width / height : 1.0f;
+    float nearPlane = (float)rlGetCullDistanceNear();
+    float farPlane = (float)rlGetCullDistanceFar();
+    
+    Matrix view = GetCameraViewMatrix(camera);
+    Vector4 rows[4] = {
+        { view.m0, view.m4, view.m8, view.m12 },
+        { view.m1, view.m5, view.m9, view.m13 },
+        { view.m2, view.m6, view.m10, view.m14 },
+        { view.m3, view.m7, view.m11, view.m15 }
+    };
+    
+    // Rows of the projection BeginMode3D loads, multiplied into the view rows
+    Vector4 clip[4];
+    float depthScale, depthOffset;
+    if (camera.projection == CAMERA_ORTHOGRAPHIC) {
+        float top = camera.fovy / 2.0f;
+        clip[0] = ScaleAddRows(rows[0], 1.0f / (top*aspect), rows[3], 0.0f);
+        clip[1] = ScaleAddRows(rows[1], 1.0f / top, rows[3], 0.0f);
+        depthScale = -2.0f / (farPlane - nearPlane);
+        depthOffset = -(farPlane + nearPlane) / (farPlane - nearPlane);
+        clip[3] = rows[3];
+    } else {
+        float tangent = tanf(camera.fovy * 0.5f * DEG2RAD);
+        clip[0] = ScaleAddRows(rows[0], 1.0f / (tangent*aspect), rows[3], 0.0f);
+        clip[1] = ScaleAddRows(rows[1], 1.0f / tangent, rows[3], 0.0f);
+        depthScale = -(farPlane + nearPlane) / (farPlane - nearPlane);
+        depthOffset = -2.0f * farPlane * nearPlane / (farPlane - nearPlane);
+        clip[3] = ScaleAddRows(rows[2], -1.0f, rows[3], 0.0f);
+    }
+    clip[2] = ScaleAddRows(rows[2], depthScale, rows[3], depthOffset);
+    
+    RayPalsFrustum frustum;
+    for (int i = 0; i < 6; i++) {
+        Vector4 plane = ScaleAddRows(clip[3], 1.0f, clip[i / 2], (i % 2) ? -1.0f : 1.0f);
+        float length = sqrtf(plane.x*plane.x + plane.y*plane.y + plane.z*plane.z);
+        if (length > 0.0f) plane = ScaleAddRows(plane, 1.0f / length, plane, 0.0f);
+        frustum.planes[i] = plane;
+    }
+    return frustum;
+}
+
+// 1 if the sphere is inside every plane, -1 if outside one of them, 0 if it crosses
+static int ClassifyFrustumSphere(const RayPalsFrustum* frustum, Vector3 center, float radius) {
+    int result = 1;
+    for (int i = 0; i < 6; i++) {
+        Vector4 p = frustum->planes[i];
+        float distance = p.x*center.x + p.y*center.y + p.z*center.z + p.w;
+        if (distance < -radius) return -1;
+        if (distance < radius) result = 0;
+    }
+    return result;
+}
+
+// Same classification for a box: outside when its corner farthest along a plane normal
+// is behind the plane, inside when even the nearest corner is in front of every plane
+static int ClassifyFrustumBox(const RayPalsFrustum* frustum, const BoundingBox* box) {
+    int result = 1;
+    for (int i = 0; i < 6; i++) {
+        Vector4 p = frustum->planes[i];
+        float farX = p.x >= 0.0f ? box->max.x : box->min.x, nearX = p.x >= 0.0f ? box->min.x : box->max.x;
+        float farY = p.y >= 0.0f ? box->max.y : box->min.y, nearY = p.y >= 0.0f ? box->min.y : box->max.y;
+        float farZ = p.z >= 0.0f ? box->max.z : box->min.z, nearZ = p.z >= 0.0f ? box->min.z : box->max.z;
+        if (p.x*farX + p.y*farY + p.z*farZ + p.w < 0.0f) return -1;
+        if (p.x*nearX + p.y*nearY + p.z*nearZ + p.w < 0.0f) result = 0;
+    }
+    return result;
+}
+
+bool IsBoundsInFrustum(const RayPalsFrustum* frustum, RayPalsBounds3D bounds) {
+    if (!frustum) return true;
+    
+    int side = ClassifyFrustumSphere(frustum, bounds.center, bounds.radius);
+    if (side != 0) return side > 0;
+    return ClassifyFrustumBox(frustum, &bounds.box) >= 0;
+}
 
-    // Main stem (rectangle)
-    RayPals2DShape* stem = CreateRectangle((Vector2){0, -size/2}, (Vector2){size/8, size/3}, stemColor);
-    AddShapeToSprite(sprite, stem);
+// Draws a visible sprite unless its bounds are outside the frustum; returns whether it drew
+static bool DrawCulled3DSprite(RayPals3DSprite* sprite, const RayPalsFrustum* frustum, const Camera* camera) {
+    // Cached bounds reject the whole sprite before any shape is looked at
+    const RayPalsBounds3D* bounds = Refresh3DSpriteBounds(sprite);
+    int side = ClassifyFrustumSphere(frustum, bounds->center, bounds->radius);
+    if (side == 0) side = ClassifyFrustumBox(frustum, &bounds->box);
+    if (side < 0) {
+        drawStats.culled++;
+        return false;
+    }
+    
+    // Shape matrices and bounds are current after the sprite bounds refresh
+    for (int i = 0; i < sprite->shapeCount; i++) {
+        RayPals3DShape* shape = sprite->shapes[i];
+        if (!shape || !shape->visible) continue;
+        if (side == 0 && !IsBoundsInFrustum(frustum, shape->bounds)) continue;
+        
+        Draw3DShapeTransformed(shape, &shape->worldMatrix, camera);
+    }
+    
+    drawStats.sprites++;
+    return true;
+}
 
-    // Create individual grapes (just the body and highlight, no stems)
-    // Top row
-    RayPals2DShape* grape1 = CreateCircle((Vector2){-size/4, -size/4}, size/4, color);
-    RayPals2DShape* grape2 = CreateCircle((Vector2){0, -size/4}, size/4, color);
-    RayPals2DShape* grape3 = CreateCircle((Vector2){size/4, -size/4}, size/4, color);
+int Draw3DSpritesCulled(RayPals3DSprite** sprites, int count, Camera camera) {
+    if (!sprites || count <= 0) return 0;
     
-    // Middle row
-    RayPals2DShape* grape4 = CreateCircle((Vector2){-size/3, 0}, size/4, color);
-    RayPals2DShape* grape5 = CreateCircle((Vector2){0, 0}, size/4, color);
-    RayPals2DShape* grape6 = CreateCircle((Vector2){size/3, 0}, size/4, color);
+    RayPalsFrustum frustum = GetCameraFrustum(camera);
+    int drawn = 0;
     
-    // Bottom row
-    RayPals2DShape* grape7 = CreateCircle((Vector2){-size/4, size/4}, size/4, color);
-    RayPals2DShape* grape8 = CreateCircle((Vector2){size/4, size/4}, size/4, color);
+    for (int s = 0; s < count; s++) {
+        RayPals3DSprite* sprite = sprites[s];
+        if (!sprite || !sprite->visible) continue;
+        
+        if (DrawCulled3DSprite(sprite, &frustum, &camera)) drawn++;
+    }
+    
+    return drawn;
+}
 
-    // Add highlights to each grape
-    RayPals2DShape* highlight1 = CreateCircle((Vector2){-size/4 - size/8, -size/4 - size/8}, size/8, (Color){255, 255, 255, 128});
-    RayPals2DShape* highlight2 = CreateCircle((Vector2){-size/8, -size/4 - size/8}, size/8, (Color){255, 255, 255, 128});
-    RayPals2DShape* highlight3 = CreateCircle((Vector2){size/4 - size/8, -size/4 - size/8}, size/8, (Color){255, 255, 255, 128});
-    RayPals2DShape* highlight4 = CreateCircle((Vector2){-size/3 - size/8, -size/8}, size/8, (Color){255, 255, 255, 128});
-    RayPals2DShape* highlight5 = CreateCircle((Vector2){-size/8, -size/8}, size/8, (Color){255, 255, 255, 128});
-    RayPals2DShape* highlight6 = CreateCircle((Vector2){size/3 - size/8, -size/8}, size/8, (Color){255, 255, 255, 128});
-    RayPals2DShape* highlight7 = CreateCircle((Vector2){-size/4 - size/8, size/4 - size/8}, size/8, (Color){255, 255, 255, 128});
-    RayPals2DShape* highlight8 = CreateCircle((Vector2){size/4 - size/8, size/4 - size/8}, size/8, (Color){255, 255, 255, 128});
+// ----------------------------------------------------------------------------
+// Bounding Volume Hierarchy Functions
+// ----------------------------------------------------------------------------
 
-    // Add all grapes and highlights to the sprite
-    AddShapeToSprite(sprite, grape1);
-    AddShapeToSprite(sprite, grape2);
-    AddShapeToSprite(sprite, grape3);
-    AddShapeToSprite(sprite, grape4);
-    AddShapeToSprite(sprite, grape5);
-    AddShapeToSprite(sprite, grape6);
-    AddShapeToSprite(sprite, grape7);
-    AddShapeToSprite(sprite, grape8);
-    AddShapeToSprite(sprite, highlight1);
-    AddShapeToSprite(sprite, highlight2);
-    AddShapeToSprite(sprite, highlight3);
-    AddShapeToSprite(sprite, highlight4);
-    AddShapeToSprite(sprite, highlight5);
-    AddShapeToSprite(sprite, highlight6);
-    AddShapeToSprite(sprite, highlight7);
-    AddShapeToSprite(sprite, highlight8);
+#define RAYPALS_BVH_BINS 16          // Candidate split planes per axis are the bin edges
+#define RAYPALS_BVH_LEAF_SIZE 4      // Ranges this small always become leaves
+#define RAYPALS_BVH_MAX_LEAF 16      // Largest leaf the heuristic may prefer to a split
+#define RAYPALS_BVH_SAH_DEPTH 48     // Deeper ranges are halved, bounding the tree depth
+#define RAYPALS_BVH_STACK 96         // Traversal stack; covers the depth bound above
+
+struct RayPalsBVHNode {
+    BoundingBox box;
+    int first;          // First sprite of the node's range in bvh->sprites
+    int count;          // Sprites in the range
+    int left;           // Index of the first child (the second follows it), -1 for leaves
+    int parent;         // -1 for the root
+    unsigned int refit; // Refit that last changed the box, so each node is counted once
+};
+
+typedef struct {
+    BoundingBox* boxes;     // Sprite boxes, permuted along with the sprites
+    Vector3* centroids;     // Box centers, permuted along with the sprites
+} RayPalsBVHBuild;
+
+static float GetVector3Axis(Vector3 v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
 
-    SetSpritePosition(sprite, position);
-    return sprite;
+static BoundingBox MergeBoundingBoxes(BoundingBox a, BoundingBox b) {
+    return (BoundingBox){
+        { fminf(a.min.x, b.min.x), fminf(a.min.y, b.min.y), fminf(a.min.z, b.min.z) },
+        { fmaxf(a.max.x, b.max.x), fmaxf(a.max.y, b.max.y), fmaxf(a.max.z, b.max.z) }
+    };
 }
 
-RayPalsSprite* CreateFrankenstein(Vector2 position, float size, Color skinColor, Color clothesColor) {
-    // Create a more iconic Frankenstein's monster
-    RayPalsSprite* sprite = CreateSprite(12);  // Increased number of parts for more detail
-    if (!sprite) return NULL;
+// Half the surface area, which is all the heuristic needs
+static float GetBoxHalfArea(BoundingBox box) {
+    float x = box.max.x - box.min.x, y = box.max.y - box.min.y, z = box.max.z - box.min.z;
+    return x*y + y*z + z*x;
+}
 
-    // Make sure skin color has a proper green tint
-    Color monsterSkin = skinColor;
-    monsterSkin.g = (unsigned char)fmin(255, monsterSkin.g + 40);  // Enhance green
-    monsterSkin.r = (unsigned char)fmax(0, monsterSkin.r - 20);    // Reduce red
+static bool BoxesOverlap(const BoundingBox* a, const BoundingBox* b) {
+    return a->min.x <= b->max.x && a->max.x >= b->min.x &&
+           a->min.y <= b->max.y && a->max.y >= b->min.y &&
+           a->min.z <= b->max.z && a->max.z >= b->min.z;
+}
 
-    // Create jacket/coat (slightly broader than body)
-    RayPals2DShape* coat = CreateRectangle((Vector2){0, 0}, (Vector2){size * 0.65f, size * 1.1f}, clothesColor);
-    if (coat) {
-        AddShapeToSprite(sprite, coat);
-    }
+static bool BoxContainsBox(const BoundingBox* outer, const BoundingBox* inner) {
+    return inner->min.x >= outer->min.x && inner->max.x <= outer->max.x &&
+           inner->min.y >= outer->min.y && inner->max.y <= outer->max.y &&
+           inner->min.z >= outer->min.z && inner->max.z <= outer->max.z;
+}
 
-    // Create shirt/undershirt
-    RayPals2DShape* shirt = CreateRectangle((Vector2){0, -size * 0.35f}, (Vector2){size * 0.4f, size * 0.4f}, (Color){240, 240, 240, 255});
-    if (shirt) {
-        AddShapeToSprite(sprite, shirt);
-    }
+static void SwapBVHEntries(RayPals3DSprite** sprites, RayPalsBVHBuild* build, int a, int b) {
+    RayPals3DSprite* sprite = sprites[a]; sprites[a] = sprites[b]; sprites[b] = sprite;
+    BoundingBox box = build->boxes[a]; build->boxes[a] = build->boxes[b]; build->boxes[b] = box;
+    Vector3 centroid = build->centroids[a]; build->centroids[a] = build->centroids[b]; build->centroids[b] = centroid;
+}
 
-    // Create neck
-    RayPals2DShape* neck = CreateRectangle((Vector2){0, -size * 0.6f}, (Vector2){size * 0.25f, size * 0.15f}, monsterSkin);
-    if (neck) {
-        AddShapeToSprite(sprite, neck);
+// Picks the bin edge with the lowest surface area cost on any axis, returning the number
+// of sprites that go left, or 0 if a leaf is cheaper or the centroids cannot be separated
+static int FindBVHSplit(RayPals3DSprite** sprites, RayPalsBVHBuild* build, int first, int count, BoundingBox box) {
+    Vector3 low = build->centroids[first], high = low;
+    for (int i = first + 1; i < first + count; i++) {
+        Vector3 c = build->centroids[i];
+        low = (Vector3){ fminf(low.x, c.x), fminf(low.y, c.y), fminf(low.z, c.z) };
+        high = (Vector3){ fmaxf(high.x, c.x), fmaxf(high.y, c.y), fmaxf(high.z, c.z) };
     }
-
-    // Create head (classic flat-top)
-    RayPals2DShape* headBottom = CreateRectangle((Vector2){0, -size * 0.8f}, (Vector2){size * 0.4f, size * 0.3f}, monsterSkin);
-    if (headBottom) {
-        AddShapeToSprite(sprite, headBottom);
+    
+    float bestCost = INFINITY;
+    int bestAxis = -1, bestEdge = 0;
+    
+    for (int axis = 0; axis < 3; axis++) {
+        float lowAxis = GetVector3Axis(low, axis);
+        float extent = GetVector3Axis(high, axis) - lowAxis;
+        if (extent <= 0.0f) continue;
+        
+        int binCounts[RAYPALS_BVH_BINS] = { 0 };
+        BoundingBox binBoxes[RAYPALS_BVH_BINS];
+        float scale = RAYPALS_BVH_BINS / extent;
+        for (int i = first; i < first + count; i++) {
+            int bin = (int)((GetVector3Axis(build->centroids[i], axis) - lowAxis) * scale);
+            if (bin >= RAYPALS_BVH_BINS) bin = RAYPALS_BVH_BINS - 1;
+            binBoxes[bin] = binCounts[bin]++ ? MergeBoundingBoxes(binBoxes[bin], build->boxes[i]) : build->boxes[i];
+        }
+        
+        // Sweep from the right to get the cost of every right side, then from the left
+        float rightCost[RAYPALS_BVH_BINS];
+        BoundingBox side = { 0 };
+        int sideCount = 0;
+        for (int bin = RAYPALS_BVH_BINS - 1; bin > 0; bin--) {
+            if (binCounts[bin]) side = sideCount ? MergeBoundingBoxes(side, binBoxes[bin]) : binBoxes[bin];
+            sideCount += binCounts[bin];
+            rightCost[bin] = sideCount * (sideCount ? GetBoxHalfArea(side) : 0.0f);
+        }
+        
+        sideCount = 0;
+        for (int edge = 1; edge < RAYPALS_BVH_BINS; edge++) {
+            int bin = edge - 1;
+            if (binCounts[bin]) side = sideCount ? MergeBoundingBoxes(side, binBoxes[bin]) : binBoxes[bin];
+            sideCount += binCounts[bin];
+            if (sideCount == 0 || sideCount == count) continue;
+            
+            float cost = sideCount * GetBoxHalfArea(side) + rightCost[edge];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestEdge = edge;
+            }
+        }
     }
-
-    // Create flat top of head
-    RayPals2DShape* headTop = CreateRectangle((Vector2){0, -size * 0.99f}, (Vector2){size * 0.45f, size * 0.08f}, monsterSkin);
-    if (headTop) {
-        AddShapeToSprite(sprite, headTop);
+    
+    if (bestAxis < 0) return 0;
+    
+    // A split costs one more box test per query; keep small ranges whole when that is cheaper
+    float area = GetBoxHalfArea(box);
+    if (count <= RAYPALS_BVH_MAX_LEAF && bestCost + area >= count * area) return 0;
+    
+    float lowAxis = GetVector3Axis(low, bestAxis);
+    float scale = RAYPALS_BVH_BINS / (GetVector3Axis(high, bestAxis) - lowAxis);
+    int split = first;
+    for (int i = first; i < first + count; i++) {
+        int bin = (int)((GetVector3Axis(build->centroids[i], bestAxis) - lowAxis) * scale);
+        if (bin >= RAYPALS_BVH_BINS) bin = RAYPALS_BVH_BINS - 1;
+        if (bin < bestEdge) SwapBVHEntries(sprites, build, i, split++);
     }
+    return split - first;
+}
 
-    // Create neck bolts (metallic)
-    RayPals2DShape* leftBoltBase = CreateRectangle((Vector2){-size * 0.2f, -size * 0.6f}, (Vector2){size * 0.15f, size * 0.05f}, DARKGRAY);
-    if (leftBoltBase) {
-        AddShapeToSprite(sprite, leftBoltBase);
+static void BuildBVHNode(RayPals3DBVH* bvh, RayPalsBVHBuild* build, int nodeIndex, int parent, int first, int count, int depth) {
+    RayPalsBVHNode* node = &bvh->nodes[nodeIndex];
+    node->box = build->boxes[first];
+    for (int i = first + 1; i < first + count; i++) node->box = MergeBoundingBoxes(node->box, build->boxes[i]);
+    node->first = first;
+    node->count = count;
+    node->left = -1;
+    node->parent = parent;
+    node->refit = 0;
+    
+    if (depth > bvh->stats.depth) bvh->stats.depth = depth;
+    if (count <= RAYPALS_BVH_LEAF_SIZE) {
+        bvh->stats.leafCount++;
+        return;
     }
-
-    RayPals2DShape* leftBoltHead = CreateCircle((Vector2){-size * 0.28f, -size * 0.6f}, size * 0.04f, GRAY);
-    if (leftBoltHead) {
-        AddShapeToSprite(sprite, leftBoltHead);
+    
+    int leftCount;
+    if (depth < RAYPALS_BVH_SAH_DEPTH) {
+        leftCount = FindBVHSplit(bvh->sprites, build, first, count, node->box);
+        if (leftCount == 0 && count <= RAYPALS_BVH_MAX_LEAF) {
+            bvh->stats.leafCount++;
+            return;
+        }
+    } else {
+        leftCount = 0;
     }
+    
+    // Coincident centroids or a very deep range: halve it in its current order
+    if (leftCount == 0) leftCount = count / 2;
+    
+    int left = bvh->nodeCount;
+    bvh->nodeCount += 2;
+    node->left = left;
+    BuildBVHNode(bvh, build, left, nodeIndex, first, leftCount, depth + 1);
+    BuildBVHNode(bvh, build, left + 1, nodeIndex, first + leftCount, count - leftCount, depth + 1);
+}
 
-    RayPals2DShape* rightBoltBase = CreateRectangle((Vector2){size * 0.2f, -size * 0.6f}, (Vector2){size * 0.15f, size * 0.05f}, DARKGRAY);
-    if (rightBoltBase) {
-        AddShapeToSprite(sprite, rightBoltBase);
+RayPals3DBVH* Create3DBVH(RayPals3DSprite** sprites, int count) {
+    if (!sprites || count < 0) return NULL;
+    
+    RayPals3DBVH* bvh = (RayPals3DBVH*)calloc(1, sizeof(RayPals3DBVH));
+    if (!bvh) return NULL;
+    
+    if (count > 0) {
+        bvh->sprites = (RayPals3DSprite**)malloc(sizeof(RayPals3DSprite*) * count);
+        bvh->nodes = (RayPalsBVHNode*)malloc(sizeof(RayPalsBVHNode) * (2 * count - 1));
+        bvh->queuedLeaves = (int*)malloc(sizeof(int) * count);
+        if (!bvh->sprites || !bvh->nodes || !bvh->queuedLeaves) {
+            Free3DBVH(bvh);
+            return NULL;
+        }
+        
+        // Null entries are dropped so every leaf entry can be dereferenced
+        for (int i = 0; i < count; i++) {
+            if (sprites[i]) bvh->sprites[bvh->spriteCount++] = sprites[i];
+        }
     }
-
-    RayPals2DShape* rightBoltHead = CreateCircle((Vector2){size * 0.28f, -size * 0.6f}, size * 0.04f, GRAY);
-    if (rightBoltHead) {
-        AddShapeToSprite(sprite, rightBoltHead);
+    
+    if (!Rebuild3DBVH(bvh)) {
+        Free3DBVH(bvh);
+        return NULL;
     }
+    return bvh;
+}
 
-    // Create eyes (deep-set)
-    RayPals2DShape* leftEye = CreateCircle((Vector2){-size * 0.1f, -size * 0.82f}, size * 0.04f, BLACK);
-    if (leftEye) {
-        AddShapeToSprite(sprite, leftEye);
+bool Rebuild3DBVH(RayPals3DBVH* bvh) {
+    if (!bvh) return false;
+    
+    double start = GetTime();
+    int count = bvh->spriteCount;
+    RayPalsBVHBuild build = { 0 };
+    if (count > 0) {
+        build.boxes = (BoundingBox*)malloc(sizeof(BoundingBox) * count);
+        build.centroids = (Vector3*)malloc(sizeof(Vector3) * count);
+        if (!build.boxes || !build.centroids) {
+            free(build.boxes);
+            free(build.centroids);
+            return false;
+        }
     }
-
-    RayPals2DShape* rightEye = CreateCircle((Vector2){size * 0.1f, -size * 0.82f}, size * 0.04f, BLACK);
-    if (rightEye) {
-        AddShapeToSprite(sprite, rightEye);
+    
+    for (int i = 0; i < count; i++) {
+        BoundingBox box = Refresh3DSpriteBounds(bvh->sprites[i])->box;
+        build.boxes[i] = box;
+        build.centroids[i] = (Vector3){ (box.min.x + box.max.x)/2, (box.min.y + box.max.y)/2, (box.min.z + box.max.z)/2 };
     }
-
-    // Create arms (slightly shorter to appear hunched)
-    RayPals2DShape* leftArm = CreateRectangle((Vector2){-size * 0.45f, size * 0.05f}, (Vector2){size * 0.25f, size * 0.6f}, monsterSkin);
-    if (leftArm) {
-        SetShapeRotation(leftArm, 10);  // Slightly angled outward
-        AddShapeToSprite(sprite, leftArm);
+    
+    bvh->stats = (RayPalsBVHStats){ 0 };
+    bvh->nodeCount = 0;
+    if (count > 0) {
+        bvh->nodeCount = 1;
+        BuildBVHNode(bvh, &build, 0, -1, 0, count, 1);
     }
-
-    RayPals2DShape* rightArm = CreateRectangle((Vector2){size * 0.45f, size * 0.05f}, (Vector2){size * 0.25f, size * 0.6f}, monsterSkin);
-    if (rightArm) {
-        SetShapeRotation(rightArm, -10);  // Slightly angled outward
-        AddShapeToSprite(sprite, rightArm);
+    
+    free(build.boxes);
+    free(build.centroids);
+    
+    // The sprites report their moves to this tree from now on; a tree they reported to
+    // before can no longer rely on its queue and visits every leaf instead
+    for (int i = 0; i < count; i++) {
+        if (bvh->sprites[i]->bvh == bvh) bvh->sprites[i]->bvh = NULL;
     }
-
-    // Create pants
-    RayPals2DShape* pants = CreateRectangle((Vector2){0, size * 0.6f}, (Vector2){size * 0.45f, size * 0.6f}, DARKBROWN);
-    if (pants) {
-        AddShapeToSprite(sprite, pants);
+    bvh->untracked = false;
+    bvh->queuedCount = 0;
+    for (int n = 0; n < bvh->nodeCount; n++) {
+        const RayPalsBVHNode* node = &bvh->nodes[n];
+        if (node->left >= 0) continue;
+        
+        for (int i = node->first; i < node->first + node->count; i++) {
+            RayPals3DSprite* sprite = bvh->sprites[i];
+            if (sprite->bvh != NULL) sprite->bvh->untracked = true;  // Another tree, or this one for a repeated sprite
+            sprite->bvh = bvh;
+            sprite->bvhLeaf = n;
+            sprite->bvhQueued = false;
+        }
     }
+    
+    bvh->stats.nodeCount = bvh->nodeCount;
+    bvh->stats.buildTime = (GetTime() - start) * 1000.0;
+    return true;
+}
 
-    // Create heavy boots
-    RayPals2DShape* leftBoot = CreateRectangle((Vector2){-size * 0.15f, size * 1.0f}, (Vector2){size * 0.2f, size * 0.2f}, BLACK);
-    if (leftBoot) {
-        AddShapeToSprite(sprite, leftBoot);
+// Measures a leaf's sprites again, then merges the boxes above it for as long as they change
+static void RefitBVHLeaf(RayPals3DBVH* bvh, int leaf) {
+    RayPalsBVHNode* node = &bvh->nodes[leaf];
+    BoundingBox box = Refresh3DSpriteBounds(bvh->sprites[node->first])->box;
+    for (int i = node->first; i < node->first + node->count; i++) {
+        RayPals3DSprite* sprite = bvh->sprites[i];
+        if (sprite->bvh == bvh) sprite->bvhQueued = false;
+        if (i > node->first) box = MergeBoundingBoxes(box, Refresh3DSpriteBounds(sprite)->box);
+    }
+    bvh->stats.refitLeaves++;
+    
+    for (;;) {
+        if (memcmp(&box, &node->box, sizeof(BoundingBox)) == 0) return;
+        
+        node->box = box;
+        if (node->refit != bvh->refits) {
+            node->refit = bvh->refits;
+            bvh->stats.refitNodes++;
+        }
+        if (node->parent < 0) return;
+        
+        node = &bvh->nodes[node->parent];
+        const RayPalsBVHNode* left = &bvh->nodes[node->left];
+        box = MergeBoundingBoxes(left[0].box, left[1].box);
     }
+}
 
-    RayPals2DShape* rightBoot = CreateRectangle((Vector2){size * 0.15f, size * 1.0f}, (Vector2){size * 0.2f, size * 0.2f}, BLACK);
-    if (rightBoot) {
-        AddShapeToSprite(sprite, rightBoot);
+int Refit3DBVH(RayPals3DBVH* bvh) {
+    if (!bvh) return 0;
+    
+    double start = GetTime();
+    bvh->refits++;
+    bvh->stats.refitNodes = 0;
+    bvh->stats.refitLeaves = 0;
+    
+    if (bvh->untracked) {
+        for (int n = 0; n < bvh->nodeCount; n++) {
+            if (bvh->nodes[n].left < 0) RefitBVHLeaf(bvh, n);
+        }
+    } else {
+        for (int i = 0; i < bvh->queuedCount; i++) RefitBVHLeaf(bvh, bvh->queuedLeaves[i]);
     }
+    bvh->queuedCount = 0;
+    
+    bvh->stats.refitTime = (GetTime() - start) * 1000.0;
+    return bvh->stats.refitNodes;
+}
 
-    // Set sprite position
-    SetSpritePosition(sprite, position);
+RayPalsBVHStats Get3DBVHStats(const RayPals3DBVH* bvh) {
+    if (!bvh) return (RayPalsBVHStats){ 0 };
+    return bvh->stats;
+}
 
-    return sprite;
+// Adds the visible sprites of a range to the results, counting past the capacity
+static int CollectBVHRange(const RayPals3DBVH* bvh, int first, int count, RayPals3DSprite** results, int maxResults, int found) {
+    for (int i = first; i < first + count; i++) {
+        RayPals3DSprite* sprite = bvh->sprites[i];
+        if (!sprite->visible) continue;
+        
+        if (results && found < maxResults) results[found] = sprite;
+        found++;
+    }
+    return found;
 }
 
-RayPalsSprite* CreateDracula(Vector2 position, float size, Color capeColor, Color skinColor) {
-    RayPalsSprite* sprite = CreateSprite(8);
-    if (sprite == NULL) return NULL;
-    
-    // Create a pale skin color
-    Color vampireSkin = skinColor;
-    vampireSkin.r -= 30;  // Make skin paler
-    vampireSkin.g -= 20;
+int Query3DBVHFrustum(const RayPals3DBVH* bvh, const RayPalsFrustum* frustum, RayPals3DSprite** results, int maxResults) {
+    if (!bvh || !frustum || bvh->nodeCount == 0) return 0;
     
-    // Cape (triangle)
-    RayPals2DShape* cape = CreateTriangle((Vector2){ 0, size * 0.3f }, size * 0.8f, capeColor);
-    cape->rotation = 180.0f; // Point downward
+    int stack[RAYPALS_BVH_STACK];
+    int top = 0, found = 0;
+    stack[top++] = 0;
     
-    // Body (rectangle)
-    RayPals2DShape* body = CreateRectangle((Vector2){ 0, size * 0.1f }, (Vector2){ size * 0.3f, size * 0.4f }, BLACK);
+    while (top > 0) {
+        const RayPalsBVHNode* node = &bvh->nodes[stack[--top]];
+        int side = ClassifyFrustumBox(frustum, &node->box);
+        if (side < 0) continue;
+        
+        if (side > 0) {
+            found = CollectBVHRange(bvh, node->first, node->count, results, maxResults, found);
+        } else if (node->left >= 0) {
+            stack[top++] = node->left;
+            stack[top++] = node->left + 1;
+        } else {
+            for (int i = node->first; i < node->first + node->count; i++) {
+                RayPals3DSprite* sprite = bvh->sprites[i];
+                if (!sprite->visible || !IsBoundsInFrustum(frustum, sprite->bounds)) continue;
+                
+                if (results && found < maxResults) results[found] = sprite;
+                found++;
+            }
+        }
+    }
     
-    // Head (circle)
-    RayPals2DShape* head = CreateCircle((Vector2){ 0, -size * 0.2f }, size * 0.15f, vampireSkin);
+    return found;
+}
+
+int Query3DBVHRegion(const RayPals3DBVH* bvh, BoundingBox region, RayPals3DSprite** results, int maxResults) {
+    if (!bvh || bvh->nodeCount == 0) return 0;
     
-    // Hair (triangle)
-    RayPals2DShape* hair = CreateTriangle((Vector2){ 0, -size * 0.35f }, size * 0.2f, BLACK);
+    int stack[RAYPALS_BVH_STACK];
+    int top = 0, found = 0;
+    stack[top++] = 0;
     
-    // Eyes (circles)
-    RayPals2DShape* eyeLeft = CreateCircle((Vector2){ -size * 0.05f, -size * 0.2f }, size * 0.03f, RED);
-    RayPals2DShape* eyeRight = CreateCircle((Vector2){ size * 0.05f, -size * 0.2f }, size * 0.03f, RED);
+    while (top > 0) {
+        const RayPalsBVHNode* node = &bvh->nodes[stack[--top]];
+        if (!BoxesOverlap(&node->box, &region)) continue;
+        
+        if (BoxContainsBox(&region, &node->box)) {
+            found = CollectBVHRange(bvh, node->first, node->count, results, maxResults, found);
+        } else if (node->left >= 0) {
+            stack[top++] = node->left;
+            stack[top++] = node->left + 1;
+        } else {
+            for (int i = node->first; i < node->first + node->count; i++) {
+                RayPals3DSprite* sprite = bvh->sprites[i];
+                if (!sprite->visible || !BoxesOverlap(&sprite->bounds.box, &region)) continue;
+                
+                if (results && found < maxResults) results[found] = sprite;
+                found++;
+            }
+        }
+    }
     
-    // Fangs (triangles)
-    RayPals2DShape* fangLeft = CreateTriangle((Vector2){ -size * 0.05f, -size * 0.1f }, size * 0.05f, WHITE);
-    fangLeft->rotation = 180.0f;
-    RayPals2DShape* fangRight = CreateTriangle((Vector2){ size * 0.05f, -size * 0.1f }, size * 0.05f, WHITE);
-    fangRight->rotation = 180.0f;
+    return found;
+}
+
+// Slab test returning where the ray enters the box (0 from inside), or INFINITY on a miss;
+// a zero direction component gives infinite slabs, which fminf/fmaxf handle
+static float GetRayBoxEntry(Vector3 origin, Vector3 inverse, float maxDistance, const BoundingBox* box) {
+    float x1 = (box->min.x - origin.x) * inverse.x, x2 = (box->max.x - origin.x) * inverse.x;
+    float y1 = (box->min.y - origin.y) * inverse.y, y2 = (box->max.y - origin.y) * inverse.y;
+    float z1 = (box->min.z - origin.z) * inverse.z, z2 = (box->max.z - origin.z) * inverse.z;
+    float enter = fmaxf(fmaxf(fminf(x1, x2), fminf(y1, y2)), fmaxf(fminf(z1, z2), 0.0f));
+    float exit = fminf(fminf(fmaxf(x1, x2), fmaxf(y1, y2)), fminf(fmaxf(z1, z2), maxDistance));
+    return enter <= exit ? enter : INFINITY;
+}
+
+static bool RayHitsBox(Vector3 origin, Vector3 inverse, float maxDistance, const BoundingBox* box) {
+    return GetRayBoxEntry(origin, inverse, maxDistance, box) != INFINITY;
+}
+
+int Query3DBVHRay(const RayPals3DBVH* bvh, Ray ray, float maxDistance, RayPals3DSprite** results, int maxResults) {
+    if (!bvh || bvh->nodeCount == 0 || maxDistance < 0.0f) return 0;
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, cape);
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, head);
-    AddShapeToSprite(sprite, hair);
-    AddShapeToSprite(sprite, eyeLeft);
-    AddShapeToSprite(sprite, eyeRight);
-    AddShapeToSprite(sprite, fangLeft);
-    AddShapeToSprite(sprite, fangRight);
+    Vector3 inverse = { 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+    int stack[RAYPALS_BVH_STACK];
+    int top = 0, found = 0;
+    stack[top++] = 0;
     
-    // Set sprite position
-    sprite->position = position;
+    while (top > 0) {
+        const RayPalsBVHNode* node = &bvh->nodes[stack[--top]];
+        if (!RayHitsBox(ray.position, inverse, maxDistance, &node->box)) continue;
+        
+        if (node->left >= 0) {
+            stack[top++] = node->left;
+            stack[top++] = node->left + 1;
+            continue;
+        }
+        
+        for (int i = node->first; i < node->first + node->count; i++) {
+            RayPals3DSprite* sprite = bvh->sprites[i];
+            if (!sprite->visible || !RayHitsBox(ray.position, inverse, maxDistance, &sprite->bounds.box)) continue;
+            
+            if (results && found < maxResults) results[found] = sprite;
+            found++;
+        }
+    }
     
-    return sprite;
+    return found;
 }
 
-RayPalsSprite* CreateWerewolf(Vector2 position, float size, Color furColor, Color eyeColor) {
-    RayPalsSprite* sprite = CreateSprite(10);
-    if (sprite == NULL) return NULL;
+int Draw3DBVH(const RayPals3DBVH* bvh, Camera camera) {
+    if (!bvh || bvh->nodeCount == 0) return 0;
     
-    // Body (rectangle)
-    RayPals2DShape* body = CreateRectangle((Vector2){ 0, size * 0.1f }, (Vector2){ size * 0.4f, size * 0.5f }, furColor);
+    RayPalsFrustum frustum = GetCameraFrustum(camera);
+    int stack[RAYPALS_BVH_STACK];
+    int top = 0, drawn = 0;
+    stack[top++] = 0;
     
-    // Head (circle)
-    RayPals2DShape* head = CreateCircle((Vector2){ 0, -size * 0.2f }, size * 0.2f, furColor);
+    while (top > 0) {
+        const RayPalsBVHNode* node = &bvh->nodes[stack[--top]];
+        int side = ClassifyFrustumBox(&frustum, &node->box);
+        
+        if (side < 0) {
+            drawStats.culled += node->count;
+        } else if (side > 0) {
+            for (int i = node->first; i < node->first + node->count; i++) {
+                RayPals3DSprite* sprite = bvh->sprites[i];
+                if (!sprite->visible) continue;
+                
+                Draw3DSprite(sprite, camera);
+                drawn++;
+            }
+        } else if (node->left >= 0) {
+            stack[top++] = node->left;
+            stack[top++] = node->left + 1;
+        } else {
+            for (int i = node->first; i < node->first + node->count; i++) {
+                RayPals3DSprite* sprite = bvh->sprites[i];
+                if (sprite->visible && DrawCulled3DSprite(sprite, &frustum, &camera)) drawn++;
+            }
+        }
+    }
     
-    // Snout (triangle)
-    RayPals2DShape* snout = CreateTriangle((Vector2){ 0, -size * 0.1f }, size * 0.15f, furColor);
-    snout->rotation = 180.0f;
+    return drawn;
+}
+
+void Free3DBVH(RayPals3DBVH* bvh) {
+    if (!bvh) return;
     
-    // Ears (triangles)
-    RayPals2DShape* earLeft = CreateTriangle((Vector2){ -size * 0.15f, -size * 0.35f }, size * 0.1f, furColor);
-    earLeft->rotation = -45.0f;
-    RayPals2DShape* earRight = CreateTriangle((Vector2){ size * 0.15f, -size * 0.35f }, size * 0.1f, furColor);
-    earRight->rotation = 45.0f;
+    for (int i = 0; i < bvh->spriteCount; i++) {
+        if (bvh->sprites[i]->bvh == bvh) bvh->sprites[i]->bvh = NULL;
+    }
+    free(bvh->sprites);
+    free(bvh->nodes);
+    free(bvh->queuedLeaves);
+    free(bvh);
+}
+
+// ----------------------------------------------------------------------------
+// 3D Instancing Functions
+// ----------------------------------------------------------------------------
+
+#define RAYPALS_INSTANCE_WIDTH 4   // Vertices per SIMD transform step; planes are padded to it
+
+struct RayPals3DTemplateRun {
+    Color color;
+    int first;                 // First vertex of the run in the template planes
+    int count;                 // Vertices in the run
+};
+
+// Transforms vertices [first, first + count) of the source planes into the destination
+// planes: positions by the matrix, normals by its normal matrix and renormalized
+typedef void (*RayPalsInstanceKernel)(const float* source, float* destination, int stride, int first, int count,
+                                      const Matrix* transform, const Matrix* normalMatrix);
+
+static void TransformInstanceScalar(const float* source, float* destination, int stride, int first, int count,
+                                    const Matrix* m, const Matrix* n) {
+    const float* x = source + first;
+    float* out = destination + first;
+    
+    for (int i = 0; i < count; i++) {
+        float vx = x[i], vy = x[stride + i], vz = x[2*stride + i];
+        out[i] = m->m0*vx + m->m4*vy + m->m8*vz + m->m12;
+        out[stride + i] = m->m1*vx + m->m5*vy + m->m9*vz + m->m13;
+        out[2*stride + i] = m->m2*vx + m->m6*vy + m->m10*vz + m->m14;
+        
+        float nx = x[3*stride + i], ny = x[4*stride + i], nz = x[5*stride + i];
+        float tx = n->m0*nx + n->m4*ny + n->m8*nz;
+        float ty = n->m1*nx + n->m5*ny + n->m9*nz;
+        float tz = n->m2*nx + n->m6*ny + n->m10*nz;
+        float scale = 1.0f / sqrtf(fmaxf(tx*tx + ty*ty + tz*tz, 1e-30f));
+        out[3*stride + i] = tx*scale;
+        out[4*stride + i] = ty*scale;
+        out[5*stride + i] = tz*scale;
+    }
+}
+
+#if defined(RAYPALS_CANVAS_X86)
+RAYPALS_TARGET_SSE2 static void TransformInstanceSSE2(const float* source, float* destination, int stride, int first, int count,
+                                                      const Matrix* m, const Matrix* n) {
+    const float* x = source + first;
+    float* out = destination + first;
+    
+    __m128 m0 = _mm_set1_ps(m->m0), m1 = _mm_set1_ps(m->m1), m2 = _mm_set1_ps(m->m2);
+    __m128 m4 = _mm_set1_ps(m->m4), m5 = _mm_set1_ps(m->m5), m6 = _mm_set1_ps(m->m6);
+    __m128 m8 = _mm_set1_ps(m->m8), m9 = _mm_set1_ps(m->m9), m10 = _mm_set1_ps(m->m10);
+    __m128 m12 = _mm_set1_ps(m->m12), m13 = _mm_set1_ps(m->m13), m14 = _mm_set1_ps(m->m14);
+    __m128 n0 = _mm_set1_ps(n->m0), n1 = _mm_set1_ps(n->m1), n2 = _mm_set1_ps(n->m2);
+    __m128 n4 = _mm_set1_ps(n->m4), n5 = _mm_set1_ps(n->m5), n6 = _mm_set1_ps(n->m6);
+    __m128 n8 = _mm_set1_ps(n->m8), n9 = _mm_set1_ps(n->m9), n10 = _mm_set1_ps(n->m10);
+    __m128 one = _mm_set1_ps(1.0f), tiny = _mm_set1_ps(1e-30f);
+    
+    int i = 0;
+    for (; i + RAYPALS_INSTANCE_WIDTH <= count; i += RAYPALS_INSTANCE_WIDTH) {
+        __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(x + stride + i), vz = _mm_loadu_ps(x + 2*stride + i);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, vx), _mm_mul_ps(m4, vy)), _mm_add_ps(_mm_mul_ps(m8, vz), m12)));
+        _mm_storeu_ps(out + stride + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, vx), _mm_mul_ps(m5, vy)), _mm_add_ps(_mm_mul_ps(m9, vz), m13)));
+        _mm_storeu_ps(out + 2*stride + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, vx), _mm_mul_ps(m6, vy)), _mm_add_ps(_mm_mul_ps(m10, vz), m14)));
+        
+        __m128 nx = _mm_loadu_ps(x + 3*stride + i), ny = _mm_loadu_ps(x + 4*stride + i), nz = _mm_loadu_ps(x + 5*stride + i);
+        __m128 tx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(n0, nx), _mm_mul_ps(n4, ny)), _mm_mul_ps(n8, nz));
+        __m128 ty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(n1, nx), _mm_mul_ps(n5, ny)), _mm_mul_ps(n9, nz));
+        __m128 tz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(n2, nx), _mm_mul_ps(n6, ny)), _mm_mul_ps(n10, nz));
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)), _mm_mul_ps(tz, tz));
+        __m128 scale = _mm_div_ps(one, _mm_sqrt_ps(_mm_max_ps(lengthSquared, tiny)));
+        _mm_storeu_ps(out + 3*stride + i, _mm_mul_ps(tx, scale));
+        _mm_storeu_ps(out + 4*stride + i, _mm_mul_ps(ty, scale));
+        _mm_storeu_ps(out + 5*stride + i, _mm_mul_ps(tz, scale));
+    }
     
-    // Eyes (circles)
-    RayPals2DShape* eyeLeft = CreateCircle((Vector2){ -size * 0.08f, -size * 0.25f }, size * 0.03f, eyeColor);
-    RayPals2DShape* eyeRight = CreateCircle((Vector2){ size * 0.08f, -size * 0.25f }, size * 0.03f, eyeColor);
+    if (i < count) TransformInstanceScalar(source, destination, stride, first + i, count - i, m, n);
+}
+#endif
+
+static RayPalsInstanceKernel instanceKernel = NULL;  // Resolved on first use
+
+// Destination planes for one instance of a template; templates stay read-only while drawn
+static float* GetInstanceScratch(int stride) {
+    if (stride > instanceScratchStride) {
+        float* scratch = (float*)realloc(instanceScratch, 6 * (size_t)stride * sizeof(float));
+        if (scratch == NULL) return NULL;
+        instanceScratch = scratch;
+        instanceScratchStride = stride;
+    }
+    return instanceScratch;
+}
+
+static RayPalsInstanceKernel GetInstanceKernel(void) {
+    if (instanceKernel == NULL) {
+        instanceKernel = TransformInstanceScalar;
+#if defined(RAYPALS_CANVAS_X86)
+        if (DetectSSE2()) instanceKernel = TransformInstanceSSE2;
+#endif
+    }
+    return instanceKernel;
+}
+
+// Unit mesh a template shape contributes, if it is drawn with the given primitive mode
+static const RayPalsUnitMesh* GetTemplateShapeMesh(const RayPals3DShape* shape, bool lines) {
+    if (!shape || !shape->visible || shape->wireframe != lines) return NULL;
+    return Get3DUnitMesh(shape->type, shape->segments, shape->wireframe);
+}
+
+RayPals3DSpriteTemplate* Create3DSpriteTemplate(RayPals3DSprite* sprite) {
+    if (!sprite) return NULL;
     
-    // Arms (rectangles)
-    RayPals2DShape* armLeft = CreateRectangle((Vector2){ -size * 0.25f, size * 0.1f }, (Vector2){ size * 0.15f, size * 0.3f }, furColor);
-    armLeft->rotation = -15.0f;
-    RayPals2DShape* armRight = CreateRectangle((Vector2){ size * 0.25f, size * 0.1f }, (Vector2){ size * 0.15f, size * 0.3f }, furColor);
-    armRight->rotation = 15.0f;
+    RayPals3DSpriteTemplate* spriteTemplate = (RayPals3DSpriteTemplate*)calloc(1, sizeof(RayPals3DSpriteTemplate));
+    if (!spriteTemplate) return NULL;
     
-    // Legs (rectangles)
-    RayPals2DShape* legLeft = CreateRectangle((Vector2){ -size * 0.1f, size * 0.4f }, (Vector2){ size * 0.15f, size * 0.4f }, furColor);
-    RayPals2DShape* legRight = CreateRectangle((Vector2){ size * 0.1f, size * 0.4f }, (Vector2){ size * 0.15f, size * 0.4f }, furColor);
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < sprite->shapeCount; i++) {
+            const RayPalsUnitMesh* mesh = GetTemplateShapeMesh(sprite->shapes[i], pass == 1);
+            if (mesh == NULL) continue;
+            
+            spriteTemplate->vertexCount += mesh->vertexCount;
+            spriteTemplate->runCount++;
+            if (pass == 0) {
+                spriteTemplate->triangleVertexCount += mesh->vertexCount;
+                spriteTemplate->triangleRunCount++;
+            }
+        }
+    }
     
-    // Claws (triangles)
-    RayPals2DShape* clawLeft = CreateTriangle((Vector2){ -size * 0.25f, size * 0.4f }, size * 0.05f, WHITE);
-    clawLeft->rotation = 90.0f;
-    RayPals2DShape* clawRight = CreateTriangle((Vector2){ size * 0.25f, size * 0.4f }, size * 0.05f, WHITE);
-    clawRight->rotation = -90.0f;
+    // Zeroed padding keeps the planes' tails finite
+    int stride = (spriteTemplate->vertexCount + RAYPALS_INSTANCE_WIDTH - 1) / RAYPALS_INSTANCE_WIDTH * RAYPALS_INSTANCE_WIDTH;
+    if (stride == 0) stride = RAYPALS_INSTANCE_WIDTH;
+    spriteTemplate->stride = stride;
+    spriteTemplate->vertexData = (float*)calloc(6 * (size_t)stride, sizeof(float));
+    spriteTemplate->runs = (RayPals3DTemplateRun*)calloc(spriteTemplate->runCount > 0 ? spriteTemplate->runCount : 1, sizeof(RayPals3DTemplateRun));
+    if (!spriteTemplate->vertexData || !spriteTemplate->runs) {
+        Free3DSpriteTemplate(spriteTemplate);
+        return NULL;
+    }
     
-    // Add shapes to sprite
-    AddShapeToSprite(sprite, body);
-    AddShapeToSprite(sprite, legLeft);
-    AddShapeToSprite(sprite, legRight);
-    AddShapeToSprite(sprite, armLeft);
-    AddShapeToSprite(sprite, armRight);
-    AddShapeToSprite(sprite, head);
-    AddShapeToSprite(sprite, snout);
-    AddShapeToSprite(sprite, earLeft);
-    AddShapeToSprite(sprite, earRight);
-    AddShapeToSprite(sprite, eyeLeft);
-    AddShapeToSprite(sprite, eyeRight);
-    AddShapeToSprite(sprite, clawLeft);
-    AddShapeToSprite(sprite, clawRight);
+    float* planes = spriteTemplate->vertexData;
+    BoundingBox box = { { 0, 0, 0 }, { 0, 0, 0 } };
+    int run = 0, at = 0;
     
-    // Set sprite position
-    sprite->position = position;
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < sprite->shapeCount; i++) {
+            RayPals3DShape* shape = sprite->shapes[i];
+            const RayPalsUnitMesh* mesh = GetTemplateShapeMesh(shape, pass == 1);
+            if (mesh == NULL) continue;
+            
+            // Shapes are baked under their local matrices, in sprite space
+            const Matrix* local = Refresh3DShapeLocalMatrix(shape);
+            Matrix normalMatrix = GetNormalMatrix(local);
+            for (int v = 0; v < mesh->vertexCount; v++) {
+                Vector3 position = TransformPoint(local, mesh->vertices[v]);
+                Vector3 normal = TransformDirection(&normalMatrix, mesh->normals[v]);
+                float length = sqrtf(normal.x*normal.x + normal.y*normal.y + normal.z*normal.z);
+                if (length > 0.0f) normal = (Vector3){ normal.x/length, normal.y/length, normal.z/length };
+                
+                planes[at + v] = position.x;
+                planes[stride + at + v] = position.y;
+                planes[2*stride + at + v] = position.z;
+                planes[3*stride + at + v] = normal.x;
+                planes[4*stride + at + v] = normal.y;
+                planes[5*stride + at + v] = normal.z;
+            }
+            
+            BoundingBox shapeBox = TransformUnitBounds(shape->type, local).box;
+            box = run == 0 ? shapeBox : MergeBoundingBoxes(box, shapeBox);
+            spriteTemplate->runs[run++] = (RayPals3DTemplateRun){ shape->color, at, mesh->vertexCount };
+            at += mesh->vertexCount;
+        }
+    }
     
-    return sprite;
+    // The sphere is centered on the box and reaches its farthest vertex
+    Vector3 center = { (box.min.x + box.max.x)/2, (box.min.y + box.max.y)/2, (box.min.z + box.max.z)/2 };
+    float radiusSquared = 0.0f;
+    for (int v = 0; v < spriteTemplate->vertexCount; v++) {
+        float dx = planes[v] - center.x, dy = planes[stride + v] - center.y, dz = planes[2*stride + v] - center.z;
+        radiusSquared = fmaxf(radiusSquared, dx*dx + dy*dy + dz*dz);
+    }
+    spriteTemplate->bounds = (RayPalsBounds3D){ box, center, sqrtf(radiusSquared) };
+    
+    return spriteTemplate;
 }
 
-RayPalsSprite* CreateMummy(Vector2 position, float size, Color bandageColor, Color eyeColor) {
-    RayPalsSprite* sprite = CreateSprite(7);  // 7 shapes: body, head, 2 eyes, 2 arms, 2 legs
-    if (!sprite) return NULL;
+Matrix Get3DInstanceTransform(Vector3 position, Vector3 rotation, Vector3 scale) {
+    return MakeTransformMatrix(position, rotation, scale);
+}
 
-    // Create body (wrapped in bandages)
-    RayPals2DShape* body = CreateRectangle((Vector2){0, 0}, (Vector2){size * 0.6f, size * 1.2f}, bandageColor);
-    if (body) {
-        AddShapeToSprite(sprite, body);
+// Conservative test of an instance's template sphere under its transform
+static bool IsInstanceInFrustum(const RayPals3DSpriteTemplate* spriteTemplate, const Matrix* m, const RayPalsFrustum* frustum) {
+    float scaleX = m->m0*m->m0 + m->m1*m->m1 + m->m2*m->m2;
+    float scaleY = m->m4*m->m4 + m->m5*m->m5 + m->m6*m->m6;
+    float scaleZ = m->m8*m->m8 + m->m9*m->m9 + m->m10*m->m10;
+    float radius = spriteTemplate->bounds.radius * sqrtf(fmaxf(scaleX, fmaxf(scaleY, scaleZ)));
+    return ClassifyFrustumSphere(frustum, TransformPoint(m, spriteTemplate->bounds.center), radius) >= 0;
+}
+
+// Streams every instance through the transform kernel into one run per primitive mode
+static int Draw3DInstanceList(const RayPals3DSpriteTemplate* spriteTemplate, const Matrix* transforms, const Color* tints,
+                              int count, const RayPalsFrustum* frustum) {
+    if (!spriteTemplate || !transforms || count <= 0 || spriteTemplate->runCount == 0) return 0;
+    
+    RayPalsInstanceKernel kernel = GetInstanceKernel();
+    int stride = spriteTemplate->stride;
+    float* out = GetInstanceScratch(stride);
+    if (out == NULL) return 0;
+    int drawn = 0;
+    
+    for (int pass = 0; pass < 2; pass++) {
+        bool lines = pass == 1;
+        int firstRun = lines ? spriteTemplate->triangleRunCount : 0;
+        int endRun = lines ? spriteTemplate->runCount : spriteTemplate->triangleRunCount;
+        if (firstRun == endRun) continue;
+        
+        // Instances are counted by the first pass that runs
+        bool counting = !lines || spriteTemplate->triangleRunCount == 0;
+        int first = lines ? spriteTemplate->triangleVertexCount : 0;
+        int vertexCount = lines ? spriteTemplate->vertexCount - spriteTemplate->triangleVertexCount : spriteTemplate->triangleVertexCount;
+        int passDrawn = 0;
+        
+        rlBegin(lines ? RL_LINES : RL_TRIANGLES);
+        
+        for (int i = 0; i < count; i++) {
+            const Matrix* transform = &transforms[i];
+            if (frustum != NULL && !IsInstanceInFrustum(spriteTemplate, transform, frustum)) {
+                if (counting) drawStats.culled++;
+                continue;
+            }
+            
+            Matrix normalMatrix = GetNormalMatrix(transform);
+            kernel(spriteTemplate->vertexData, out, stride, first, vertexCount, transform, &normalMatrix);
+            
+            Color tint = tints ? tints[i] : WHITE;
+            bool tinting = !ColorIsEqual(tint, WHITE);
+            
+            for (int r = firstRun; r < endRun; r++) {
+                const RayPals3DTemplateRun* templateRun = &spriteTemplate->runs[r];
+                Color color = tinting ? TintColor(templateRun->color, tint) : templateRun->color;
+                rlColor4ub(color.r, color.g, color.b, color.a);
+                
+                int end = templateRun->first + templateRun->count;
+                for (int base = templateRun->first; base < end; base += RAYPALS_CACHE_CHUNK) {
+                    int chunkEnd = base + RAYPALS_CACHE_CHUNK < end ? base + RAYPALS_CACHE_CHUNK : end;
+                    
+                    // Chunks hold whole primitives, so a flush never splits one
+                    CheckRenderBatchLimit(chunkEnd - base);
+                    
+                    for (int v = base; v < chunkEnd; v++) {
+                        rlNormal3f(out[3*stride + v], out[4*stride + v], out[5*stride + v]);
+                        rlVertex3f(out[v], out[stride + v], out[2*stride + v]);
+                    }
+                }
+            }
+            passDrawn++;
+        }
+        
+        rlEnd();
+        drawStats.batches++;
+        drawStats.vertices += passDrawn * vertexCount;
+        if (!lines) Count3DTriangles(passDrawn * (vertexCount / 3));
+        if (counting) {
+            drawStats.sprites += passDrawn;
+            drawn = passDrawn;
+        }
     }
+    
+    return drawn;
+}
 
-    // Create head (wrapped in bandages)
-    RayPals2DShape* head = CreateCircle((Vector2){0, -size * 0.5f}, size * 0.2f, bandageColor);
-    if (head) {
-        AddShapeToSprite(sprite, head);
+void Draw3DSpriteInstances(const RayPals3DSpriteTemplate* spriteTemplate, const Matrix* transforms, const Color* tints, int count) {
+    Draw3DInstanceList(spriteTemplate, transforms, tints, count, NULL);
+}
+
+int Draw3DSpriteInstancesCulled(const RayPals3DSpriteTemplate* spriteTemplate, const Matrix* transforms, const Color* tints, int count, Camera camera) {
+    RayPalsFrustum frustum = GetCameraFrustum(camera);
+    return Draw3DInstanceList(spriteTemplate, transforms, tints, count, &frustum);
+}
+
+int Get3DInstanceVertices(const RayPals3DSpriteTemplate* spriteTemplate, Matrix transform, Vector3* positions, Vector3* normals) {
+    if (!spriteTemplate) return 0;
+    
+    int stride = spriteTemplate->stride;
+    float* out = GetInstanceScratch(stride);
+    if (out == NULL) return 0;
+    
+    Matrix normalMatrix = GetNormalMatrix(&transform);
+    GetInstanceKernel()(spriteTemplate->vertexData, out, stride, 0, spriteTemplate->vertexCount, &transform, &normalMatrix);
+    
+    for (int v = 0; v < spriteTemplate->vertexCount; v++) {
+        if (positions) positions[v] = (Vector3){ out[v], out[stride + v], out[2*stride + v] };
+        if (normals) normals[v] = (Vector3){ out[3*stride + v], out[4*stride + v], out[5*stride + v] };
     }
+    return spriteTemplate->vertexCount;
+}
 
-    // Create eyes
-    RayPals2DShape* leftEye = CreateCircle((Vector2){-size * 0.1f, -size * 0.5f}, size * 0.05f, eyeColor);
-    if (leftEye) {
-        AddShapeToSprite(sprite, leftEye);
+void Free3DSpriteTemplate(RayPals3DSpriteTemplate* spriteTemplate) {
+    if (!spriteTemplate) return;
+    
+    free(spriteTemplate->vertexData);
+    free(spriteTemplate->runs);
+    free(spriteTemplate);
+}
+
+// ----------------------------------------------------------------------------
+// Picking Functions
+// ----------------------------------------------------------------------------
+
+// Edge-sign test that accepts either winding and counts points on the edges as inside
+static bool IsPointInTriangle2D(Vector2 p, Vector2 a, Vector2 b, Vector2 c) {
+    float d1 = (b.x - a.x)*(p.y - a.y) - (b.y - a.y)*(p.x - a.x);
+    float d2 = (c.x - b.x)*(p.y - b.y) - (c.y - b.y)*(p.x - b.x);
+    float d3 = (a.x - c.x)*(p.y - c.y) - (a.y - c.y)*(p.x - c.x);
+    bool negative = d1 < 0.0f || d2 < 0.0f || d3 < 0.0f;
+    bool positive = d1 > 0.0f || d2 > 0.0f || d3 > 0.0f;
+    return !(negative && positive);
+}
+
+// Tests a point against the one triangle of a fan around the origin whose sector holds
+// it. Vertex i sits at angle startAngle + i*2PI/count, alternating between evenRadius
+// and oddRadius (count must be even when the radii differ).
+static bool IsPointInUnitFan(Vector2 p, int count, float startAngle, float evenRadius, float oddRadius) {
+    float step = 2.0f * PI / count;
+    int sector = (int)floorf((atan2f(p.y, p.x) - startAngle) / step);
+    sector = ((sector % count) + count) % count;
+    
+    float angle = startAngle + sector*step;
+    float radius = sector % 2 == 0 ? evenRadius : oddRadius;
+    float nextRadius = sector % 2 == 0 ? oddRadius : evenRadius;
+    Vector2 first = { cosf(angle) * radius, sinf(angle) * radius };
+    Vector2 second = { cosf(angle + step) * nextRadius, sinf(angle + step) * nextRadius };
+    return IsPointInTriangle2D(p, (Vector2){ 0, 0 }, first, second);
+}
+
+// Point against the area of a shape, in shape space. Polygonal shapes match the
+// triangles BuildUnitShapeTriangles emits; circles and the round top of water drops are
+// exact rather than segmented. Outlines count as their filled area, and the remaining
+// types fall back to their local extents.
+static bool IsPointInShapeLocal(const RayPals2DShape* shape, Vector2 p) {
+    Vector2 scale = GetUnitShapeScale(shape->type, shape->size);
+    if (scale.x == 0.0f || scale.y == 0.0f) return false;
+    
+    Vector2 u = { p.x / scale.x, p.y / scale.y };
+    float distanceSquared = u.x*u.x + u.y*u.y;
+    
+    switch (shape->type) {
+        case RAYPALS_SQUARE:
+        case RAYPALS_RECTANGLE: return fabsf(u.x) <= 0.5f && fabsf(u.y) <= 0.5f;
+        case RAYPALS_CIRCLE: return distanceSquared <= 0.25f;
+        case RAYPALS_TRIANGLE: return IsPointInTriangle2D(u, (Vector2){ 0, -0.5f }, (Vector2){ -0.5f, 0.5f }, (Vector2){ 0.5f, 0.5f });
+        case RAYPALS_STAR: {
+            int points = shape->points >= 3 ? shape->points : 5;
+            return distanceSquared <= 0.25f && IsPointInUnitFan(u, points * 2, -PI/2, 0.5f, 0.5f/3);
+        }
+        case RAYPALS_POLYGON: {
+            int sides = shape->segments >= 3 ? shape->segments : 3;
+            return distanceSquared <= 0.25f && IsPointInUnitFan(u, sides, 0.0f, 0.5f, 0.5f);
+        }
+        case RAYPALS_ARROW:
+            return (fabsf(u.x) <= 0.5f && fabsf(u.y) <= 0.1f) ||
+                   IsPointInTriangle2D(u, (Vector2){ 0.5f, 0 }, (Vector2){ 0.25f, -0.25f }, (Vector2){ 0.25f, 0.25f });
+        case RAYPALS_WATER_DROP: {
+            float dy = u.y + 0.15f;
+            return u.x*u.x + dy*dy <= 0.35f*0.35f ||
+                   IsPointInTriangle2D(u, (Vector2){ 0, 0.45f }, (Vector2){ -0.35f, -0.05f }, (Vector2){ 0.35f, -0.05f });
+        }
+        default: {
+            Rectangle extents = GetShapeLocalExtents(shape);
+            return p.x >= extents.x && p.x <= extents.x + extents.width && p.y >= extents.y && p.y <= extents.y + extents.height;
+        }
     }
+}
 
-    RayPals2DShape* rightEye = CreateCircle((Vector2){size * 0.1f, -size * 0.5f}, size * 0.05f, eyeColor);
-    if (rightEye) {
-        AddShapeToSprite(sprite, rightEye);
+// Moves a point from the space a shape is positioned in into the shape's own space
+static Vector2 GetPointInShapeSpace(const RayPals2DShape* shape, Vector2 point) {
+    float cosine = cosf(shape->rotation * DEG2RAD);
+    float sine = sinf(shape->rotation * DEG2RAD);
+    float dx = point.x - shape->position.x, dy = point.y - shape->position.y;
+    return (Vector2){ dx*cosine + dy*sine, dy*cosine - dx*sine };
+}
+
+// Undoes a sprite or instance transform; false when a zero scale collapses it
+static bool GetPointInSpriteSpace(Vector2 point, Vector2 position, float rotation, float scale, Vector2* local) {
+    if (scale == 0.0f) return false;
+    
+    float cosine = cosf(rotation * DEG2RAD) / scale;
+    float sine = sinf(rotation * DEG2RAD) / scale;
+    float dx = point.x - position.x, dy = point.y - position.y;
+    *local = (Vector2){ dx*cosine + dy*sine, dy*cosine - dx*sine };
+    return true;
+}
+
+// Index of the topmost visible shape holding a sprite-space point, or -1. Shapes draw in
+// order, so the search runs from the last one.
+static int FindShapeAtPoint(RayPals2DShape** shapes, const RayPals2DShape* shapeValues, int count, Vector2 point) {
+    for (int i = count - 1; i >= 0; i--) {
+        const RayPals2DShape* shape = shapes != NULL ? shapes[i] : &shapeValues[i];
+        if (shape->visible && IsPointInShapeLocal(shape, GetPointInShapeSpace(shape, point))) return i;
     }
+    return -1;
+}
 
-    // Create arms (wrapped in bandages)
-    RayPals2DShape* leftArm = CreateRectangle((Vector2){-size * 0.4f, 0}, (Vector2){size * 0.3f, size * 0.6f}, bandageColor);
-    if (leftArm) {
-        SetShapeRotation(leftArm, 45);
-        AddShapeToSprite(sprite, leftArm);
+bool CheckCollisionPoint2DShape(Vector2 point, const RayPals2DShape* shape) {
+    if (!shape) return false;
+    return IsPointInShapeLocal(shape, GetPointInShapeSpace(shape, point));
+}
+
+int GetSpriteShapeAtPoint(RayPalsSprite* sprite, Vector2 point) {
+    Vector2 local;
+    if (!sprite || !sprite->visible || !GetPointInSpriteSpace(point, sprite->position, sprite->rotation, sprite->scale, &local)) return -1;
+    
+    return FindShapeAtPoint(sprite->shapes, NULL, sprite->shapeCount, local);
+}
+
+int GetSpriteInstanceShapeAtPoint(const RayPalsSpriteInstance* instance, Vector2 point) {
+    Vector2 local;
+    if (!instance || !instance->visible || !instance->spriteTemplate) return -1;
+    if (!GetPointInSpriteSpace(point, instance->position, instance->rotation, instance->scale, &local)) return -1;
+    
+    return FindShapeAtPoint(NULL, instance->spriteTemplate->shapes, instance->spriteTemplate->shapeCount, local);
+}
+
+RayPalsSprite* PickSprite(RayPalsSprite** sprites, int count, Vector2 point, int* shapeIndex) {
+    if (shapeIndex) *shapeIndex = -1;
+    if (!sprites) return NULL;
+    
+    // Later sprites draw over earlier ones
+    for (int i = count - 1; i >= 0; i--) {
+        RayPalsSprite* sprite = sprites[i];
+        if (!sprite || !sprite->visible) continue;
+        
+        Rectangle bounds = GetSpriteBounds(sprite);
+        if (point.x < bounds.x || point.x > bounds.x + bounds.width || point.y < bounds.y || point.y > bounds.y + bounds.height) continue;
+        
+        int index = GetSpriteShapeAtPoint(sprite, point);
+        if (index < 0) continue;
+        
+        if (shapeIndex) *shapeIndex = index;
+        return sprite;
     }
+    
+    return NULL;
+}
 
-    RayPals2DShape* rightArm = CreateRectangle((Vector2){size * 0.4f, 0}, (Vector2){size * 0.3f, size * 0.6f}, bandageColor);
-    if (rightArm) {
-        SetShapeRotation(rightArm, -45);
-        AddShapeToSprite(sprite, rightArm);
+static void KeepNearerHit(float t, Vector3 normal, float* nearest, Vector3* nearestNormal) {
+    if (t >= 0.0f && t < *nearest) {
+        *nearest = t;
+        *nearestNormal = normal;
     }
+}
 
-    // Create legs (wrapped in bandages)
-    RayPals2DShape* leftLeg = CreateRectangle((Vector2){-size * 0.2f, size * 0.7f}, (Vector2){size * 0.3f, size * 0.6f}, bandageColor);
-    if (leftLeg) {
-        AddShapeToSprite(sprite, leftLeg);
+// Casts a ray against a unit mesh in its own space (see Get3DUnitMesh): the cube of side
+// 1 and the sphere of radius 1 around the origin, the cylinder and cone of radius 1
+// standing on y = 0 with height 1. Returns the ray parameter of the first surface in
+// front of the origin, or INFINITY, and the outward normal there.
+static float RaycastUnitShape(RayPalsShapeType type, Vector3 o, Vector3 d, Vector3* normal) {
+    float nearest = INFINITY;
+    
+    switch (type) {
+        case RAYPALS_CUBE: {
+            float origin[3] = { o.x, o.y, o.z };
+            float direction[3] = { d.x, d.y, d.z };
+            float enter = -INFINITY, exit = INFINITY;
+            int enterAxis = 0, exitAxis = 0;
+            
+            for (int axis = 0; axis < 3; axis++) {
+                if (direction[axis] == 0.0f) {
+                    if (fabsf(origin[axis]) > 0.5f) return INFINITY;
+                    continue;
+                }
+                
+                float t1 = (-0.5f - origin[axis]) / direction[axis];
+                float t2 = (0.5f - origin[axis]) / direction[axis];
+                if (t1 > t2) {
+                    float swap = t1;
+                    t1 = t2;
+                    t2 = swap;
+                }
+                if (t1 > enter) { enter = t1; enterAxis = axis; }
+                if (t2 < exit) { exit = t2; exitAxis = axis; }
+            }
+            if (enter > exit || exit < 0.0f) return INFINITY;
+            
+            // From inside the cube the first surface is the exit face
+            int axis = enter >= 0.0f ? enterAxis : exitAxis;
+            nearest = enter >= 0.0f ? enter : exit;
+            float side = origin[axis] + nearest*direction[axis] > 0.0f ? 1.0f : -1.0f;
+            *normal = (Vector3){ axis == 0 ? side : 0.0f, axis == 1 ? side : 0.0f, axis == 2 ? side : 0.0f };
+        } break;
+        
+        case RAYPALS_SPHERE: {
+            float a = d.x*d.x + d.y*d.y + d.z*d.z;
+            float b = o.x*d.x + o.y*d.y + o.z*d.z;
+            float c = o.x*o.x + o.y*o.y + o.z*o.z - 1.0f;
+            float discriminant = b*b - a*c;
+            if (discriminant < 0.0f) return INFINITY;
+            
+            float root = sqrtf(discriminant);
+            float t = (-b - root) / a;
+            if (t < 0.0f) t = (-b + root) / a;
+            KeepNearerHit(t, (Vector3){ o.x + t*d.x, o.y + t*d.y, o.z + t*d.z }, &nearest, normal);
+        } break;
+        
+        case RAYPALS_CYLINDER:
+        case RAYPALS_CONE: {
+            // Side: x^2 + z^2 = r^2 for 0 <= y <= 1, where r = 1 on the cylinder and 1 - y on
+            // the cone; along the ray r = k + t*dk
+            bool cone = type == RAYPALS_CONE;
+            float k = cone ? 1.0f - o.y : 1.0f;
+            float dk = cone ? -d.y : 0.0f;
+            float a = d.x*d.x + d.z*d.z - dk*dk;
+            float b = o.x*d.x + o.z*d.z - k*dk;
+            float c = o.x*o.x + o.z*o.z - k*k;
+            
+            float roots[2];
+            int rootCount = 0;
+            if (fabsf(a) > 1e-8f) {
+                float discriminant = b*b - a*c;
+                if (discriminant >= 0.0f) {
+                    float root = sqrtf(discriminant);
+                    roots[rootCount++] = (-b - root) / a;
+                    roots[rootCount++] = (-b + root) / a;
+                }
+            } else if (b != 0.0f) {
+                roots[rootCount++] = -c / (2.0f * b);   // Ray parallel to a cone's slope
+            }
+            
+            for (int i = 0; i < rootCount; i++) {
+                float t = roots[i];
+                float y = o.y + t*d.y;
+                if (y < 0.0f || y > 1.0f) continue;
+                KeepNearerHit(t, (Vector3){ o.x + t*d.x, cone ? 1.0f - y : 0.0f, o.z + t*d.z }, &nearest, normal);
+            }
+            
+            // Caps: the base at y = 0, and the top at y = 1 for the cylinder
+            if (d.y != 0.0f) {
+                for (int cap = 0; cap < (cone ? 1 : 2); cap++) {
+                    float t = ((float)cap - o.y) / d.y;
+                    float x = o.x + t*d.x, z = o.z + t*d.z;
+                    if (x*x + z*z <= 1.0f) KeepNearerHit(t, (Vector3){ 0, cap ? 1.0f : -1.0f, 0 }, &nearest, normal);
+                }
+            }
+        } break;
+        
+        default: break;
     }
+    
+    return nearest;
+}
 
-    RayPals2DShape* rightLeg = CreateRectangle((Vector2){size * 0.2f, size * 0.7f}, (Vector2){size * 0.3f, size * 0.6f}, bandageColor);
-    if (rightLeg) {
-        AddShapeToSprite(sprite, rightLeg);
+// Normalizes a ray's direction so hit distances come out in world units
+static bool NormalizeRay(Ray* ray) {
+    Vector3 d = ray->direction;
+    float length = sqrtf(d.x*d.x + d.y*d.y + d.z*d.z);
+    if (!(length > 0.0f)) return false;
+    
+    ray->direction = (Vector3){ d.x / length, d.y / length, d.z / length };
+    return true;
+}
+
+// Casts a ray with a unit direction against a shape no farther than maxDistance. The ray
+// moves into unit mesh space through the inverse world matrix, where distances along it
+// are unchanged, so the exact unit tests hold for any rotation and non-uniform scale.
+static bool RaycastWorldShape(RayPals3DShape* shape, RayPals3DSprite* sprite, Ray ray, float maxDistance, RayCollision* collision) {
+    const Matrix* m = Refresh3DShapeWorldMatrix(shape, sprite);
+    Matrix n = GetNormalMatrix(m);
+    float determinant = m->m0*n.m0 + m->m4*n.m4 + m->m8*n.m8;   // Positive, as n carries its sign
+    if (!(determinant > 0.0f)) return false;
+    
+    // The inverse of the linear part is the transposed normal matrix over the determinant
+    Vector3 offset = { ray.position.x - m->m12, ray.position.y - m->m13, ray.position.z - m->m14 };
+    Vector3 dir = ray.direction;
+    Vector3 origin = {
+        (n.m0*offset.x + n.m1*offset.y + n.m2*offset.z) / determinant,
+        (n.m4*offset.x + n.m5*offset.y + n.m6*offset.z) / determinant,
+        (n.m8*offset.x + n.m9*offset.y + n.m10*offset.z) / determinant
+    };
+    Vector3 direction = {
+        (n.m0*dir.x + n.m1*dir.y + n.m2*dir.z) / determinant,
+        (n.m4*dir.x + n.m5*dir.y + n.m6*dir.z) / determinant,
+        (n.m8*dir.x + n.m9*dir.y + n.m10*dir.z) / determinant
+    };
+    
+    Vector3 localNormal = { 0, 0, 0 };
+    float t = RaycastUnitShape(shape->type, origin, direction, &localNormal);
+    if (t == INFINITY || t > maxDistance) return false;
+    
+    // Report the normal facing the ray, which flips it when the ray starts inside
+    Vector3 normal = TransformDirection(&n, localNormal);
+    float length = sqrtf(normal.x*normal.x + normal.y*normal.y + normal.z*normal.z);
+    if (length > 0.0f) normal = (Vector3){ normal.x / length, normal.y / length, normal.z / length };
+    if (normal.x*dir.x + normal.y*dir.y + normal.z*dir.z > 0.0f) normal = (Vector3){ -normal.x, -normal.y, -normal.z };
+    
+    collision->hit = true;
+    collision->distance = t;
+    collision->point = (Vector3){ ray.position.x + t*dir.x, ray.position.y + t*dir.y, ray.position.z + t*dir.z };
+    collision->normal = normal;
+    return true;
+}
+
+// Nearest visible shape of a sprite hit closer than maxDistance, or -1. The sprite and
+// shape boxes reject most misses before the exact tests.
+static int RaycastSprite(RayPals3DSprite* sprite, Ray ray, Vector3 inverse, float maxDistance, RayCollision* collision) {
+    const RayPalsBounds3D* bounds = Refresh3DSpriteBounds(sprite);
+    if (GetRayBoxEntry(ray.position, inverse, maxDistance, &bounds->box) == INFINITY) return -1;
+    
+    int nearest = -1;
+    for (int i = 0; i < sprite->shapeCount; i++) {
+        RayPals3DShape* shape = sprite->shapes[i];
+        if (shape == NULL || !shape->visible) continue;
+        if (GetRayBoxEntry(ray.position, inverse, maxDistance, &shape->bounds.box) == INFINITY) continue;
+        
+        if (RaycastWorldShape(shape, sprite, ray, maxDistance, collision)) {
+            maxDistance = collision->distance;
+            nearest = i;
+        }
     }
+    
+    return nearest;
+}
 
-    // Set sprite position
-    SetSpritePosition(sprite, position);
+RayCollision GetRayCollision3DShape(Ray ray, RayPals3DShape* shape, RayPals3DSprite* sprite) {
+    RayCollision collision = { 0 };
+    if (!shape || !NormalizeRay(&ray)) return collision;
+    
+    RaycastWorldShape(shape, sprite, ray, INFINITY, &collision);
+    return collision;
+}
 
-    return sprite;
-}
\ No newline at end of file
+RayCollision GetRayCollision3DSprite(Ray ray, RayPals3DSprite* sprite, int* shapeIndex) {
+    RayCollision collision = { 0 };
+    if (shapeIndex) *shapeIndex = -1;
+    if (!sprite || !sprite->visible || !NormalizeRay(&ray)) return collision;
+    
+    Vector3 inverse = { 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+    int index = RaycastSprite(sprite, ray, inverse, INFINITY, &collision);
+    if (shapeIndex) *shapeIndex = index;
+    return collision;
+}
+
+RayPals3DSprite* Raycast3DBVH(const RayPals3DBVH* bvh, Ray ray, float maxDistance, RayCollision* collision, int* shapeIndex) {
+    RayCollision nearest = { 0 };
+    RayPals3DSprite* hitSprite = NULL;
+    int hitShape = -1;
+    
+    if (bvh && bvh->nodeCount > 0 && maxDistance >= 0.0f && NormalizeRay(&ray)) {
+        Vector3 inverse = { 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+        int stack[RAYPALS_BVH_STACK];
+        int top = 0;
+        stack[top++] = 0;
+        
+        // Every hit shortens the ray, so nodes beyond the nearest hit so far are skipped
+        while (top > 0) {
+            const RayPalsBVHNode* node = &bvh->nodes[stack[--top]];
+            if (GetRayBoxEntry(ray.position, inverse, maxDistance, &node->box) == INFINITY) continue;
+            
+            if (node->left >= 0) {
+                // Pop the nearer child first
+                float leftEntry = GetRayBoxEntry(ray.position, inverse, maxDistance, &bvh->nodes[node->left].box);
+                float rightEntry = GetRayBoxEntry(ray.position, inverse, maxDistance, &bvh->nodes[node->left + 1].box);
+                int nearChild = leftEntry <= rightEntry ? node->left : node->left + 1;
+                if (fmaxf(leftEntry, rightEntry) != INFINITY) stack[top++] = nearChild == node->left ? node->left + 1 : node->left;
+                if (fminf(leftEntry, rightEntry) != INFINITY) stack[top++] = nearChild;
+                continue;
+            }
+            
+            for (int i = node->first; i < node->first + node->count; i++) {
+                RayPals3DSprite* sprite = bvh->sprites[i];
+                if (!sprite->visible || GetRayBoxEntry(ray.position, inverse, maxDistance, &sprite->bounds.box) == INFINITY) continue;
+                
+                int index = RaycastSprite(sprite, ray, inverse, maxDistance, &nearest);
+                if (index < 0) continue;
+                
+                hitSprite = sprite;
+                hitShape = index;
+                maxDistance = nearest.distance;
+            }
+        }
+    }
+    
+    if (collision) *collision = nearest;
+    if (shapeIndex) *shapeIndex = hitShape;
+    return hitSprite;
+}
@@ -0,0 +1,90 @@
+#include "raypals_thread.h"
+#include <stdlib.h>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+// Threads start through a trampoline so both platforms share one entry signature
+typedef struct {
+    RayPalsThreadEntry entry;
+    void* argument;
+} RayPalsThreadStart;
+
+#if defined(_WIN32)
+_Static_assert(sizeof(RayPalsMutex) == sizeof(SRWLOCK), "RayPalsMutex must hold an SRWLOCK");
+_Static_assert(sizeof(RayPalsCondition) == sizeof(CONDITION_VARIABLE), "RayPalsCondition must hold a CONDITION_VARIABLE");
+
+void RayPalsInitMutex(RayPalsMutex* mutex) { InitializeSRWLock((PSRWLOCK)mutex); }
+void RayPalsDestroyMutex(RayPalsMutex* mutex) { (void)mutex; }
+void RayPalsLockMutex(RayPalsMutex* mutex) { AcquireSRWLockExclusive((PSRWLOCK)mutex); }
+void RayPalsUnlockMutex(RayPalsMutex* mutex) { ReleaseSRWLockExclusive((PSRWLOCK)mutex); }
+void RayPalsInitCondition(RayPalsCondition* condition) { InitializeConditionVariable((PCONDITION_VARIABLE)condition); }
+void RayPalsDestroyCondition(RayPalsCondition* condition) { (void)condition; }
+void RayPalsBroadcastCondition(RayPalsCondition* condition) { WakeAllConditionVariable((PCONDITION_VARIABLE)condition); }
+int RayPalsGetProcessorCount(void) { return (int)GetActiveProcessorCount(ALL_PROCESSOR_GROUPS); }
+
+void RayPalsWaitCondition(RayPalsCondition* condition, RayPalsMutex* mutex) {
+    SleepConditionVariableSRW((PCONDITION_VARIABLE)condition, (PSRWLOCK)mutex, INFINITE, 0);
+}
+
+static DWORD WINAPI ThreadMain(LPVOID argument) {
+    RayPalsThreadStart start = *(RayPalsThreadStart*)argument;
+    free(argument);
+    start.entry(start.argument);
+    return 0;
+}
+
+bool RayPalsStartThread(RayPalsThread* thread, RayPalsThreadEntry entry, void* argument) {
+    RayPalsThreadStart* start = (RayPalsThreadStart*)malloc(sizeof(RayPalsThreadStart));
+    if (start == NULL) return false;
+    start->entry = entry;
+    start->argument = argument;
+    
+    *thread = CreateThread(NULL, 0, ThreadMain, start, 0, NULL);
+    if (*thread == NULL) {
+        free(start);
+        return false;
+    }
+    return true;
+}
+
+void RayPalsJoinThread(RayPalsThread thread) {
+    WaitForSingleObject((HANDLE)thread, INFINITE);
+    CloseHandle((HANDLE)thread);
+}
+#else
+void RayPalsInitMutex(RayPalsMutex* mutex) { pthread_mutex_init(mutex, NULL); }
+void RayPalsDestroyMutex(RayPalsMutex* mutex) { pthread_mutex_destroy(mutex); }
+void RayPalsLockMutex(RayPalsMutex* mutex) { pthread_mutex_lock(mutex); }
+void RayPalsUnlockMutex(RayPalsMutex* mutex) { pthread_mutex_unlock(mutex); }
+void RayPalsInitCondition(RayPalsCondition* condition) { pthread_cond_init(condition, NULL); }
+void RayPalsDestroyCondition(RayPalsCondition* condition) { pthread_cond_destroy(condition); }
+void RayPalsWaitCondition(RayPalsCondition* condition, RayPalsMutex* mutex) { pthread_cond_wait(condition, mutex); }
+void RayPalsBroadcastCondition(RayPalsCondition* condition) { pthread_cond_broadcast(condition); }
+int RayPalsGetProcessorCount(void) { return (int)sysconf(_SC_NPROCESSORS_ONLN); }
+
+static void* ThreadMain(void* argument) {
+    RayPalsThreadStart start = *(RayPalsThreadStart*)argument;
+    free(argument);
+    start.entry(start.argument);
+    return NULL;
+}
+
+bool RayPalsStartThread(RayPalsThread* thread, RayPalsThreadEntry entry, void* argument) {
+    RayPalsThreadStart* start = (RayPalsThreadStart*)malloc(sizeof(RayPalsThreadStart));
+    if (start == NULL) return false;
+    start->entry = entry;
+    start->argument = argument;
+    
+    if (pthread_create(thread, NULL, ThreadMain, start) != 0) {
+        free(start);
+        return false;
+    }
+    return true;
+}
+
+void RayPalsJoinThread(RayPalsThread thread) { pthread_join(thread, NULL); }
+#endif
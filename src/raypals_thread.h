@@ -0,0 +1,37 @@
+#ifndef RAYPALS_THREAD_H
+#define RAYPALS_THREAD_H
+
+#include <stdbool.h>
+
+// Locks, condition variables and threads for the worker pool and the atlas baker.
+// Internal to the library: windows.h clashes with raylib names (Rectangle, CloseWindow, ...),
+// so the Win32 implementation lives in raypals_thread.c, which never includes raylib.h.
+
+#if defined(_WIN32)
+typedef struct { void* ptr; } RayPalsMutex;         // Storage for an SRWLOCK
+typedef struct { void* ptr; } RayPalsCondition;     // Storage for a CONDITION_VARIABLE
+typedef void* RayPalsThread;                        // HANDLE
+#else
+#include <pthread.h>
+typedef pthread_mutex_t RayPalsMutex;
+typedef pthread_cond_t RayPalsCondition;
+typedef pthread_t RayPalsThread;
+#endif
+
+typedef void (*RayPalsThreadEntry)(void* argument);
+
+void RayPalsInitMutex(RayPalsMutex* mutex);
+void RayPalsDestroyMutex(RayPalsMutex* mutex);
+void RayPalsLockMutex(RayPalsMutex* mutex);
+void RayPalsUnlockMutex(RayPalsMutex* mutex);
+void RayPalsInitCondition(RayPalsCondition* condition);
+void RayPalsDestroyCondition(RayPalsCondition* condition);
+void RayPalsWaitCondition(RayPalsCondition* condition, RayPalsMutex* mutex);
+void RayPalsBroadcastCondition(RayPalsCondition* condition);
+int RayPalsGetProcessorCount(void);
+
+// Runs entry(argument) on a new thread; false if the thread could not be started
+bool RayPalsStartThread(RayPalsThread* thread, RayPalsThreadEntry entry, void* argument);
+void RayPalsJoinThread(RayPalsThread thread);
+
+#endif // RAYPALS_THREAD_H
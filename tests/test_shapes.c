@@ -1,6 +1,8 @@
 #include <raylib.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
+#include <string.h>
 #include "../include/raypals.h"
 
 // Test function declarations
@@ -10,6 +12,31 @@ void test_sprite_creation();
 void test_shape_manipulation();
 void test_animation();
 void test_3d_robot_creation();
+void test_shape_arena();
+void test_inline_sprite();
+void test_sprite_capacity();
+void test_shape_batch();
+void test_sprite_template();
+void test_sprite_cache();
+void test_batched_sprites();
+void test_lod();
+void test_sprite_bounds();
+void test_software_canvas();
+void test_tiled_canvas();
+void test_canvas_kernels();
+void test_sprite_atlas();
+void test_atlas_tiers();
+void test_retained_scene();
+void test_render_queue();
+void test_3d_mesh_cache();
+void test_3d_static_batch();
+void test_transform_cache();
+void test_3d_batch_scope();
+void test_3d_frustum_culling();
+void test_3d_bvh();
+void test_3d_lod();
+void test_3d_instancing();
+void test_picking();
 
 int main() {
     // Initialize raylib window for testing
@@ -25,6 +52,31 @@ int main() {
     test_shape_manipulation();
     test_animation();
     test_3d_robot_creation();
+    test_shape_arena();
+    test_inline_sprite();
+    test_sprite_capacity();
+    test_shape_batch();
+    test_sprite_template();
+    test_sprite_cache();
+    test_batched_sprites();
+    test_lod();
+    test_sprite_bounds();
+    test_software_canvas();
+    test_tiled_canvas();
+    test_canvas_kernels();
+    test_sprite_atlas();
+    test_atlas_tiers();
+    test_retained_scene();
+    test_render_queue();
+    test_3d_mesh_cache();
+    test_3d_static_batch();
+    test_transform_cache();
+    test_3d_batch_scope();
+    test_3d_frustum_culling();
+    test_3d_bvh();
+    test_3d_lod();
+    test_3d_instancing();
+    test_picking();
 
     printf("All tests completed!\n");
 
@@ -300,4 +352,1821 @@ void test_3d_robot_creation() {
     
     printf("PASS: 3D robot creation test completed\n");
     Free3DSprite(robot);
-} 
\ No newline at end of file
+} 
+
+void test_shape_arena() {
+    printf("\nTesting shape arena...\n");
+    
+    RayPalsArena* arena = CreateShapeArena(4096);
+    if (arena == NULL) {
+        printf("FAIL: Arena creation failed\n");
+        return;
+    }
+    
+    // Prefabs built inside the arena scope come from the arena
+    BeginShapeArena(arena);
+    RayPalsSprite* dragon = CreateDragon((Vector2){ 100, 100 }, 80, DARKGREEN, GREEN);
+    RayPals3DSprite* robot = Create3DRobot((Vector3){ 0, 0, 0 }, 1.0f, RED, YELLOW);
+    EndShapeArena();
+    
+    // Objects created after the scope ends come from the heap again
+    RayPals2DShape* heapShape = CreateSquare((Vector2){ 0, 0 }, 10, RED);
+    
+    if (dragon == NULL || robot == NULL || heapShape == NULL) {
+        printf("FAIL: Arena allocation failed\n");
+        return;
+    }
+    
+    if (dragon->arena != arena || dragon->shapes[0]->arena != arena || robot->shapes[0]->arena != arena) {
+        printf("FAIL: Arena objects not tagged with their arena\n");
+    }
+    
+    if (heapShape->arena != NULL) {
+        printf("FAIL: Heap shape tagged with an arena\n");
+    }
+    
+    if (GetShapeArenaUsage(arena) == 0) {
+        printf("FAIL: Arena usage not tracked\n");
+    }
+    
+    // Heap shapes can still join arena sprites and FreeSprite stays safe
+    AddShapeToSprite(dragon, heapShape);
+    FreeSprite(dragon);
+    Free3DSprite(robot);
+    
+    ResetShapeArena(arena);
+    if (GetShapeArenaUsage(arena) != 0) {
+        printf("FAIL: Arena reset did not release its memory\n");
+    }
+    
+    // Slabs are reused after a reset
+    BeginShapeArena(arena);
+    RayPalsSprite* grapes = CreateGrapes((Vector2){ 0, 0 }, 40, PURPLE, BROWN);
+    EndShapeArena();
+    
+    if (grapes == NULL || grapes->arena != arena) {
+        printf("FAIL: Arena allocation after reset failed\n");
+    }
+    
+    // Re-entering the same arena needs one EndShapeArena per BeginShapeArena
+    BeginShapeArena(arena);
+    BeginShapeArena(arena);
+    EndShapeArena();
+    RayPals2DShape* inner = CreateSquare((Vector2){ 0, 0 }, 10, RED);
+    EndShapeArena();
+    RayPals2DShape* outer = CreateSquare((Vector2){ 0, 0 }, 10, RED);
+    if (inner->arena != arena || outer->arena != NULL) {
+        printf("FAIL: Re-entered arena scope ended at the wrong EndShapeArena\n");
+    }
+    FreeShape(outer);
+    
+    // Freeing an arena below the top of the stack never reactivates it
+    RayPalsArena* other = CreateShapeArena(4096);
+    BeginShapeArena(arena);
+    BeginShapeArena(other);
+    FreeShapeArena(arena);
+    RayPals2DShape* fromOther = CreateSquare((Vector2){ 0, 0 }, 10, RED);
+    EndShapeArena();
+    RayPals2DShape* fromHeap = CreateSquare((Vector2){ 0, 0 }, 10, RED);
+    EndShapeArena();
+    if (fromOther->arena != other || fromHeap->arena != NULL) {
+        printf("FAIL: Freed arena was left on the arena stack\n");
+    }
+    FreeShape(fromHeap);
+    
+    FreeShapeArena(other);
+    printf("PASS: Shape arena test completed\n");
+}
+
+void test_inline_sprite() {
+    printf("\nTesting inline sprite storage...\n");
+    
+    RayPalsSprite* sprite = CreateInlineSprite(2);
+    if (sprite == NULL || sprite->shapeStorage == NULL) {
+        printf("FAIL: Inline sprite creation failed\n");
+        return;
+    }
+    
+    AddShapeToSprite(sprite, CreateSquare((Vector2){ 10, 10 }, 20, RED));
+    AddShapeToSprite(sprite, CreateCircle((Vector2){ 30, 30 }, 15, BLUE));
+    AddShapeToSprite(sprite, CreateTriangle((Vector2){ 50, 50 }, 10, GREEN));
+    
+    if (sprite->shapeCount != 3) {
+        printf("FAIL: Inline sprite shape count incorrect\n");
+    }
+    
+    // Shapes are stored by value and the pointer array points into the storage
+    for (int i = 0; i < sprite->shapeCount; i++) {
+        if (sprite->shapes[i] != &sprite->shapeStorage[i]) {
+            printf("FAIL: Inline sprite pointer %d does not reference storage\n", i);
+        }
+    }
+    
+    if (sprite->shapeStorage[1].type != RAYPALS_CIRCLE || sprite->shapeStorage[2].color.g != GREEN.g) {
+        printf("FAIL: Inline sprite shapes not copied correctly\n");
+    }
+    
+    // The pointer passed to AddShapeToSprite was freed; edits go through the sprite's copy
+    RayPals2DShape* copy = GetSpriteShape(sprite, 1);
+    SetShapeColor(copy, YELLOW);
+    if (copy != &sprite->shapeStorage[1] || sprite->shapeStorage[1].color.b != YELLOW.b || GetSpriteShape(sprite, 3) != NULL) {
+        printf("FAIL: GetSpriteShape did not return the inline copy\n");
+    }
+    
+    // Pointer-based sprites keep the caller's shape
+    RayPalsSprite* pointerSprite = CreateSprite(1);
+    RayPals2DShape* kept = CreateSquare((Vector2){ 0, 0 }, 10, RED);
+    AddShapeToSprite(pointerSprite, kept);
+    SetShapeColor(kept, BLUE);
+    if (GetSpriteShape(pointerSprite, 0) != kept || pointerSprite->shapes[0]->color.b != BLUE.b) {
+        printf("FAIL: Pointer sprite did not keep the caller's shape\n");
+    }
+    FreeSprite(pointerSprite);
+    
+    FreeSprite(sprite);
+    
+    // Prefab sprites can be converted after creation
+    RayPalsSprite* castle = CreateCastle((Vector2){ 200, 200 }, 100, GRAY, RED);
+    int count = castle->shapeCount;
+    RayPalsShapeType firstType = castle->shapes[0]->type;
+    
+    if (!MakeSpriteInline(castle) || castle->shapeStorage == NULL) {
+        printf("FAIL: Sprite conversion to inline storage failed\n");
+    } else if (castle->shapeCount != count || castle->shapeStorage[0].type != firstType ||
+               castle->shapes[count - 1] != &castle->shapeStorage[count - 1]) {
+        printf("FAIL: Converted sprite shapes incorrect\n");
+    }
+    
+    FreeSprite(castle);
+    printf("PASS: Inline sprite storage test completed\n");
+}
+
+void test_sprite_capacity() {
+    printf("\nTesting sprite capacity growth...\n");
+    
+    RayPalsSprite* sprite = CreateSprite(2);
+    if (sprite == NULL) {
+        printf("FAIL: Sprite creation failed\n");
+        return;
+    }
+    
+    if (sprite->shapeCapacity != 2) {
+        printf("FAIL: Initial capacity not honored\n");
+    }
+    
+    // Growth is geometric rather than one slot per add
+    for (int i = 0; i < 3; i++) {
+        AddShapeToSprite(sprite, CreateCircle((Vector2){ i * 10.0f, 0 }, 5, RED));
+    }
+    
+    if (sprite->shapeCount != 3 || sprite->shapeCapacity < 4) {
+        printf("FAIL: Capacity did not grow geometrically (count %d, capacity %d)\n",
+               sprite->shapeCount, sprite->shapeCapacity);
+    }
+    
+    // Bulk insertion reserves once for the whole batch
+    RayPals2DShape* batch[10];
+    for (int i = 0; i < 10; i++) batch[i] = CreateSquare((Vector2){ 0, i * 10.0f }, 5, BLUE);
+    AddShapesToSprite(sprite, batch, 10);
+    
+    if (sprite->shapeCount != 13 || sprite->shapes[12] != batch[9]) {
+        printf("FAIL: Bulk insertion incorrect\n");
+    }
+    
+    ShrinkSpriteToFit(sprite);
+    if (sprite->shapeCapacity != sprite->shapeCount) {
+        printf("FAIL: ShrinkSpriteToFit did not trim capacity\n");
+    }
+    
+    FreeSprite(sprite);
+    
+    // Prefabs allocate their shape array exactly once
+    RayPalsSprite* waterfall = CreateWaterfallSprite((Vector2){ 0, 0 }, 100, 300, SKYBLUE);
+    if (waterfall->shapeCapacity != waterfall->shapeCount) {
+        printf("FAIL: Waterfall prefab capacity %d does not match %d drops\n",
+               waterfall->shapeCapacity, waterfall->shapeCount);
+    }
+    FreeSprite(waterfall);
+    
+    RayPals3DSprite* ship = Create3DSpaceship((Vector3){ 0, 0, 0 }, 1.0f, GRAY, SKYBLUE);
+    RayPals3DShape* extras[2] = {
+        CreateSphere((Vector3){ 0, 1, 0 }, 0.2f, 8, RED),
+        CreateCube((Vector3){ 0, -1, 0 }, (Vector3){ 1, 1, 1 }, BLUE)
+    };
+    AddShapesTo3DSprite(ship, extras, 2);
+    
+    if (ship->shapeCount != 7 || ship->shapes[6] != extras[1]) {
+        printf("FAIL: 3D bulk insertion incorrect\n");
+    }
+    
+    Shrink3DSpriteToFit(ship);
+    if (ship->shapeCapacity != ship->shapeCount) {
+        printf("FAIL: Shrink3DSpriteToFit did not trim capacity\n");
+    }
+    
+    Free3DSprite(ship);
+    printf("PASS: Sprite capacity test completed\n");
+}
+
+void test_shape_batch() {
+    printf("\nTesting shape batch...\n");
+    
+    if (CreateShapeBatch(RAYPALS_SKELETON, 4) != NULL) {
+        printf("FAIL: Skeleton shapes should not be batchable\n");
+    }
+    
+    RayPalsShapeBatch* batch = CreateShapeBatch(RAYPALS_CIRCLE, 2);
+    if (batch == NULL) {
+        printf("FAIL: Shape batch is NULL\n");
+        return;
+    }
+    
+    for (int i = 0; i < 100; i++) {
+        AddShapeToBatch(batch, (Vector2){ (float)i, 0 }, (Vector2){ 10, 10 }, 0, RED);
+    }
+    
+    if (batch->count != 100 || batch->capacity < 100) {
+        printf("FAIL: Batch did not grow (count %d, capacity %d)\n", batch->count, batch->capacity);
+    }
+    
+    SetBatchShapeVelocity(batch, 5, (Vector2){ 10, -20 }, 90);
+    UpdateShapeBatch(batch, 0.5f);
+    
+    if (batch->positionX[5] != 10.0f || batch->positionY[5] != -10.0f || batch->rotation[5] != 45.0f) {
+        printf("FAIL: Batch update incorrect\n");
+    }
+    if (batch->positionX[6] != 6.0f || batch->positionY[6] != 0.0f) {
+        printf("FAIL: Batch update moved a stationary element\n");
+    }
+    
+    TransformShapeBatch(batch, (Vector2){ 100, 50 }, 0, 2.0f);
+    if (batch->positionX[1] != 102.0f || batch->positionY[1] != 50.0f || batch->sizeX[1] != 20.0f) {
+        printf("FAIL: Batch transform incorrect\n");
+    }
+    
+    // Removal swaps the last element into the hole
+    RemoveShapeFromBatch(batch, 0);
+    if (batch->count != 99 || batch->positionX[0] != 100.0f + 99 * 2.0f) {
+        printf("FAIL: Batch removal incorrect\n");
+    }
+    
+    DrawShapeBatch(batch);
+    if (batch->unitVertexCount != 36 * 3) {
+        printf("FAIL: Batch template has %d vertices\n", batch->unitVertexCount);
+    }
+    
+    FreeShapeBatch(batch);
+    printf("PASS: Shape batch test completed\n");
+}
+
+void test_sprite_template() {
+    printf("\nTesting sprite templates...\n");
+    
+    RayPalsSprite* bush = CreateBush((Vector2){ 50, 50 }, 100, GREEN);
+    RayPalsSpriteTemplate* bushTemplate = CreateSpriteTemplate(bush);
+    
+    if (bushTemplate == NULL || bushTemplate->shapeCount != bush->shapeCount) {
+        printf("FAIL: Template did not copy the sprite's shapes\n");
+        FreeSprite(bush);
+        return;
+    }
+    
+    if (bushTemplate->shapes[2].position.y != bush->shapes[2]->position.y) {
+        printf("FAIL: Template shapes are not in local space\n");
+    }
+    
+    // The template no longer depends on the source sprite
+    FreeSprite(bush);
+    
+    RayPalsSpriteInstance instances[1000];
+    for (int i = 0; i < 1000; i++) {
+        instances[i] = CreateSpriteInstance(bushTemplate, (Vector2){ i * 10.0f, 0 }, 0.5f);
+    }
+    
+    if (instances[999].spriteTemplate != bushTemplate || !instances[999].visible ||
+        !ColorIsEqual(instances[999].tint, WHITE) || instances[999].scale != 0.5f) {
+        printf("FAIL: Instance defaults incorrect\n");
+    }
+    
+    // Tinting while drawing must not modify the shared template
+    instances[0].tint = RED;
+    DrawSpriteInstances(instances, 1000);
+    if (!ColorIsEqual(bushTemplate->shapes[0].color, GREEN)) {
+        printf("FAIL: Drawing a tinted instance modified the template\n");
+    }
+    
+    FreeSpriteTemplate(bushTemplate);
+    printf("PASS: Sprite template test completed\n");
+}
+
+void test_sprite_cache() {
+    printf("\nTesting sprite tessellation cache...\n");
+    
+    RayPalsSprite* sprite = CreateSprite(2);
+    RayPals2DShape* body = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ 20, 10 }, BLUE);
+    RayPals2DShape* wheel = CreateCircle((Vector2){ 0, 10 }, 5, BLACK);
+    AddShapeToSprite(sprite, body);
+    AddShapeToSprite(sprite, wheel);
+    
+    if (GetSpriteCachedVertexCount(sprite) != 0) {
+        printf("FAIL: Sprite cache exists before the first draw\n");
+    }
+    
+    // Rectangle (2 triangles) plus a 36 segment circle fan
+    DrawSprite(sprite);
+    if (GetSpriteCachedVertexCount(sprite) != 6 + 36 * 3) {
+        printf("FAIL: Cached vertex count %d incorrect\n", GetSpriteCachedVertexCount(sprite));
+    }
+    
+    // Setters renew the shape version; the next draw rebuilds the cache
+    SetShapeColor(wheel, DARKGRAY);
+    if (GetSpriteCachedVertexCount(sprite) != 0) {
+        printf("FAIL: SetShapeColor did not invalidate the cache\n");
+    }
+    DrawSprite(sprite);
+    if (GetSpriteCachedVertexCount(sprite) == 0) {
+        printf("FAIL: Cache was not rebuilt after a shape change\n");
+    }
+    
+    // Sprite transforms are applied at draw time and keep the cache valid
+    SetSpritePosition(sprite, (Vector2){ 100, 100 });
+    RotateSprite(sprite, 1.0f, 45.0f);
+    if (GetSpriteCachedVertexCount(sprite) == 0) {
+        printf("FAIL: Sprite transform invalidated the cache\n");
+    }
+    
+    // Direct field writes need MarkSpriteDirty
+    wheel->visible = false;
+    MarkSpriteDirty(sprite);
+    DrawSprite(sprite);
+    if (GetSpriteCachedVertexCount(sprite) != 6) {
+        printf("FAIL: Hidden shape still cached (%d vertices)\n", GetSpriteCachedVertexCount(sprite));
+    }
+    
+    // Adding a shape invalidates the cache as well
+    AddShapeToSprite(sprite, CreateTriangle((Vector2){ 0, -10 }, 10, RED));
+    if (GetSpriteCachedVertexCount(sprite) != 0) {
+        printf("FAIL: Adding a shape did not invalidate the cache\n");
+    }
+    
+    FreeSprite(sprite);
+    
+    // Arena sprites keep their cache in the arena
+    RayPalsArena* arena = CreateShapeArena(0);
+    BeginShapeArena(arena);
+    RayPalsSprite* ghost = CreateGhost((Vector2){ 0, 0 }, 40, VIOLET);
+    EndShapeArena();
+    DrawSprite(ghost);
+    if (GetSpriteCachedVertexCount(ghost) == 0) {
+        printf("FAIL: Arena sprite was not cached\n");
+    }
+    
+    // A shape shared by two sprites invalidates both caches, whichever rebuilds first
+    BeginShapeArena(arena);
+    RayPals2DShape* shared = CreateCircle((Vector2){ 0, 0 }, 5, RED);
+    RayPalsSprite* first = CreateSprite(1);
+    RayPalsSprite* second = CreateSprite(1);
+    EndShapeArena();
+    AddShapeToSprite(first, shared);
+    AddShapeToSprite(second, shared);
+    DrawSprite(first);
+    DrawSprite(second);
+    SetShapeColor(shared, BLUE);
+    DrawSprite(first);
+    if (GetSpriteCachedVertexCount(first) == 0 || GetSpriteCachedVertexCount(second) != 0) {
+        printf("FAIL: Rebuilding one sprite hid a shared shape edit from the other\n");
+    }
+    FreeShapeArena(arena);
+    
+    printf("PASS: Sprite cache test completed\n");
+}
+
+void test_batched_sprites() {
+    printf("\nTesting batched sprite drawing...\n");
+    
+    RayPalsSprite* sprites[3] = {
+        CreateBush((Vector2){ 10, 10 }, 20, GREEN),
+        CreateRock((Vector2){ 50, 10 }, 20, GRAY),
+        CreateSimpleTree((Vector2){ 90, 10 }, 30, BROWN, DARKGREEN)
+    };
+    sprites[1]->visible = false;
+    
+    ResetDrawStats();
+    DrawSpritesBatched(sprites, 3);
+    RayPalsDrawStats stats = GetDrawStats();
+    
+    int expected = GetSpriteCachedVertexCount(sprites[0]) + GetSpriteCachedVertexCount(sprites[2]);
+    if (stats.sprites != 2 || stats.batches != 1 || stats.vertices != expected || expected == 0) {
+        printf("FAIL: Batched stats incorrect (sprites %d, batches %d, vertices %d)\n",
+               stats.sprites, stats.batches, stats.vertices);
+    }
+    
+    // The matrix path submits the same cached vertices, one run per sprite
+    ResetDrawStats();
+    DrawSprite(sprites[0]);
+    DrawSprite(sprites[2]);
+    if (GetDrawStats().vertices != expected || GetDrawStats().batches != 2) {
+        printf("FAIL: DrawSprite stats incorrect\n");
+    }
+    
+    for (int i = 0; i < 3; i++) FreeSprite(sprites[i]);
+    printf("PASS: Batched sprite test completed\n");
+}
+
+void test_lod() {
+    printf("\nTesting screen-space LOD...\n");
+    
+    RayPalsLODSettings defaults = GetLODSettings();
+    if (defaults.enabled) {
+        printf("FAIL: LOD should be disabled by default\n");
+    }
+    
+    RayPalsLODSettings settings = defaults;
+    settings.enabled = true;
+    SetLODSettings(settings);
+    
+    int small = GetCircleLODSegments(2.0f);
+    int large = GetCircleLODSegments(400.0f);
+    if (small != settings.minSegments || large <= small || large > settings.maxSegments) {
+        printf("FAIL: LOD segment counts incorrect (small %d, large %d)\n", small, large);
+    }
+    
+    // The chosen count keeps the chord error within the tolerance
+    float radius = 100.0f;
+    int segments = GetCircleLODSegments(radius);
+    if (radius * (1.0f - cosf(PI / segments)) > settings.tolerance) {
+        printf("FAIL: LOD error exceeds the tolerance\n");
+    }
+    
+    settings.quality = 4.0f;
+    SetLODSettings(settings);
+    if (GetCircleLODSegments(radius) <= segments) {
+        printf("FAIL: Higher quality did not add segments\n");
+    }
+    settings.quality = 1.0f;
+    SetLODSettings(settings);
+    
+    // A tiny on-screen circle uses far fewer vertices than its stored 36 segments
+    RayPalsSprite* sprite = CreateSprite(1);
+    AddShapeToSprite(sprite, CreateCircle((Vector2){ 0, 0 }, 50, RED));
+    SetSpriteScale(sprite, 0.02f);
+    DrawSprite(sprite);
+    int tinyVertices = GetSpriteCachedVertexCount(sprite);
+    if (tinyVertices != settings.minSegments * 3) {
+        printf("FAIL: Tiny circle used %d vertices\n", tinyVertices);
+    }
+    
+    // Growing the sprite rebuilds the cache with more segments
+    SetSpriteScale(sprite, 8.0f);
+    DrawSprite(sprite);
+    if (GetSpriteCachedVertexCount(sprite) <= tinyVertices) {
+        printf("FAIL: Cache was not rebuilt for a larger scale\n");
+    }
+    
+    // Turning LOD off restores the shape's own segment count
+    SetLODSettings(defaults);
+    DrawSprite(sprite);
+    if (GetSpriteCachedVertexCount(sprite) != 36 * 3) {
+        printf("FAIL: Disabling LOD did not restore 36 segments\n");
+    }
+    
+    FreeSprite(sprite);
+    printf("PASS: LOD test completed\n");
+}
+
+void test_sprite_bounds() {
+    printf("\nTesting sprite bounds and culling...\n");
+    
+    RayPalsSprite* sprite = CreateSprite(1);
+    AddShapeToSprite(sprite, CreateRectangle((Vector2){ 10, 0 }, (Vector2){ 20, 10 }, RED));
+    SetSpritePosition(sprite, (Vector2){ 100, 50 });
+    
+    Rectangle bounds = GetSpriteBounds(sprite);
+    if (bounds.x != 100.0f || bounds.y != 45.0f || bounds.width != 20.0f || bounds.height != 10.0f) {
+        printf("FAIL: Sprite bounds incorrect (%.1f, %.1f, %.1f, %.1f)\n", bounds.x, bounds.y, bounds.width, bounds.height);
+    }
+    
+    // Sprite rotation and scale are applied to the cached local box
+    SetSpriteRotation(sprite, 90.0f);
+    SetSpriteScale(sprite, 2.0f);
+    bounds = GetSpriteBounds(sprite);
+    if (fabsf(bounds.x - 90.0f) > 0.01f || fabsf(bounds.y - 50.0f) > 0.01f ||
+        fabsf(bounds.width - 20.0f) > 0.01f || fabsf(bounds.height - 40.0f) > 0.01f) {
+        printf("FAIL: Rotated sprite bounds incorrect (%.1f, %.1f, %.1f, %.1f)\n", bounds.x, bounds.y, bounds.width, bounds.height);
+    }
+    
+    // Shape rotation changes the local box through the dirty flag
+    SetSpriteRotation(sprite, 0.0f);
+    SetSpriteScale(sprite, 1.0f);
+    SetShapeRotation(sprite->shapes[0], 90.0f);
+    bounds = GetSpriteBounds(sprite);
+    if (fabsf(bounds.width - 10.0f) > 0.01f || fabsf(bounds.height - 20.0f) > 0.01f) {
+        printf("FAIL: Shape rotation not reflected in bounds\n");
+    }
+    
+    // Culling keeps sprites inside the view and skips the rest
+    RayPalsSprite* far = CreateRock((Vector2){ 5000, 5000 }, 20, GRAY);
+    RayPalsSprite* sprites[2] = { sprite, far };
+    Camera2D camera = { 0 };
+    camera.zoom = 1.0f;
+    
+    ResetDrawStats();
+    int drawn = DrawSpritesCulled(sprites, 2, camera);
+    if (drawn != 1 || GetDrawStats().culled != 1) {
+        printf("FAIL: Culling drew %d sprites (culled %d)\n", drawn, GetDrawStats().culled);
+    }
+    
+    // Moving the camera over the far sprite brings it into view
+    camera.target = (Vector2){ 4800, 4800 };
+    if (DrawSpritesCulled(sprites, 2, camera) != 1 || sprites[1] != far) {
+        printf("FAIL: Culling did not follow the camera\n");
+    }
+    
+    FreeSprite(sprite);
+    FreeSprite(far);
+    printf("PASS: Sprite bounds test completed\n");
+}
+
+void test_software_canvas() {
+    printf("\nTesting software canvas...\n");
+    
+    RayPalsCanvas* canvas = CreateCanvas(32, 32);
+    if (!canvas || canvas->image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+        printf("FAIL: Canvas creation failed\n");
+        return;
+    }
+    ClearCanvas(canvas, BLACK);
+    
+    // A half-transparent square is two triangles sharing a diagonal: every covered pixel
+    // must be blended exactly once, and the pixel centers inside x,y in [4, 12) covered
+    Color half = { 255, 0, 0, 128 };
+    RayPals2DShape* square = CreateSquare((Vector2){ 8, 8 }, 8, half);
+    DrawShapeToCanvas(canvas, square);
+    
+    Color* pixels = (Color*)canvas->image.data;
+    int covered = 0, overdrawn = 0;
+    for (int i = 0; i < 32*32; i++) {
+        if (pixels[i].r == 128 && pixels[i].a == 255) covered++;
+        else if (pixels[i].r != 0) overdrawn++;
+    }
+    if (covered != 64 || overdrawn != 0) {
+        printf("FAIL: Square covered %d pixels (%d blended twice)\n", covered, overdrawn);
+    }
+    if (pixels[4*32 + 4].r != 128 || pixels[11*32 + 11].r != 128 || pixels[12*32 + 12].r != 0) {
+        printf("FAIL: Square edges do not follow the fill rule\n");
+    }
+    
+    // A circle fan has many edges meeting at the center; none may be drawn twice
+    ClearCanvas(canvas, BLACK);
+    RayPals2DShape* circle = CreateCircle((Vector2){ 16, 16 }, 12, half);
+    DrawShapeToCanvas(canvas, circle);
+    
+    covered = overdrawn = 0;
+    for (int i = 0; i < 32*32; i++) {
+        if (pixels[i].r == 128) covered++;
+        else if (pixels[i].r != 0) overdrawn++;
+    }
+    if (overdrawn != 0 || covered < 400 || covered > 480) {
+        printf("FAIL: Circle covered %d pixels (%d blended twice)\n", covered, overdrawn);
+    }
+    
+    // Blending over a transparent canvas keeps the source color and alpha
+    ClearCanvas(canvas, BLANK);
+    ResetCanvasStats(canvas);
+    DrawCanvasTriangle(canvas, (Vector2){ 0, 0 }, (Vector2){ 32, 0 }, (Vector2){ 0, 32 }, half);
+    if (!ColorIsEqual(pixels[0], half) || canvas->stats.triangles != 1 || canvas->stats.pixels != 31*32/2) {
+        printf("FAIL: Triangle over transparent pixels (%d triangles, %lld pixels)\n",
+               canvas->stats.triangles, canvas->stats.pixels);
+    }
+    
+    // Sprites go through the camera: zooming in by 2 doubles the covered width
+    ClearCanvas(canvas, BLACK);
+    RayPalsSprite* sprite = CreateSprite(1);
+    SetSpritePosition(sprite, (Vector2){ 4, 4 });
+    AddShapeToSprite(sprite, CreateSquare((Vector2){ 0, 0 }, 4, RED));
+    SetCanvasCamera(canvas, (Camera2D){ { 0, 0 }, { 0, 0 }, 0.0f, 2.0f });
+    DrawSpriteToCanvas(canvas, sprite);
+    
+    covered = 0;
+    for (int i = 0; i < 32*32; i++) {
+        if (ColorIsEqual(pixels[i], RED)) covered++;
+    }
+    if (covered != 64 || !ColorIsEqual(pixels[4*32 + 4], RED)) {
+        printf("FAIL: Sprite through the canvas camera covered %d pixels\n", covered);
+    }
+    
+    FreeShape(square);
+    FreeShape(circle);
+    FreeSprite(sprite);
+    FreeCanvas(canvas);
+    printf("PASS: Software canvas test completed\n");
+}
+
+void test_tiled_canvas() {
+    printf("\nTesting multi-threaded canvas...\n");
+    
+    // Overlapping translucent sprites spanning several 64x64 tiles
+    RayPalsSprite* sprites[24];
+    for (int i = 0; i < 24; i++) {
+        Vector2 position = { (float)(20 + (i*53) % 260), (float)(20 + (i*37) % 180) };
+        sprites[i] = i % 2 ? CreateGhost(position, 30, Fade(VIOLET, 0.6f)) : CreateBush(position, 25, Fade(GREEN, 0.7f));
+    }
+    
+    RayPalsCanvas* serial = CreateCanvas(300, 200);
+    RayPalsCanvas* tiled = CreateCanvas(300, 200);
+    SetCanvasThreads(tiled, 4);
+    if (!serial || !tiled || tiled->threadCount < 2) {
+        printf("FAIL: Could not create a multi-threaded canvas\n");
+    }
+    
+    // Two frames, so the second reuses the queue and the clear drops recorded work
+    for (int frame = 0; frame < 2; frame++) {
+        ResetCanvasStats(serial);
+        ResetCanvasStats(tiled);
+        ClearCanvas(serial, RAYWHITE);
+        ClearCanvas(tiled, BLACK);
+        DrawSpriteToCanvas(tiled, sprites[0]);
+        ClearCanvas(tiled, RAYWHITE);
+        
+        for (int i = 0; i < 24; i++) {
+            SetSpriteRotation(sprites[i], frame*15.0f);
+            DrawSpriteToCanvas(serial, sprites[i]);
+            DrawSpriteToCanvas(tiled, sprites[i]);
+        }
+        FlushCanvas(tiled);
+        
+        if (memcmp(serial->image.data, tiled->image.data, 300*200*sizeof(Color)) != 0) {
+            printf("FAIL: Tiled output differs from the single-threaded output (frame %d)\n", frame);
+        }
+        if (tiled->stats.pixels != serial->stats.pixels || tiled->stats.triangles != serial->stats.triangles ||
+            tiled->stats.tileTriangles < serial->stats.triangles) {
+            printf("FAIL: Tiled stats (%lld pixels, %lld pairs) vs %lld pixels\n",
+                   tiled->stats.pixels, tiled->stats.tileTriangles, serial->stats.pixels);
+        }
+    }
+    
+    // Going back to one thread flushes and draws immediately again
+    DrawCanvasTriangle(tiled, (Vector2){ 0, 0 }, (Vector2){ 10, 0 }, (Vector2){ 0, 10 }, RED);
+    SetCanvasThreads(tiled, 1);
+    if (tiled->queue != NULL || !ColorIsEqual(((Color*)tiled->image.data)[0], RED)) {
+        printf("FAIL: Switching to one thread did not flush the canvas\n");
+    }
+    
+    for (int i = 0; i < 24; i++) FreeSprite(sprites[i]);
+    FreeCanvas(serial);
+    FreeCanvas(tiled);
+    printf("PASS: Multi-threaded canvas test completed\n");
+}
+
+// Draws opaque, translucent and overlapping triangles over both opaque and transparent pixels
+static void DrawKernelTestScene(RayPalsCanvas* canvas) {
+    ClearCanvas(canvas, BLANK);
+    DrawCanvasTriangle(canvas, (Vector2){ 0, 0 }, (Vector2){ 97, 0 }, (Vector2){ 0, 61 }, DARKBLUE);
+    
+    for (int i = 0; i < 40; i++) {
+        Color color = { (unsigned char)(i*37), (unsigned char)(255 - i*5), (unsigned char)(i*11), (unsigned char)(i*13 % 256) };
+        Vector2 a = { (float)(i*7 % 97), (float)(i*3 % 61) };
+        Vector2 b = { a.x + 30.3f, a.y + 5.7f };
+        Vector2 c = { a.x + 3.1f, a.y + 40.9f };
+        DrawCanvasTriangle(canvas, a, b, c, color);
+    }
+}
+
+void test_canvas_kernels() {
+    printf("\nTesting canvas span kernels...\n");
+    
+    RayPalsCanvasKernel original = GetCanvasKernel();
+    if (original == RAYPALS_CANVAS_KERNEL_AUTO || !IsCanvasKernelSupported(RAYPALS_CANVAS_KERNEL_SCALAR)) {
+        printf("FAIL: No span kernel was selected\n");
+    }
+    
+    RayPalsCanvas* reference = CreateCanvas(97, 61);
+    RayPalsCanvas* canvas = CreateCanvas(97, 61);
+    SetCanvasKernel(RAYPALS_CANVAS_KERNEL_SCALAR);
+    DrawKernelTestScene(reference);
+    
+    // Every supported kernel must reproduce the scalar image exactly
+    RayPalsCanvasKernel kernels[] = { RAYPALS_CANVAS_KERNEL_SSE2, RAYPALS_CANVAS_KERNEL_AVX2 };
+    for (int k = 0; k < 2; k++) {
+        if (!IsCanvasKernelSupported(kernels[k])) {
+            if (SetCanvasKernel(kernels[k])) printf("FAIL: Unsupported kernel %d was selected\n", kernels[k]);
+            continue;
+        }
+        
+        if (!SetCanvasKernel(kernels[k]) || GetCanvasKernel() != kernels[k]) {
+            printf("FAIL: Could not select kernel %d\n", kernels[k]);
+            continue;
+        }
+        DrawKernelTestScene(canvas);
+        if (memcmp(reference->image.data, canvas->image.data, 97*61*sizeof(Color)) != 0) {
+            printf("FAIL: Kernel %d differs from the scalar kernel\n", kernels[k]);
+        }
+    }
+    
+    SetCanvasKernel(RAYPALS_CANVAS_KERNEL_AUTO);
+    if (GetCanvasKernel() != original) {
+        printf("FAIL: Automatic kernel selection is not stable\n");
+    }
+    
+    FreeCanvas(reference);
+    FreeCanvas(canvas);
+    printf("PASS: Canvas kernel test completed\n");
+}
+
+void test_sprite_atlas() {
+    printf("\nTesting sprite atlas...\n");
+    
+    RayPalsSpriteAtlas* atlas = CreateSpriteAtlas(256, 256, 0);
+    if (atlas == NULL) {
+        printf("FAIL: Could not create sprite atlas\n");
+        return;
+    }
+    
+    // Two clouds share a key, so only the first one is baked
+    RayPalsSprite* cloudA = CreateCloud((Vector2){ 100, 100 }, 40, WHITE);
+    RayPalsSprite* cloudB = CreateCloud((Vector2){ 300, 80 }, 40, WHITE);
+    RayPalsSprite* house = CreateHouse((Vector2){ 200, 200 }, 60, LIGHTGRAY, RED);
+    RayPalsBakeKey cloudKey = { "CreateCloud", 40, { WHITE }, 0 };
+    RayPalsBakeKey houseKey = { "CreateHouse", 60, { LIGHTGRAY, RED }, 0 };
+    
+    Rectangle cloudSource = BakeSprite(atlas, cloudKey, cloudA);
+    Rectangle sharedSource = BakeSprite(atlas, cloudKey, cloudB);
+    Rectangle houseSource = BakeSprite(atlas, houseKey, house);
+    if (cloudSource.width <= 0 || houseSource.width <= 0) {
+        printf("FAIL: Sprites were not baked\n");
+    }
+    if (sharedSource.x != cloudSource.x || sharedSource.y != cloudSource.y) {
+        printf("FAIL: Sprites sharing a key did not share an entry\n");
+    }
+    if (atlas->stats.bakes != 2 || atlas->stats.hits != 1 || atlas->stats.entries != 2) {
+        printf("FAIL: Expected 2 bakes, 1 hit and 2 entries, got %d, %d and %d\n",
+               atlas->stats.bakes, atlas->stats.hits, atlas->stats.entries);
+    }
+    if (CheckCollisionRecs(cloudSource, houseSource)) {
+        printf("FAIL: Atlas entries overlap\n");
+    }
+    
+    // The baked texels carry the sprite's colors
+    Color* pixels = (Color*)atlas->canvas->image.data;
+    int opaque = 0;
+    for (int y = (int)houseSource.y; y < (int)(houseSource.y + houseSource.height); y++) {
+        for (int x = (int)houseSource.x; x < (int)(houseSource.x + houseSource.width); x++) {
+            if (pixels[y*256 + x].a == 255) opaque++;
+        }
+    }
+    if (opaque == 0) {
+        printf("FAIL: Baked house has no opaque texels\n");
+    }
+    
+    // The transparent border keeps the outermost texel rows empty
+    for (int x = (int)houseSource.x; x < (int)(houseSource.x + houseSource.width); x++) {
+        if (pixels[(int)houseSource.y*256 + x].a != 0) {
+            printf("FAIL: Baked entry has no transparent border\n");
+            break;
+        }
+    }
+    
+    // Editing a sprite re-bakes its entry
+    SetShapeColor(house->shapes[0], BLUE);
+    BakeSprite(atlas, houseKey, house);
+    if (atlas->stats.bakes != 3 || atlas->stats.entries != 2) {
+        printf("FAIL: Edited sprite was not re-baked in place\n");
+    }
+    BakeSprite(atlas, houseKey, house);
+    if (atlas->stats.bakes != 3) {
+        printf("FAIL: Clean sprite was re-baked\n");
+    }
+    
+    // An edit is still seen after a draw has rebuilt the sprite's cache
+    SetShapeColor(house->shapes[0], GREEN);
+    DrawSprite(house);
+    BakeSprite(atlas, houseKey, house);
+    if (atlas->stats.bakes != 4) {
+        printf("FAIL: Sprite edited and drawn before the lookup was not re-baked\n");
+    }
+    
+    // A budget one byte short of both entries evicts the least recently used one
+    RayPalsSpriteAtlas* small = CreateSpriteAtlas(256, 256, atlas->stats.bytesUsed - 1);
+    BakeSprite(small, houseKey, house);
+    BakeSprite(small, cloudKey, cloudA);
+    BakeSprite(small, houseKey, house);
+    if (small->stats.evictions != 2 || small->stats.entries != 1 || small->stats.bytesUsed > small->byteBudget) {
+        printf("FAIL: Atlas exceeded its byte budget\n");
+    }
+    
+    // A new bake scale invalidates every entry
+    SetAtlasBakeScale(atlas, 2.0f);
+    if (atlas->stats.entries != 0 || atlas->stats.bytesUsed != 0) {
+        printf("FAIL: Bake scale change kept stale entries\n");
+    }
+    Rectangle scaled = BakeSprite(atlas, houseKey, house);
+    if (scaled.width < houseSource.width*1.5f) {
+        printf("FAIL: Bake scale did not enlarge the entry\n");
+    }
+    
+    FreeSpriteAtlas(small);
+    FreeSpriteAtlas(atlas);
+    FreeSprite(cloudA);
+    FreeSprite(cloudB);
+    FreeSprite(house);
+    printf("PASS: Sprite atlas test completed\n");
+}
+
+void test_atlas_tiers() {
+    printf("\nTesting sprite atlas resolution tiers...\n");
+    
+    RayPalsSpriteAtlas* atlas = CreateSpriteAtlas(512, 512, 0);
+    RayPalsSpriteAtlas* reference = CreateSpriteAtlas(512, 512, 0);
+    RayPalsSprite* house = CreateHouse((Vector2){ 200, 200 }, 30, LIGHTGRAY, RED);
+    RayPalsBakeKey key = { "CreateHouse", 30, { LIGHTGRAY, RED }, 0 };
+    
+    Rectangle base = BakeSprite(atlas, key, house);
+    
+    // Zooming in keeps drawing the baked tier while a sharper one is baked in the background
+    SetAtlasZoom(atlas, 3.0f);
+    DrawSpriteBaked(atlas, key, house);
+    if (atlas->stats.bakes != 1) {
+        printf("FAIL: Zooming in baked on the main thread\n");
+    }
+    DrawSpriteBaked(atlas, key, house);
+    FlushSpriteAtlas(atlas);
+    if (atlas->stats.backgroundBakes != 1 || atlas->stats.pendingBakes != 0 || atlas->stats.entries != 2) {
+        printf("FAIL: Expected 1 background bake and 2 entries, got %d and %d\n",
+               atlas->stats.backgroundBakes, atlas->stats.entries);
+    }
+    
+    // The zoom of 3 needs the 4x tier
+    Rectangle sharp = BakeSprite(atlas, key, house);
+    if (atlas->stats.bakes != 2 || fabsf((sharp.width - 2) - 4*(base.width - 2)) > 4) {
+        printf("FAIL: Expected a 4x tier, got %.0f texels for %.0f\n", sharp.width, base.width);
+    }
+    
+    // A background bake produces the same texels as a bake on the main thread
+    SetAtlasZoom(reference, 3.0f);
+    Rectangle direct = BakeSprite(reference, key, house);
+    Color* pixels = (Color*)atlas->canvas->image.data;
+    Color* expected = (Color*)reference->canvas->image.data;
+    bool same = direct.width == sharp.width && direct.height == sharp.height;
+    for (int y = 0; same && y < (int)sharp.height; y++) {
+        same = memcmp(&pixels[((int)sharp.y + y)*512 + (int)sharp.x], &expected[((int)direct.y + y)*512 + (int)direct.x],
+                      sizeof(Color) * (int)sharp.width) == 0;
+    }
+    if (!same) {
+        printf("FAIL: Background bake differs from a direct bake\n");
+    }
+    
+    // Editing the sprite drops the other tiers and queued bakes
+    SetAtlasZoom(atlas, 1.0f);
+    SetShapeColor(house->shapes[0], BLUE);
+    DrawSpriteBaked(atlas, key, house);
+    if (atlas->stats.entries != 1) {
+        printf("FAIL: Edited sprite kept stale tiers\n");
+    }
+    
+    // Zooming out far keeps the lowest tier
+    SetAtlasZoom(atlas, 0.25f);
+    if (BakeSprite(atlas, key, house).width != base.width) {
+        printf("FAIL: Zooming out did not use the lowest tier\n");
+    }
+    
+    // Bakes tessellate on their own, so the sprite's cache keeps the LOD it is drawn with
+    RayPalsLODSettings defaults = GetLODSettings();
+    RayPalsLODSettings settings = defaults;
+    settings.enabled = true;
+    SetLODSettings(settings);
+    RayPalsSprite* cloud = CreateCloud((Vector2){ 100, 100 }, 20, WHITE);
+    RayPalsBakeKey cloudKey = { "CreateCloud", 20, { WHITE }, 0 };
+    DrawSprite(cloud);
+    int drawnVertices = GetSpriteCachedVertexCount(cloud);
+    SetAtlasZoom(atlas, 8.0f);
+    BakeSprite(atlas, cloudKey, cloud);
+    if (drawnVertices == 0 || GetSpriteCachedVertexCount(cloud) != drawnVertices) {
+        printf("FAIL: Baking changed the sprite's cached tessellation (%d -> %d vertices)\n",
+               drawnVertices, GetSpriteCachedVertexCount(cloud));
+    }
+    SetLODSettings(defaults);
+    FreeSprite(cloud);
+    
+    FreeSpriteAtlas(reference);
+    FreeSpriteAtlas(atlas);
+    FreeSprite(house);
+    printf("PASS: Sprite atlas tier test completed\n");
+}
+
+void test_retained_scene() {
+    printf("\nTesting retained scene...\n");
+    
+    RayPalsRetainedScene* scene = CreateRetainedScene(800, 600, SKYBLUE);
+    if (scene == NULL) {
+        printf("FAIL: Could not create retained scene\n");
+        return;
+    }
+    
+    RayPalsSprite* house = CreateHouse((Vector2){ 200, 300 }, 80, LIGHTGRAY, RED);
+    RayPalsSprite* cloud = CreateCloud((Vector2){ 600, 100 }, 60, WHITE);
+    
+    // The first frame repaints everything
+    BeginRetainedScene(scene);
+    DrawSpriteRetained(scene, house);
+    DrawSpriteRetained(scene, cloud);
+    EndRetainedScene(scene);
+    if (scene->stats.redrawnPixels != 800*600 || scene->stats.redrawnSprites != 2) {
+        printf("FAIL: First frame redrew %lld pixels and %d sprites\n", scene->stats.redrawnPixels, scene->stats.redrawnSprites);
+    }
+    
+    // An unchanged frame repaints nothing
+    BeginRetainedScene(scene);
+    DrawSpriteRetained(scene, house);
+    DrawSpriteRetained(scene, cloud);
+    EndRetainedScene(scene);
+    if (scene->stats.redrawnPixels != 0 || scene->stats.dirtyRects != 0) {
+        printf("FAIL: Static frame redrew %lld pixels\n", scene->stats.redrawnPixels);
+    }
+    
+    // Moving the cloud repaints its old and new area only
+    Rectangle cloudBounds = GetSpriteBounds(cloud);
+    SetSpritePosition(cloud, (Vector2){ 610, 100 });
+    BeginRetainedScene(scene);
+    DrawSpriteRetained(scene, house);
+    DrawSpriteRetained(scene, cloud);
+    EndRetainedScene(scene);
+    long long limit = (long long)((cloudBounds.width + 16) * (cloudBounds.height + 8));
+    if (scene->stats.redrawnPixels == 0 || scene->stats.redrawnPixels > limit || scene->stats.redrawnSprites != 1) {
+        printf("FAIL: Moving the cloud redrew %lld pixels and %d sprites\n", scene->stats.redrawnPixels, scene->stats.redrawnSprites);
+    }
+    
+    // Re-coloring and hiding are changes too
+    SetShapeColor(house->shapes[0], BLUE);
+    BeginRetainedScene(scene);
+    DrawSpriteRetained(scene, house);
+    DrawSpriteRetained(scene, cloud);
+    EndRetainedScene(scene);
+    if (scene->stats.redrawnSprites != 1 || scene->stats.dirtyRects != 1) {
+        printf("FAIL: Re-coloring the house was not redrawn\n");
+    }
+    
+    // Even when the sprite was drawn elsewhere after the edit
+    SetShapeColor(house->shapes[0], GREEN);
+    DrawSprite(house);
+    BeginRetainedScene(scene);
+    DrawSpriteRetained(scene, house);
+    DrawSpriteRetained(scene, cloud);
+    EndRetainedScene(scene);
+    if (scene->stats.redrawnSprites != 1 || scene->stats.dirtyRects != 1) {
+        printf("FAIL: Re-coloring the house before a draw was not redrawn\n");
+    }
+    
+    house->visible = false;
+    BeginRetainedScene(scene);
+    DrawSpriteRetained(scene, house);
+    DrawSpriteRetained(scene, cloud);
+    EndRetainedScene(scene);
+    if (scene->stats.dirtyRects != 1 || scene->stats.redrawnSprites != 0) {
+        printf("FAIL: Hiding the house did not clear its area\n");
+    }
+    
+    // A sprite no longer submitted leaves a dirty area behind
+    BeginRetainedScene(scene);
+    DrawSpriteRetained(scene, house);
+    EndRetainedScene(scene);
+    if (scene->stats.dirtyRects != 1 || scene->stats.sprites != 1) {
+        printf("FAIL: Removing the cloud did not clear its area\n");
+    }
+    
+    // Moving the camera repaints everything
+    Camera2D camera = { 0 };
+    camera.zoom = 2.0f;
+    SetRetainedSceneCamera(scene, camera);
+    BeginRetainedScene(scene);
+    DrawSpriteRetained(scene, house);
+    EndRetainedScene(scene);
+    if (scene->stats.redrawnPixels != 800*600) {
+        printf("FAIL: Camera change did not redraw the whole frame\n");
+    }
+    
+    FreeRetainedScene(scene);
+    FreeSprite(house);
+    FreeSprite(cloud);
+    printf("PASS: Retained scene test completed\n");
+}
+
+void test_render_queue() {
+    printf("\nTesting render queue...\n");
+    
+    RayPalsRenderQueue* queue = CreateRenderQueue(8);
+    RayPalsSprite* sprites[6];
+    for (int i = 0; i < 6; i++) sprites[i] = CreateCoin((Vector2){ 50.0f*i, 100 }, 10, GOLD);
+    
+    RayPalsSprite* prefab = CreateBush((Vector2){ 0, 0 }, 20, GREEN);
+    RayPalsSpriteTemplate* bushTemplate = CreateSpriteTemplate(prefab);
+    FreeSprite(prefab);
+    RayPalsSpriteInstance bush = CreateSpriteInstance(bushTemplate, (Vector2){ 10, 10 }, 1.0f);
+    
+    // Submitted out of order on purpose
+    QueueSprite(queue, sprites[0], 2, 5.0f, RAYPALS_BLEND_ALPHA);        // 0
+    QueueSprite(queue, sprites[1], 1, 1.0f, RAYPALS_BLEND_ALPHA);        // 1: near
+    QueueSprite(queue, sprites[2], 1, -3.0f, RAYPALS_BLEND_ALPHA);       // 2: nearest
+    QueueSprite(queue, sprites[3], 1, 8.0f, RAYPALS_BLEND_ADDITIVE);     // 3: farthest
+    QueueSprite(queue, sprites[4], 1, 0.0f, RAYPALS_BLEND_OPAQUE);       // 4
+    QueueSpriteInstance(queue, &bush, 1, 9.0f, RAYPALS_BLEND_OPAQUE);    // 5
+    QueueSprite(queue, sprites[5], 0, 0.0f, RAYPALS_BLEND_ALPHA);        // 6
+    QueueSprite(queue, sprites[1], 1, 1.0f, RAYPALS_BLEND_ALPHA);        // 7: ties with 1
+    
+    // Layer 0, then layer 1 opaque by state (sprites before instances), then blended
+    // back to front with ties in submission order, then layer 2
+    int expected[8] = { 6, 4, 5, 3, 1, 7, 2, 0 };
+    SortRenderQueue(queue);
+    for (int i = 0; i < 8; i++) {
+        if (queue->order[i].item != expected[i]) {
+            printf("FAIL: Queue position %d holds item %d instead of %d\n", i, queue->order[i].item, expected[i]);
+            break;
+        }
+    }
+    if (queue->stats.sortPasses == 0 || queue->stats.sortPasses > 8) {
+        printf("FAIL: Unexpected radix pass count %d\n", queue->stats.sortPasses);
+    }
+    
+    FlushRenderQueue(queue);
+    if (queue->count != 0 || queue->stats.items != 8 || queue->stats.blendChanges != 2) {
+        printf("FAIL: Flush drew %d items with %d blend changes\n", queue->stats.items, queue->stats.blendChanges);
+    }
+    
+    // Later frames reuse the buffers
+    RayPalsQueueItem* items = queue->items;
+    int capacity = queue->capacity;
+    for (int frame = 0; frame < 3; frame++) {
+        for (int i = 0; i < 6; i++) QueueSprite(queue, sprites[i], i % 3, (float)i, RAYPALS_BLEND_ALPHA);
+        FlushRenderQueue(queue);
+    }
+    if (queue->items != items || queue->capacity != capacity) {
+        printf("FAIL: Render queue allocated while reused\n");
+    }
+    
+    // Growing past the capacity keeps every item, and hidden sprites are skipped
+    sprites[0]->visible = false;
+    for (int i = 0; i < 100; i++) QueueSprite(queue, sprites[i % 6], 0, (float)(i % 10), RAYPALS_BLEND_ALPHA);
+    SortRenderQueue(queue);
+    bool ordered = queue->count == 100 - 17;
+    for (int i = 1; i < queue->count && ordered; i++) ordered = queue->order[i - 1].key <= queue->order[i].key;
+    if (!ordered) {
+        printf("FAIL: Grown queue is not sorted\n");
+    }
+    ClearRenderQueue(queue);
+    
+    FreeRenderQueue(queue);
+    FreeSpriteTemplate(bushTemplate);
+    for (int i = 0; i < 6; i++) FreeSprite(sprites[i]);
+    printf("PASS: Render queue test completed\n");
+}
+
+void test_3d_mesh_cache() {
+    printf("\nTesting 3D mesh cache...\n");
+    
+    RayPals3DShape* shapes[4] = {
+        CreateCube((Vector3){ 0, 0, 0 }, (Vector3){ 1, 2, 3 }, RED),
+        CreateSphere((Vector3){ 0, 0, 0 }, 1.0f, 8, BLUE),
+        CreateCylinder((Vector3){ 0, 0, 0 }, 1.0f, 2.0f, 8, GREEN),
+        CreateCone((Vector3){ 0, 0, 0 }, 1.0f, 2.0f, 8, YELLOW)
+    };
+    
+    // Same vertex counts raylib's DrawCube/DrawSphereEx/DrawCylinder(Wires) submit
+    int filled[4] = { 36, 9*8*6, 8*12, 8*6 };
+    int wires[4] = { 24, 10*8*6, 8*8, 8*8 };
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < 4; i++) {
+            for (int wire = 0; wire < 2; wire++) {
+                shapes[i]->wireframe = wire;
+                ResetDrawStats();
+                Draw3DShape(shapes[i], NULL);
+                int expected = wire ? wires[i] : filled[i];
+                if (GetDrawStats().vertices != expected) {
+                    printf("FAIL: Shape %d (wireframe %d) drew %d vertices instead of %d\n", i, wire, GetDrawStats().vertices, expected);
+                }
+            }
+        }
+        
+        // Meshes are rebuilt after the cache is released
+        Free3DMeshCache();
+    }
+    
+    // Degenerate segment counts are clamped instead of producing empty meshes
+    shapes[1]->wireframe = false;
+    shapes[1]->segments = 1;
+    ResetDrawStats();
+    Draw3DShape(shapes[1], NULL);
+    if (GetDrawStats().vertices != 4*3*6) {
+        printf("FAIL: Sphere with 1 segment drew %d vertices\n", GetDrawStats().vertices);
+    }
+    
+    Free3DMeshCache();
+    for (int i = 0; i < 4; i++) Free3DShape(shapes[i]);
+    printf("PASS: 3D mesh cache test completed\n");
+}
+
+void test_3d_static_batch() {
+    printf("\nTesting 3D static batch...\n");
+    
+    RayPals3DTree trees[2] = {
+        Create3DTree((Vector3){ 0, 0, 0 }, 1.0f, BROWN, DARKGREEN),
+        Create3DTree((Vector3){ 4, 0, 1 }, 0.8f, BROWN, DARKGREEN)
+    };
+    RayPals3DSprite* sprites[3] = {
+        trees[0].sprite,
+        Create3DRobot((Vector3){ -3, 0, 2 }, 1.0f, GRAY, RED),
+        trees[1].sprite
+    };
+    
+    // Baking submits the same vertices as drawing the sprites one by one
+    Camera camera = { 0 };
+    ResetDrawStats();
+    for (int i = 0; i < 3; i++) Draw3DSprite(sprites[i], camera);
+    int expected = GetDrawStats().vertices;
+    
+    RayPals3DStaticBatch* batch = Create3DStaticBatch(sprites, 3);
+    if (!batch || batch->vertexCount != expected) {
+        printf("FAIL: Static batch holds %d vertices instead of %d\n", batch ? batch->vertexCount : -1, expected);
+    }
+    
+    ResetDrawStats();
+    Draw3DStaticBatch(batch);
+    if (GetDrawStats().vertices != expected || GetDrawStats().batches != batch->groupCount) {
+        printf("FAIL: Static batch drew %d vertices in %d runs\n", GetDrawStats().vertices, GetDrawStats().batches);
+    }
+    
+    // Trees share their trunk and leaf colors, so the runs are fewer than the shapes
+    int shapes = sprites[0]->shapeCount + sprites[1]->shapeCount + sprites[2]->shapeCount;
+    if (batch->groupCount >= shapes) {
+        printf("FAIL: %d shapes were baked into %d runs\n", shapes, batch->groupCount);
+    }
+    
+    // Moving a sprite is rewritten in place
+    Set3DSpritePosition(sprites[2], (Vector3){ 8, 0, 8 });
+    Update3DStaticBatch(batch, 2);
+    if (batch->rebuilds != 1 || batch->updates != 1) {
+        printf("FAIL: Moving a sprite caused %d rebuilds and %d updates\n", batch->rebuilds, batch->updates);
+    }
+    
+    // Changing a color or hiding a shape changes the layout and rebuilds
+    Set3DShapeColor(sprites[0]->shapes[1], LIME);
+    Update3DStaticBatch(batch, 0);
+    sprites[1]->shapes[0]->visible = false;
+    Update3DStaticBatch(batch, 1);
+    if (batch->rebuilds != 3 || batch->vertexCount >= expected) {
+        printf("FAIL: Layout changes caused %d rebuilds (%d vertices)\n", batch->rebuilds, batch->vertexCount);
+    }
+    if (Update3DStaticBatch(batch, 3)) {
+        printf("FAIL: Updating an out-of-range sprite succeeded\n");
+    }
+    
+    Free3DStaticBatch(batch);
+    Free3DSprite(sprites[1]);
+    Free3DTree(&trees[0]);
+    Free3DTree(&trees[1]);
+    printf("PASS: 3D static batch test completed\n");
+}
+
+void test_transform_cache() {
+    printf("\nTesting cached transforms...\n");
+    
+    RayPals3DSprite* sprite = Create3DSprite(1);
+    RayPals3DShape* cube = CreateCube((Vector3){ 1, 0, 0 }, (Vector3){ 2, 2, 2 }, RED);
+    AddShapeTo3DSprite(sprite, cube);
+    Set3DSpritePosition(sprite, (Vector3){ 10, 0, 0 });
+    Set3DSpriteRotation(sprite, (Vector3){ 0, 90, 0 });
+    
+    // Yaw of 90 degrees maps the shape offset +x onto -z; the unit cube is scaled by the size
+    Matrix world = Get3DShapeMatrix(cube, sprite);
+    if (fabsf(world.m12 - 10.0f) > 0.001f || fabsf(world.m14 + 1.0f) > 0.001f || fabsf(world.m5 - 2.0f) > 0.001f) {
+        printf("FAIL: Cube world matrix has translation (%f, %f, %f)\n", world.m12, world.m13, world.m14);
+    }
+    
+    // Drawing an unchanged sprite reuses the cached matrices
+    unsigned int stamp = sprite->transformStamp;
+    Camera camera = { 0 };
+    Draw3DSprite(sprite, camera);
+    Draw3DSprite(sprite, camera);
+    if (sprite->transformStamp != stamp || cube->parentStamp != stamp || cube->transformDirty) {
+        printf("FAIL: Unchanged sprite rebuilt its matrices\n");
+    }
+    
+    // A setter on the sprite propagates to the shape's world matrix
+    Set3DSpritePosition(sprite, (Vector3){ 0, 5, 0 });
+    world = Get3DShapeMatrix(cube, sprite);
+    if (sprite->transformStamp == stamp || fabsf(world.m13 - 5.0f) > 0.001f || fabsf(world.m12) > 0.001f) {
+        printf("FAIL: Moved sprite left its shape matrix at (%f, %f, %f)\n", world.m12, world.m13, world.m14);
+    }
+    
+    // Direct writes are picked up after marking the sprite dirty
+    cube->position.x = 3.0f;
+    Mark3DSpriteDirty(sprite);
+    world = Get3DShapeMatrix(cube, sprite);
+    if (fabsf(world.m14 + 3.0f) > 0.001f) {
+        printf("FAIL: Marked shape was not rebuilt (z = %f)\n", world.m14);
+    }
+    
+    // 2D sprites cache rotation and scale the same way
+    RayPalsSprite* coin = CreateCoin((Vector2){ 0, 0 }, 10, GOLD);
+    SetSpritePosition(coin, (Vector2){ 50, 60 });
+    SetSpriteRotation(coin, 90.0f);
+    SetSpriteScale(coin, 2.0f);
+    Matrix matrix = GetSpriteMatrix(coin);
+    if (fabsf(matrix.m0) > 0.001f || fabsf(matrix.m1 - 2.0f) > 0.001f || matrix.m12 != 50.0f || matrix.m13 != 60.0f || coin->transformDirty) {
+        printf("FAIL: Sprite matrix is wrong or still dirty\n");
+    }
+    
+    // Direct writes to the transform fields rebuild the matrix without MarkSpriteDirty, so
+    // drawing agrees with culling, dirty rects and picking, which read the fields
+    coin->position.x = 80.0f;
+    coin->scale = 1.0f;
+    matrix = GetSpriteMatrix(coin);
+    if (matrix.m12 != 80.0f || fabsf(matrix.m1 - 1.0f) > 0.001f) {
+        printf("FAIL: Sprite matrix kept a stale transform after direct writes\n");
+    }
+    
+    FreeSprite(coin);
+    Free3DSprite(sprite);
+    printf("PASS: Cached transform test completed\n");
+}
+
+void test_3d_batch_scope() {
+    printf("\nTesting 3D batch scope...\n");
+    
+    RayPals3DShape* rocks[10];
+    for (int i = 0; i < 10; i++) rocks[i] = CreateSphere((Vector3){ (float)i, 0, 0 }, 0.5f, 6, GRAY);
+    Camera camera = { 0 };
+    
+    // Every standalone draw opens and closes its own camera scope
+    ResetDrawStats();
+    for (int i = 0; i < 10; i++) Draw3DShape(rocks[i], &camera);
+    if (GetDrawStats().flushes != 20) {
+        printf("FAIL: Standalone draws flushed %d times instead of 20\n", GetDrawStats().flushes);
+    }
+    int vertices = GetDrawStats().vertices;
+    
+    // One scope for all of them, drawing the same vertices
+    ResetDrawStats();
+    Draw3DShapes(rocks, 10, camera);
+    if (GetDrawStats().flushes != 2 || GetDrawStats().vertices != vertices) {
+        printf("FAIL: Draw3DShapes flushed %d times for %d vertices\n", GetDrawStats().flushes, GetDrawStats().vertices);
+    }
+    
+    // Draws inside an explicit batch ignore their camera, and nested Draw3DShapes reuses it
+    ResetDrawStats();
+    Begin3DBatch(camera);
+    for (int i = 0; i < 5; i++) Draw3DShape(rocks[i], &camera);
+    Draw3DShapes(rocks + 5, 5, camera);
+    End3DBatch();
+    if (GetDrawStats().flushes != 2 || GetDrawStats().vertices != vertices) {
+        printf("FAIL: Explicit 3D batch flushed %d times for %d vertices\n", GetDrawStats().flushes, GetDrawStats().vertices);
+    }
+    
+    // An inner scope closing leaves the outer one open
+    ResetDrawStats();
+    Begin3DBatch(camera);
+    Begin3DBatch(camera);
+    for (int i = 0; i < 5; i++) Draw3DShape(rocks[i], &camera);
+    End3DBatch();
+    if (GetDrawStats().flushes != 1) {
+        printf("FAIL: Inner End3DBatch closed the outer scope\n");
+    }
+    for (int i = 5; i < 10; i++) Draw3DShape(rocks[i], &camera);
+    End3DBatch();
+    if (GetDrawStats().flushes != 2 || GetDrawStats().vertices != vertices) {
+        printf("FAIL: Nested 3D batches flushed %d times for %d vertices\n", GetDrawStats().flushes, GetDrawStats().vertices);
+    }
+    
+    // A stray End3DBatch is ignored: the next standalone draw still opens its own scope
+    End3DBatch();
+    ResetDrawStats();
+    Draw3DShape(rocks[0], &camera);
+    if (GetDrawStats().flushes != 2 || GetDrawStats().vertices != vertices / 10) {
+        printf("FAIL: Draw after a stray End3DBatch flushed %d times for %d vertices\n", GetDrawStats().flushes, GetDrawStats().vertices);
+    }
+    
+    // With LOD on, shapes nested in a batch take their detail from the batch's camera
+    RayPals3DShape* ball = CreateSphere((Vector3){ 0, 0, 0 }, 1.0f, 16, WHITE);
+    Camera nearCamera = { 0 };
+    nearCamera.position = (Vector3){ 0, 0, 10 };
+    nearCamera.up = (Vector3){ 0, 1, 0 };
+    nearCamera.fovy = 45.0f;
+    nearCamera.projection = CAMERA_PERSPECTIVE;
+    Camera farCamera = nearCamera;
+    farCamera.position = (Vector3){ 0, 0, 100 };
+    ResetDrawStats();
+    Draw3DShapes(&ball, 1, nearCamera);
+    int nearVertices = GetDrawStats().vertices;
+    
+    RayPals3DLODSettings settings = Get3DLODSettings();
+    settings.enabled = true;
+    Set3DLODSettings(settings);
+    ResetDrawStats();
+    Begin3DBatch(nearCamera);
+    Draw3DShapes(&ball, 1, farCamera);
+    End3DBatch();
+    if (GetDrawStats().vertices != nearVertices) {
+        printf("FAIL: Nested Draw3DShapes used its own camera for LOD (%d vertices instead of %d)\n", GetDrawStats().vertices, nearVertices);
+    }
+    settings.enabled = false;
+    Set3DLODSettings(settings);
+    Free3DShape(ball);
+    
+    for (int i = 0; i < 10; i++) Free3DShape(rocks[i]);
+    printf("PASS: 3D batch scope test completed\n");
+}
+
+void test_3d_frustum_culling() {
+    printf("\nTesting 3D frustum culling...\n");
+    
+    // A unit cube on a sprite at x = 4
+    RayPals3DSprite* sprite = Create3DSprite(1);
+    Set3DSpritePosition(sprite, (Vector3){ 4, 0, 0 });
+    AddShapeTo3DSprite(sprite, CreateCube((Vector3){ 0, 0, 0 }, (Vector3){ 1, 1, 1 }, RED));
+    
+    RayPalsBounds3D bounds = Get3DSpriteBounds(sprite);
+    if (fabsf(bounds.box.min.x - 3.5f) > 0.001f || fabsf(bounds.box.max.x - 4.5f) > 0.001f ||
+        fabsf(bounds.box.min.y + 0.5f) > 0.001f || fabsf(bounds.radius - 0.866f) > 0.001f) {
+        printf("FAIL: Cube bounds are (%f..%f, %f) radius %f\n", bounds.box.min.x, bounds.box.max.x, bounds.box.min.y, bounds.radius);
+    }
+    
+    // Moving the sprite moves the cached bounds
+    Set3DSpritePosition(sprite, (Vector3){ 0, 0, -20 });
+    bounds = Get3DSpriteBounds(sprite);
+    if (fabsf(bounds.center.z + 20.0f) > 0.001f || fabsf(bounds.center.x) > 0.001f) {
+        printf("FAIL: Moved sprite bounds centered at (%f, %f, %f)\n", bounds.center.x, bounds.center.y, bounds.center.z);
+    }
+    
+    // Camera at z = 10 looking down -z: the sprite in front is drawn, the one behind is culled
+    Camera camera = { 0 };
+    camera.position = (Vector3){ 0, 0, 10 };
+    camera.target = (Vector3){ 0, 0, 0 };
+    camera.up = (Vector3){ 0, 1, 0 };
+    camera.fovy = 45.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+    
+    RayPals3DSprite* behind = Create3DSprite(1);
+    Set3DSpritePosition(behind, (Vector3){ 0, 0, 20 });
+    AddShapeTo3DSprite(behind, CreateSphere((Vector3){ 0, 0, 0 }, 1.0f, 8, BLUE));
+    RayPalsFrustum frustum = GetCameraFrustum(camera);
+    RayPalsBounds3D aside = { { { 29, -1, -1 }, { 31, 1, 1 } }, { 30, 0, 0 }, 1.8f };
+    if (!IsBoundsInFrustum(&frustum, Get3DSpriteBounds(sprite)) || IsBoundsInFrustum(&frustum, Get3DSpriteBounds(behind)) ||
+        IsBoundsInFrustum(&frustum, aside)) {
+        printf("FAIL: Frustum test misclassified the sprites\n");
+    }
+    
+    // Inside a square render texture the frustum narrows to its aspect, not the screen's
+    RayPalsBounds3D edge = { { { 4.9f, -0.1f, -0.1f }, { 5.1f, 0.1f, 0.1f } }, { 5, 0, 0 }, 0.18f };
+    RenderTexture2D target = LoadRenderTexture(GetScreenHeight(), GetScreenHeight());
+    BeginTextureMode(target);
+    RayPalsFrustum textureFrustum = GetCameraFrustum(camera);
+    EndTextureMode();
+    UnloadRenderTexture(target);
+    if (GetScreenWidth() > GetScreenHeight() &&
+        (!IsBoundsInFrustum(&frustum, edge) || IsBoundsInFrustum(&textureFrustum, edge))) {
+        printf("FAIL: Render texture frustum used the screen aspect\n");
+    }
+    
+    RayPals3DSprite* scene[2] = { sprite, behind };
+    ResetDrawStats();
+    int drawn = Draw3DSpritesCulled(scene, 2, camera);
+    if (drawn != 1 || GetDrawStats().culled != 1 || GetDrawStats().vertices == 0) {
+        printf("FAIL: Culled draw drew %d sprites, culled %d\n", drawn, GetDrawStats().culled);
+    }
+    
+    Free3DSprite(sprite);
+    Free3DSprite(behind);
+    printf("PASS: 3D frustum culling test completed\n");
+}
+
+void test_3d_bvh() {
+    printf("\nTesting 3D bounding volume hierarchy...\n");
+    
+    // A 20 x 20 grid of small cubes, one unit apart
+    RayPals3DSprite* sprites[400];
+    for (int i = 0; i < 400; i++) {
+        sprites[i] = Create3DSprite(1);
+        Set3DSpritePosition(sprites[i], (Vector3){ (float)(i % 20), 0, (float)(i / 20) });
+        AddShapeTo3DSprite(sprites[i], CreateCube((Vector3){ 0, 0, 0 }, (Vector3){ 0.5f, 0.5f, 0.5f }, GREEN));
+    }
+    
+    RayPals3DBVH* bvh = Create3DBVH(sprites, 400);
+    RayPalsBVHStats stats = Get3DBVHStats(bvh);
+    if (!bvh || stats.nodeCount != 2*stats.leafCount - 1 || stats.depth < 2 || stats.depth > 20) {
+        printf("FAIL: BVH has %d nodes, %d leaves, depth %d\n", stats.nodeCount, stats.leafCount, stats.depth);
+    }
+    
+    // Region query: the 3 x 3 block around (5, 0, 5)
+    BoundingBox region = { { 3.9f, -1, 3.9f }, { 6.1f, 1, 6.1f } };
+    RayPals3DSprite* found[400];
+    int count = Query3DBVHRegion(bvh, region, found, 400);
+    if (count != 9) {
+        printf("FAIL: Region query found %d sprites instead of 9\n", count);
+    }
+    
+    // Ray query along the row z = 3 finds the 20 cubes of that row
+    Ray ray = { { -5, 0, 3 }, { 1, 0, 0 } };
+    count = Query3DBVHRay(bvh, ray, 100.0f, found, 400);
+    if (count != 20) {
+        printf("FAIL: Ray query found %d sprites instead of 20\n", count);
+    }
+    
+    // Frustum query and culled drawing agree with testing every sprite
+    Camera camera = { 0 };
+    camera.position = (Vector3){ 10, 3, -4 };
+    camera.target = (Vector3){ 4, 0, 6 };
+    camera.up = (Vector3){ 0, 1, 0 };
+    camera.fovy = 45.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+    RayPalsFrustum frustum = GetCameraFrustum(camera);
+    int expected = 0;
+    for (int i = 0; i < 400; i++) expected += IsBoundsInFrustum(&frustum, Get3DSpriteBounds(sprites[i]));
+    count = Query3DBVHFrustum(bvh, &frustum, NULL, 0);
+    int drawn = Draw3DBVH(bvh, camera);
+    if (expected == 0 || expected == 400 || count != expected || drawn != expected) {
+        printf("FAIL: Frustum query found %d and drew %d sprites, expected %d\n", count, drawn, expected);
+    }
+    
+    // Moving one sprite refits only its leaf and ancestors
+    Set3DSpritePosition(sprites[0], (Vector3){ 50, 0, 50 });
+    int refitted = Refit3DBVH(bvh);
+    BoundingBox farRegion = { { 49, -1, 49 }, { 51, 1, 51 } };
+    if (refitted == 0 || refitted > Get3DBVHStats(bvh).depth || Query3DBVHRegion(bvh, farRegion, found, 400) != 1 || found[0] != sprites[0]) {
+        printf("FAIL: Refit changed %d nodes and the moved sprite was not found\n", refitted);
+    }
+    if (Get3DBVHStats(bvh).refitLeaves != 1) {
+        printf("FAIL: Refit measured %d leaves for one moved sprite\n", Get3DBVHStats(bvh).refitLeaves);
+    }
+    if (Refit3DBVH(bvh) != 0 || Get3DBVHStats(bvh).refitLeaves != 0) {
+        printf("FAIL: Refit without movement changed nodes\n");
+    }
+    
+    // Editing a shape is reported through Mark3DSpriteDirty
+    sprites[1]->shapes[0]->position.y = 5;
+    Mark3DSpriteDirty(sprites[1]);
+    Refit3DBVH(bvh);
+    BoundingBox raised = { { 0, 4, 0 }, { 2, 6, 1 } };
+    if (Query3DBVHRegion(bvh, raised, found, 400) != 1 || found[0] != sprites[1]) {
+        printf("FAIL: Refit missed a shape edit reported with Mark3DSpriteDirty\n");
+    }
+    
+    // A second tree over the same sprites takes over their reports, and the first
+    // one falls back to measuring every leaf
+    RayPals3DBVH* other = Create3DBVH(sprites, 400);
+    Set3DSpritePosition(sprites[2], (Vector3){ 55, 0, 55 });
+    Refit3DBVH(bvh);
+    Refit3DBVH(other);
+    BoundingBox corner = { { 54, -1, 54 }, { 56, 1, 56 } };
+    if (Query3DBVHRegion(bvh, corner, NULL, 0) != 1 || Query3DBVHRegion(other, corner, NULL, 0) != 1 ||
+        Get3DBVHStats(other).refitLeaves != 1) {
+        printf("FAIL: Trees sharing sprites did not both see the move\n");
+    }
+    Free3DBVH(other);
+    
+    // Rebuilding keeps every sprite
+    Rebuild3DBVH(bvh);
+    BoundingBox everything = { { -10, -10, -10 }, { 60, 10, 60 } };
+    if (Query3DBVHRegion(bvh, everything, NULL, 0) != 400) {
+        printf("FAIL: Rebuilt BVH lost sprites\n");
+    }
+    
+    Free3DBVH(bvh);
+    for (int i = 0; i < 400; i++) Free3DSprite(sprites[i]);
+    printf("PASS: 3D bounding volume hierarchy test completed\n");
+}
+
+// Vertices Draw3DShapes submits for one shape seen from a distance along +z
+static int DrawLODSphereAt(RayPals3DShape* shape, float distance) {
+    Camera camera = { 0 };
+    camera.position = (Vector3){ 0, 0, distance };
+    camera.up = (Vector3){ 0, 1, 0 };
+    camera.fovy = 45.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+    
+    ResetDrawStats();
+    Draw3DShapes(&shape, 1, camera);
+    return GetDrawStats().vertices;
+}
+
+void test_3d_lod() {
+    printf("\nTesting 3D LOD...\n");
+    
+    RayPals3DShape* sphere = CreateSphere((Vector3){ 0, 0, 0 }, 1.0f, 16, WHITE);
+    RayPals3DShape* half = CreateSphere((Vector3){ 0, 0, 0 }, 1.0f, 8, WHITE);
+    int fullVertices = DrawLODSphereAt(sphere, 65.0f);
+    int halfVertices = DrawLODSphereAt(half, 65.0f);
+    
+    RayPals3DLODSettings settings = Get3DLODSettings();
+    settings.enabled = true;
+    Set3DLODSettings(settings);
+    
+    // Close enough for full detail, then far enough to halve the segments
+    if (DrawLODSphereAt(sphere, 65.0f) != fullVertices) {
+        printf("FAIL: Sphere lost detail at 65 units\n");
+    }
+    if (DrawLODSphereAt(sphere, 100.0f) != halfVertices) {
+        printf("FAIL: Distant sphere did not drop to 8 segments\n");
+    }
+    
+    // Hysteresis: coming back to 65 units keeps the coarser step, getting close restores it
+    if (DrawLODSphereAt(sphere, 65.0f) != halfVertices) {
+        printf("FAIL: Sphere popped back to full detail inside the hysteresis band\n");
+    }
+    if (DrawLODSphereAt(sphere, 10.0f) != fullVertices) {
+        printf("FAIL: Near sphere did not return to full detail\n");
+    }
+    
+    // A budget caps the triangles of many close spheres
+    RayPals3DShape* spheres[50];
+    for (int i = 0; i < 50; i++) spheres[i] = CreateSphere((Vector3){ (float)i, 0, 0 }, 1.0f, 32, WHITE);
+    Camera camera = { 0 };
+    camera.position = (Vector3){ 25, 0, 5 };
+    camera.target = (Vector3){ 25, 0, 0 };
+    camera.up = (Vector3){ 0, 1, 0 };
+    camera.fovy = 45.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+    ResetDrawStats();
+    Draw3DShapes(spheres, 50, camera);
+    int unbudgeted = GetDrawStats().triangles;
+    
+    // Shapes past the budget drop to their coarsest step at once, and the tolerance
+    // rises over the next frames until the whole frame fits
+    settings.triangleBudget = 10000;
+    Set3DLODSettings(settings);
+    for (int frame = 0; frame < 30; frame++) {
+        Begin3DLODFrame();
+        ResetDrawStats();
+        Draw3DShapes(spheres, 50, camera);
+    }
+    if (unbudgeted <= 10000 || GetDrawStats().triangles > 10000 || GetDrawStats().triangles == 0) {
+        printf("FAIL: Budgeted frame drew %d of %d triangles\n", GetDrawStats().triangles, unbudgeted);
+    }
+    
+    // Triangles of shapes without LOD count towards the budget, and only Begin3DLODFrame
+    // starts a new frame: spheres drawn after cubes used it up are at their coarsest step
+    RayPals3DShape* coarsest = CreateSphere((Vector3){ 0, 0, 0 }, 1.0f, settings.minSegments, WHITE);
+    ResetDrawStats();
+    Draw3DShapes(&coarsest, 1, camera);
+    int coarsestTriangles = GetDrawStats().triangles;
+    RayPals3DShape* cubes[900];
+    for (int i = 0; i < 900; i++) cubes[i] = CreateCube((Vector3){ (float)(i % 30), -5, (float)(-i / 30) }, (Vector3){ 0.5f, 0.5f, 0.5f }, GRAY);
+    Set3DLODSettings(settings);
+    Begin3DLODFrame();
+    Draw3DShapes(cubes, 900, camera);
+    ResetDrawStats();
+    Draw3DShapes(spheres, 50, camera);
+    if (GetDrawStats().triangles != 50 * coarsestTriangles) {
+        printf("FAIL: Spheres after a spent budget drew %d triangles instead of %d\n", GetDrawStats().triangles, 50 * coarsestTriangles);
+    }
+    Begin3DLODFrame();
+    
+    settings.enabled = false;
+    settings.triangleBudget = 0;
+    Set3DLODSettings(settings);
+    for (int i = 0; i < 50; i++) Free3DShape(spheres[i]);
+    for (int i = 0; i < 900; i++) Free3DShape(cubes[i]);
+    Free3DShape(coarsest);
+    Free3DShape(sphere);
+    Free3DShape(half);
+    printf("PASS: 3D LOD test completed\n");
+}
+
+void test_3d_instancing() {
+    printf("\nTesting 3D instancing...\n");
+    
+    RayPals3DSprite* robot = Create3DRobot((Vector3){ 5, 5, 5 }, 1.0f, RED, YELLOW);
+    RayPals3DSpriteTemplate* robotTemplate = Create3DSpriteTemplate(robot);
+    if (!robotTemplate || robotTemplate->vertexCount == 0 || robotTemplate->stride % 4 != 0 || robotTemplate->stride < robotTemplate->vertexCount) {
+        printf("FAIL: Robot template was not baked\n");
+        Free3DSprite(robot);
+        return;
+    }
+    
+    // The template holds the same vertices a single sprite draw submits
+    Camera camera = { 0 };
+    ResetDrawStats();
+    Draw3DSprite(robot, camera);
+    int spriteVertices = GetDrawStats().vertices;
+    Free3DSprite(robot);
+    if (spriteVertices != robotTemplate->vertexCount) {
+        printf("FAIL: Template has %d vertices, the sprite draws %d\n", robotTemplate->vertexCount, spriteVertices);
+    }
+    
+    // 100 instances in a row along -z, half of them tinted
+    Matrix transforms[100];
+    Color tints[100];
+    for (int i = 0; i < 100; i++) {
+        transforms[i] = Get3DInstanceTransform((Vector3){ 0, 0, -2.0f * i }, (Vector3){ 0, i * 10.0f, 0 }, (Vector3){ 1, 1, 1 });
+        tints[i] = (i % 2) ? GRAY : WHITE;
+    }
+    
+    ResetDrawStats();
+    Draw3DSpriteInstances(robotTemplate, transforms, tints, 100);
+    RayPalsDrawStats stats = GetDrawStats();
+    if (stats.sprites != 100 || stats.vertices != 100 * robotTemplate->vertexCount || stats.batches > 2) {
+        printf("FAIL: Instanced draw submitted %d sprites, %d vertices in %d runs\n", stats.sprites, stats.vertices, stats.batches);
+    }
+    
+    // Looking along +z from z = 10, every instance is behind the camera
+    camera.position = (Vector3){ 0, 0, 10 };
+    camera.target = (Vector3){ 0, 0, 20 };
+    camera.up = (Vector3){ 0, 1, 0 };
+    camera.fovy = 45.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+    ResetDrawStats();
+    int drawn = Draw3DSpriteInstancesCulled(robotTemplate, transforms, NULL, 100, camera);
+    if (drawn != 0 || GetDrawStats().culled != 100) {
+        printf("FAIL: Culled instanced draw drew %d instances behind the camera\n", drawn);
+    }
+    
+    camera.target = (Vector3){ 0, 0, 0 };
+    ResetDrawStats();
+    drawn = Draw3DSpriteInstancesCulled(robotTemplate, transforms, NULL, 100, camera);
+    if (drawn == 0 || drawn + GetDrawStats().culled != 100) {
+        printf("FAIL: Culled instanced draw drew %d and culled %d instances\n", drawn, GetDrawStats().culled);
+    }
+    
+    Free3DSpriteTemplate(robotTemplate);
+    
+    // A rotated, non-uniformly scaled box instance lands where Draw3DSprite puts the sprite
+    RayPals3DSprite* box = Create3DSprite(1);
+    AddShapeTo3DSprite(box, CreateCube((Vector3){ 1, 0.5f, -1 }, (Vector3){ 1, 2, 3 }, RED));
+    Set3DShapeRotation(box->shapes[0], (Vector3){ 0, 0, 20 });
+    RayPals3DSpriteTemplate* boxTemplate = Create3DSpriteTemplate(box);
+    Vector3 position = { 4, -2, 7 }, rotation = { 30, 45, 60 }, scale = { 2, 0.5f, 1.5f };
+    Set3DSpritePosition(box, position);
+    Set3DSpriteRotation(box, rotation);
+    Set3DSpriteScale(box, scale);
+    Matrix m = Get3DInstanceTransform(position, rotation, scale);
+    
+    int vertexCount = boxTemplate ? boxTemplate->vertexCount : 0;
+    Vector3* positions = (Vector3*)malloc(sizeof(Vector3) * (vertexCount > 0 ? vertexCount : 1));
+    Vector3* normals = (Vector3*)malloc(sizeof(Vector3) * (vertexCount > 0 ? vertexCount : 1));
+    if (vertexCount == 0 || Get3DInstanceVertices(boxTemplate, m, positions, normals) != vertexCount) {
+        printf("FAIL: Box instance was not transformed\n");
+    } else {
+        // Positions match a plain scalar transform of the template, vertex by vertex
+        int stride = boxTemplate->stride;
+        const float* planes = boxTemplate->vertexData;
+        int wrongPositions = 0, wrongNormals = 0;
+        BoundingBox extent = { positions[0], positions[0] };
+        for (int v = 0; v < vertexCount; v++) {
+            float x = planes[v], y = planes[stride + v], z = planes[2*stride + v];
+            Vector3 expected = {
+                m.m0*x + m.m4*y + m.m8*z + m.m12,
+                m.m1*x + m.m5*y + m.m9*z + m.m13,
+                m.m2*x + m.m6*y + m.m10*z + m.m14
+            };
+            if (fabsf(positions[v].x - expected.x) > 1e-4f || fabsf(positions[v].y - expected.y) > 1e-4f ||
+                fabsf(positions[v].z - expected.z) > 1e-4f) wrongPositions++;
+            
+            extent.min = (Vector3){ fminf(extent.min.x, positions[v].x), fminf(extent.min.y, positions[v].y), fminf(extent.min.z, positions[v].z) };
+            extent.max = (Vector3){ fmaxf(extent.max.x, positions[v].x), fmaxf(extent.max.y, positions[v].y), fmaxf(extent.max.z, positions[v].z) };
+        }
+        
+        // Normals stay unit length, perpendicular to their triangle and facing out of the box
+        for (int v = 0; v + 2 < boxTemplate->triangleVertexCount; v += 3) {
+            Vector3 e1 = { positions[v+1].x - positions[v].x, positions[v+1].y - positions[v].y, positions[v+1].z - positions[v].z };
+            Vector3 e2 = { positions[v+2].x - positions[v].x, positions[v+2].y - positions[v].y, positions[v+2].z - positions[v].z };
+            for (int k = v; k < v + 3; k++) {
+                Vector3 n = normals[k];
+                Vector3 out = {
+                    positions[k].x - (extent.min.x + extent.max.x)/2,
+                    positions[k].y - (extent.min.y + extent.max.y)/2,
+                    positions[k].z - (extent.min.z + extent.max.z)/2
+                };
+                float length = sqrtf(n.x*n.x + n.y*n.y + n.z*n.z);
+                if (fabsf(length - 1.0f) > 1e-4f || fabsf(n.x*e1.x + n.y*e1.y + n.z*e1.z) > 1e-3f ||
+                    fabsf(n.x*e2.x + n.y*e2.y + n.z*e2.z) > 1e-3f || n.x*out.x + n.y*out.y + n.z*out.z <= 0.0f) wrongNormals++;
+            }
+        }
+        
+        // The sprite path's world bounds are exact for a box
+        BoundingBox spriteBox = Get3DSpriteBounds(box).box;
+        bool boundsMatch = fabsf(extent.min.x - spriteBox.min.x) < 1e-3f && fabsf(extent.min.y - spriteBox.min.y) < 1e-3f &&
+                           fabsf(extent.min.z - spriteBox.min.z) < 1e-3f && fabsf(extent.max.x - spriteBox.max.x) < 1e-3f &&
+                           fabsf(extent.max.y - spriteBox.max.y) < 1e-3f && fabsf(extent.max.z - spriteBox.max.z) < 1e-3f;
+        if (wrongPositions > 0 || wrongNormals > 0 || !boundsMatch) {
+            printf("FAIL: Box instance has %d wrong positions, %d wrong normals, bounds %s the sprite's\n",
+                   wrongPositions, wrongNormals, boundsMatch ? "matching" : "differing from");
+        }
+    }
+    free(positions);
+    free(normals);
+    Free3DSpriteTemplate(boxTemplate);
+    Free3DSprite(box);
+    
+    printf("PASS: 3D instancing test completed\n");
+}
+
+void test_picking() {
+    printf("\nTesting picking...\n");
+    
+    // A star tip is on the shape; the notch between two tips is inside its bounds but not on it
+    RayPals2DShape* star = CreateStar((Vector2){ 100, 100 }, 60, 5, GOLD);
+    float notch = -54.0f * DEG2RAD;
+    if (!CheckCollisionPoint2DShape((Vector2){ 100, 72 }, star) ||
+        CheckCollisionPoint2DShape((Vector2){ 100 + cosf(notch)*20, 100 + sinf(notch)*20 }, star)) {
+        printf("FAIL: Star picking does not follow its spikes\n");
+    }
+    FreeShape(star);
+    
+    // Shapes are tested in their own rotated space
+    RayPals2DShape* bar = CreateRectangle((Vector2){ 0, 0 }, (Vector2){ 100, 10 }, RED);
+    SetShapeRotation(bar, 90.0f);
+    if (!CheckCollisionPoint2DShape((Vector2){ 0, 40 }, bar) || CheckCollisionPoint2DShape((Vector2){ 40, 0 }, bar)) {
+        printf("FAIL: Rotated rectangle picking ignores its rotation\n");
+    }
+    FreeShape(bar);
+    
+    // Near the tip of a water drop only a thin sliver is covered
+    RayPals2DShape* drop = CreateWaterDrop((Vector2){ 0, 0 }, 40, 0.0f, BLUE);
+    if (!CheckCollisionPoint2DShape((Vector2){ 0, 16 }, drop) || !CheckCollisionPoint2DShape((Vector2){ 0, -15 }, drop) ||
+        CheckCollisionPoint2DShape((Vector2){ 12, 14 }, drop)) {
+        printf("FAIL: Water drop picking does not follow its outline\n");
+    }
+    FreeShape(drop);
+    
+    // The topmost shape wins, through the sprite's rotation and scale
+    RayPalsSprite* sprite = CreateSprite(2);
+    AddShapeToSprite(sprite, CreateCircle((Vector2){ 0, 0 }, 10, GREEN));
+    AddShapeToSprite(sprite, CreateSquare((Vector2){ 0, 0 }, 8, YELLOW));
+    SetSpritePosition(sprite, (Vector2){ 200, 200 });
+    SetSpriteRotation(sprite, 45.0f);
+    SetSpriteScale(sprite, 2.0f);
+    RayPalsSprite* other = CreateSprite(1);
+    AddShapeToSprite(other, CreateCircle((Vector2){ 0, 0 }, 10, GREEN));
+    
+    RayPalsSprite* sprites[2] = { sprite, other };
+    int shapeIndex = -1;
+    Vector2 rim = { 200 + 18 * cosf(45.0f * DEG2RAD), 200 + 18 * sinf(45.0f * DEG2RAD) };
+    if (GetSpriteShapeAtPoint(sprite, (Vector2){ 200, 200 }) != 1 || GetSpriteShapeAtPoint(sprite, rim) != 0 ||
+        PickSprite(sprites, 2, rim, &shapeIndex) != sprite || shapeIndex != 0 ||
+        PickSprite(sprites, 2, (Vector2){ 230, 200 }, &shapeIndex) != NULL || shapeIndex != -1) {
+        printf("FAIL: Sprite picking returned the wrong sprite or shape\n");
+    }
+    FreeSprite(sprite);
+    FreeSprite(other);
+    
+    // A cylinder rotated onto the -x axis: hit on its side and its cap, missed in a box corner
+    RayPals3DShape* cylinder = CreateCylinder((Vector3){ 0, 0, 0 }, 1, 4, 8, BROWN);
+    Set3DShapeRotation(cylinder, (Vector3){ 0, 0, 90 });
+    RayCollision side = GetRayCollision3DShape((Ray){ { -2, 5, 0 }, { 0, -2, 0 } }, cylinder, NULL);
+    RayCollision cap = GetRayCollision3DShape((Ray){ { 5, 0, 0 }, { -1, 0, 0 } }, cylinder, NULL);
+    RayCollision corner = GetRayCollision3DShape((Ray){ { 5, 0.9f, 0.9f }, { -1, 0, 0 } }, cylinder, NULL);
+    if (!side.hit || fabsf(side.distance - 4.0f) > 1e-3f || side.normal.y < 0.999f ||
+        !cap.hit || fabsf(cap.distance - 5.0f) > 1e-3f || cap.normal.x < 0.999f || corner.hit) {
+        printf("FAIL: Rotated cylinder ray hits are wrong\n");
+    }
+    Free3DShape(cylinder);
+    
+    // The slanted side of a cone, with its normal leaning up and out
+    RayPals3DShape* cone = CreateCone((Vector3){ 0, 0, 0 }, 1, 2, 8, DARKGREEN);
+    RayCollision slope = GetRayCollision3DShape((Ray){ { 0.75f, 5, 0 }, { 0, -1, 0 } }, cone, NULL);
+    if (!slope.hit || fabsf(slope.distance - 4.5f) > 1e-3f || slope.normal.x <= 0.0f || slope.normal.y <= 0.0f) {
+        printf("FAIL: Cone ray hit is wrong\n");
+    }
+    Free3DShape(cone);
+    
+    // The nearest shape of a rotated sprite, and a miss inside the box of a rotated cube
+    RayPals3DSprite* object = Create3DSprite(2);
+    Set3DSpritePosition(object, (Vector3){ 10, 0, 0 });
+    Set3DSpriteRotation(object, (Vector3){ 0, 90, 0 });
+    RayPals3DShape* cube = CreateCube((Vector3){ 0, 0, 0 }, (Vector3){ 2, 2, 2 }, GRAY);
+    Set3DShapeRotation(cube, (Vector3){ 0, 45, 0 });
+    AddShapeTo3DSprite(object, cube);
+    AddShapeTo3DSprite(object, CreateSphere((Vector3){ 0, 0, -3 }, 1, 8, RED));
+    
+    RayCollision front = GetRayCollision3DSprite((Ray){ { 0, 0, 0 }, { 2, 0, 0 } }, object, &shapeIndex);
+    if (!front.hit || shapeIndex != 1 || fabsf(front.distance - 6.0f) > 1e-3f) {
+        printf("FAIL: Sprite ray hit shape %d at %f instead of the sphere at 6\n", shapeIndex, front.distance);
+    }
+    RayCollision back = GetRayCollision3DSprite((Ray){ { 20, 0, 0 }, { -1, 0, 0 } }, object, &shapeIndex);
+    if (!back.hit || shapeIndex != 0 || fabsf(back.distance - (10.0f - sqrtf(2.0f))) > 1e-3f) {
+        printf("FAIL: Sprite ray hit shape %d at %f instead of the cube corner\n", shapeIndex, back.distance);
+    }
+    if (GetRayCollision3DSprite((Ray){ { 11.3f, 5, 1.3f }, { 0, -1, 0 } }, object, &shapeIndex).hit || shapeIndex != -1) {
+        printf("FAIL: Ray through the empty corner of a rotated cube's box hit it\n");
+    }
+    Free3DSprite(object);
+    
+    // Nearest hit and line of sight through a BVH over a row of spheres
+    RayPals3DSprite* row[10];
+    for (int i = 0; i < 10; i++) {
+        row[i] = Create3DSprite(1);
+        Set3DSpritePosition(row[i], (Vector3){ 3.0f * i, 0, 0 });
+        AddShapeTo3DSprite(row[i], CreateSphere((Vector3){ 0, 0, 0 }, 1, 8, BLUE));
+    }
+    RayPals3DBVH* bvh = Create3DBVH(row, 10);
+    RayCollision hit = { 0 };
+    RayPals3DSprite* nearest = Raycast3DBVH(bvh, (Ray){ { 40, 0, 0 }, { -1, 0, 0 } }, 100.0f, &hit, &shapeIndex);
+    if (nearest != row[9] || shapeIndex != 0 || fabsf(hit.distance - 12.0f) > 1e-3f) {
+        printf("FAIL: BVH raycast did not return the nearest sphere\n");
+    }
+    if (Raycast3DBVH(bvh, (Ray){ { 40, 0, 0 }, { -1, 0, 0 } }, 10.0f, NULL, NULL) != NULL ||
+        Raycast3DBVH(bvh, (Ray){ { 40, 0.8f, 0.8f }, { -1, 0, 0 } }, 100.0f, NULL, NULL) != NULL) {
+        printf("FAIL: BVH raycast hit beyond its range or between the spheres\n");
+    }
+    Free3DBVH(bvh);
+    for (int i = 0; i < 10; i++) Free3DSprite(row[i]);
+    
+    printf("PASS: Picking test completed\n");
+}